@@ -0,0 +1,48 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace radar::bench
+{
+
+// Parses all of text as a T. False on an empty string, trailing characters, a sign on an unsigned type,
+// a value out of T's range, or a non-finite float.
+template <typename T>
+bool parseNumber(std::string_view text, T& value)
+{
+    T parsed{};
+    const char* const end = text.data() + text.size();
+    const auto [last, error] = std::from_chars(text.data(), end, parsed);
+    if (text.empty() || error != std::errc() || last != end)
+    {
+        return false;
+    }
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (!std::isfinite(parsed))
+        {
+            return false;
+        }
+    }
+    value = parsed;
+    return true;
+}
+
+// parseNumber that also rejects zero and negative values, for counts, passes and sizes.
+template <typename T>
+bool parsePositive(std::string_view text, T& value)
+{
+    T parsed{};
+    if (!parseNumber(text, parsed) || !(parsed > T{}))
+    {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+} // namespace radar::bench
@@ -0,0 +1,99 @@
+#include "bench/bench_args.hpp"
+#include "mapping/RadarVirtualSensorMapping.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Scattered occupied cells (about occupiedShare of them) on a 120 m grid of 0.5 m cells, like
+// FusedRadarMapping's default geometry.
+std::vector<float> makeLogOdds(int size, float occupiedShare)
+{
+    std::mt19937 rng(11U);
+    std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+    std::vector<float> logOdds(static_cast<std::size_t>(size * size));
+    for (auto& value : logOdds)
+    {
+        value = unit(rng) < occupiedShare ? 1.0F : -0.5F;
+    }
+    return logOdds;
+}
+
+std::vector<glm::vec2> makeDetections(std::size_t count)
+{
+    std::mt19937 rng(13U);
+    std::uniform_real_distribution<float> coordinate(-60.0F, 60.0F);
+    std::vector<glm::vec2> detections(count);
+    for (auto& detection : detections)
+    {
+        detection = glm::vec2(coordinate(rng), coordinate(rng));
+    }
+    return detections;
+}
+
+template <typename Update>
+double usPerUpdate(std::size_t passes, Update&& update)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass)
+    {
+        update();
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return us / static_cast<double>(passes);
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_grid_ring_bench [segments] [passes]\n";
+}
+} // namespace
+
+// Times RadarVirtualSensorMapping::updateFromGrid() on a fixed grid against the detection update for growing
+// point counts: the grid march does not depend on the number of detections.
+// Usage: radar_grid_ring_bench [segments] [passes]
+int main(int argc, char** argv)
+{
+    std::size_t segments = radar::RadarVirtualSensorMapping::kDefaultSegmentCount;
+    std::size_t passes = 2000U;
+    if ((argc > 1 && !radar::bench::parsePositive(argv[1], segments)) ||
+        (argc > 2 && !radar::bench::parsePositive(argv[2], passes)))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    radar::RadarVirtualSensorMapping mapping;
+    mapping.setSegmentCount(segments);
+    mapping.setVehicleContour({{-0.9F, -1.0F}, {0.9F, -1.0F}, {0.9F, 3.8F}, {-0.9F, 3.8F}});
+
+    constexpr int kGridSize = 240;
+    const auto logOdds = makeLogOdds(kGridSize, 0.01F);
+    const radar::OccupancyGridView grid{logOdds.data(), kGridSize, 0.5F, glm::vec2(-60.0F, -60.0F), 0.2F};
+
+    // The first call builds the traversal lists; time it separately from the steady state.
+    const auto buildStart = std::chrono::steady_clock::now();
+    mapping.updateFromGrid(grid, {});
+    const double buildUs =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - buildStart).count();
+    const double gridUs = usPerUpdate(passes, [&] { mapping.updateFromGrid(grid, {}); });
+
+    std::cout << segments << " segments, " << kGridSize << "x" << kGridSize << " grid\n"
+              << std::fixed << std::setprecision(2) << "traversal build:  " << buildUs << " us\n"
+              << "grid march:       " << gridUs << " us/update\n";
+    for (const std::size_t count : {std::size_t{1000U}, std::size_t{10000U}, std::size_t{100000U}})
+    {
+        const auto detections = makeDetections(count);
+        const double detectionUs = usPerUpdate(std::max<std::size_t>(1U, passes * 1000U / count),
+                                               [&] { mapping.update(detections, {}); });
+        std::cout << std::setw(6) << count << " detections: " << detectionUs << " us/update\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include "bench/bench_args.hpp"
+#include "mapping/FusedRadarMapping.hpp"
+#include "processing/RadarPlayback.hpp"
+#include "processing/ScenarioGenerator.hpp"
+#include "radar_core/huge_page_allocator.hpp"
+#include "radar_core/perf_counters.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+void runMode(radar::core::HugePageMode mode, float cellSize, const std::vector<radar::BaseRadarSensor::PointCloud>& frames)
+{
+    radar::FusedRadarMapping::Settings settings;
+    settings.cellSize = cellSize;
+    settings.mapRadius = 100.0F;
+    settings.gridHugePages = mode;
+    radar::FusedRadarMapping mapping(settings);
+
+    std::size_t detections = 0U;
+    for (const auto& frame : frames)
+    {
+        detections += frame.size();
+    }
+
+    // Counters are opened after the grid exists so its first-touch page faults are not measured.
+    radar::core::PerfCounterGroup counters;
+    radar::core::PerfCounterSample before;
+    radar::core::PerfCounterSample after;
+    const bool counted = counters.read(before);
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& frame : frames)
+    {
+        mapping.update(frame);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const bool countedAfter = counted && counters.read(after);
+    const radar::core::PerfCounterSample events = after.deltaSince(before);
+
+    const auto perDetection = [&](radar::core::PerfCounter counter) -> std::string
+    {
+        if (!countedAfter || !counters.supports(counter) || detections == 0U)
+        {
+            return "n/a";
+        }
+        std::ostringstream value;
+        value << std::fixed << std::setprecision(2)
+              << static_cast<double>(events[counter]) / static_cast<double>(detections);
+        return value.str();
+    };
+
+    const int side = static_cast<int>(std::ceil(settings.mapRadius * 2.0F / cellSize));
+    const double gridMiB = static_cast<double>(side) * side * sizeof(float) / (1024.0 * 1024.0);
+    std::cout << std::left << std::setw(13) << radar::core::hugePageModeName(mode) << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << gridMiB << std::setw(12)
+              << static_cast<double>(mapping.gridHugePageBytes()) / (1024.0 * 1024.0) << std::setw(14)
+              << (seconds > 0.0 ? static_cast<double>(detections) / seconds / 1e3 : 0.0) << std::setw(14)
+              << perDetection(radar::core::PerfCounter::DataTlbMisses) << std::setw(14)
+              << perDetection(radar::core::PerfCounter::LastLevelCacheMisses) << '\n';
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_huge_page_grid [cellSize ...]\n";
+}
+} // namespace
+
+// Replays one synthetic scenario into FusedRadarMapping with the grid on 4 KB pages, transparent huge pages
+// and explicit huge pages, and prints update throughput plus dTLB / LLC misses per detection.
+// Usage: radar_huge_page_grid [cellSize ...]
+int main(int argc, char** argv)
+{
+    std::vector<float> cellSizes = {0.1F, 0.05F};
+    if (argc > 1)
+    {
+        cellSizes.clear();
+        for (int i = 1; i < argc; ++i)
+        {
+            float cellSize = 0.0F;
+            if (!radar::bench::parsePositive(argv[i], cellSize))
+            {
+                printUsage();
+                return EXIT_FAILURE;
+            }
+            cellSizes.push_back(cellSize);
+        }
+    }
+
+    radar::ScenarioSettings scenario;
+    scenario.duration_s = 2.0F;
+    scenario.returnsPerScan = 64U;
+    const std::filesystem::path dataRoot = std::filesystem::temp_directory_path() / "radar_huge_page_grid";
+    radar::ScenarioCapture capture;
+    if (!radar::ScenarioGenerator(scenario).write(dataRoot, capture))
+    {
+        return EXIT_FAILURE;
+    }
+
+    radar::RadarPlayback::Settings settings;
+    settings.dataRoot = dataRoot;
+    settings.inputFiles = capture.inputFiles;
+    settings.vehicleConfigPath = capture.vehicleConfigPath;
+    radar::RadarPlayback playback(std::move(settings));
+    if (!playback.initialize())
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<radar::BaseRadarSensor::PointCloud> frames;
+    radar::RadarFrame frame;
+    while (playback.readNextFrame(frame))
+    {
+        if (frame.hasDetections)
+        {
+            frames.push_back(frame.detections);
+        }
+    }
+
+    for (const float cellSize : cellSizes)
+    {
+        std::cout << "cellSize " << cellSize << " m, " << frames.size() << " frames\n";
+        std::cout << std::left << std::setw(13) << "grid pages" << std::right << std::setw(10) << "MiB"
+                  << std::setw(12) << "huge MiB" << std::setw(14) << "kdet/s" << std::setw(14) << "dTLB/det"
+                  << std::setw(14) << "LLC/det" << '\n';
+        for (const auto mode :
+             {radar::core::HugePageMode::Off, radar::core::HugePageMode::Transparent, radar::core::HugePageMode::Explicit})
+        {
+            runMode(mode, cellSize, frames);
+        }
+        std::cout << '\n';
+    }
+
+    // Every grid has been released by now, so only the fallback count is still informative.
+    std::cout << radar::core::hugePageStatistics().fallbacks << " fallbacks\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+#include "processing/RadarPlayback.hpp"
+#include "radar_core/odometry_estimator.hpp"
+#include "radar_core/perf_counters.hpp"
+#include "radar_core/processing_pipeline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr float kPi = 3.14159265358979f;
+
+struct Method
+{
+    const char* name;
+    radar::core::OdometryMethod method;
+};
+
+constexpr std::array<Method, 2> kMethods = {{{"ransac", radar::core::OdometryMethod::Ransac},
+                                             {"histogram", radar::core::OdometryMethod::Histogram}}};
+
+struct SyntheticFrame
+{
+    radar::core::ScratchVector<radar::core::OdometrySample> samples;
+    float vLon = 0.0f;
+    float vLat = 0.0f;
+};
+
+// Returns all around the vehicle with 0.1 m/s range-rate noise; a clutterFraction share is replaced by movers
+// with unrelated range rates.
+std::vector<SyntheticFrame> makeFrames(float clutterFraction, std::size_t frameCount, std::size_t samplesPerFrame)
+{
+    std::mt19937 rng(3U);
+    std::uniform_real_distribution<float> angle(-kPi, kPi);
+    std::uniform_real_distribution<float> speed(0.0f, 30.0f);
+    std::uniform_real_distribution<float> lateral(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> mover(-35.0f, 35.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+
+    std::vector<SyntheticFrame> frames(frameCount);
+    for (auto& frame : frames)
+    {
+        frame.vLon = speed(rng);
+        frame.vLat = lateral(rng);
+        frame.samples.reserve(samplesPerFrame);
+        for (std::size_t i = 0; i < samplesPerFrame; ++i)
+        {
+            const float a = angle(rng);
+            radar::core::OdometrySample sample{std::cos(a), std::sin(a), 0.0f};
+            sample.rangeRate = unit(rng) < clutterFraction
+                                   ? mover(rng)
+                                   : -(frame.vLon * sample.cosAngle + frame.vLat * sample.sinAngle) + noise(rng);
+            frame.samples.push_back(sample);
+        }
+    }
+    return frames;
+}
+
+void compareSynthetic(float clutterFraction)
+{
+    const auto frames = makeFrames(clutterFraction, 2000U, 64U);
+    for (const auto& method : kMethods)
+    {
+        radar::core::OdometrySettings settings;
+        settings.method = method.method;
+        radar::core::RadarOdometryEstimator estimator(settings);
+
+        std::vector<float> errors;
+        errors.reserve(frames.size());
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& frame : frames)
+        {
+            utility::OdometryEstimate estimate;
+            if (estimator.processSamples(frame.samples, 0U) && estimator.latestEstimate(estimate))
+            {
+                errors.push_back(std::hypot(estimate.vLon_mps - frame.vLon, estimate.vLat_mps - frame.vLat));
+            }
+        }
+        const double us =
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+            static_cast<double>(frames.size());
+
+        std::sort(errors.begin(), errors.end());
+        const auto quantile = [&errors](double q)
+        { return errors.empty() ? 0.0f : errors[static_cast<std::size_t>(q * static_cast<double>(errors.size() - 1U))]; };
+        const auto gross = std::count_if(errors.begin(), errors.end(), [](float error) { return error > 1.0f; });
+        std::cout << std::left << std::setw(10) << method.name << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(9) << clutterFraction * 100.0f << '%' << std::setprecision(1) << std::setw(10)
+                  << 100.0 * static_cast<double>(errors.size()) / static_cast<double>(frames.size()) << '%'
+                  << std::setprecision(3) << std::setw(12) << quantile(0.5) << std::setw(12) << quantile(0.95)
+                  << std::setw(10) << gross << std::setprecision(2) << std::setw(12) << us << '\n';
+    }
+}
+
+// Replays the capture once per method and compares the per-frame estimates; the capture has no ground truth,
+// so agreement between the methods and frame-to-frame smoothness stand in for accuracy.
+bool compareCapture(const std::filesystem::path& dataRoot)
+{
+    std::array<std::vector<utility::OdometryEstimate>, kMethods.size()> estimates;
+    std::array<double, kMethods.size()> odometryUs{};
+    for (std::size_t m = 0; m < kMethods.size(); ++m)
+    {
+        radar::RadarPlayback::Settings settings;
+        settings.dataRoot = dataRoot;
+        settings.inputFiles = {"fourCornersfusedRadarDetections.txt", "fusedFrontRadarsDetections.txt",
+                               "fusedRadarTracks.txt"};
+        radar::RadarPlayback playback(std::move(settings));
+        if (!playback.initialize())
+        {
+            return false;
+        }
+
+        radar::core::ProcessingSettings processing;
+        processing.odometry.method = kMethods[m].method;
+        radar::core::RadarProcessingPipeline pipeline(processing);
+        pipeline.initialize(playback.vehicleParameters());
+        radar::core::StageProfiler profiler(false);
+        pipeline.setProfiler(&profiler);
+
+        radar::RadarRecordBatch batch;
+        radar::RadarFrame frame;
+        while (playback.readNextRecords(batch))
+        {
+            playback.processRecords(batch, pipeline, frame);
+            utility::OdometryEstimate estimate;
+            pipeline.latestOdometry(estimate);
+            estimates[m].push_back(estimate);
+        }
+        for (const auto& stage : profiler.stages())
+        {
+            if (stage.name == "pipeline.odometry" && stage.calls > 0U)
+            {
+                odometryUs[m] = stage.wallTime_s * 1e6 / static_cast<double>(stage.calls);
+            }
+        }
+    }
+
+    std::cout << "\ncapture " << dataRoot.string() << " (" << estimates[0].size() << " frames)\n";
+    for (std::size_t m = 0; m < kMethods.size(); ++m)
+    {
+        std::size_t valid = 0U;
+        double jitter = 0.0;
+        std::size_t jitterCount = 0U;
+        for (std::size_t i = 0; i < estimates[m].size(); ++i)
+        {
+            valid += estimates[m][i].valid ? 1U : 0U;
+            if (i > 0U && estimates[m][i].valid && estimates[m][i - 1U].valid)
+            {
+                jitter += std::abs(estimates[m][i].vLon_mps - estimates[m][i - 1U].vLon_mps);
+                ++jitterCount;
+            }
+        }
+        std::cout << std::left << std::setw(10) << kMethods[m].name << std::right << std::fixed
+                  << std::setprecision(1) << " valid "
+                  << 100.0 * static_cast<double>(valid) / static_cast<double>(std::max<std::size_t>(1U, estimates[m].size()))
+                  << "%  frame-to-frame |dvLon| " << std::setprecision(3)
+                  << (jitterCount > 0U ? jitter / static_cast<double>(jitterCount) : 0.0) << " m/s  odometry "
+                  << std::setprecision(2) << odometryUs[m] << " us/call\n";
+    }
+
+    double difference = 0.0;
+    std::size_t both = 0U;
+    for (std::size_t i = 0; i < estimates[0].size() && i < estimates[1].size(); ++i)
+    {
+        if (estimates[0][i].valid && estimates[1][i].valid)
+        {
+            difference += std::hypot(estimates[0][i].vLon_mps - estimates[1][i].vLon_mps,
+                                     estimates[0][i].vLat_mps - estimates[1][i].vLat_mps);
+            ++both;
+        }
+    }
+    std::cout << "mean |v_ransac - v_histogram| over " << both << " frames: " << std::setprecision(3)
+              << (both > 0U ? difference / static_cast<double>(both) : 0.0) << " m/s\n";
+    return true;
+}
+} // namespace
+
+// Compares the RANSAC and histogram ego-velocity estimators: accuracy and cost on synthetic frames with known
+// velocity and increasing clutter, then agreement on the shipped capture.
+// Usage: radar_odometry_compare [dataRoot]
+int main(int argc, char** argv)
+{
+    const std::filesystem::path dataRoot = argc > 1 ? std::filesystem::path(argv[1]) : std::filesystem::path("data");
+
+    std::cout << std::left << std::setw(10) << "method" << std::right << std::setw(10) << "clutter" << std::setw(11)
+              << "valid" << std::setw(12) << "p50 err" << std::setw(12) << "p95 err" << std::setw(10) << ">1 m/s"
+              << std::setw(12) << "us/frame" << '\n';
+    for (const float clutter : {0.0f, 0.3f, 0.6f, 0.8f})
+    {
+        compareSynthetic(clutter);
+    }
+
+    if (!compareCapture(dataRoot))
+    {
+        std::cerr << "capture not found under " << dataRoot.string() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#include "bench/bench_args.hpp"
+#include "mapping/FusedRadarMapping.hpp"
+#include "processing/ParameterSweep.hpp"
+#include "processing/RadarPlayback.hpp"
+#include "processing/ScenarioGenerator.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<radar::SweepVariant> buildVariants()
+{
+    std::vector<radar::SweepVariant> variants;
+    for (const float nSigma : {2.0F, 3.0F, 4.0F})
+    {
+        for (const float inlierThreshold : {0.2F, 0.35F, 0.5F})
+        {
+            radar::SweepVariant variant;
+            variant.processing.stationary.nSigma = nSigma;
+            variant.processing.odometry.inlierThreshold_mps = inlierThreshold;
+            std::ostringstream name;
+            name << "nSigma=" << nSigma << " inlier=" << inlierThreshold;
+            variant.name = name.str();
+            variants.push_back(std::move(variant));
+        }
+    }
+    return variants;
+}
+
+// What tuning cost before the sweep runner: one full replay (decode + process + map) per variant.
+double replayPerVariantMs(const radar::ScenarioCapture& capture,
+                          const std::filesystem::path& dataRoot,
+                          const std::vector<radar::SweepVariant>& variants)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& variant : variants)
+    {
+        radar::RadarPlayback::Settings settings;
+        settings.dataRoot = dataRoot;
+        settings.inputFiles = capture.inputFiles;
+        settings.vehicleConfigPath = capture.vehicleConfigPath;
+        settings.processingSettings =
+            std::make_shared<radar::core::SettingsChannel<radar::core::ProcessingSettings>>(variant.processing);
+        radar::RadarPlayback playback(std::move(settings));
+        if (!playback.initialize())
+        {
+            return 0.0;
+        }
+        radar::FusedRadarMapping mapping(variant.mapping);
+        radar::RadarFrame frame;
+        while (playback.readNextFrame(frame))
+        {
+            mapping.update(frame.detections);
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_parameter_sweep [workers] [duration_s]\n";
+}
+} // namespace
+
+// Sweeps stationary nSigma x odometry inlier threshold over one synthetic capture with a single decode pass,
+// then replays the capture once per variant for comparison.
+// Usage: radar_parameter_sweep [workers] [duration_s]
+int main(int argc, char** argv)
+{
+    radar::ScenarioSettings scenario;
+    scenario.duration_s = 10.0F;
+    scenario.returnsPerScan = 64U;
+    std::size_t workers = 0U;
+    // Zero workers lets ParameterSweep pick one per hardware thread.
+    if ((argc > 1 && !radar::bench::parseNumber(argv[1], workers)) ||
+        (argc > 2 && !radar::bench::parsePositive(argv[2], scenario.duration_s)))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path dataRoot = std::filesystem::temp_directory_path() / "radar_parameter_sweep";
+    radar::ScenarioCapture capture;
+    if (!radar::ScenarioGenerator(scenario).write(dataRoot, capture))
+    {
+        return EXIT_FAILURE;
+    }
+
+    const auto variants = buildVariants();
+    radar::ParameterSweep::Settings settings;
+    settings.dataRoot = dataRoot;
+    settings.inputFiles = capture.inputFiles;
+    settings.vehicleConfigPath = capture.vehicleConfigPath;
+    settings.workerCount = workers;
+    radar::ParameterSweep sweep(std::move(settings));
+    for (const auto& variant : variants)
+    {
+        sweep.addVariant(variant);
+    }
+    if (!sweep.run())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << sweep.report();
+
+    const double sequentialMs = replayPerVariantMs(capture, dataRoot, variants);
+    std::cout << "replay per variant " << std::fixed << std::setprecision(1) << sequentialMs << " ms ("
+              << variants.size() << " decodes)\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+#include "bench/bench_args.hpp"
+#include "radar_core/processing_pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+utility::VehicleParameters makeParameters()
+{
+    utility::VehicleParameters parameters;
+    parameters.cornerHardwareDelay_s = 0.08f;
+    for (auto& calibration : parameters.radarCalibrations)
+    {
+        calibration.polarity = 1.0f;
+        calibration.rangeRateAccuracy_mps = 1.5f;
+        calibration.iso.longitudinal_m = 3.5f;
+        calibration.iso.lateral_m = 0.8f;
+        calibration.iso.orientation_rad = 0.7f;
+        calibration.vcs = calibration.iso;
+    }
+    return parameters;
+}
+
+// One corner radar at 20 Hz driving at ~12 m/s, with returnsPerScan returns per scan; a mover every seventh.
+std::vector<utility::RawCornerDetections> makeFrames(std::size_t frameCount, std::size_t returnsPerScan)
+{
+    std::mt19937 rng(5U);
+    std::uniform_real_distribution<float> azimuth(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> range(1.0f, 60.0f);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    std::vector<utility::RawCornerDetections> frames(frameCount);
+    for (std::size_t frame = 0; frame < frameCount; ++frame)
+    {
+        auto& record = frames[frame];
+        record.header.timestamp_us = 1000000U + frame * 50000U;
+        for (std::size_t i = 0; i < returnsPerScan; ++i)
+        {
+            const float angle = azimuth(rng);
+            record.range_m[i] = range(rng);
+            record.azimuthRaw_rad[i] = angle;
+            record.azimuth_rad[i] = angle;
+            record.rangeRate_ms[i] = (i % 7U == 0U) ? 3.0f : -12.0f * std::cos(angle + 0.7f) + noise(rng);
+            record.radarValidReturn[i] = 1U;
+        }
+    }
+    return frames;
+}
+
+// Tracks ahead of the vehicle, refreshed every fourth frame like a 5 Hz fusion output.
+std::vector<utility::RawTrackFusion> makeTracks(std::size_t count, std::size_t trackCount)
+{
+    std::vector<utility::RawTrackFusion> tracks(count);
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        for (std::size_t slot = 0; slot < trackCount; ++slot)
+        {
+            tracks[n].status[slot] = static_cast<std::uint8_t>(utility::TrackStatus::Updated);
+            tracks[n].vcsLongitudinalPosition[slot] = 5.0f + 3.0f * static_cast<float>(slot);
+            tracks[n].vcsLateralPosition[slot] = static_cast<float>(slot % 5U) * 3.0f - 6.0f;
+            tracks[n].vcsLongitudinalVelocity[slot] = 2.0f;
+            tracks[n].length[slot] = 4.5f;
+            tracks[n].width[slot] = 1.8f;
+        }
+    }
+    return tracks;
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_pipeline_batch_bench [frames] [returnsPerScan] [trackCount] [passes]\n";
+}
+} // namespace
+
+// Times RadarProcessingPipeline::processCornerBatch against one processCornerDetectionsFused call per frame
+// over the same frames and track snapshots, and checks both produce the same detections.
+// Usage: radar_pipeline_batch_bench [frames] [returnsPerScan] [trackCount] [passes]
+int main(int argc, char** argv)
+{
+    std::size_t frameCount = 2000U;
+    std::size_t returnsPerScan = 48U;
+    std::size_t trackCount = 24U;
+    std::size_t passes = 20U;
+    if ((argc > 1 && !radar::bench::parsePositive(argv[1], frameCount)) ||
+        (argc > 2 && !radar::bench::parsePositive(argv[2], returnsPerScan)) ||
+        (argc > 3 && !radar::bench::parseNumber(argv[3], trackCount)) ||
+        (argc > 4 && !radar::bench::parsePositive(argv[4], passes)))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    returnsPerScan = std::min<std::size_t>(returnsPerScan, utility::kCornerReturnCount);
+    trackCount = std::min<std::size_t>(trackCount, utility::kTrackCount);
+
+    const auto parameters = makeParameters();
+    const auto frames = makeFrames(frameCount, returnsPerScan);
+    std::vector<std::uint64_t> timestamps;
+    for (const auto& frame : frames)
+    {
+        timestamps.push_back(frame.header.timestamp_us + 80000U);
+    }
+    const auto tracks = makeTracks((frameCount + 3U) / 4U, trackCount);
+    std::vector<radar::core::TrackSnapshot> snapshots;
+    for (std::size_t n = 0; n < tracks.size(); ++n)
+    {
+        snapshots.push_back({timestamps[n * 4U], &tracks[n]});
+    }
+
+    std::size_t singleDetections = 0U;
+    std::size_t singleAssociated = 0U;
+    const auto singleStart = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass)
+    {
+        radar::core::RadarProcessingPipeline pipeline;
+        pipeline.initialize(&parameters);
+        utility::EnhancedTracks trackOutput;
+        std::vector<utility::EnhancedDetection> detections;
+        detections.reserve(frameCount * returnsPerScan);
+        const auto append = [&](utility::SensorIndex, std::size_t, const utility::EnhancedDetection& det)
+        { detections.push_back(det); };
+        for (std::size_t i = 0; i < frames.size(); ++i)
+        {
+            if (i % 4U == 0U)
+            {
+                pipeline.processTrackFusion(snapshots[i / 4U].timestamp_us, tracks[i / 4U], trackOutput);
+            }
+            pipeline.processCornerDetectionsFused(utility::SensorIndex::FrontLeft, timestamps[i], frames[i], append);
+        }
+        singleDetections = detections.size();
+        singleAssociated = 0U;
+        for (const auto& det : detections)
+        {
+            singleAssociated += det.fusedTrackIndex >= 0 ? 1U : 0U;
+        }
+    }
+    const double singleMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - singleStart).count();
+
+    radar::core::ProcessedBatch batch;
+    std::size_t batchAssociated = 0U;
+    const auto batchStart = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass)
+    {
+        radar::core::RadarProcessingPipeline pipeline;
+        pipeline.initialize(&parameters);
+        pipeline.processCornerBatch(utility::SensorIndex::FrontLeft, timestamps, frames, snapshots, batch);
+        batchAssociated = 0U;
+        for (const auto& det : batch.detections)
+        {
+            batchAssociated += det.fusedTrackIndex >= 0 ? 1U : 0U;
+        }
+    }
+    const double batchMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batchStart).count();
+
+    if (batch.detections.size() != singleDetections || batchAssociated != singleAssociated)
+    {
+        std::cerr << "batch mismatch: " << batch.detections.size() << " detections (" << batchAssociated
+                  << " associated) vs " << singleDetections << " (" << singleAssociated << ")\n";
+        return EXIT_FAILURE;
+    }
+
+    const double perFrame = static_cast<double>(passes * frameCount) / 1000.0;
+    std::cout << frameCount << " frames x " << returnsPerScan << " returns, " << trackCount << " tracks, "
+              << singleAssociated << " associated detections\n"
+              << std::fixed << std::setprecision(2) << "per-frame calls: " << singleMs / perFrame << " us/frame\n"
+              << "batch:           " << batchMs / perFrame << " us/frame ("
+              << (batchMs > 0.0 ? singleMs / batchMs : 0.0) << "x)\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#include "bench/bench_args.hpp"
+#include "mapping/FusedRadarMapping.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The per-detection plausibility before the tables: three exp() calls, an fmod() wrap and a switch.
+float referencePlausibility(const radar::FusedRadarMapping::Settings& settings,
+                            float range_m,
+                            float azimuth_rad,
+                            float amplitude_dBsm)
+{
+    const auto sigmoid = [](float value, float growthRate, float midpoint)
+    { return 1.0F / (1.0F + std::exp(-growthRate * (value - midpoint))); };
+    float azimuthDeg = std::fmod(azimuth_rad * 57.2957795F + 180.0F, 360.0F);
+    azimuthDeg = std::abs((azimuthDeg < 0.0F ? azimuthDeg + 360.0F : azimuthDeg) - 180.0F);
+    const float range =
+        sigmoid(range_m, -4.39444915F / settings.plausibilityRangeBandwidth, settings.plausibilityRangeMidpoint);
+    const float azimuth = sigmoid(azimuthDeg,
+                                  -4.39444915F / settings.plausibilityAzimuthBandwidth,
+                                  settings.plausibilityAzimuthMidpoint);
+    const float amplitude = sigmoid(amplitude_dBsm,
+                                    4.39444915F / settings.plausibilityAmplitudeBandwidth,
+                                    settings.plausibilityAmplitudeMidpoint);
+
+    using Method = radar::FusedRadarMapping::PlausibilityCombinationMethod;
+    float combined = 1.0F;
+    switch (settings.plausibilityMethod)
+    {
+        case Method::Average:
+            combined = (range + azimuth + amplitude) / 3.0F;
+            break;
+        case Method::Product:
+            combined = range * azimuth * amplitude;
+            break;
+        case Method::Minimum:
+            combined = std::min({range, azimuth, amplitude});
+            break;
+        default:
+            combined = range_m > settings.customCombinationRangeThreshold ? std::min(range, azimuth) * amplitude
+                                                                          : range * amplitude;
+            break;
+    }
+    return std::clamp(combined, 0.0F, 1.0F);
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_plausibility_bench [detections] [passes]\n";
+}
+} // namespace
+
+// Times the closed-form plausibility against FusedRadarMapping::computePlausibility() over the same detections
+// and reports the largest difference.
+// Usage: radar_plausibility_bench [detections] [passes]
+int main(int argc, char** argv)
+{
+    std::size_t count = 4096U;
+    std::size_t passes = 500U;
+    if ((argc > 1 && !radar::bench::parsePositive(argv[1], count)) ||
+        (argc > 2 && !radar::bench::parsePositive(argv[2], passes)))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 rng(11U);
+    std::uniform_real_distribution<float> range(0.5F, 120.0F);
+    std::uniform_real_distribution<float> azimuth(-3.14159265F, 3.14159265F);
+    std::uniform_real_distribution<float> amplitude(-40.0F, 20.0F);
+    std::vector<float> ranges(count);
+    std::vector<float> azimuths(count);
+    std::vector<float> amplitudes(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ranges[i] = range(rng);
+        azimuths[i] = azimuth(rng);
+        amplitudes[i] = amplitude(rng);
+    }
+
+    const radar::FusedRadarMapping::Settings settings;
+    const radar::FusedRadarMapping mapping(settings);
+    std::vector<float> reference(count);
+    std::vector<float> tabulated(count);
+
+    const auto nsPerDetection = [&](auto&& evaluate)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            evaluate();
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return ns / static_cast<double>(passes * count);
+    };
+
+    const double referenceNs = nsPerDetection(
+        [&]()
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                reference[i] = referencePlausibility(settings, ranges[i], azimuths[i], amplitudes[i]);
+            }
+        });
+    const double tabulatedNs = nsPerDetection(
+        [&]() { mapping.computePlausibility(ranges.data(), azimuths.data(), amplitudes.data(), count, tabulated.data()); });
+
+    float maxError = 0.0F;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        maxError = std::max(maxError, std::abs(reference[i] - tabulated[i]));
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << "closed form  " << referenceNs << " ns/detection\n"
+              << "tabulated    " << tabulatedNs << " ns/detection ("
+              << (tabulatedNs > 0.0 ? referenceNs / tabulatedNs : 0.0) << "x)\n"
+              << std::scientific << std::setprecision(2) << "max |difference| " << maxError << '\n';
+    return EXIT_SUCCESS;
+}
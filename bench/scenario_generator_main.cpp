@@ -0,0 +1,125 @@
+#include "bench/bench_args.hpp"
+#include "processing/ScenarioGenerator.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void printUsage()
+{
+    std::cerr << "Usage: radar_scenario_generator <output dir> [key=value ...]\n"
+              << "Keys: seed, duration, scanPeriod, cornerSensors, front, returns, tracks, clutter,\n"
+              << "      speed, yawRate, landmarkSpacing, roadHalfWidth, binary\n";
+}
+
+bool applyOption(const std::string& key, const std::string& value, radar::ScenarioSettings& settings)
+{
+    if (key == "seed")
+    {
+        return radar::bench::parseNumber(value, settings.seed);
+    }
+    else if (key == "duration")
+    {
+        return radar::bench::parsePositive(value, settings.duration_s);
+    }
+    else if (key == "scanPeriod")
+    {
+        return radar::bench::parsePositive(value, settings.scanPeriod_s);
+    }
+    else if (key == "cornerSensors")
+    {
+        return radar::bench::parseNumber(value, settings.cornerSensorCount);
+    }
+    else if (key == "front")
+    {
+        settings.includeFrontRadar = value != "0";
+    }
+    else if (key == "returns")
+    {
+        return radar::bench::parsePositive(value, settings.returnsPerScan);
+    }
+    else if (key == "tracks")
+    {
+        return radar::bench::parseNumber(value, settings.trackCount);
+    }
+    else if (key == "clutter")
+    {
+        return radar::bench::parseNumber(value, settings.clutterFraction);
+    }
+    else if (key == "speed")
+    {
+        return radar::bench::parseNumber(value, settings.egoSpeed_mps);
+    }
+    else if (key == "yawRate")
+    {
+        return radar::bench::parseNumber(value, settings.egoYawRate_rps);
+    }
+    else if (key == "landmarkSpacing")
+    {
+        return radar::bench::parsePositive(value, settings.landmarkSpacing_m);
+    }
+    else if (key == "roadHalfWidth")
+    {
+        return radar::bench::parsePositive(value, settings.roadHalfWidth_m);
+    }
+    else if (key == "binary")
+    {
+        settings.binaryCaptures = value != "0";
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// False for unknown keys and for values that are not entirely a number; durations, spacings and the return
+// count must also be positive.
+bool parseOption(const std::string& argument, radar::ScenarioSettings& settings)
+{
+    const auto separator = argument.find('=');
+    if (separator == std::string::npos)
+    {
+        return false;
+    }
+    return applyOption(argument.substr(0, separator), argument.substr(separator + 1U), settings);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    radar::ScenarioSettings settings;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (!parseOption(argument, settings))
+        {
+            std::cerr << "Invalid option: " << argument << '\n';
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    radar::ScenarioCapture capture;
+    if (!radar::ScenarioGenerator(settings).write(argv[1], capture))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Wrote " << capture.scanCount << " scans (" << capture.detectionLineCount << " detection lines, "
+              << capture.trackLineCount << " track lines):\n";
+    for (const auto& file : capture.inputFiles)
+    {
+        std::cout << "  " << file << '\n';
+    }
+    return EXIT_SUCCESS;
+}
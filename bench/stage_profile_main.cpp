@@ -0,0 +1,69 @@
+#include "bench/bench_args.hpp"
+#include "mapping/FusedRadarMapping.hpp"
+#include "processing/RadarPlayback.hpp"
+#include "processing/ScenarioGenerator.hpp"
+#include "radar_core/memory_accounting.hpp"
+#include "radar_core/perf_counters.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void printUsage()
+{
+    std::cerr << "Usage: radar_stage_profile [returnsPerScan] [trackCount]\n";
+}
+} // namespace
+
+// Replays a synthetic scenario with stage profiling enabled and prints per-stage IPC and misses per detection.
+int main(int argc, char** argv)
+{
+    radar::ScenarioSettings scenario;
+    scenario.duration_s = 20.0F;
+    scenario.returnsPerScan = 64U;
+    scenario.trackCount = 64U;
+    if ((argc > 1 && !radar::bench::parsePositive(argv[1], scenario.returnsPerScan)) ||
+        (argc > 2 && !radar::bench::parseNumber(argv[2], scenario.trackCount)))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path dataRoot = std::filesystem::temp_directory_path() / "radar_stage_profile";
+    radar::ScenarioCapture capture;
+    if (!radar::ScenarioGenerator(scenario).write(dataRoot, capture))
+    {
+        return EXIT_FAILURE;
+    }
+
+    radar::RadarPlayback::Settings settings;
+    settings.dataRoot = dataRoot;
+    settings.inputFiles = capture.inputFiles;
+    settings.vehicleConfigPath = capture.vehicleConfigPath;
+    settings.enableStageProfiling = true;
+    settings.enableLatencyAnalysis = true;
+    radar::RadarPlayback playback(std::move(settings));
+    if (!playback.initialize())
+    {
+        return EXIT_FAILURE;
+    }
+
+    radar::core::StageProfiler mappingProfiler;
+    radar::FusedRadarMapping mapping;
+    mapping.setProfiler(&mappingProfiler);
+
+    radar::RadarFrame frame;
+    while (playback.readNextFrame(frame))
+    {
+        mapping.update(frame.detections);
+    }
+
+    std::cout << "Pipeline stages:\n" << playback.stageProfiler()->report() << '\n';
+    std::cout << "Mapping stages:\n" << mappingProfiler.report() << '\n';
+    std::cout << "Sensor latency:\n" << playback.latencyAnalyzer()->report() << '\n';
+    std::cout << "Memory:\n" << radar::core::memoryFootprintReport();
+    return EXIT_SUCCESS;
+}
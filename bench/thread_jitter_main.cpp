@@ -0,0 +1,170 @@
+#include "bench/bench_args.hpp"
+#include "radar_core/thread_placement.hpp"
+#include "radar_core/voxel_downsampler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::chrono::microseconds kPeriod{1000};
+constexpr std::size_t kPointsPerFrame = 4096U;
+
+struct JitterResult
+{
+    std::vector<double> wakeLateness_us;
+    std::vector<double> workTime_us;
+};
+
+double quantile(std::vector<double> values, double q)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    const auto index = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1U));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+void printRow(const std::string& label, const std::vector<double>& values)
+{
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << quantile(values, 0.5) << std::setw(10) << quantile(values, 0.99)
+              << std::setw(10) << quantile(values, 0.999) << std::setw(10)
+              << (values.empty() ? 0.0 : *std::max_element(values.begin(), values.end())) << '\n';
+}
+
+// Periodic 1 kHz loop that downsamples one synthetic frame per tick, like a processing thread would.
+JitterResult runPeriodicLoop(std::size_t iterations, const std::vector<radar::core::VoxelPointSample>& frame)
+{
+    radar::core::VoxelDownsampler downsampler({true, 0.5F, 0.0F});
+    JitterResult result;
+    result.wakeLateness_us.reserve(iterations);
+    result.workTime_us.reserve(iterations);
+
+    auto deadline = std::chrono::steady_clock::now() + kPeriod;
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        std::this_thread::sleep_until(deadline);
+        const auto wake = std::chrono::steady_clock::now();
+
+        downsampler.beginFrame(frame.size());
+        for (std::size_t p = 0; p < frame.size(); ++p)
+        {
+            downsampler.addPoint(static_cast<std::uint32_t>(p), frame[p]);
+        }
+        static_cast<void>(downsampler.finishFrame());
+
+        const auto done = std::chrono::steady_clock::now();
+        result.wakeLateness_us.push_back(std::chrono::duration<double, std::micro>(wake - deadline).count());
+        result.workTime_us.push_back(std::chrono::duration<double, std::micro>(done - wake).count());
+        deadline += kPeriod;
+        if (done > deadline)
+        {
+            deadline = done + kPeriod;
+        }
+    }
+    return result;
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_thread_jitter [placement spec, e.g. \"render=3@80;mlock\"] [iterations]"
+              << " [noise threads]\n";
+}
+} // namespace
+
+// Compares wake-up lateness and work time of a 1 kHz processing loop with and without thread placement.
+// Usage: radar_thread_jitter [placement spec, e.g. "render=3@80;mlock"] [iterations] [noise threads]
+int main(int argc, char** argv)
+{
+    radar::core::ThreadPlacementSettings placement;
+    const unsigned cpuCount = std::max(1U, std::thread::hardware_concurrency());
+    const std::string spec = argc > 1 ? argv[1] : "render=" + std::to_string(cpuCount - 1U);
+    if (!radar::core::parseThreadPlacement(spec, placement))
+    {
+        std::cerr << "Invalid placement spec: " << spec << '\n';
+        return EXIT_FAILURE;
+    }
+    std::size_t iterations = 5000U;
+    std::size_t noiseThreads = cpuCount;
+    if ((argc > 2 && !radar::bench::parsePositive(argv[2], iterations)) ||
+        (argc > 3 && !radar::bench::parseNumber(argv[3], noiseThreads)))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 rng(7U);
+    std::uniform_real_distribution<float> position(-60.0F, 60.0F);
+    std::vector<radar::core::VoxelPointSample> frame(kPointsPerFrame);
+    for (auto& point : frame)
+    {
+        point.x = position(rng);
+        point.y = position(rng);
+    }
+
+    // Unpinned busy threads competing for every core, standing in for the render loop and other processes.
+    std::atomic<bool> stopNoise{false};
+    std::vector<std::thread> noise;
+    for (std::size_t i = 0; i < noiseThreads; ++i)
+    {
+        noise.emplace_back(
+            [&stopNoise]()
+            {
+                volatile std::uint64_t sink = 0U;
+                while (!stopNoise.load(std::memory_order_relaxed))
+                {
+                    sink = sink + 1U;
+                }
+            });
+    }
+
+    JitterResult unpinned;
+    std::thread([&]() { unpinned = runPeriodicLoop(iterations, frame); }).join();
+
+    JitterResult pinned;
+    std::vector<radar::core::AppliedPlacement> applied(1U);
+    bool memoryLocked = false;
+    std::thread(
+        [&]()
+        {
+            std::string error;
+            memoryLocked = placement.lockMemory && radar::core::lockProcessMemory(error);
+            if (!error.empty())
+            {
+                std::cerr << error << '\n';
+            }
+            radar::core::applyThreadPlacement(
+                radar::core::ThreadRole::Render, placement[radar::core::ThreadRole::Render], "jitter-pinned",
+                applied.front());
+            pinned = runPeriodicLoop(iterations, frame);
+        })
+        .join();
+
+    stopNoise = true;
+    for (auto& thread : noise)
+    {
+        thread.join();
+    }
+
+    std::cout << radar::core::formatPlacementReport(applied, memoryLocked) << '\n';
+    std::cout << iterations << " ticks at " << kPeriod.count() << " us, " << noiseThreads << " noise threads\n";
+    std::cout << std::left << std::setw(22) << "[us]" << std::right << std::setw(10) << "p50" << std::setw(10)
+              << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << '\n';
+    printRow("unpinned wake", unpinned.wakeLateness_us);
+    printRow("pinned wake", pinned.wakeLateness_us);
+    printRow("unpinned work", unpinned.workTime_us);
+    printRow("pinned work", pinned.workTime_us);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+#include "bench/bench_args.hpp"
+#include "radar_core/processing_pipeline.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Per-track state the pipeline keeps for association, mirrored here for the reference loop.
+struct ReferenceTrackState
+{
+    glm::vec2 position{0.0f};
+    glm::vec2 velocity{0.0f};
+    glm::vec2 acceleration{0.0f};
+    float length = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    float heading = 0.0f;
+    float headingRate = 0.0f;
+    bool isStationary = false;
+    bool isMoveable = false;
+    float movingVotes = 0.0f;
+};
+
+// The track fusion conversion before slot compaction: branch on every slot and push_back both outputs.
+void referenceTrackFusion(std::uint64_t timestamp_us,
+                          const utility::RawTrackFusion& input,
+                          utility::EnhancedTracks& output,
+                          std::vector<ReferenceTrackState>& states)
+{
+    output.timestamp_us = timestamp_us;
+    output.tracks.clear();
+    states.clear();
+    for (std::size_t i = 0; i < utility::kTrackCount; ++i)
+    {
+        const auto status = static_cast<utility::TrackStatus>(input.status[i]);
+        if (status == utility::TrackStatus::Invalid)
+        {
+            continue;
+        }
+
+        utility::EnhancedTrack track;
+        track.vcsLongitudinalPosition = input.vcsLongitudinalPosition[i];
+        track.vcsLateralPosition = input.vcsLateralPosition[i];
+        track.vcsLateralVelocity = input.vcsLateralVelocity[i];
+        track.vcsLongitudinalVelocity = input.vcsLongitudinalVelocity[i];
+        track.vcsLateralAcceleration = input.vcsLateralAcceleration[i];
+        track.vcsLongitudinalAcceleration = input.vcsLongitudinalAcceleration[i];
+        track.vcsHeading = input.vcsHeading[i];
+        track.vcsHeadingRate = input.vcsHeadingRate[i];
+        track.length = input.length[i];
+        track.width = input.width[i];
+        track.height = input.height[i];
+        track.probabilityOfDetection = input.probabilityOfDetection[i];
+        track.id = input.id[i];
+        track.objectClassification = input.objectClassification[i];
+        track.objectClassificationConfidence = input.objectClassificationConfidence[i];
+        track.isMoving = input.movingFlag[i] != 0U;
+        track.isStationary = input.stationaryFlag[i] != 0U;
+        track.isMoveable = input.moveableFlag[i] != 0U;
+        track.isVehicle = input.vehicleFlag[i] != 0U;
+        track.status = status;
+        output.tracks.push_back(track);
+
+        ReferenceTrackState state;
+        state.position = glm::vec2(track.vcsLongitudinalPosition, track.vcsLateralPosition);
+        state.velocity = glm::vec2(track.vcsLongitudinalVelocity, track.vcsLateralVelocity);
+        state.acceleration = glm::vec2(track.vcsLongitudinalAcceleration, track.vcsLateralAcceleration);
+        state.length = track.length;
+        state.width = track.width;
+        state.height = track.height;
+        state.heading = track.vcsHeading;
+        state.headingRate = track.vcsHeadingRate;
+        state.isStationary = track.isStationary;
+        state.isMoveable = track.isMoveable;
+        states.push_back(state);
+    }
+}
+
+// Records with validCount live tracks at random slots; the slot pattern changes from record to record like it
+// does in a capture, so the per-slot branch cannot be learned.
+std::vector<utility::RawTrackFusion> makeRecords(std::size_t validCount, std::size_t recordCount)
+{
+    std::mt19937 rng(7U);
+    std::vector<utility::RawTrackFusion> records(recordCount);
+    std::vector<std::size_t> slots(utility::kTrackCount);
+    for (auto& record : records)
+    {
+        std::iota(slots.begin(), slots.end(), 0U);
+        std::shuffle(slots.begin(), slots.end(), rng);
+        for (std::size_t n = 0; n < validCount; ++n)
+        {
+            const std::size_t slot = slots[n];
+            record.status[slot] = static_cast<std::uint8_t>(utility::TrackStatus::Updated);
+            record.id[slot] = static_cast<std::int32_t>(slot);
+            record.vcsLongitudinalPosition[slot] = static_cast<float>(slot);
+            record.length[slot] = 4.5f;
+            record.width[slot] = 1.8f;
+            record.movingFlag[slot] = static_cast<std::uint8_t>(n % 2U);
+        }
+    }
+    return records;
+}
+
+template <typename Convert>
+double nsPerRecord(const std::vector<utility::RawTrackFusion>& records, std::size_t passes, Convert&& convert)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass)
+    {
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            convert(pass * records.size() + i, records[i]);
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / static_cast<double>(passes * records.size());
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: radar_track_fusion_bench [passes]\n";
+}
+} // namespace
+
+// Times RadarProcessingPipeline::processTrackFusion against the per-slot push_back loop it replaced, for
+// records with 0, 25 and 96 valid tracks.
+// Usage: radar_track_fusion_bench [passes]
+int main(int argc, char** argv)
+{
+    std::size_t passes = 2000U;
+    if (argc > 1 && !radar::bench::parsePositive(argv[1], passes))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::left << std::setw(8) << "valid" << std::right << std::setw(16) << "reference ns" << std::setw(16)
+              << "compacted ns" << std::setw(10) << "speedup" << '\n';
+    for (const std::size_t validCount : {std::size_t{0U}, std::size_t{25U}, utility::kTrackCount})
+    {
+        const auto records = makeRecords(validCount, 256U);
+
+        utility::EnhancedTracks referenceOutput;
+        std::vector<ReferenceTrackState> referenceStates;
+        std::size_t referenceTracks = 0U;
+        const double referenceNs = nsPerRecord(records,
+                                               passes,
+                                               [&](std::size_t n, const utility::RawTrackFusion& record)
+                                               {
+                                                   referenceTrackFusion(n, record, referenceOutput, referenceStates);
+                                                   referenceTracks += referenceOutput.tracks.size();
+                                               });
+
+        radar::core::RadarProcessingPipeline pipeline;
+        utility::EnhancedTracks output;
+        std::size_t tracks = 0U;
+        const double compactedNs = nsPerRecord(records,
+                                               passes,
+                                               [&](std::size_t n, const utility::RawTrackFusion& record)
+                                               {
+                                                   pipeline.processTrackFusion(n, record, output);
+                                                   tracks += output.tracks.size();
+                                               });
+
+        if (tracks != referenceTracks)
+        {
+            std::cerr << "track count mismatch: " << tracks << " vs " << referenceTracks << '\n';
+            return EXIT_FAILURE;
+        }
+        std::cout << std::left << std::setw(8) << validCount << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(16) << referenceNs << std::setw(16) << compactedNs << std::setw(9)
+                  << (compactedNs > 0.0 ? referenceNs / compactedNs : 0.0) << "x\n";
+    }
+    return EXIT_SUCCESS;
+}
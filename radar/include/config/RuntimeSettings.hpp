@@ -0,0 +1,56 @@
+#pragma once
+
+#include "mapping/FusedRadarMapping.hpp"
+#include "radar_core/processing_common.hpp"
+#include "radar_core/settings_channel.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace radar
+{
+
+// Tunables that may change while the engine runs. Vehicle geometry (Vehicle.ini) is deliberately not part
+// of this: it is loaded once and referenced by pointer throughout the pipeline.
+struct RuntimeSettings
+{
+    core::ProcessingSettings processing;
+    FusedRadarMapping::Settings mapping;
+    // Virtual sensor segments; 0 leaves the count to the visualizer slider.
+    std::size_t mapSegmentCount = 0U;
+};
+
+// Overrides the fields present in the INI file ([Processing], [Odometry], [Mapping], [VirtualSensor]) and
+// keeps the rest of settings as passed in.
+bool loadRuntimeSettings(const std::filesystem::path& iniPath, RuntimeSettings& settings);
+
+// Polling file watcher for RuntimeSettings.ini. poll() is cheap (one stat) and meant to be called once per
+// frame by a single thread; each subsystem gets its own channel so it only sees a new version when its own
+// settings actually changed.
+class RuntimeSettingsWatcher
+{
+public:
+    explicit RuntimeSettingsWatcher(std::filesystem::path iniPath, RuntimeSettings initial = {});
+
+    // Returns true when at least one channel published a new snapshot.
+    bool poll();
+    const RuntimeSettings& current() const noexcept;
+    const std::filesystem::path& path() const noexcept;
+
+    std::shared_ptr<const core::SettingsChannel<core::ProcessingSettings>> processingChannel() const;
+    std::shared_ptr<const core::SettingsChannel<FusedRadarMapping::Settings>> mappingChannel() const;
+    std::shared_ptr<const core::SettingsChannel<std::size_t>> segmentChannel() const;
+
+private:
+    std::filesystem::path m_path;
+    std::optional<std::filesystem::file_time_type> m_lastWrite;
+    std::optional<std::filesystem::file_time_type> m_lastFailedWrite;
+    RuntimeSettings m_current;
+    std::shared_ptr<core::SettingsChannel<core::ProcessingSettings>> m_processing;
+    std::shared_ptr<core::SettingsChannel<FusedRadarMapping::Settings>> m_mapping;
+    std::shared_ptr<core::SettingsChannel<std::size_t>> m_segments;
+};
+
+} // namespace radar
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "mapping/RadarVirtualSensorMapping.hpp"
+#include "radar_core/frame_metrics.hpp"
+#include "radar_core/thread_placement.hpp"
+#include "radar_core/voxel_downsampler.hpp"
 #include "sensors/BaseRadarSensor.hpp"
 #include "visualization/RadarVisualizer.hpp"
 
@@ -28,20 +31,24 @@ public:
 
     bool initialize();
     void run();
+    // Applied when run() starts: Render to the calling thread, Reader to the sensor reader thread.
+    void setThreadPlacement(core::ThreadPlacementSettings settings);
+    std::vector<core::AppliedPlacement> appliedThreadPlacement() const;
 
 private:
     bool captureFrame(uint64_t& timestampUs);
 
     static constexpr std::chrono::milliseconds kTargetFrameDuration{33};
+    static constexpr std::size_t kMaxQueuedFrames = 4U;
 
     std::unique_ptr<BaseRadarSensor> m_sensor;
     visualization::RadarVisualizer m_visualizer;
     std::array<BaseRadarSensor::PointCloud, 2> m_pointBuffers;
     size_t m_readIndex = 0U;
     RadarVirtualSensorMapping m_mapping;
+    core::VoxelDownsampler m_downsampler;
+    BaseRadarSensor::PointCloud m_downsampledPoints;
     std::vector<glm::vec2> m_mapPoints;
-    std::vector<glm::vec3> m_mapVertices;
-    std::vector<glm::vec3> m_mapSegmentVertices;
     std::size_t m_lastSegmentCount = 0U;
     uint64_t m_previousTimestampUs = 0U;
     bool m_hasPreviousTimestamp = false;
@@ -59,12 +66,18 @@ private:
 
     std::thread m_readerThread;
     std::deque<RadarFrame> m_frameQueue;
-    std::mutex m_queueMutex;
+    mutable std::mutex m_queueMutex;
     std::condition_variable m_queueCond;
     bool m_readerRunning = false;
     bool m_readerFinished = false;
     bool m_stopReader = false;
     std::vector<std::string> m_currentSources;
+    core::ThreadPlacementSettings m_threadPlacement;
+    std::vector<core::AppliedPlacement> m_appliedPlacement;
+    bool m_memoryLocked = false;
+    // Read by the visualizer's Performance panel; samples are published from the render thread.
+    std::unique_ptr<core::FrameMetricsRing> m_metrics;
+    core::FrameMetricsRecorder m_metricsRecorder;
 };
 
 } // namespace radar
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "config/RuntimeSettings.hpp"
 #include "mapping/RadarVirtualSensorMapping.hpp"
+#include "radar_core/frame_metrics.hpp"
+#include "radar_core/thread_placement.hpp"
+#include "radar_core/voxel_downsampler.hpp"
 #include "processing/RadarPlayback.hpp"
 #include "visualization/RadarVisualizer.hpp"
 
@@ -8,6 +12,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace radar
@@ -20,20 +25,36 @@ public:
 
     bool initialize();
     void run();
+    // Playback reads, processes and renders on the thread calling run(), which gets the Render placement.
+    void setThreadPlacement(core::ThreadPlacementSettings settings);
+    const std::vector<core::AppliedPlacement>& appliedThreadPlacement() const noexcept;
+    // Polled once per frame; the processing channel should also be set in the playback settings.
+    void setRuntimeSettings(std::shared_ptr<RuntimeSettingsWatcher> watcher);
 
 private:
     static constexpr std::chrono::milliseconds kTargetFrameDuration{33};
 
+    void publishFrameMetrics();
+
     RadarPlayback m_playback;
     visualization::RadarVisualizer m_visualizer;
     RadarVirtualSensorMapping m_mapping;
+    core::VoxelDownsampler m_downsampler;
+    BaseRadarSensor::PointCloud m_downsampledPoints;
     std::vector<glm::vec2> m_mapPoints;
-    std::vector<glm::vec3> m_mapVertices;
-    std::vector<glm::vec3> m_mapSegmentVertices;
     std::vector<RadarTrack> m_latestTracks;
     std::size_t m_lastSegmentCount = 0U;
     uint64_t m_previousTimestampUs = 0U;
     bool m_hasPreviousTimestamp = false;
+    std::shared_ptr<RuntimeSettingsWatcher> m_runtimeSettings;
+    core::SettingsReader<std::size_t> m_segmentSettings;
+    std::size_t m_segmentOverride = 0U;
+    core::ThreadPlacementSettings m_threadPlacement;
+    std::vector<core::AppliedPlacement> m_appliedPlacement;
+    // Read by the visualizer's Performance panel.
+    std::unique_ptr<core::FrameMetricsRing> m_metrics;
+    core::FrameMetricsRecorder m_metricsRecorder;
+    std::vector<double> m_profilerWallTime_s;
 };
 
 } // namespace radar
@@ -1,10 +1,22 @@
 #pragma once
 
+#include "mapping/MapVertex.hpp"
+#include "mapping/OccupancyGridView.hpp"
+#include "radar_core/huge_page_allocator.hpp"
+#include "radar_core/perf_counters.hpp"
+#include "radar_core/settings_channel.hpp"
+#include "radar_core/voxel_downsampler.hpp"
+#include "radar_core/world_tile_store.hpp"
 #include "sensors/BaseRadarSensor.hpp"
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace radar
@@ -59,20 +71,116 @@ public:
         float plausibilityAzimuthBandwidth = 14.65F;
         float plausibilityAmplitudeMidpoint = -22.0F;
         float plausibilityAmplitudeBandwidth = 8.79F;
+        bool enableDownsampling = false;
+        float downsampleCellSize = 0.25F;
+        // Backing for the log-odds grid; grids under 2 MB (cellSize >= ~0.2 m at 60 m radius) stay on the heap.
+        core::HugePageMode gridHugePages = core::HugePageMode::Transparent;
+        // World-referenced map paged to worldTileFile (core::WorldTileStore), fed by update() calls that carry a
+        // pose. Cells have the grid's cellSize; tiles are worldTileCells cells wide and the window keeps
+        // worldActiveRadius tiles around the vehicle plus worldPrefetchTiles ahead of it.
+        bool enableWorldMap = false;
+        std::string worldTileFile = "radar_world_tiles.bin";
+        int worldTileCells = 64;
+        int worldActiveRadius = 2;
+        int worldPrefetchTiles = 2;
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    using SettingsChannel = core::SettingsChannel<Settings>;
+
+    // Vehicle pose in the world frame: a map point (lateral, longitudinal) p is at position + R(heading) p.
+    // velocity is in the world frame and steers the world map's prefetch.
+    struct WorldPose
+    {
+        glm::vec2 position{0.0F};
+        float heading_rad = 0.0F;
+        glm::vec2 velocity{0.0F};
+
+        // Dead-reckons dt_s forward from a vehicle-frame velocity (lateral, longitudinal) and a yaw rate.
+        void advance(const glm::vec2& vehicleVelocity, float yawRate, float dt_s);
     };
 
     explicit FusedRadarMapping(Settings settings = Settings());
 
     void update(const BaseRadarSensor::PointCloud& points);
+    // Same update; with enableWorldMap the grid updates are also applied to the world map at pose. Cells whose
+    // tile is still being paged in are skipped rather than waited for.
+    void update(const BaseRadarSensor::PointCloud& points, const WorldPose& pose);
     void reset();
     std::vector<glm::vec3> occupiedCells() const;
-    void applySettings(const Settings& settings);
+    // Direct-write form of occupiedCells() for caller-owned vertex memory: writes cell centres until out is
+    // full and returns the number written.
+    std::size_t writeOccupiedCells(std::span<MapVertex> out, const MapVertexTransform& transform = {}) const;
+    // The accumulated grid, e.g. for RadarVirtualSensorMapping::updateFromGrid(). Invalidated when
+    // applySettings() reallocates the grid.
+    OccupancyGridView gridView() const noexcept;
+    // Resident world map cells at or above occupiedThreshold, in world coordinates. Empty without the world map.
+    std::vector<glm::vec3> occupiedWorldCells() const;
+    // nullptr unless enableWorldMap is set and the tile file could be opened.
+    const core::WorldTileStore* worldMap() const noexcept;
+    // Waits for the world map's queued page-ins and page-outs and adopts them (tests, shutdown).
+    void flushWorldMap();
+    // Keeps the accumulated grid unless the geometry (cell size, radius, backing) changes; otherwise only the
+    // derived caches are rebuilt. Returns true when the grid had to be reallocated (and was cleared).
+    bool applySettings(const Settings& settings);
     const Settings& settings() const noexcept;
+    // Hot reload: the newest published snapshot is adopted at the start of each update().
+    void setSettingsChannel(std::shared_ptr<const SettingsChannel> channel);
+    // Bytes of the grid currently backed by huge pages (Linux only, 0 elsewhere).
+    std::size_t gridHugePageBytes() const;
+    // Optional per-stage profiling of the plausibility pass and the grid update (Gaussian / hit plus free-space
+    // cone per detection); pass nullptr to detach.
+    void setProfiler(core::StageProfiler* profiler);
+    // Plausibility of count detections given as separate range, azimuth and amplitude arrays, written to out.
+    // Reads the per-component tables built from the current settings; within ~1e-4 of the closed-form sigmoids.
+    void computePlausibility(const float* range_m,
+                             const float* azimuth_rad,
+                             const float* amplitude_dBsm,
+                             std::size_t count,
+                             float* out) const;
 
 private:
+    static constexpr std::size_t kPlausibilityTableSize = 512U;
+
+    // One logistic plausibility component sampled over the input window where it is not saturated; inputs
+    // outside the window clamp to its ends and values in between are interpolated linearly.
+    struct PlausibilityTable
+    {
+        float origin = 0.0F;
+        float invStep = 0.0F;
+        std::array<float, kPlausibilityTableSize + 1U> values{};
+
+        float operator()(float value) const;
+    };
+
+    // Detections that passed the type and range checks in update(), as columns for the batched plausibility
+    // pass and the grid updates after it.
+    struct DetectionBatch
+    {
+        std::vector<const RadarPoint*> points;
+        std::vector<float> range_m;
+        std::vector<float> azimuth_rad;
+        std::vector<float> amplitude_dBsm;
+        std::vector<float> freeSpaceRange_m;
+        std::vector<float> rangeAccuracy_m;
+        std::vector<float> angleAccuracy_rad;
+        std::vector<float> plausibility;
+        std::vector<float> freeSpacePlausibility;
+
+        void clear();
+        void resizeResults();
+    };
+
     bool worldToCell(const glm::vec2& position, int& ix, int& iy) const;
     void updatePlausibilityCache();
-    float computePlausibility(float range_m, float azimuth_rad, float amplitude_dBsm) const;
+    template <typename Combine>
+    void combinePlausibility(const float* range_m,
+                             const float* azimuth_rad,
+                             const float* amplitude_dBsm,
+                             std::size_t count,
+                             float* out,
+                             Combine combine) const;
     void computeSensorAccuracies(const RadarPoint& point,
                                  float& rangeAccuracy_m,
                                  float& angleAccuracy_rad) const;
@@ -88,18 +196,33 @@ private:
                           float azimuth_rad,
                           float range_m,
                           float rangeAccuracy_m,
-                          float amplitude_dBsm);
+                          float plausibility);
     void updateCell(int ix, int iy, float delta);
     glm::vec3 cellCenter(int ix, int iy) const;
     void initializeGrid();
+    void openWorldMap();
 
     Settings m_settings;
     int m_gridSize = 0;
     float m_gridCenter = 0.0F;
-    std::vector<float> m_logOdds;
-    float m_rangeGrowthRate = 0.0F;
-    float m_azimuthGrowthRate = 0.0F;
-    float m_amplitudeGrowthRate = 0.0F;
+    std::vector<float, core::HugePageAllocator<float>> m_logOdds;
+    PlausibilityTable m_rangeTable;
+    PlausibilityTable m_azimuthTable;
+    PlausibilityTable m_amplitudeTable;
+    DetectionBatch m_batch;
+    core::VoxelDownsampler m_downsampler;
+    BaseRadarSensor::PointCloud m_validPoints;
+    BaseRadarSensor::PointCloud m_downsampledPoints;
+    core::SettingsReader<Settings> m_settingsReader;
+    core::StageProfiler* m_profiler = nullptr;
+    std::size_t m_plausibilityStage = 0U;
+    std::size_t m_gridUpdateStage = 0U;
+    std::unique_ptr<core::WorldTileStore> m_worldMap;
+    // Set for the duration of a posed update(): grid cell centres are rotated and offset into the world map.
+    bool m_forwardToWorld = false;
+    glm::vec2 m_worldOrigin{0.0F};
+    float m_worldCos = 1.0F;
+    float m_worldSin = 0.0F;
 };
 
 } // namespace radar
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace radar
+{
+
+// Vertex layout of the visualizer's line and point buffers. The mapping classes' direct-write outputs fill
+// spans of these, so map results land in render-ready memory without intermediate vectors.
+struct MapVertex
+{
+    glm::vec3 position{0.0F};
+    float intensity = 1.0F;
+};
+
+// Applied by the direct-write outputs on the way out: x' = lateralSign * x, y' = y + longitudinalOffset
+// (the visualizer's VCS to ISO view is lateralSign -1 and the rear axle distance).
+struct MapVertexTransform
+{
+    float lateralSign = 1.0F;
+    float longitudinalOffset = 0.0F;
+
+    MapVertex apply(const glm::vec2& point) const noexcept
+    {
+        return {glm::vec3(lateralSign * point.x, point.y + longitudinalOffset, 0.0F), 1.0F};
+    }
+};
+
+} // namespace radar
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace radar
+{
+
+// Read-only view of a square log-odds grid in map coordinates (lateral, longitudinal): cell (ix, iy) covers
+// origin + cellSize * [ix, ix + 1) x [iy, iy + 1) and holds logOdds[iy * size + ix]. Cells at or above
+// occupiedThreshold count as occupied. Valid until the owner reallocates its grid.
+struct OccupancyGridView
+{
+    const float* logOdds = nullptr;
+    int size = 0;
+    float cellSize = 0.0F;
+    glm::vec2 origin{0.0F};
+    float occupiedThreshold = 0.0F;
+
+    bool valid() const noexcept
+    {
+        return logOdds != nullptr && size > 0 && cellSize > 0.0F;
+    }
+
+    // Same cell layout; the values and the threshold may differ.
+    bool sameGeometry(const OccupancyGridView& other) const noexcept
+    {
+        return size == other.size && cellSize == other.cellSize && origin.x == other.origin.x &&
+               origin.y == other.origin.y;
+    }
+};
+
+} // namespace radar
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "mapping/MapVertex.hpp"
+#include "mapping/OccupancyGridView.hpp"
+
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <span>
 #include <vector>
 
 namespace radar
@@ -16,14 +21,54 @@ class RadarVirtualSensorMapping
 public:
     static constexpr std::size_t kDefaultSegmentCount = 72U;
 
+    // Ego velocity (VCS origin, m/s, in map point order: lateral, longitudinal) and yaw rate (rad/s) used to
+    // carry the segment state between scans.
+    struct EgoMotion
+    {
+        glm::vec2 velocity{0.0F};
+        float yawRate = 0.0F;
+
+        // From a vehicle-frame estimate such as utility::OdometryEstimate (longitudinal first).
+        static EgoMotion fromVehicleFrame(float vLon_mps, float vLat_mps, float yawRate_rps)
+        {
+            return {glm::vec2(vLat_mps, vLon_mps), yawRate_rps};
+        }
+    };
+
+    struct PersistenceSettings
+    {
+        // Share of a farther hit blended into a segment's end distance per scan; closer hits apply at once.
+        float recedeGain = 0.3F;
+        // A segment keeps its end distance for this long after its last hit.
+        std::uint64_t holdUs = 400000U;
+        // Larger gaps between scans drop the state instead of extrapolating the motion over them.
+        std::uint64_t maxGapUs = 500000U;
+    };
+
     RadarVirtualSensorMapping();
 
     bool setSegmentCount(std::size_t count);
     std::size_t segmentCount() const;
 
     void setVehicleContour(const std::vector<glm::vec2>& contour);
+    void setPersistence(const PersistenceSettings& settings);
+    const PersistenceSettings& persistence() const;
+
+    // Single-scan ring: every segment ends at this scan's nearest hit. Drops the temporal state.
     void update(const std::vector<glm::vec2>& detections,
                 const std::vector<std::array<glm::vec2, 4>>& trackFootprints);
+    // Temporal ring: the previous segment state is moved by egoMotion over the time since the last scan, then
+    // filtered with this scan's hits, so segments without a hit keep their end for holdUs. Without egoMotion
+    // the state cannot be carried and the ring restarts from this scan.
+    void update(const std::vector<glm::vec2>& detections,
+                const std::vector<std::array<glm::vec2, 4>>& trackFootprints,
+                std::uint64_t timestampUs,
+                const EgoMotion* egoMotion);
+    // Grid ring: every segment ends where its ray, marched outwards from the vehicle contour, first enters an
+    // occupied cell of grid; track footprints apply as in update(). Accumulated evidence gives a boundary that
+    // is stable from scan to scan, at a cost that does not depend on the number of detections. The cells each
+    // ray crosses are computed once per grid geometry and segment layout. Drops the temporal state.
+    void updateFromGrid(const OccupancyGridView& grid, const std::vector<std::array<glm::vec2, 4>>& trackFootprints);
     void reset();
 
     std::vector<glm::vec2> ring(float fallbackRange) const;
@@ -34,11 +79,52 @@ public:
     };
     std::vector<Segment> segments(float fallbackRange) const;
 
+    // Direct-write forms of ring() and segments() for caller-owned vertex memory (a visualizer's vertex
+    // buffer or mapped GPU memory). Return the number of vertices written: ringVertexCount() ring points, or
+    // two per segment. Nothing is written when out is smaller than that.
+    std::size_t ringVertexCount() const;
+    std::size_t segmentVertexCount() const;
+    std::size_t writeRing(float fallbackRange,
+                          std::span<MapVertex> out,
+                          const MapVertexTransform& transform = {}) const;
+    std::size_t writeSegments(float fallbackRange,
+                              std::span<MapVertex> out,
+                              const MapVertexTransform& transform = {}) const;
+
 private:
+    // Entries of the angle lookup per segment; a lookup cell covers at most one segment boundary.
+    static constexpr std::size_t kLookupCellsPerSegment = 4U;
+    // Segment rays marched side by side by updateFromGrid().
+    static constexpr std::size_t kRayLanes = 4U;
+
+    // Cells crossed by the segment rays of one grid geometry. Rays are grouped kRayLanes at a time and stored
+    // step-major, so one step of a group is kRayLanes consecutive entries; a group has as many steps as its
+    // longest ray and shorter rays are padded with cell 0 at an infinite distance.
+    struct GridTraversal
+    {
+        OccupancyGridView geometry;
+        bool valid = false;
+        std::vector<std::uint32_t> groupFirst;
+        std::vector<std::uint32_t> groupSteps;
+        std::vector<std::uint32_t> cells;
+        // Distance from the contour centre at which the ray enters the cell.
+        std::vector<float> distances;
+    };
+
     void rebuildSegments();
+    // End distance of segment i as drawn: capped at fallbackRange, never inside the vehicle contour.
+    float drawnEndDistance(std::size_t segment, float fallbackRange) const;
     void resetSegments();
+    void resetPersistence();
+    void collectHits(const std::vector<glm::vec2>& detections,
+                     const std::vector<std::array<glm::vec2, 4>>& trackFootprints);
+    void collectFootprintHits(const std::vector<std::array<glm::vec2, 4>>& trackFootprints);
+    void buildGridTraversal(const OccupancyGridView& grid);
+    void marchGrid(const OccupancyGridView& grid);
+    void carryPersistence(const EgoMotion& egoMotion, float dt);
     static float normalizeAngle(float angle);
     std::size_t segmentIndex(float angle) const;
+    std::size_t segmentIndex(const glm::vec2& delta) const;
     bool raySegmentIntersection(const glm::vec2& origin,
                                 const glm::vec2& direction,
                                 const glm::vec2& a,
@@ -56,6 +142,21 @@ private:
     std::vector<float> m_segmentStartDist;
     std::vector<float> m_segmentEndDist;
     bool m_ready = false;
+
+    // Trig-free segment lookup: cells over the pseudo-angle of a direction, each holding the first segment it
+    // touches; the boundary to the next segment is checked with one cross product.
+    std::vector<std::uint32_t> m_lookupSegment;
+    std::vector<glm::vec2> m_segmentBoundaries;
+
+    PersistenceSettings m_persistence;
+    std::vector<float> m_filteredEndDist;
+    std::vector<std::uint64_t> m_lastHitUs;
+    std::vector<float> m_carriedEndDist;
+    std::vector<std::uint64_t> m_carriedHitUs;
+    std::uint64_t m_lastUpdateUs = 0U;
+    bool m_hasState = false;
+
+    GridTraversal m_gridTraversal;
 };
 
 } // namespace radar
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "mapping/FusedRadarMapping.hpp"
+#include "radar_core/processing_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace radar
+{
+
+// One settings combination evaluated by the sweep.
+struct SweepVariant
+{
+    std::string name;
+    core::ProcessingSettings processing;
+    FusedRadarMapping::Settings mapping;
+};
+
+struct SweepMetrics
+{
+    std::size_t frames = 0U;
+    std::size_t detections = 0U;
+    std::size_t stationaryDetections = 0U;
+    std::size_t tracks = 0U;
+    // Frames after which the pipeline held a valid ego-motion estimate, and the sum of their inlier counts.
+    std::size_t odometryFrames = 0U;
+    std::uint64_t odometryInliers = 0U;
+    // Occupied grid cells after the last frame.
+    std::size_t occupiedCells = 0U;
+    // Time spent in this variant's pipeline and mapping; decode time is shared and reported separately.
+    double processingMs = 0.0;
+    double mappingMs = 0.0;
+};
+
+struct SweepResult
+{
+    std::string name;
+    SweepMetrics metrics;
+};
+
+// Replays a capture once and fans every decoded frame out to one pipeline + mapping instance per variant.
+// Frames are decoded in chunks on the calling thread while the previous chunk is processed by the workers,
+// each worker owning whole variants, so the shared chunk is read-only and no per-frame locking is needed.
+class ParameterSweep
+{
+public:
+    struct Settings
+    {
+        std::filesystem::path dataRoot;
+        std::vector<std::string> inputFiles;
+        std::filesystem::path vehicleConfigPath;
+        // 0 uses std::thread::hardware_concurrency().
+        std::size_t workerCount = 0U;
+        std::size_t chunkFrames = 32U;
+    };
+
+    explicit ParameterSweep(Settings settings);
+
+    void addVariant(SweepVariant variant);
+    std::size_t variantCount() const noexcept;
+
+    // Runs all variants over the whole capture. Returns false when the capture cannot be opened.
+    bool run();
+
+    const std::vector<SweepResult>& results() const noexcept;
+    std::size_t decodedFrames() const noexcept;
+    double decodeMs() const noexcept;
+    double wallMs() const noexcept;
+    // Table with one row per variant.
+    std::string report() const;
+
+private:
+    Settings m_settings;
+    std::vector<SweepVariant> m_variants;
+    std::vector<SweepResult> m_results;
+    std::size_t m_decodedFrames = 0U;
+    double m_decodeMs = 0.0;
+    double m_wallMs = 0.0;
+};
+
+} // namespace radar
@@ -1,13 +1,20 @@
 #pragma once
 
 #include "processing/RadarTrack.hpp"
+#include "radar_core/frame_reorder_buffer.hpp"
+#include "radar_core/huge_page_allocator.hpp"
+#include "radar_core/latency_analyzer.hpp"
+#include "radar_core/processing_common.hpp"
+#include "radar_core/settings_channel.hpp"
 #include "sensors/BaseRadarSensor.hpp"
+#include "utility/radar_records.hpp"
 
 #include <glm/glm.hpp>
 
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace utility
@@ -15,6 +22,12 @@ namespace utility
 struct VehicleParameters;
 }
 
+namespace radar::core
+{
+class RadarProcessingPipeline;
+class StageProfiler;
+} // namespace radar::core
+
 namespace radar
 {
 
@@ -26,6 +39,25 @@ struct RadarFrame
     std::vector<std::string> sources;
     bool hasDetections = false;
     bool hasTracks = false;
+    // Latest ego-motion estimate of the pipeline after this frame; not necessarily from this frame's returns.
+    utility::OdometryEstimate odometry;
+};
+
+// Decoded capture records that share one publish timestamp, before any processing. Entries keep the
+// stream order so processing them reproduces readNextFrame() exactly.
+struct RadarRecordBatch
+{
+    using Record =
+        std::variant<utility::CornerDetectionsRecord, utility::FrontDetectionsRecord, utility::RawTrackFusion>;
+
+    uint64_t timestampUs = 0U;
+    std::vector<Record> records;
+};
+
+struct SensorReorderStatistics
+{
+    std::string source;
+    core::ReorderStatistics statistics;
 };
 
 class RadarPlayback
@@ -36,6 +68,20 @@ public:
         std::filesystem::path dataRoot;
         std::vector<std::string> inputFiles;
         std::filesystem::path vehicleConfigPath;
+        // Samples wall time and hardware counters per pipeline stage; the report is logged on destruction.
+        bool enableStageProfiling = false;
+        // Sketches each detection sensor's capture->publish and publish->processed latency, warns when a sensor
+        // goes over budget and logs the distributions on destruction.
+        bool enableLatencyAnalysis = false;
+        core::LatencyBudgetSettings latencyBudget;
+        // Jitter bound for live or re-sent captures: each sensor's frames are held for its hardware delay plus
+        // this bound and released in sensor-timestamp order. 0 keeps file order.
+        std::uint64_t reorderLatencyUs = 0U;
+        std::size_t reorderCapacity = 8U;
+        // Backing for the reorder frame pools; only pools of 2 MB or more (large capacities) use huge pages.
+        core::HugePageMode reorderHugePages = core::HugePageMode::Off;
+        // Optional hot-reload source for the pipeline thresholds, adopted at the start of readNextFrame().
+        std::shared_ptr<const core::SettingsChannel<core::ProcessingSettings>> processingSettings;
     };
 
     explicit RadarPlayback(Settings settings);
@@ -48,8 +94,24 @@ public:
     bool initialize();
     bool readNextFrame(RadarFrame& frame);
 
+    // Decode-only half of readNextFrame(): merges the streams and returns the next timestamp's raw records.
+    bool readNextRecords(RadarRecordBatch& batch);
+    // Processing half: runs a batch through the given pipeline (which must be initialized with
+    // vehicleParameters()) and converts the results. Const, so one playback can feed several pipelines.
+    void processRecords(const RadarRecordBatch& batch,
+                        core::RadarProcessingPipeline& pipeline,
+                        RadarFrame& frame) const;
+
     const std::vector<glm::vec2>& vehicleContour() const noexcept;
     const utility::VehicleParameters* vehicleParameters() const noexcept;
+    const core::StageProfiler* stageProfiler() const noexcept;
+    // Null unless Settings::enableLatencyAnalysis.
+    const core::LatencyAnalyzer* latencyAnalyzer() const noexcept;
+    // Microseconds from the start of initialize() until readNextRecords() first returned a batch; 0 before that.
+    std::uint64_t timeToFirstFrameUs() const noexcept;
+    std::vector<SensorReorderStatistics> reorderStatistics() const;
+    // Frames held in the reorder buffers right now; 0 without reordering. Call from the reading thread.
+    std::size_t bufferedFrames() const noexcept;
 
 private:
     struct Impl;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace radar
+{
+
+// Synthetic scenario description. All load dimensions are independent so benchmarks can sweep one
+// axis at a time; identical settings (including the seed) always produce byte-identical captures.
+struct ScenarioSettings
+{
+    std::uint32_t seed = 1U;
+    float duration_s = 10.0F;
+    float scanPeriod_s = 0.05F;
+    std::uint64_t startTimestampUs = 1000000U;
+    // Corner sensors beyond the four physical mounts reuse indices 0..3 and go to additional capture files.
+    std::size_t cornerSensorCount = 4U;
+    bool includeFrontRadar = true;
+    // Valid returns per corner scan (capped at kCornerReturnCount); the front radar fills both halves.
+    std::size_t returnsPerScan = 32U;
+    // Tracks beyond kTrackCount are split across additional track capture files.
+    std::size_t trackCount = 16U;
+    // Share of each scan's returns replaced by random false alarms.
+    float clutterFraction = 0.1F;
+    // Ego motion (constant speed / yaw rate, VCS convention: positive yaw turns right).
+    float egoSpeed_mps = 15.0F;
+    float egoYawRate_rps = 0.0F;
+    float landmarkSpacing_m = 2.0F;
+    float roadHalfWidth_m = 7.0F;
+    // Write .rdrb binary record streams instead of text lines; RadarPlayback reads either form.
+    bool binaryCaptures = false;
+};
+
+struct ScenarioCapture
+{
+    std::vector<std::string> inputFiles;
+    std::filesystem::path vehicleConfigPath;
+    std::size_t scanCount = 0U;
+    std::size_t detectionLineCount = 0U;
+    std::size_t trackLineCount = 0U;
+};
+
+class ScenarioGenerator
+{
+public:
+    explicit ScenarioGenerator(ScenarioSettings settings);
+
+    // Writes the captures plus a matching Vehicle.ini into dataRoot.
+    bool write(const std::filesystem::path& dataRoot, ScenarioCapture& capture) const;
+    const ScenarioSettings& settings() const noexcept;
+
+private:
+    ScenarioSettings m_settings;
+};
+
+} // namespace radar
@@ -31,7 +31,9 @@ private:
     };
 
     bool prepareFrames();
-    std::filesystem::path findRadarFile(const std::string& filename) const;
+    std::vector<std::filesystem::path> searchRoots() const;
+    std::filesystem::path findRadarFile(const std::vector<std::filesystem::path>& roots,
+                                        const std::string& filename) const;
     std::filesystem::path m_dataDirectory;
     std::vector<std::unique_ptr<BaseRadarSensor>> m_sensors;
     std::vector<SourceFrame> m_frames;
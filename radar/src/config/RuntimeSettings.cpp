@@ -0,0 +1,179 @@
+#include "config/RuntimeSettings.hpp"
+
+#include "logging/Logger.hpp"
+
+#include "IniFileParser.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace radar
+{
+namespace
+{
+// IniFileParser::readInteger zeroes the value when the key is missing, so integers go through getInteger.
+void readInt(const IniFileParser& parser, const char* section, const char* name, int& value)
+{
+    value = static_cast<int>(parser.getInteger(section, name, value));
+}
+
+void readProcessing(const IniFileParser& parser, core::ProcessingSettings& settings)
+{
+    parser.readScalar("Processing", "boundingBoxScale", settings.association.boundingBoxScale);
+    parser.readScalar("Processing", "rangeRateSigma", settings.association.rangeRateSigma);
+    parser.readScalar("Processing", "velocityVariance", settings.association.velocityVariance);
+    parser.readScalar("Processing", "headingRateVariance", settings.association.headingRateVariance);
+    parser.readScalar("Processing", "stationaryNSigma", settings.stationary.nSigma);
+
+    parser.readEnum("Odometry", "method", settings.odometry.method);
+    readInt(parser, "Odometry", "maxIterations", settings.odometry.maxIterations);
+    parser.readScalar("Odometry", "inlierThreshold", settings.odometry.inlierThreshold_mps);
+    readInt(parser, "Odometry", "minInliers", settings.odometry.minInliers);
+    parser.readScalar("Odometry", "histogramMaxSpeed", settings.odometry.histogramMaxSpeed_mps);
+    parser.readScalar("Odometry", "histogramBinSize", settings.odometry.histogramBinSize_mps);
+}
+
+void readMapping(const IniFileParser& parser, FusedRadarMapping::Settings& settings)
+{
+    parser.readScalar("Mapping", "cellSize", settings.cellSize);
+    parser.readScalar("Mapping", "mapRadius", settings.mapRadius);
+    parser.readScalar("Mapping", "hitIncrement", settings.hitIncrement);
+    parser.readScalar("Mapping", "missDecrement", settings.missDecrement);
+    parser.readScalar("Mapping", "maxLogOdds", settings.maxLogOdds);
+    parser.readScalar("Mapping", "minLogOdds", settings.minLogOdds);
+    parser.readScalar("Mapping", "occupiedThreshold", settings.occupiedThreshold);
+    parser.readEnum("Mapping", "radarModel", settings.radarModel);
+    parser.readBoolean("Mapping", "enableOccupied", settings.enableOccupied);
+    parser.readBoolean("Mapping", "enableFreespace", settings.enableFreespace);
+    parser.readBoolean("Mapping", "alwaysMapDynamicDetections", settings.alwaysMapDynamicDetections);
+    parser.readBoolean("Mapping", "enablePlausibilityScaling", settings.enablePlausibilityScaling);
+    parser.readScalar("Mapping", "maxAdditiveProbability", settings.maxAdditiveProbability);
+    parser.readScalar("Mapping", "maxFreeSpaceRange", settings.maxFreeSpaceRange_m);
+    parser.readScalar("Mapping", "minPlausibility", settings.minPlausibility);
+    parser.readEnum("Mapping", "plausibilityMethod", settings.plausibilityMethod);
+    parser.readScalar("Mapping", "plausibilityRangeMidpoint", settings.plausibilityRangeMidpoint);
+    parser.readScalar("Mapping", "plausibilityRangeBandwidth", settings.plausibilityRangeBandwidth);
+    parser.readScalar("Mapping", "plausibilityAzimuthMidpoint", settings.plausibilityAzimuthMidpoint);
+    parser.readScalar("Mapping", "plausibilityAzimuthBandwidth", settings.plausibilityAzimuthBandwidth);
+    parser.readScalar("Mapping", "plausibilityAmplitudeMidpoint", settings.plausibilityAmplitudeMidpoint);
+    parser.readScalar("Mapping", "plausibilityAmplitudeBandwidth", settings.plausibilityAmplitudeBandwidth);
+    parser.readBoolean("Mapping", "enableDownsampling", settings.enableDownsampling);
+    parser.readScalar("Mapping", "downsampleCellSize", settings.downsampleCellSize);
+    parser.readBoolean("Mapping", "enableWorldMap", settings.enableWorldMap);
+    settings.worldTileFile = parser.getString("Mapping", "worldTileFile", settings.worldTileFile);
+    readInt(parser, "Mapping", "worldTileCells", settings.worldTileCells);
+    readInt(parser, "Mapping", "worldActiveRadius", settings.worldActiveRadius);
+    readInt(parser, "Mapping", "worldPrefetchTiles", settings.worldPrefetchTiles);
+}
+} // namespace
+
+bool loadRuntimeSettings(const std::filesystem::path& iniPath, RuntimeSettings& settings)
+{
+    IniFileParser parser;
+    if (!parser.parseFile(iniPath.string()))
+    {
+        return false;
+    }
+
+    RuntimeSettings loaded = settings;
+    readProcessing(parser, loaded.processing);
+    readMapping(parser, loaded.mapping);
+    loaded.mapSegmentCount = static_cast<std::size_t>(
+        std::max(0L, parser.getInteger("VirtualSensor", "segmentCount", static_cast<long>(loaded.mapSegmentCount))));
+    if (loaded.mapping.cellSize <= 0.0F || loaded.mapping.mapRadius <= 0.0F)
+    {
+        return false;
+    }
+
+    settings = loaded;
+    return true;
+}
+
+RuntimeSettingsWatcher::RuntimeSettingsWatcher(std::filesystem::path iniPath, RuntimeSettings initial)
+    : m_path(std::move(iniPath))
+    , m_current(std::move(initial))
+{
+    std::error_code error;
+    if (std::filesystem::exists(m_path, error) && loadRuntimeSettings(m_path, m_current))
+    {
+        m_lastWrite = std::filesystem::last_write_time(m_path, error);
+    }
+    m_processing = std::make_shared<core::SettingsChannel<core::ProcessingSettings>>(m_current.processing);
+    m_mapping = std::make_shared<core::SettingsChannel<FusedRadarMapping::Settings>>(m_current.mapping);
+    m_segments = std::make_shared<core::SettingsChannel<std::size_t>>(m_current.mapSegmentCount);
+}
+
+bool RuntimeSettingsWatcher::poll()
+{
+    std::error_code error;
+    const auto lastWrite = std::filesystem::last_write_time(m_path, error);
+    if (error || (m_lastWrite && *m_lastWrite == lastWrite))
+    {
+        return false;
+    }
+
+    RuntimeSettings loaded = m_current;
+    if (!loadRuntimeSettings(m_path, loaded))
+    {
+        // Likely caught mid-save; keep the previous snapshot and retry on the next poll, but only warn once
+        // per write so a file left broken does not log every frame.
+        if (!m_lastFailedWrite || *m_lastFailedWrite != lastWrite)
+        {
+            Logger::log(Logger::Level::Warning, "Ignoring unreadable runtime settings: " + m_path.string());
+            m_lastFailedWrite = lastWrite;
+        }
+        return false;
+    }
+    m_lastWrite = lastWrite;
+    m_lastFailedWrite.reset();
+
+    bool published = false;
+    if (!(loaded.processing == m_current.processing))
+    {
+        m_processing->publish(loaded.processing);
+        published = true;
+    }
+    if (!(loaded.mapping == m_current.mapping))
+    {
+        m_mapping->publish(loaded.mapping);
+        published = true;
+    }
+    if (loaded.mapSegmentCount != m_current.mapSegmentCount)
+    {
+        m_segments->publish(loaded.mapSegmentCount);
+        published = true;
+    }
+    m_current = loaded;
+    if (published)
+    {
+        Logger::log(Logger::Level::Info, "Runtime settings reloaded from " + m_path.string());
+    }
+    return published;
+}
+
+const RuntimeSettings& RuntimeSettingsWatcher::current() const noexcept
+{
+    return m_current;
+}
+
+const std::filesystem::path& RuntimeSettingsWatcher::path() const noexcept
+{
+    return m_path;
+}
+
+std::shared_ptr<const core::SettingsChannel<core::ProcessingSettings>> RuntimeSettingsWatcher::processingChannel() const
+{
+    return m_processing;
+}
+
+std::shared_ptr<const core::SettingsChannel<FusedRadarMapping::Settings>> RuntimeSettingsWatcher::mappingChannel() const
+{
+    return m_mapping;
+}
+
+std::shared_ptr<const core::SettingsChannel<std::size_t>> RuntimeSettingsWatcher::segmentChannel() const
+{
+    return m_segments;
+}
+
+} // namespace radar
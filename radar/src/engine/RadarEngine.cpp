@@ -2,6 +2,7 @@
 
 #include "config/VehicleProfile.hpp"
 #include "logging/Logger.hpp"
+#include "radar_core/memory_accounting.hpp"
 #include "sensors/OfflineRadarSensor.hpp"
 
 #include <algorithm>
@@ -16,6 +17,11 @@ namespace
 {
 constexpr float kMapMaxRange = 120.0F;
 
+// Performance panel columns.
+constexpr std::size_t kStageCapture = 0U;
+constexpr std::size_t kStageMapping = 1U;
+constexpr std::size_t kStageRender = 2U;
+
 std::vector<glm::vec2> convertContourIsoToVcs(const std::vector<glm::vec2>& isoContour,
                                               float distRearAxle)
 {
@@ -36,10 +42,26 @@ namespace radar
 
 RadarEngine::RadarEngine(std::unique_ptr<BaseRadarSensor> sensor)
     : m_sensor(std::move(sensor))
+    , m_metrics(std::make_unique<core::FrameMetricsRing>())
+    , m_metricsRecorder(*m_metrics)
 {
 }
 
-RadarEngine::~RadarEngine() = default;
+RadarEngine::~RadarEngine()
+{
+    stopReader();
+}
+
+void RadarEngine::setThreadPlacement(core::ThreadPlacementSettings settings)
+{
+    m_threadPlacement = std::move(settings);
+}
+
+std::vector<core::AppliedPlacement> RadarEngine::appliedThreadPlacement() const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_appliedPlacement;
+}
 
 bool RadarEngine::initialize()
 {
@@ -70,6 +92,8 @@ bool RadarEngine::initialize()
             m_visualizer.updateMapPoints({});
             m_visualizer.updateMapSegments({});
         });
+    m_metrics->defineStages({"frame.capture", "frame.mapping", "frame.render"});
+    m_visualizer.setFrameMetrics(m_metrics.get());
     const bool visualizerReady = m_visualizer.initialize();
     Logger::log(Logger::Level::Info, visualizerReady ? "Visualizer initialized" : "Visualizer failed to initialize");
     return visualizerReady;
@@ -82,9 +106,36 @@ void RadarEngine::run()
         return;
     }
 
+    if (!m_threadPlacement.empty())
+    {
+        // Lock before the reader starts so its stack and frame buffers are resident too.
+        std::string error;
+        m_memoryLocked = m_threadPlacement.lockMemory && core::lockProcessMemory(error);
+        if (!error.empty())
+        {
+            Logger::log(Logger::Level::Warning, error);
+        }
+
+        core::AppliedPlacement applied;
+        core::applyThreadPlacement(core::ThreadRole::Render,
+                                   m_threadPlacement[core::ThreadRole::Render],
+                                   "radar-render",
+                                   applied);
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_appliedPlacement.push_back(std::move(applied));
+    }
+
+    startReader();
+    if (!m_threadPlacement.empty())
+    {
+        const std::string report = core::formatPlacementReport(appliedThreadPlacement(), m_memoryLocked);
+        Logger::log(Logger::Level::Info, report);
+    }
+
     while (!m_visualizer.windowShouldClose())
     {
         const auto frameStart = std::chrono::steady_clock::now();
+        m_metricsRecorder.beginFrame();
 
         uint64_t timestampUs = 0U;
         if (!captureFrame(timestampUs))
@@ -92,12 +143,21 @@ void RadarEngine::run()
             std::cerr << "Radar sensor exhausted the capture" << '\n';
             break;
         }
+        m_metricsRecorder.lap(kStageCapture);
+        m_metricsRecorder.countPoints(m_pointBuffers[m_readIndex]);
+
+        const BaseRadarSensor::PointCloud* framePoints = &m_pointBuffers[m_readIndex];
+        if (m_visualizer.downsampleEnabled())
+        {
+            m_downsampler.updateSettings({true, m_visualizer.downsampleCellSize(), 0.0F});
+            m_downsampler.downsample(*framePoints, m_downsampledPoints);
+            framePoints = &m_downsampledPoints;
+        }
 
-        BaseRadarSensor::PointCloud& currentBuffer = m_pointBuffers[m_readIndex];
-        m_visualizer.updatePoints(currentBuffer, timestampUs, m_currentSources);
+        m_visualizer.updatePoints(*framePoints, timestampUs, m_currentSources);
         m_mapPoints.clear();
-        m_mapPoints.reserve(currentBuffer.size());
-        for (const auto& point : currentBuffer)
+        m_mapPoints.reserve(framePoints->size());
+        for (const auto& point : *framePoints)
         {
             m_mapPoints.emplace_back(point.x, point.y);
         }
@@ -110,24 +170,16 @@ void RadarEngine::run()
         }
 
         m_mapping.update(m_mapPoints, {});
-        const auto ring = m_mapping.ring(kMapMaxRange);
-        const auto segments = m_mapping.segments(kMapMaxRange);
-        m_mapVertices.clear();
-        m_mapVertices.reserve(ring.size());
-        for (const auto& point : ring)
-        {
-            m_mapVertices.emplace_back(point.x, point.y, 0.0F);
-        }
-        m_mapSegmentVertices.clear();
-        m_mapSegmentVertices.reserve(segments.size() * 2U);
-        for (const auto& segment : segments)
-        {
-            m_mapSegmentVertices.emplace_back(segment.start.x, segment.start.y, 0.0F);
-            m_mapSegmentVertices.emplace_back(segment.end.x, segment.end.y, 0.0F);
-        }
-        m_visualizer.updateMapPoints(m_mapVertices);
-        m_visualizer.updateMapSegments(m_mapSegmentVertices);
+        // The ring and segments are written straight into the visualizer's vertex buffers.
+        const auto mapTransform = m_visualizer.mapVertexTransform();
+        m_visualizer.commitMapPoints(m_mapping.writeRing(
+            kMapMaxRange, m_visualizer.mapPointBuffer(m_mapping.ringVertexCount()), mapTransform));
+        m_visualizer.commitMapSegments(m_mapping.writeSegments(
+            kMapMaxRange, m_visualizer.mapSegmentBuffer(m_mapping.segmentVertexCount()), mapTransform));
+        m_metricsRecorder.lap(kStageMapping);
         m_visualizer.render();
+        m_metricsRecorder.lap(kStageRender);
+        m_metricsRecorder.endFrame();
 
         m_readIndex = (m_readIndex + 1U) % m_pointBuffers.size();
 
@@ -150,25 +202,121 @@ void RadarEngine::run()
             std::this_thread::sleep_for(scaledTarget - frameDuration);
         }
     }
+
+    stopReader();
+
+    const std::string footprint = core::memoryFootprintReport();
+    Logger::log(Logger::Level::Info, footprint);
 }
 
-bool RadarEngine::captureFrame(uint64_t& timestampUs)
+void RadarEngine::startReader()
 {
-    BaseRadarSensor::PointCloud& buffer = m_pointBuffers[m_readIndex];
-    buffer.clear();
-    if (!m_sensor->readNextScan(buffer, timestampUs))
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    if (m_readerRunning)
     {
-        return false;
+        return;
     }
+    m_stopReader = false;
+    m_readerFinished = false;
+    m_readerRunning = true;
+    m_frameQueue.clear();
+    const std::size_t placedThreads = m_appliedPlacement.size();
+    m_readerThread = std::thread(&RadarEngine::readerLoop, this);
 
-    if (auto* offlineSensor = dynamic_cast<OfflineRadarSensor*>(m_sensor.get()))
+    if (!m_threadPlacement.empty())
     {
-        m_currentSources = offlineSensor->lastFrameSources();
+        // Wait for the reader to record its placement so the startup report is complete.
+        m_queueCond.wait(lock, [&]() { return m_appliedPlacement.size() > placedThreads || m_readerFinished; });
     }
-    else
+}
+
+void RadarEngine::stopReader()
+{
     {
-        m_currentSources.clear();
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (!m_readerRunning)
+        {
+            return;
+        }
+        m_stopReader = true;
+    }
+    m_queueCond.notify_all();
+    if (m_readerThread.joinable())
+    {
+        m_readerThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_readerRunning = false;
+    m_frameQueue.clear();
+}
+
+void RadarEngine::readerLoop()
+{
+    if (!m_threadPlacement.empty())
+    {
+        core::AppliedPlacement applied;
+        core::applyThreadPlacement(core::ThreadRole::Reader,
+                                   m_threadPlacement[core::ThreadRole::Reader],
+                                   "radar-reader",
+                                   applied);
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_appliedPlacement.push_back(std::move(applied));
+        }
+        m_queueCond.notify_all();
+    }
+
+    auto* offlineSensor = dynamic_cast<OfflineRadarSensor*>(m_sensor.get());
+    while (true)
+    {
+        RadarFrame frame;
+        const bool hasFrame = m_sensor->readNextScan(frame.points, frame.timestampUs);
+        if (hasFrame && offlineSensor)
+        {
+            frame.sources = offlineSensor->lastFrameSources();
+        }
+
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        if (!hasFrame)
+        {
+            m_readerFinished = true;
+            lock.unlock();
+            m_queueCond.notify_all();
+            return;
+        }
+
+        // Bounded queue: the reader stays at most kMaxQueuedFrames ahead of the render loop.
+        m_queueCond.wait(lock, [this]() { return m_stopReader || m_frameQueue.size() < kMaxQueuedFrames; });
+        if (m_stopReader)
+        {
+            return;
+        }
+        m_frameQueue.push_back(std::move(frame));
+        lock.unlock();
+        m_queueCond.notify_all();
+    }
+}
+
+bool RadarEngine::captureFrame(uint64_t& timestampUs)
+{
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_queueCond.wait(lock, [this]() { return !m_frameQueue.empty() || m_readerFinished || !m_readerRunning; });
+    if (m_frameQueue.empty())
+    {
+        return false;
     }
+
+    RadarFrame frame = std::move(m_frameQueue.front());
+    m_frameQueue.pop_front();
+    m_metricsRecorder.setQueueDepth(m_frameQueue.size());
+    lock.unlock();
+    m_queueCond.notify_all();
+
+    // Swap rather than copy so the point buffers keep their capacity across frames.
+    std::swap(m_pointBuffers[m_readIndex], frame.points);
+    timestampUs = frame.timestampUs;
+    m_currentSources = std::move(frame.sources);
     return true;
 }
 
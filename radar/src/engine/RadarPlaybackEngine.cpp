@@ -1,6 +1,8 @@
 #include "engine/RadarPlaybackEngine.hpp"
 
 #include "logging/Logger.hpp"
+#include "radar_core/memory_accounting.hpp"
+#include "radar_core/perf_counters.hpp"
 #include "utility/radar_types.hpp"
 
 #include <algorithm>
@@ -15,6 +17,12 @@ namespace
 {
 constexpr float kMapMaxRange = 120.0F;
 
+// Performance panel columns; the playback profiler's stages follow.
+constexpr std::size_t kStageRead = 0U;
+constexpr std::size_t kStageMapping = 1U;
+constexpr std::size_t kStageRender = 2U;
+constexpr std::size_t kFirstProfilerStage = 3U;
+
 std::vector<glm::vec2> convertContourIsoToVcs(const std::vector<glm::vec2>& isoContour,
                                               float distRearAxle)
 {
@@ -53,7 +61,26 @@ namespace radar
 
 RadarPlaybackEngine::RadarPlaybackEngine(RadarPlayback playback)
     : m_playback(std::move(playback))
+    , m_metrics(std::make_unique<core::FrameMetricsRing>())
+    , m_metricsRecorder(*m_metrics)
+{
+}
+
+void RadarPlaybackEngine::setThreadPlacement(core::ThreadPlacementSettings settings)
 {
+    m_threadPlacement = std::move(settings);
+}
+
+const std::vector<core::AppliedPlacement>& RadarPlaybackEngine::appliedThreadPlacement() const noexcept
+{
+    return m_appliedPlacement;
+}
+
+void RadarPlaybackEngine::setRuntimeSettings(std::shared_ptr<RuntimeSettingsWatcher> watcher)
+{
+    m_runtimeSettings = std::move(watcher);
+    m_segmentSettings = core::SettingsReader<std::size_t>(
+        m_runtimeSettings ? m_runtimeSettings->segmentChannel() : nullptr);
 }
 
 bool RadarPlaybackEngine::initialize()
@@ -85,6 +112,18 @@ bool RadarPlaybackEngine::initialize()
             m_visualizer.updateMapSegments({});
         });
 
+    std::vector<std::string> stageNames = {"frame.read", "frame.mapping", "frame.render"};
+    if (const auto* profiler = m_playback.stageProfiler())
+    {
+        for (const auto& stage : profiler->stages())
+        {
+            stageNames.push_back(stage.name);
+        }
+        m_profilerWallTime_s.assign(profiler->stages().size(), 0.0);
+    }
+    m_metrics->defineStages(stageNames);
+    m_visualizer.setFrameMetrics(m_metrics.get());
+
     const bool visualizerReady = m_visualizer.initialize();
     Logger::log(Logger::Level::Info, visualizerReady ? "Visualizer initialized" : "Visualizer failed to initialize");
     return visualizerReady;
@@ -97,20 +136,57 @@ void RadarPlaybackEngine::run()
         return;
     }
 
+    if (!m_threadPlacement.empty())
+    {
+        std::string error;
+        const bool memoryLocked = m_threadPlacement.lockMemory && core::lockProcessMemory(error);
+        if (!error.empty())
+        {
+            Logger::log(Logger::Level::Warning, error);
+        }
+
+        m_appliedPlacement.assign(1U, core::AppliedPlacement{});
+        core::applyThreadPlacement(core::ThreadRole::Render,
+                                   m_threadPlacement[core::ThreadRole::Render],
+                                   "radar-render",
+                                   m_appliedPlacement.front());
+        const std::string report = core::formatPlacementReport(m_appliedPlacement, memoryLocked);
+        Logger::log(Logger::Level::Info, report);
+    }
+
     RadarFrame frame;
     while (!m_visualizer.windowShouldClose())
     {
         const auto frameStart = std::chrono::steady_clock::now();
+        m_metricsRecorder.beginFrame();
+
+        if (m_runtimeSettings)
+        {
+            m_runtimeSettings->poll();
+        }
+        if (m_segmentSettings.refresh())
+        {
+            m_segmentOverride = m_segmentSettings.settings();
+        }
 
         if (!m_playback.readNextFrame(frame))
         {
             std::cerr << "Radar playback has no more data\n";
             break;
         }
+        m_metricsRecorder.lap(kStageRead);
+
+        const BaseRadarSensor::PointCloud* framePoints = &frame.detections;
+        if (m_visualizer.downsampleEnabled())
+        {
+            m_downsampler.updateSettings({true, m_visualizer.downsampleCellSize(), 0.0F});
+            m_downsampler.downsample(frame.detections, m_downsampledPoints);
+            framePoints = &m_downsampledPoints;
+        }
 
         if (frame.hasDetections)
         {
-            m_visualizer.updatePoints(frame.detections, frame.timestampUs, frame.sources);
+            m_visualizer.updatePoints(*framePoints, frame.timestampUs, frame.sources);
         }
         else
         {
@@ -123,14 +199,16 @@ void RadarPlaybackEngine::run()
             m_latestTracks = frame.tracks;
         }
 
+        m_metricsRecorder.countPoints(frame.detections);
         m_mapPoints.clear();
-        m_mapPoints.reserve(frame.detections.size());
-        for (const auto& point : frame.detections)
+        m_mapPoints.reserve(framePoints->size());
+        for (const auto& point : *framePoints)
         {
             m_mapPoints.emplace_back(point.x, point.y);
         }
 
-        const std::size_t desiredSegments = m_visualizer.mapSegmentCount();
+        const std::size_t desiredSegments =
+            m_segmentOverride > 0U ? m_segmentOverride : m_visualizer.mapSegmentCount();
         if (desiredSegments != m_lastSegmentCount)
         {
             m_mapping.setSegmentCount(desiredSegments);
@@ -144,26 +222,24 @@ void RadarPlaybackEngine::run()
             trackFootprints.push_back(buildTrackFootprint(track));
         }
 
-        m_mapping.update(m_mapPoints, trackFootprints);
-        const auto ring = m_mapping.ring(kMapMaxRange);
-        const auto segments = m_mapping.segments(kMapMaxRange);
-        m_mapVertices.clear();
-        m_mapVertices.reserve(ring.size());
-        for (const auto& point : ring)
-        {
-            m_mapVertices.emplace_back(point.x, point.y, 0.0F);
-        }
-        m_mapSegmentVertices.clear();
-        m_mapSegmentVertices.reserve(segments.size() * 2U);
-        for (const auto& segment : segments)
-        {
-            m_mapSegmentVertices.emplace_back(segment.start.x, segment.start.y, 0.0F);
-            m_mapSegmentVertices.emplace_back(segment.end.x, segment.end.y, 0.0F);
-        }
-        m_visualizer.updateMapPoints(m_mapVertices);
-        m_visualizer.updateMapSegments(m_mapSegmentVertices);
+        // The free-space ring is carried over from the previous frame while the odometry estimate is fresh.
+        const auto egoMotion = RadarVirtualSensorMapping::EgoMotion::fromVehicleFrame(
+            frame.odometry.vLon_mps, frame.odometry.vLat_mps, frame.odometry.yawRate_rps);
+        const bool egoMotionValid = frame.odometry.valid && frame.timestampUs >= frame.odometry.timestamp_us &&
+                                    frame.timestampUs - frame.odometry.timestamp_us <=
+                                        m_mapping.persistence().maxGapUs;
+        m_mapping.update(m_mapPoints, trackFootprints, frame.timestampUs, egoMotionValid ? &egoMotion : nullptr);
+        // The ring and segments are written straight into the visualizer's vertex buffers.
+        const auto mapTransform = m_visualizer.mapVertexTransform();
+        m_visualizer.commitMapPoints(m_mapping.writeRing(
+            kMapMaxRange, m_visualizer.mapPointBuffer(m_mapping.ringVertexCount()), mapTransform));
+        m_visualizer.commitMapSegments(m_mapping.writeSegments(
+            kMapMaxRange, m_visualizer.mapSegmentBuffer(m_mapping.segmentVertexCount()), mapTransform));
+        m_metricsRecorder.lap(kStageMapping);
 
         m_visualizer.render();
+        m_metricsRecorder.lap(kStageRender);
+        publishFrameMetrics();
 
         std::chrono::microseconds targetDurationUs =
             std::chrono::duration_cast<std::chrono::microseconds>(kTargetFrameDuration);
@@ -185,6 +261,25 @@ void RadarPlaybackEngine::run()
             std::this_thread::sleep_for(scaledTarget - frameDuration);
         }
     }
+
+    const std::string footprint = core::memoryFootprintReport();
+    Logger::log(Logger::Level::Info, footprint);
+}
+
+void RadarPlaybackEngine::publishFrameMetrics()
+{
+    // The profiler accumulates; this frame's share of each stage is the growth since the previous frame.
+    if (const auto* profiler = m_playback.stageProfiler())
+    {
+        const auto& stages = profiler->stages();
+        for (std::size_t i = 0; i < stages.size() && i < m_profilerWallTime_s.size(); ++i)
+        {
+            m_metricsRecorder.addStageTime(kFirstProfilerStage + i, stages[i].wallTime_s - m_profilerWallTime_s[i]);
+            m_profilerWallTime_s[i] = stages[i].wallTime_s;
+        }
+    }
+    m_metricsRecorder.setQueueDepth(m_playback.bufferedFrames());
+    m_metricsRecorder.endFrame();
 }
 
 } // namespace radar
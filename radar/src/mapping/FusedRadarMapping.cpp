@@ -1,12 +1,22 @@
 #include "mapping/FusedRadarMapping.hpp"
 
+#include "logging/Logger.hpp"
+#include "radar_core/mask_compaction.hpp" // RADAR_CORE_HAS_SSE2
+
 #include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <limits>
 
 namespace
 {
 constexpr float kDegToRad = 0.0174532925F;
 constexpr float kRadToDeg = 57.2957795F;
+constexpr float kPi = 3.14159265F;
+// Logistic inputs beyond +-12 are within 1e-5 of saturation, so each table only spans that window.
+constexpr float kSaturatedLogit = 12.0F;
+// Free-space cones are weighted as if the return were at most this far away.
+constexpr float kFreeSpacePlausibilityRange_m = 15.0F;
 constexpr float kMinProbability = 1e-3F;
 constexpr float kMaxProbability = 1.0F - kMinProbability;
 
@@ -38,6 +48,20 @@ bool isMrrSensorIndex(int sensorIndex)
 {
     return sensorIndex == 4 || sensorIndex == 5;
 }
+
+glm::vec2 rotate(const glm::vec2& vector, float angle_rad)
+{
+    const float c = std::cos(angle_rad);
+    const float s = std::sin(angle_rad);
+    return glm::vec2(c * vector.x - s * vector.y, s * vector.x + c * vector.y);
+}
+
+bool worldMapSettingsChanged(const radar::FusedRadarMapping::Settings& a, const radar::FusedRadarMapping::Settings& b)
+{
+    return a.enableWorldMap != b.enableWorldMap || a.worldTileFile != b.worldTileFile ||
+           a.worldTileCells != b.worldTileCells || a.worldActiveRadius != b.worldActiveRadius ||
+           a.worldPrefetchTiles != b.worldPrefetchTiles || a.cellSize != b.cellSize;
+}
 } // namespace
 
 namespace radar
@@ -45,14 +69,68 @@ namespace radar
 
 FusedRadarMapping::FusedRadarMapping(Settings settings)
     : m_settings(std::move(settings))
+    , m_downsampler({m_settings.enableDownsampling, m_settings.downsampleCellSize, 0.0F})
 {
     updatePlausibilityCache();
     initializeGrid();
+    openWorldMap();
+}
+
+void FusedRadarMapping::WorldPose::advance(const glm::vec2& vehicleVelocity, float yawRate, float dt_s)
+{
+    // Midpoint heading over the step, so a constant turn traces the arc instead of its tangent.
+    const glm::vec2 displacement = rotate(vehicleVelocity, heading_rad + 0.5F * yawRate * dt_s) * dt_s;
+    position += displacement;
+    heading_rad += yawRate * dt_s;
+    velocity = rotate(vehicleVelocity, heading_rad);
+}
+
+void FusedRadarMapping::update(const BaseRadarSensor::PointCloud& points, const WorldPose& pose)
+{
+    if (m_settingsReader.refresh())
+    {
+        applySettings(m_settingsReader.settings());
+    }
+    if (!m_worldMap)
+    {
+        update(points);
+        return;
+    }
+
+    m_worldMap->setVehiclePosition(pose.position.x, pose.position.y, pose.velocity.x, pose.velocity.y);
+    m_worldOrigin = pose.position;
+    m_worldCos = std::cos(pose.heading_rad);
+    m_worldSin = std::sin(pose.heading_rad);
+    m_forwardToWorld = true;
+    update(points);
+    m_forwardToWorld = false;
 }
 
 void FusedRadarMapping::update(const BaseRadarSensor::PointCloud& points)
 {
-    for (const auto& point : points)
+    if (m_settingsReader.refresh())
+    {
+        applySettings(m_settingsReader.settings());
+    }
+
+    const BaseRadarSensor::PointCloud* input = &points;
+    if (m_settings.enableDownsampling)
+    {
+        // Drop invalid returns first: a strong invalid one would otherwise represent its cell and take the
+        // cell's valid returns down with it in the filter below.
+        m_validPoints.clear();
+        std::copy_if(points.begin(),
+                     points.end(),
+                     std::back_inserter(m_validPoints),
+                     [](const RadarPoint& point) { return point.radarValid != 0U || point.superResolution != 0U; });
+        m_downsampler.downsample(m_validPoints, m_downsampledPoints);
+        input = &m_downsampledPoints;
+    }
+
+    // Gather the detections that can touch the grid, evaluate their plausibility in one batched pass, then apply
+    // them in input order (updateCell() clamps, so the order of grid updates matters).
+    m_batch.clear();
+    for (const auto& point : *input)
     {
         const bool detectionTypeValid = (point.radarValid != 0U) || (point.superResolution != 0U);
         if (!detectionTypeValid)
@@ -84,8 +162,46 @@ void FusedRadarMapping::update(const BaseRadarSensor::PointCloud& points)
         float rangeAccuracy_m = 0.0F;
         float angleAccuracy_rad = 0.0F;
         computeSensorAccuracies(point, rangeAccuracy_m, angleAccuracy_rad);
+        const float freeSpaceRange =
+            range_m - (m_settings.freespaceRangeSigmaFactor * std::max(0.0F, rangeAccuracy_m));
+
+        m_batch.points.push_back(&point);
+        m_batch.range_m.push_back(range_m);
+        m_batch.azimuth_rad.push_back(azimuth_rad);
+        m_batch.amplitude_dBsm.push_back(point.amplitude_dBsm);
+        m_batch.freeSpaceRange_m.push_back(std::min(freeSpaceRange, kFreeSpacePlausibilityRange_m));
+        m_batch.rangeAccuracy_m.push_back(rangeAccuracy_m);
+        m_batch.angleAccuracy_rad.push_back(angleAccuracy_rad);
+    }
+
+    const std::size_t count = m_batch.points.size();
+    m_batch.resizeResults();
+    {
+        const core::StageProfiler::Scope scope(m_profiler, m_plausibilityStage, count);
+        computePlausibility(m_batch.range_m.data(),
+                            m_batch.azimuth_rad.data(),
+                            m_batch.amplitude_dBsm.data(),
+                            count,
+                            m_batch.plausibility.data());
+        if (m_settings.enableFreespace)
+        {
+            computePlausibility(m_batch.freeSpaceRange_m.data(),
+                                m_batch.azimuth_rad.data(),
+                                m_batch.amplitude_dBsm.data(),
+                                count,
+                                m_batch.freeSpacePlausibility.data());
+        }
+    }
 
-        const float plausibility = computePlausibility(range_m, azimuth_rad, point.amplitude_dBsm);
+    // Occupied then free space per detection: one scope covers both kernels, since sampling them separately
+    // would either cost more than the few cell writes per call or reorder the clamped grid updates.
+    const core::StageProfiler::Scope scope(m_profiler, m_gridUpdateStage, count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const RadarPoint& point = *m_batch.points[i];
+        const glm::vec2 detectionPosition(point.x, point.y);
+        const glm::vec2 sensorPosition(point.sensorLateral_m, point.sensorLongitudinal_m);
+        const float plausibility = m_batch.plausibility[i];
         const bool isStationary =
             (point.isStationary != 0U) || (point.isStatic != 0U) || (point.motionStatus == 0);
 
@@ -95,11 +211,11 @@ void FusedRadarMapping::update(const BaseRadarSensor::PointCloud& points)
             if (m_settings.radarModel == RadarModel::Gaussian)
             {
                 addGaussian(detectionPosition,
-                            relativeVector,
-                            range_m,
-                            azimuth_rad,
-                            rangeAccuracy_m,
-                            angleAccuracy_rad,
+                            detectionPosition - sensorPosition,
+                            m_batch.range_m[i],
+                            m_batch.azimuth_rad[i],
+                            m_batch.rangeAccuracy_m[i],
+                            m_batch.angleAccuracy_rad[i],
                             plausibility);
             }
             else
@@ -110,7 +226,11 @@ void FusedRadarMapping::update(const BaseRadarSensor::PointCloud& points)
 
         if (m_settings.enableFreespace)
         {
-            addFreespaceCone(sensorPosition, azimuth_rad, range_m, rangeAccuracy_m, point.amplitude_dBsm);
+            addFreespaceCone(sensorPosition,
+                             m_batch.azimuth_rad[i],
+                             m_batch.range_m[i],
+                             m_batch.rangeAccuracy_m[i],
+                             m_batch.freeSpacePlausibility[i]);
         }
     }
 }
@@ -120,11 +240,28 @@ void FusedRadarMapping::reset()
     std::fill(m_logOdds.begin(), m_logOdds.end(), 0.0F);
 }
 
-void FusedRadarMapping::applySettings(const Settings& settings)
+bool FusedRadarMapping::applySettings(const Settings& settings)
 {
+    const bool rebuildGrid = settings.cellSize != m_settings.cellSize || settings.mapRadius != m_settings.mapRadius ||
+                             settings.gridHugePages != m_settings.gridHugePages;
+    const bool reopenWorldMap = worldMapSettingsChanged(settings, m_settings);
     m_settings = settings;
+    m_downsampler.updateSettings({m_settings.enableDownsampling, m_settings.downsampleCellSize, 0.0F});
     updatePlausibilityCache();
-    initializeGrid();
+    if (rebuildGrid)
+    {
+        initializeGrid();
+    }
+    if (reopenWorldMap)
+    {
+        openWorldMap();
+    }
+    return rebuildGrid;
+}
+
+void FusedRadarMapping::setSettingsChannel(std::shared_ptr<const SettingsChannel> channel)
+{
+    m_settingsReader = core::SettingsReader<Settings>(std::move(channel));
 }
 
 const FusedRadarMapping::Settings& FusedRadarMapping::settings() const noexcept
@@ -132,6 +269,45 @@ const FusedRadarMapping::Settings& FusedRadarMapping::settings() const noexcept
     return m_settings;
 }
 
+std::size_t FusedRadarMapping::gridHugePageBytes() const
+{
+    return core::residentHugePageBytes(m_logOdds.data(), m_logOdds.size() * sizeof(float));
+}
+
+void FusedRadarMapping::setProfiler(core::StageProfiler* profiler)
+{
+    m_profiler = profiler;
+    if (m_profiler)
+    {
+        m_plausibilityStage = m_profiler->addStage("mapping.plausibility");
+        m_gridUpdateStage = m_profiler->addStage("mapping.gridUpdate");
+    }
+}
+
+std::vector<glm::vec3> FusedRadarMapping::occupiedWorldCells() const
+{
+    std::vector<glm::vec3> cells;
+    if (m_worldMap)
+    {
+        m_worldMap->forEachCellAbove(m_settings.occupiedThreshold,
+                                     [&cells](float x, float y, float) { cells.emplace_back(x, y, 0.0F); });
+    }
+    return cells;
+}
+
+const core::WorldTileStore* FusedRadarMapping::worldMap() const noexcept
+{
+    return m_worldMap.get();
+}
+
+void FusedRadarMapping::flushWorldMap()
+{
+    if (m_worldMap)
+    {
+        m_worldMap->flush();
+    }
+}
+
 std::vector<glm::vec3> FusedRadarMapping::occupiedCells() const
 {
     std::vector<glm::vec3> cells;
@@ -150,6 +326,36 @@ std::vector<glm::vec3> FusedRadarMapping::occupiedCells() const
     return cells;
 }
 
+std::size_t FusedRadarMapping::writeOccupiedCells(std::span<MapVertex> out,
+                                                  const MapVertexTransform& transform) const
+{
+    std::size_t written = 0U;
+    for (int iy = 0; iy < m_gridSize && written < out.size(); ++iy)
+    {
+        for (int ix = 0; ix < m_gridSize && written < out.size(); ++ix)
+        {
+            if (m_logOdds[iy * m_gridSize + ix] >= m_settings.occupiedThreshold)
+            {
+                const glm::vec3 center = cellCenter(ix, iy);
+                out[written++] = transform.apply(glm::vec2(center.x, center.y));
+            }
+        }
+    }
+    return written;
+}
+
+OccupancyGridView FusedRadarMapping::gridView() const noexcept
+{
+    OccupancyGridView view;
+    view.logOdds = m_logOdds.data();
+    view.size = m_gridSize;
+    view.cellSize = m_settings.cellSize;
+    // Cell ix starts at (ix - m_gridCenter) * cellSize, as in worldToCell().
+    view.origin = glm::vec2(-m_gridCenter * m_settings.cellSize, -m_gridCenter * m_settings.cellSize);
+    view.occupiedThreshold = m_settings.occupiedThreshold;
+    return view;
+}
+
 bool FusedRadarMapping::worldToCell(const glm::vec2& position, int& ix, int& iy) const
 {
     const float scaledX = position.x / m_settings.cellSize + m_gridCenter;
@@ -159,49 +365,167 @@ bool FusedRadarMapping::worldToCell(const glm::vec2& position, int& ix, int& iy)
     return ix >= 0 && ix < m_gridSize && iy >= 0 && iy < m_gridSize;
 }
 
+inline float FusedRadarMapping::PlausibilityTable::operator()(float value) const
+{
+    constexpr auto kLast = static_cast<float>(kPlausibilityTableSize);
+    const float scaled = (value - origin) * invStep;
+#if RADAR_CORE_HAS_SSE2
+    // maxss/minss keep the clamp branchless (inputs fall on either side of the window unpredictably) and return
+    // the second operand for NaN, so NaN lands on the first entry.
+    const float position =
+        _mm_cvtss_f32(_mm_min_ss(_mm_max_ss(_mm_set_ss(scaled), _mm_setzero_ps()), _mm_set_ss(kLast)));
+#else
+    const float position = std::min(std::max(0.0F, scaled), kLast);
+#endif
+    const auto index = std::min(static_cast<std::size_t>(static_cast<int>(position)), kPlausibilityTableSize - 1U);
+    const float fraction = position - static_cast<float>(index);
+    return values[index] + fraction * (values[index + 1U] - values[index]);
+}
+
+void FusedRadarMapping::DetectionBatch::clear()
+{
+    points.clear();
+    range_m.clear();
+    azimuth_rad.clear();
+    amplitude_dBsm.clear();
+    freeSpaceRange_m.clear();
+    rangeAccuracy_m.clear();
+    angleAccuracy_rad.clear();
+}
+
+void FusedRadarMapping::DetectionBatch::resizeResults()
+{
+    plausibility.resize(points.size());
+    freeSpacePlausibility.resize(points.size());
+}
+
 void FusedRadarMapping::updatePlausibilityCache()
 {
-    m_rangeGrowthRate = -computeGrowthRate(m_settings.plausibilityRangeBandwidth);
-    m_azimuthGrowthRate = -computeGrowthRate(m_settings.plausibilityAzimuthBandwidth);
-    m_amplitudeGrowthRate = computeGrowthRate(m_settings.plausibilityAmplitudeBandwidth);
+    // Samples 1 / (1 + exp(-growthRate * (input * inputScale - midpoint))) over [lo, hi] of the table input,
+    // narrowed to where the sigmoid is not saturated. A zero growth rate gives a constant 0.5.
+    const auto build = [](PlausibilityTable& table,
+                          float growthRate,
+                          float midpoint,
+                          float inputScale,
+                          float lo,
+                          float hi)
+    {
+        if (growthRate == 0.0F)
+        {
+            table.origin = 0.0F;
+            table.invStep = 0.0F;
+            table.values.fill(0.5F);
+            return;
+        }
+
+        const float halfWidth = kSaturatedLogit / std::abs(growthRate);
+        const float windowLo = std::max(lo, (midpoint - halfWidth) / inputScale);
+        const float windowHi = std::min(hi, (midpoint + halfWidth) / inputScale);
+        if (windowLo < windowHi)
+        {
+            lo = windowLo;
+            hi = windowHi;
+        }
+        table.origin = lo;
+        const float step = (hi - lo) / static_cast<float>(kPlausibilityTableSize);
+        table.invStep = step > 0.0F ? 1.0F / step : 0.0F;
+        for (std::size_t i = 0; i < table.values.size(); ++i)
+        {
+            const float input = (lo + step * static_cast<float>(i)) * inputScale;
+            table.values[i] = computeIndividualPlausibility(input, growthRate, midpoint);
+        }
+    };
+
+    constexpr float kUnbounded = std::numeric_limits<float>::max();
+    build(m_rangeTable,
+          -computeGrowthRate(m_settings.plausibilityRangeBandwidth),
+          m_settings.plausibilityRangeMidpoint,
+          1.0F,
+          -kUnbounded,
+          kUnbounded);
+    // Indexed by |azimuth| in radians; the component itself is defined in degrees.
+    build(m_azimuthTable,
+          -computeGrowthRate(m_settings.plausibilityAzimuthBandwidth),
+          m_settings.plausibilityAzimuthMidpoint,
+          kRadToDeg,
+          0.0F,
+          kPi);
+    build(m_amplitudeTable,
+          computeGrowthRate(m_settings.plausibilityAmplitudeBandwidth),
+          m_settings.plausibilityAmplitudeMidpoint,
+          1.0F,
+          -kUnbounded,
+          kUnbounded);
+}
+
+template <typename Combine>
+void FusedRadarMapping::combinePlausibility(const float* range_m,
+                                            const float* azimuth_rad,
+                                            const float* amplitude_dBsm,
+                                            std::size_t count,
+                                            float* out,
+                                            Combine combine) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float azimuth = std::abs(azimuth_rad[i]);
+        // atan2() results are already in range; only raw fallback azimuths can need wrapping.
+        if (azimuth > kPi)
+        {
+            azimuth = std::abs(wrapTo180(azimuth_rad[i] * kRadToDeg)) * kDegToRad;
+        }
+        out[i] = combine(range_m[i],
+                         m_rangeTable(range_m[i]),
+                         m_azimuthTable(azimuth),
+                         m_amplitudeTable(amplitude_dBsm[i]));
+    }
 }
 
-float FusedRadarMapping::computePlausibility(float range_m, float azimuth_rad, float amplitude_dBsm) const
+void FusedRadarMapping::computePlausibility(const float* range_m,
+                                            const float* azimuth_rad,
+                                            const float* amplitude_dBsm,
+                                            std::size_t count,
+                                            float* out) const
 {
     if (!m_settings.enablePlausibilityScaling)
     {
-        return 1.0F;
+        std::fill(out, out + count, 1.0F);
+        return;
     }
 
-    const float rangeComponent =
-        computeIndividualPlausibility(range_m, m_rangeGrowthRate, m_settings.plausibilityRangeMidpoint);
-    const float azimuthDeg = std::abs(wrapTo180(azimuth_rad * kRadToDeg));
-    const float azimuthComponent =
-        computeIndividualPlausibility(azimuthDeg, m_azimuthGrowthRate, m_settings.plausibilityAzimuthMidpoint);
-    const float amplitudeComponent =
-        computeIndividualPlausibility(amplitude_dBsm, m_amplitudeGrowthRate, m_settings.plausibilityAmplitudeMidpoint);
-
-    float combined = 1.0F;
+    // Table values lie in [0, 1], so every combination does too.
     switch (m_settings.plausibilityMethod)
     {
         case PlausibilityCombinationMethod::Average:
-            combined = (rangeComponent + azimuthComponent + amplitudeComponent) / 3.0F;
+            combinePlausibility(range_m, azimuth_rad, amplitude_dBsm, count, out,
+                                [](float, float range, float azimuth, float amplitude)
+                                { return (range + azimuth + amplitude) / 3.0F; });
             break;
         case PlausibilityCombinationMethod::Product:
-            combined = rangeComponent * azimuthComponent * amplitudeComponent;
+            combinePlausibility(range_m, azimuth_rad, amplitude_dBsm, count, out,
+                                [](float, float range, float azimuth, float amplitude)
+                                { return range * azimuth * amplitude; });
             break;
         case PlausibilityCombinationMethod::Minimum:
-            combined = std::min({rangeComponent, azimuthComponent, amplitudeComponent});
+            combinePlausibility(range_m, azimuth_rad, amplitude_dBsm, count, out,
+                                [](float, float range, float azimuth, float amplitude)
+                                { return std::min({range, azimuth, amplitude}); });
             break;
         case PlausibilityCombinationMethod::Custom:
         default:
-            combined = range_m > m_settings.customCombinationRangeThreshold
-                           ? std::min(rangeComponent, azimuthComponent) * amplitudeComponent
-                           : rangeComponent * amplitudeComponent;
+        {
+            const float threshold = m_settings.customCombinationRangeThreshold;
+            combinePlausibility(range_m, azimuth_rad, amplitude_dBsm, count, out,
+                                [threshold](float input_m, float range, float azimuth, float amplitude)
+                                {
+                                    // Beyond the threshold the azimuth term caps the range term; the select is
+                                    // arithmetic because either side is equally likely.
+                                    const float nearby = static_cast<float>(input_m <= threshold);
+                                    return std::min(range, azimuth + (1.0F - azimuth) * nearby) * amplitude;
+                                });
             break;
+        }
     }
-
-    return std::clamp(combined, 0.0F, 1.0F);
 }
 
 void FusedRadarMapping::computeSensorAccuracies(const RadarPoint& point,
@@ -298,7 +622,7 @@ void FusedRadarMapping::addFreespaceCone(const glm::vec2& sensorPosition,
                                          float azimuth_rad,
                                          float range_m,
                                          float rangeAccuracy_m,
-                                         float amplitude_dBsm)
+                                         float plausibility)
 {
     if (range_m > m_settings.maxFreeSpaceRange_m)
     {
@@ -307,14 +631,7 @@ void FusedRadarMapping::addFreespaceCone(const glm::vec2& sensorPosition,
 
     const float freeSpaceRange =
         range_m - (m_settings.freespaceRangeSigmaFactor * std::max(0.0F, rangeAccuracy_m));
-    if (freeSpaceRange <= 0.0F)
-    {
-        return;
-    }
-
-    const float freeSpacePlausibility =
-        computePlausibility(std::min(freeSpaceRange, 15.0F), azimuth_rad, amplitude_dBsm);
-    if (freeSpacePlausibility < m_settings.minPlausibility)
+    if (freeSpaceRange <= 0.0F || plausibility < m_settings.minPlausibility)
     {
         return;
     }
@@ -327,7 +644,7 @@ void FusedRadarMapping::addFreespaceCone(const glm::vec2& sensorPosition,
     const glm::vec2 right =
         sensorPosition + freeSpaceRange * glm::vec2(std::sin(angleRight), std::cos(angleRight));
 
-    const float delta = -std::abs(m_settings.missDecrement) * freeSpacePlausibility;
+    const float delta = -std::abs(m_settings.missDecrement) * plausibility;
 
     const float minX = std::min({sensorPosition.x, left.x, right.x});
     const float maxX = std::max({sensorPosition.x, left.x, right.x});
@@ -376,6 +693,15 @@ void FusedRadarMapping::updateCell(int ix, int iy, float delta)
     const float& current = m_logOdds[iy * m_gridSize + ix];
     const float next = std::clamp(current + delta, m_settings.minLogOdds, m_settings.maxLogOdds);
     m_logOdds[iy * m_gridSize + ix] = next;
+    if (m_forwardToWorld)
+    {
+        const glm::vec3 cell = cellCenter(ix, iy);
+        m_worldMap->addLogOdds(m_worldOrigin.x + m_worldCos * cell.x - m_worldSin * cell.y,
+                               m_worldOrigin.y + m_worldSin * cell.x + m_worldCos * cell.y,
+                               delta,
+                               m_settings.minLogOdds,
+                               m_settings.maxLogOdds);
+    }
 }
 
 glm::vec3 FusedRadarMapping::cellCenter(int ix, int iy) const
@@ -389,7 +715,36 @@ void FusedRadarMapping::initializeGrid()
 {
     m_gridSize = std::max(3, static_cast<int>(std::ceil((m_settings.mapRadius * 2.0F) / m_settings.cellSize)));
     m_gridCenter = (static_cast<float>(m_gridSize) - 1.0F) * 0.5F;
-    m_logOdds.assign(m_gridSize * m_gridSize, 0.0F);
+    // Replace rather than assign so a changed gridHugePages mode takes effect.
+    m_logOdds = std::vector<float, core::HugePageAllocator<float>>(
+        static_cast<std::size_t>(m_gridSize) * static_cast<std::size_t>(m_gridSize),
+        0.0F,
+        core::HugePageAllocator<float>(m_settings.gridHugePages, core::MemoryTag::MappingGrid));
+}
+
+void FusedRadarMapping::openWorldMap()
+{
+    // Closing writes the resident tiles back before a new store maps the file.
+    m_worldMap.reset();
+    if (!m_settings.enableWorldMap)
+    {
+        return;
+    }
+
+    core::WorldTileStore::Settings settings;
+    settings.tileFile = m_settings.worldTileFile;
+    settings.cellSize_m = m_settings.cellSize;
+    settings.tileCells = m_settings.worldTileCells;
+    settings.activeRadius = m_settings.worldActiveRadius;
+    settings.prefetchTiles = m_settings.worldPrefetchTiles;
+    auto store = std::make_unique<core::WorldTileStore>();
+    std::string error;
+    if (!store->open(settings, error))
+    {
+        Logger::log(Logger::Level::Warning, "World map disabled: " + error);
+        return;
+    }
+    m_worldMap = std::move(store);
 }
 
 } // namespace radar
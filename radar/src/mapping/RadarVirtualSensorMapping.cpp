@@ -1,6 +1,9 @@
 #include "mapping/RadarVirtualSensorMapping.hpp"
 
+#include "radar_core/mask_compaction.hpp" // RADAR_CORE_HAS_SSE2
+
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <limits>
 
@@ -14,6 +17,108 @@ float cross2(const glm::vec2& a, const glm::vec2& b)
 {
     return a.x * b.y - a.y * b.x;
 }
+
+// Monotonic in the polar angle over [0, 4) without trig; the zero vector is not allowed.
+float pseudoAngle(const glm::vec2& v)
+{
+    if (v.y >= 0.0F)
+    {
+        return v.x >= 0.0F ? v.y / (v.x + v.y) : 1.0F - v.x / (v.y - v.x);
+    }
+    return v.x < 0.0F ? 2.0F - v.y / (-v.x - v.y) : 3.0F + v.x / (v.x - v.y);
+}
+
+// Inverse of pseudoAngle() up to length.
+glm::vec2 pseudoAngleDirection(float p)
+{
+    const int quadrant = std::min(3, static_cast<int>(p));
+    const float f = p - static_cast<float>(quadrant);
+    switch (quadrant)
+    {
+    case 0:
+        return glm::vec2(1.0F - f, f);
+    case 1:
+        return glm::vec2(-f, 1.0F - f);
+    case 2:
+        return glm::vec2(f - 1.0F, -f);
+    default:
+        return glm::vec2(f, f - 1.0F);
+    }
+}
+
+// Appends the cells of grid that the ray origin + t direction (t >= tStart, direction of unit length) crosses,
+// in order, with the t at which it enters each (Amanatides & Woo traversal).
+void traceGridRay(const OccupancyGridView& grid,
+                  const glm::vec2& origin,
+                  const glm::vec2& direction,
+                  float tStart,
+                  std::vector<std::uint32_t>& cells,
+                  std::vector<float>& distances)
+{
+    const float extent = grid.cellSize * static_cast<float>(grid.size);
+    const float origins[2] = {origin.x, origin.y};
+    const float directions[2] = {direction.x, direction.y};
+    const float gridMin[2] = {grid.origin.x, grid.origin.y};
+
+    // Clip the ray to the grid square, one slab per axis.
+    float tEnter = tStart;
+    float tExit = std::numeric_limits<float>::infinity();
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        if (std::fabs(directions[axis]) < kEpsilon)
+        {
+            if (origins[axis] < gridMin[axis] || origins[axis] >= gridMin[axis] + extent)
+            {
+                return;
+            }
+            continue;
+        }
+        float t0 = (gridMin[axis] - origins[axis]) / directions[axis];
+        float t1 = (gridMin[axis] + extent - origins[axis]) / directions[axis];
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
+    }
+    if (!(tEnter < tExit))
+    {
+        return;
+    }
+
+    int index[2] = {};
+    int step[2] = {};
+    float tNext[2] = {};
+    float tDelta[2] = {};
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        const float position = (origins[axis] + directions[axis] * tEnter - gridMin[axis]) / grid.cellSize;
+        index[axis] = std::clamp(static_cast<int>(std::floor(position)), 0, grid.size - 1);
+        if (std::fabs(directions[axis]) < kEpsilon)
+        {
+            tNext[axis] = std::numeric_limits<float>::infinity();
+            tDelta[axis] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+        step[axis] = directions[axis] > 0.0F ? 1 : -1;
+        const int boundaryIndex = index[axis] + (step[axis] > 0 ? 1 : 0);
+        const float boundary = gridMin[axis] + static_cast<float>(boundaryIndex) * grid.cellSize;
+        tNext[axis] = (boundary - origins[axis]) / directions[axis];
+        tDelta[axis] = grid.cellSize / std::fabs(directions[axis]);
+    }
+
+    float t = tEnter;
+    while (t < tExit && index[0] >= 0 && index[0] < grid.size && index[1] >= 0 && index[1] < grid.size)
+    {
+        cells.push_back(static_cast<std::uint32_t>(index[1] * grid.size + index[0]));
+        distances.push_back(t);
+        const int axis = tNext[0] < tNext[1] ? 0 : 1;
+        t = tNext[axis];
+        tNext[axis] += tDelta[axis];
+        index[axis] += step[axis];
+    }
+}
 } // namespace
 
 RadarVirtualSensorMapping::RadarVirtualSensorMapping()
@@ -33,6 +138,14 @@ bool RadarVirtualSensorMapping::setSegmentCount(std::size_t count)
     m_segmentDirections.assign(m_segmentCount, glm::vec2(0.0F));
     m_segmentStartDist.assign(m_segmentCount, 0.0F);
     m_segmentEndDist.assign(m_segmentCount, std::numeric_limits<float>::infinity());
+    m_segmentBoundaries.assign(m_segmentCount, glm::vec2(0.0F));
+    m_lookupSegment.assign(m_segmentCount * kLookupCellsPerSegment, 0U);
+    m_filteredEndDist.assign(m_segmentCount, std::numeric_limits<float>::infinity());
+    m_lastHitUs.assign(m_segmentCount, 0U);
+    m_carriedEndDist.assign(m_segmentCount, std::numeric_limits<float>::infinity());
+    m_carriedHitUs.assign(m_segmentCount, 0U);
+    m_hasState = false;
+    m_gridTraversal.valid = false;
 
     rebuildSegments();
 
@@ -75,11 +188,78 @@ void RadarVirtualSensorMapping::setVehicleContour(const std::vector<glm::vec2>&
         m_segmentStartDist[i] = std::max(0.0F, distance);
     }
 
+    // Segment state is relative to the contour centre.
+    resetPersistence();
+    m_gridTraversal.valid = false;
     m_ready = true;
 }
 
+void RadarVirtualSensorMapping::setPersistence(const PersistenceSettings& settings)
+{
+    m_persistence = settings;
+    m_persistence.recedeGain = std::clamp(m_persistence.recedeGain, 0.0F, 1.0F);
+}
+
+const RadarVirtualSensorMapping::PersistenceSettings& RadarVirtualSensorMapping::persistence() const
+{
+    return m_persistence;
+}
+
 void RadarVirtualSensorMapping::update(const std::vector<glm::vec2>& detections,
                                        const std::vector<std::array<glm::vec2, 4>>& trackFootprints)
+{
+    resetPersistence();
+    collectHits(detections, trackFootprints);
+}
+
+void RadarVirtualSensorMapping::update(const std::vector<glm::vec2>& detections,
+                                       const std::vector<std::array<glm::vec2, 4>>& trackFootprints,
+                                       std::uint64_t timestampUs,
+                                       const EgoMotion* egoMotion)
+{
+    collectHits(detections, trackFootprints);
+    if (!m_ready)
+    {
+        resetPersistence();
+        return;
+    }
+
+    const bool carry = m_hasState && egoMotion != nullptr && timestampUs >= m_lastUpdateUs &&
+                       timestampUs - m_lastUpdateUs <= m_persistence.maxGapUs;
+    if (carry)
+    {
+        carryPersistence(*egoMotion, static_cast<float>(timestampUs - m_lastUpdateUs) * 1e-6F);
+    }
+    else
+    {
+        resetPersistence();
+    }
+
+    // Closer hits are taken as they are, farther ones are blended in, and segments without a hit keep their
+    // end until it has not been confirmed for holdUs.
+    for (std::size_t i = 0; i < m_segmentCount; ++i)
+    {
+        const float hit = m_segmentEndDist[i];
+        float& filtered = m_filteredEndDist[i];
+        if (std::isfinite(hit))
+        {
+            filtered = hit < filtered || !std::isfinite(filtered)
+                           ? hit
+                           : filtered + m_persistence.recedeGain * (hit - filtered);
+            m_lastHitUs[i] = timestampUs;
+        }
+        else if (std::isfinite(filtered) && timestampUs - m_lastHitUs[i] > m_persistence.holdUs)
+        {
+            filtered = std::numeric_limits<float>::infinity();
+        }
+        m_segmentEndDist[i] = filtered;
+    }
+    m_lastUpdateUs = timestampUs;
+    m_hasState = true;
+}
+
+void RadarVirtualSensorMapping::collectHits(const std::vector<glm::vec2>& detections,
+                                            const std::vector<std::array<glm::vec2, 4>>& trackFootprints)
 {
     resetSegments();
 
@@ -97,7 +277,7 @@ void RadarVirtualSensorMapping::update(const std::vector<glm::vec2>& detections,
             continue;
         }
 
-        const std::size_t idx = segmentIndex(std::atan2(delta.y, delta.x));
+        const std::size_t idx = segmentIndex(delta);
         if (distance <= m_segmentStartDist[idx] + kEpsilon)
         {
             continue;
@@ -108,6 +288,11 @@ void RadarVirtualSensorMapping::update(const std::vector<glm::vec2>& detections,
         }
     }
 
+    collectFootprintHits(trackFootprints);
+}
+
+void RadarVirtualSensorMapping::collectFootprintHits(const std::vector<std::array<glm::vec2, 4>>& trackFootprints)
+{
     for (const auto& footprint : trackFootprints)
     {
         for (std::size_t i = 0; i < m_segmentCount; ++i)
@@ -129,9 +314,189 @@ void RadarVirtualSensorMapping::update(const std::vector<glm::vec2>& detections,
     }
 }
 
+void RadarVirtualSensorMapping::updateFromGrid(const OccupancyGridView& grid,
+                                               const std::vector<std::array<glm::vec2, 4>>& trackFootprints)
+{
+    resetPersistence();
+    resetSegments();
+    if (!m_ready || !grid.valid())
+    {
+        return;
+    }
+
+    if (!m_gridTraversal.valid || !m_gridTraversal.geometry.sameGeometry(grid))
+    {
+        buildGridTraversal(grid);
+    }
+    marchGrid(grid);
+    collectFootprintHits(trackFootprints);
+}
+
+void RadarVirtualSensorMapping::buildGridTraversal(const OccupancyGridView& grid)
+{
+    GridTraversal& traversal = m_gridTraversal;
+    traversal.geometry = grid;
+    traversal.groupFirst.clear();
+    traversal.groupSteps.clear();
+    traversal.cells.clear();
+    traversal.distances.clear();
+
+    std::array<std::vector<std::uint32_t>, kRayLanes> rayCells;
+    std::array<std::vector<float>, kRayLanes> rayDistances;
+    for (std::size_t first = 0; first < m_segmentCount; first += kRayLanes)
+    {
+        std::size_t steps = 0U;
+        for (std::size_t lane = 0; lane < kRayLanes; ++lane)
+        {
+            rayCells[lane].clear();
+            rayDistances[lane].clear();
+            const std::size_t segment = first + lane;
+            if (segment < m_segmentCount)
+            {
+                // Start just outside the contour, as detections on it do not count either.
+                traceGridRay(grid,
+                             m_vehicleCenter,
+                             m_segmentDirections[segment],
+                             m_segmentStartDist[segment] + kEpsilon,
+                             rayCells[lane],
+                             rayDistances[lane]);
+            }
+            steps = std::max(steps, rayCells[lane].size());
+        }
+
+        traversal.groupFirst.push_back(static_cast<std::uint32_t>(traversal.cells.size()));
+        traversal.groupSteps.push_back(static_cast<std::uint32_t>(steps));
+        for (std::size_t step = 0; step < steps; ++step)
+        {
+            for (std::size_t lane = 0; lane < kRayLanes; ++lane)
+            {
+                const bool inside = step < rayCells[lane].size();
+                traversal.cells.push_back(inside ? rayCells[lane][step] : 0U);
+                traversal.distances.push_back(inside ? rayDistances[lane][step]
+                                                     : std::numeric_limits<float>::infinity());
+            }
+        }
+    }
+    traversal.valid = true;
+}
+
+void RadarVirtualSensorMapping::marchGrid(const OccupancyGridView& grid)
+{
+    const GridTraversal& traversal = m_gridTraversal;
+    constexpr unsigned kAllLanes = (1U << kRayLanes) - 1U;
+#if RADAR_CORE_HAS_SSE2
+    static_assert(kRayLanes == 4U, "one SSE2 register of log-odds per step");
+    const __m128 threshold = _mm_set1_ps(grid.occupiedThreshold);
+#endif
+    for (std::size_t group = 0; group < traversal.groupFirst.size(); ++group)
+    {
+        const std::uint32_t* cells = traversal.cells.data() + traversal.groupFirst[group];
+        const float* distances = traversal.distances.data() + traversal.groupFirst[group];
+        std::array<float, kRayLanes> ends{};
+        ends.fill(std::numeric_limits<float>::infinity());
+        // Lanes whose ray has not hit an occupied cell yet; the group stops once every ray has (a padded step
+        // counts as a hit at infinity).
+        unsigned pending = kAllLanes;
+        for (std::size_t step = 0; step < traversal.groupSteps[group] && pending != 0U; ++step)
+        {
+            const std::uint32_t* stepCells = cells + step * kRayLanes;
+#if RADAR_CORE_HAS_SSE2
+            // No gather in SSE2: the four cells are loaded one by one, compared together.
+            const __m128 values = _mm_setr_ps(grid.logOdds[stepCells[0]],
+                                              grid.logOdds[stepCells[1]],
+                                              grid.logOdds[stepCells[2]],
+                                              grid.logOdds[stepCells[3]]);
+            unsigned hits = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpge_ps(values, threshold))) & pending;
+#else
+            unsigned hits = 0U;
+            for (std::size_t lane = 0; lane < kRayLanes; ++lane)
+            {
+                hits |= grid.logOdds[stepCells[lane]] >= grid.occupiedThreshold ? (1U << lane) : 0U;
+            }
+            hits &= pending;
+#endif
+            pending &= ~hits;
+            for (; hits != 0U; hits &= hits - 1U)
+            {
+                const auto lane = static_cast<std::size_t>(std::countr_zero(hits));
+                ends[lane] = distances[step * kRayLanes + lane];
+            }
+        }
+
+        for (std::size_t lane = 0; lane < kRayLanes && group * kRayLanes + lane < m_segmentCount; ++lane)
+        {
+            m_segmentEndDist[group * kRayLanes + lane] = ends[lane];
+        }
+    }
+}
+
+void RadarVirtualSensorMapping::carryPersistence(const EgoMotion& egoMotion, float dt)
+{
+    // A static point p seen from the previous pose is at R(-yaw dt) (p - v dt) now. Each segment's end arc is
+    // moved by its two boundary points and spread over the segments it lands on, so translation that widens
+    // the arc leaves no holes; overlapping arcs keep the nearest end.
+    const float yaw = egoMotion.yawRate * dt;
+    const float c = std::cos(yaw);
+    const float s = std::sin(yaw);
+    const glm::vec2 translation = egoMotion.velocity * dt;
+    const auto move = [&](const glm::vec2& point)
+    {
+        const glm::vec2 shifted = point - translation;
+        return glm::vec2(c * shifted.x + s * shifted.y, -s * shifted.x + c * shifted.y) - m_vehicleCenter;
+    };
+
+    std::fill(m_carriedEndDist.begin(), m_carriedEndDist.end(), std::numeric_limits<float>::infinity());
+    std::fill(m_carriedHitUs.begin(), m_carriedHitUs.end(), 0U);
+    for (std::size_t i = 0; i < m_segmentCount; ++i)
+    {
+        const float distance = m_filteredEndDist[i];
+        if (!std::isfinite(distance))
+        {
+            continue;
+        }
+
+        const std::size_t next = i + 1U == m_segmentCount ? 0U : i + 1U;
+        const glm::vec2 first = move(m_vehicleCenter + m_segmentBoundaries[i] * distance);
+        const glm::vec2 last = move(m_vehicleCenter + m_segmentBoundaries[next] * distance);
+        const float firstDistance = glm::length(first);
+        const float lastDistance = glm::length(last);
+        if (firstDistance <= kEpsilon || lastDistance <= kEpsilon)
+        {
+            continue;
+        }
+
+        std::size_t from = segmentIndex(first);
+        std::size_t span = (segmentIndex(last) + m_segmentCount - from) % m_segmentCount;
+        if (span > m_segmentCount / 2U)
+        {
+            // The arc flipped (it passed the contour centre); keep only its middle.
+            const glm::vec2 middle = move(m_vehicleCenter + m_segmentDirections[i] * distance);
+            if (glm::length(middle) <= kEpsilon)
+            {
+                continue;
+            }
+            from = segmentIndex(middle);
+            span = 0U;
+        }
+        const float moved = std::min(firstDistance, lastDistance);
+        for (std::size_t k = 0; k <= span; ++k)
+        {
+            const std::size_t j = (from + k) % m_segmentCount;
+            if (moved > m_segmentStartDist[j] + kEpsilon && moved < m_carriedEndDist[j])
+            {
+                m_carriedEndDist[j] = moved;
+                m_carriedHitUs[j] = m_lastHitUs[i];
+            }
+        }
+    }
+    m_filteredEndDist.swap(m_carriedEndDist);
+    m_lastHitUs.swap(m_carriedHitUs);
+}
+
 void RadarVirtualSensorMapping::reset()
 {
     resetSegments();
+    resetPersistence();
 }
 
 std::vector<glm::vec2> RadarVirtualSensorMapping::ring(float fallbackRange) const
@@ -145,9 +510,7 @@ std::vector<glm::vec2> RadarVirtualSensorMapping::ring(float fallbackRange) cons
     ringPoints.reserve(m_segmentCount);
     for (std::size_t i = 0; i < m_segmentCount; ++i)
     {
-        float length = std::min(m_segmentEndDist[i], fallbackRange);
-        length = std::max(length, m_segmentStartDist[i]);
-        ringPoints.push_back(m_vehicleCenter + m_segmentDirections[i] * length);
+        ringPoints.push_back(m_vehicleCenter + m_segmentDirections[i] * drawnEndDistance(i, fallbackRange));
     }
 
     return ringPoints;
@@ -164,16 +527,65 @@ std::vector<RadarVirtualSensorMapping::Segment> RadarVirtualSensorMapping::segme
     output.reserve(m_segmentCount);
     for (std::size_t i = 0; i < m_segmentCount; ++i)
     {
-        float length = std::min(m_segmentEndDist[i], fallbackRange);
-        length = std::max(length, m_segmentStartDist[i]);
         const glm::vec2 start = m_vehicleCenter + m_segmentDirections[i] * m_segmentStartDist[i];
-        const glm::vec2 end = m_vehicleCenter + m_segmentDirections[i] * length;
+        const glm::vec2 end = m_vehicleCenter + m_segmentDirections[i] * drawnEndDistance(i, fallbackRange);
         output.push_back({start, end});
     }
 
     return output;
 }
 
+std::size_t RadarVirtualSensorMapping::ringVertexCount() const
+{
+    return m_ready ? m_segmentCount : 0U;
+}
+
+std::size_t RadarVirtualSensorMapping::segmentVertexCount() const
+{
+    return m_ready ? m_segmentCount * 2U : 0U;
+}
+
+std::size_t RadarVirtualSensorMapping::writeRing(float fallbackRange,
+                                                 std::span<MapVertex> out,
+                                                 const MapVertexTransform& transform) const
+{
+    const std::size_t count = ringVertexCount();
+    if (count == 0U || fallbackRange <= 0.0F || out.size() < count)
+    {
+        return 0U;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = transform.apply(m_vehicleCenter + m_segmentDirections[i] * drawnEndDistance(i, fallbackRange));
+    }
+    return count;
+}
+
+std::size_t RadarVirtualSensorMapping::writeSegments(float fallbackRange,
+                                                     std::span<MapVertex> out,
+                                                     const MapVertexTransform& transform) const
+{
+    const std::size_t count = segmentVertexCount();
+    if (count == 0U || fallbackRange <= 0.0F || out.size() < count)
+    {
+        return 0U;
+    }
+
+    for (std::size_t i = 0; i < m_segmentCount; ++i)
+    {
+        const glm::vec2& direction = m_segmentDirections[i];
+        out[2U * i] = transform.apply(m_vehicleCenter + direction * m_segmentStartDist[i]);
+        out[2U * i + 1U] = transform.apply(m_vehicleCenter + direction * drawnEndDistance(i, fallbackRange));
+    }
+    return count;
+}
+
+float RadarVirtualSensorMapping::drawnEndDistance(std::size_t segment, float fallbackRange) const
+{
+    return std::max(std::min(m_segmentEndDist[segment], fallbackRange), m_segmentStartDist[segment]);
+}
+
 void RadarVirtualSensorMapping::rebuildSegments()
 {
     if (m_segmentCount == 0U)
@@ -186,8 +598,19 @@ void RadarVirtualSensorMapping::rebuildSegments()
     {
         const float angle = (static_cast<float>(i) + 0.5F) * delta;
         m_segmentDirections[i] = glm::vec2(std::cos(angle), std::sin(angle));
+        m_segmentBoundaries[i] =
+            glm::vec2(std::cos(static_cast<float>(i) * delta), std::sin(static_cast<float>(i) * delta));
         m_segmentStartDist[i] = 0.0F;
     }
+
+    // Segments are at least pi / count wide in pseudo-angle, a lookup cell 4 / (4 count), so no cell spans a
+    // whole segment.
+    const float cellWidth = 4.0F / static_cast<float>(m_lookupSegment.size());
+    for (std::size_t cell = 0; cell < m_lookupSegment.size(); ++cell)
+    {
+        const glm::vec2 direction = pseudoAngleDirection(static_cast<float>(cell) * cellWidth);
+        m_lookupSegment[cell] = static_cast<std::uint32_t>(segmentIndex(std::atan2(direction.y, direction.x)));
+    }
 }
 
 void RadarVirtualSensorMapping::resetSegments()
@@ -195,6 +618,13 @@ void RadarVirtualSensorMapping::resetSegments()
     std::fill(m_segmentEndDist.begin(), m_segmentEndDist.end(), std::numeric_limits<float>::infinity());
 }
 
+void RadarVirtualSensorMapping::resetPersistence()
+{
+    std::fill(m_filteredEndDist.begin(), m_filteredEndDist.end(), std::numeric_limits<float>::infinity());
+    std::fill(m_lastHitUs.begin(), m_lastHitUs.end(), 0U);
+    m_hasState = false;
+}
+
 float RadarVirtualSensorMapping::normalizeAngle(float angle)
 {
     constexpr float twoPi = glm::two_pi<float>();
@@ -218,6 +648,16 @@ std::size_t RadarVirtualSensorMapping::segmentIndex(float angle) const
     return std::min(idx, m_segmentCount - 1U);
 }
 
+std::size_t RadarVirtualSensorMapping::segmentIndex(const glm::vec2& delta) const
+{
+    const float cells = static_cast<float>(m_lookupSegment.size());
+    const std::size_t cell =
+        std::min(m_lookupSegment.size() - 1U, static_cast<std::size_t>(pseudoAngle(delta) * cells * 0.25F));
+    const std::size_t idx = m_lookupSegment[cell];
+    const std::size_t next = idx + 1U == m_segmentCount ? 0U : idx + 1U;
+    return cross2(m_segmentBoundaries[next], delta) >= 0.0F ? next : idx;
+}
+
 bool RadarVirtualSensorMapping::raySegmentIntersection(const glm::vec2& origin,
                                                        const glm::vec2& direction,
                                                        const glm::vec2& a,
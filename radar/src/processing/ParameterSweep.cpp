@@ -0,0 +1,251 @@
+#include "processing/ParameterSweep.hpp"
+
+#include "logging/Logger.hpp"
+#include "processing/RadarPlayback.hpp"
+#include "radar_core/processing_pipeline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace radar
+{
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+struct VariantState
+{
+    explicit VariantState(const SweepVariant& variant)
+        : pipeline(variant.processing)
+        , mapping(variant.mapping)
+    {
+    }
+
+    core::RadarProcessingPipeline pipeline;
+    FusedRadarMapping mapping;
+    RadarFrame frame;
+    SweepMetrics metrics;
+};
+
+// Fills chunk with up to its size in batches; returns how many were decoded. Batches keep their record
+// storage between chunks.
+std::size_t decodeChunk(RadarPlayback& playback, std::vector<RadarRecordBatch>& chunk)
+{
+    std::size_t count = 0U;
+    while (count < chunk.size() && playback.readNextRecords(chunk[count]))
+    {
+        ++count;
+    }
+    return count;
+}
+
+void processChunk(const RadarPlayback& playback,
+                  const std::vector<RadarRecordBatch>& chunk,
+                  std::size_t count,
+                  VariantState& state)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto start = Clock::now();
+        playback.processRecords(chunk[i], state.pipeline, state.frame);
+        const auto processed = Clock::now();
+        state.mapping.update(state.frame.detections);
+        const auto mapped = Clock::now();
+
+        SweepMetrics& metrics = state.metrics;
+        metrics.processingMs += elapsedMs(start, processed);
+        metrics.mappingMs += elapsedMs(processed, mapped);
+        ++metrics.frames;
+        metrics.detections += state.frame.detections.size();
+        metrics.stationaryDetections += static_cast<std::size_t>(
+            std::count_if(state.frame.detections.begin(),
+                          state.frame.detections.end(),
+                          [](const RadarPoint& point) { return point.isStationary != 0U; }));
+        metrics.tracks += state.frame.tracks.size();
+
+        utility::OdometryEstimate odometry;
+        if (state.pipeline.latestOdometry(odometry) && odometry.valid)
+        {
+            ++metrics.odometryFrames;
+            metrics.odometryInliers += odometry.inlierCount;
+        }
+    }
+}
+} // namespace
+
+ParameterSweep::ParameterSweep(Settings settings)
+    : m_settings(std::move(settings))
+{
+}
+
+void ParameterSweep::addVariant(SweepVariant variant)
+{
+    m_variants.push_back(std::move(variant));
+}
+
+std::size_t ParameterSweep::variantCount() const noexcept
+{
+    return m_variants.size();
+}
+
+bool ParameterSweep::run()
+{
+    m_results.clear();
+    m_decodedFrames = 0U;
+    m_decodeMs = 0.0;
+    m_wallMs = 0.0;
+    if (m_variants.empty())
+    {
+        Logger::log(Logger::Level::Warning, "ParameterSweep has no variants.");
+        return false;
+    }
+
+    RadarPlayback::Settings playbackSettings;
+    playbackSettings.dataRoot = m_settings.dataRoot;
+    playbackSettings.inputFiles = m_settings.inputFiles;
+    playbackSettings.vehicleConfigPath = m_settings.vehicleConfigPath;
+    RadarPlayback playback(std::move(playbackSettings));
+    if (!playback.initialize())
+    {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<VariantState>> states;
+    states.reserve(m_variants.size());
+    for (const auto& variant : m_variants)
+    {
+        states.push_back(std::make_unique<VariantState>(variant));
+        states.back()->pipeline.initialize(playback.vehicleParameters());
+    }
+
+    std::size_t workerCount = m_settings.workerCount;
+    if (workerCount == 0U)
+    {
+        workerCount = std::max(1U, std::thread::hardware_concurrency());
+    }
+    workerCount = std::min(workerCount, states.size());
+
+    const auto wallStart = Clock::now();
+    const std::size_t chunkFrames = std::max<std::size_t>(1U, m_settings.chunkFrames);
+    std::array<std::vector<RadarRecordBatch>, 2> chunks;
+    chunks[0].resize(chunkFrames);
+    chunks[1].resize(chunkFrames);
+
+    auto decodeStart = Clock::now();
+    std::size_t filled = decodeChunk(playback, chunks[0]);
+    m_decodeMs += elapsedMs(decodeStart, Clock::now());
+    std::size_t active = 0U;
+    while (filled > 0U)
+    {
+        const auto& chunk = chunks[active];
+        std::atomic<std::size_t> nextVariant{0U};
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (std::size_t w = 0; w < workerCount; ++w)
+        {
+            workers.emplace_back([&]()
+            {
+                for (std::size_t index = nextVariant.fetch_add(1U); index < states.size();
+                     index = nextVariant.fetch_add(1U))
+                {
+                    processChunk(playback, chunk, filled, *states[index]);
+                }
+            });
+        }
+
+        // The next chunk is decoded while the workers consume this one.
+        decodeStart = Clock::now();
+        const std::size_t nextFilled = decodeChunk(playback, chunks[1U - active]);
+        m_decodeMs += elapsedMs(decodeStart, Clock::now());
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        m_decodedFrames += filled;
+        filled = nextFilled;
+        active = 1U - active;
+    }
+    m_wallMs = elapsedMs(wallStart, Clock::now());
+
+    m_results.reserve(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        SweepResult result{m_variants[i].name, states[i]->metrics};
+        result.metrics.occupiedCells = states[i]->mapping.occupiedCells().size();
+        m_results.push_back(std::move(result));
+    }
+
+    Logger::log(Logger::Level::Info,
+                "ParameterSweep decoded " + std::to_string(m_decodedFrames) + " frames once for " +
+                    std::to_string(m_variants.size()) + " variants on " + std::to_string(workerCount) +
+                    " workers");
+    return true;
+}
+
+const std::vector<SweepResult>& ParameterSweep::results() const noexcept
+{
+    return m_results;
+}
+
+std::size_t ParameterSweep::decodedFrames() const noexcept
+{
+    return m_decodedFrames;
+}
+
+double ParameterSweep::decodeMs() const noexcept
+{
+    return m_decodeMs;
+}
+
+double ParameterSweep::wallMs() const noexcept
+{
+    return m_wallMs;
+}
+
+std::string ParameterSweep::report() const
+{
+    std::ostringstream out;
+    out << std::left << std::setw(24) << "variant" << std::right << std::setw(10) << "det" << std::setw(10)
+        << "static%" << std::setw(10) << "tracks" << std::setw(10) << "odom%" << std::setw(10) << "inliers"
+        << std::setw(10) << "occupied" << std::setw(12) << "proc ms" << std::setw(12) << "map ms" << '\n';
+    for (const auto& result : m_results)
+    {
+        const SweepMetrics& metrics = result.metrics;
+        const double staticShare = metrics.detections > 0U
+                                       ? 100.0 * static_cast<double>(metrics.stationaryDetections) /
+                                             static_cast<double>(metrics.detections)
+                                       : 0.0;
+        const double odometryShare =
+            metrics.frames > 0U
+                ? 100.0 * static_cast<double>(metrics.odometryFrames) / static_cast<double>(metrics.frames)
+                : 0.0;
+        const double meanInliers = metrics.odometryFrames > 0U
+                                       ? static_cast<double>(metrics.odometryInliers) /
+                                             static_cast<double>(metrics.odometryFrames)
+                                       : 0.0;
+        out << std::left << std::setw(24) << result.name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << metrics.detections << std::setw(10) << staticShare << std::setw(10)
+            << metrics.tracks << std::setw(10) << odometryShare << std::setw(10) << meanInliers << std::setw(10)
+            << metrics.occupiedCells << std::setw(12) << metrics.processingMs << std::setw(12)
+            << metrics.mappingMs << '\n';
+    }
+    out << "decoded " << m_decodedFrames << " frames once in " << std::fixed << std::setprecision(1)
+        << m_decodeMs << " ms, sweep wall " << m_wallMs << " ms\n";
+    return out.str();
+}
+
+} // namespace radar
@@ -2,18 +2,29 @@
 
 #include "logging/Logger.hpp"
 
+#include "radar_core/frame_reorder_buffer.hpp"
+#include "radar_core/latency_analyzer.hpp"
 #include "radar_core/processing_pipeline.hpp"
+#include "radar_core/stream_generator.hpp"
+#include "utility/math_utils.hpp"
+#include "utility/radar_records.hpp"
 #include "utility/radar_types.hpp"
 #include "utility/vehicle_config.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <fstream>
-#include <limits>
+#include <future>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
 
 namespace fs = std::filesystem;
 
@@ -22,8 +33,6 @@ namespace radar
 namespace
 {
 constexpr size_t kCornerReturnCount = utility::kCornerReturnCount;
-constexpr size_t kFrontReturnCount = utility::kFrontReturnCount;
-constexpr size_t kTrackCount = utility::kTrackCount;
 constexpr float kMinTrackExtent = 0.25F;
 
 enum class StreamType
@@ -33,23 +42,138 @@ enum class StreamType
     Tracks
 };
 
+template <typename Record>
+using ReorderChannels = std::vector<std::unique_ptr<core::FrameReorderBuffer<Record>>>;
+
+using RecordSource = core::StreamGenerator<RadarRecordBatch::Record>;
+
+// Reads a capture in fixed-size blocks on a background task, one block ahead of the parser. The parser
+// consumes bytes from the front of the buffered window and, when it runs dry, co_awaits pendingRead() and
+// adopts the block with adoptBlock().
+class BlockReader
+{
+public:
+    static constexpr std::size_t kBlockSize = 256U * 1024U;
+
+    BlockReader() = default;
+    BlockReader(BlockReader&&) noexcept = default;
+    BlockReader& operator=(BlockReader&&) noexcept = default;
+
+    // Starts reading the first block. The reader and in must stay in place from here on.
+    void start(std::istream& in)
+    {
+        m_in = &in;
+        m_block.resize(kBlockSize);
+        readAhead();
+    }
+
+    const char* data() const noexcept
+    {
+        return m_window.data() + m_begin;
+    }
+
+    std::size_t available() const noexcept
+    {
+        return m_end - m_begin;
+    }
+
+    void consume(std::size_t bytes) noexcept
+    {
+        m_begin += bytes;
+    }
+
+    // True once the whole file is in the window.
+    bool finished() const noexcept
+    {
+        return m_finished;
+    }
+
+    const std::future<std::size_t>& pendingRead() const noexcept
+    {
+        return m_pending;
+    }
+
+    // Appends the block read in the background to the window and starts reading the next one.
+    void adoptBlock()
+    {
+        const std::size_t bytes = m_pending.get();
+        if (m_begin > 0U)
+        {
+            std::memmove(m_window.data(), m_window.data() + m_begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0U;
+        }
+        if (m_end + bytes > m_window.size())
+        {
+            m_window.resize(m_end + bytes);
+        }
+        std::memcpy(m_window.data() + m_end, m_block.data(), bytes);
+        m_end += bytes;
+
+        if (bytes < kBlockSize)
+        {
+            m_finished = true;
+            return;
+        }
+        readAhead();
+    }
+
+private:
+    void readAhead()
+    {
+        m_pending = std::async(std::launch::async,
+                               [in = m_in, block = m_block.data()]()
+                               {
+                                   in->read(block, static_cast<std::streamsize>(kBlockSize));
+                                   return static_cast<std::size_t>(in->gcount());
+                               });
+    }
+
+    using Bytes = std::vector<char, core::TaggedAllocator<char, core::MemoryTag::PlaybackStreams>>;
+
+    std::istream* m_in = nullptr;
+    Bytes m_window;
+    std::size_t m_begin = 0U;
+    std::size_t m_end = 0U;
+    Bytes m_block;
+    bool m_finished = false;
+    // Declared last so destruction waits for a read in flight before the block goes away.
+    std::future<std::size_t> m_pending;
+};
+
 struct StreamState
 {
     StreamType type;
     std::string label;
     fs::path path;
     std::ifstream file;
-    bool hasPending = false;
-    bool exhausted = false;
-    uint64_t timestampUs = 0U;
     uint64_t lastTimestampUs = 0U;
-    utility::SensorIndex radarIndex = utility::SensorIndex::FrontLeft;
-    utility::RawCornerDetections cornerData{};
-    utility::RawFrontDetections frontData{};
-    utility::RawTrackFusion trackData{};
-    std::vector<float> elevationRad;
+    // Playback clock (newest publish timestamp read) when the source last yielded; the record's publish
+    // timestamp without reordering.
+    uint64_t releaseClockUs = 0U;
+    bool binary = false;
+    core::ReorderSettings reorder;
+    ReorderChannels<utility::CornerDetectionsRecord> cornerChannels;
+    ReorderChannels<utility::FrontDetectionsRecord> frontChannels;
+    ReorderChannels<utility::RawTrackFusion> trackChannels;
+    // Destroyed before the file it reads.
+    BlockReader reader;
+    // Parses (and reorders) the stream's records; destroyed first.
+    RecordSource source;
+};
+
+// Stream head in the merge heap; the earliest timestamp, then the lowest stream index, is on top.
+struct MergeHead
+{
+    std::uint64_t timestampUs = 0U;
+    std::size_t stream = 0U;
 };
 
+bool mergesLater(const MergeHead& a, const MergeHead& b)
+{
+    return a.timestampUs > b.timestampUs || (a.timestampUs == b.timestampUs && a.stream > b.stream);
+}
+
 std::string toLower(std::string value)
 {
     std::transform(value.begin(), value.end(), value.begin(),
@@ -92,527 +216,406 @@ const utility::RadarCalibration& calibrationForSensor(const utility::VehiclePara
     return params.radarCalibrations.front();
 }
 
-bool readNextNonEmptyLine(std::ifstream& file, std::string& line)
+enum class ParseStatus
 {
-    while (std::getline(file, line))
-    {
-        if (!line.empty())
-        {
-            return true;
-        }
-    }
-    return false;
-}
+    Parsed,
+    // The window ends inside the next record; a block is being read.
+    NeedInput,
+    End
+};
 
-bool parseCornerLine(const std::string& line,
-                     utility::SensorIndex& radarIndex,
-                     uint64_t& timestampOut,
-                     utility::RawCornerDetections& base,
-                     std::vector<float>& elevationRad)
+// Parses the next record from the stream's buffered window: fixed-size columns for binary captures, the next
+// non-empty line that parses for text captures.
+template <typename Record>
+ParseStatus parseNextRecord(StreamState& stream, Record& record)
 {
-    std::istringstream ss(line);
-    double radarIndexRaw = 0.0;
-    double timestampOutRaw = 0.0;
-    double timestampInRaw = 0.0;
-    double horizontalFov = 0.0;
-    double maximumRange = 0.0;
-    double azimuthPolarity = 0.0;
-    double boresight = 0.0;
-    double longitudinalPos = 0.0;
-    double lateralPos = 0.0;
-
-    if (!(ss >> radarIndexRaw >> timestampOutRaw >> timestampInRaw >> horizontalFov >> maximumRange >>
-          azimuthPolarity >> boresight >> longitudinalPos >> lateralPos))
+    BlockReader& reader = stream.reader;
+    if (stream.binary)
     {
-        return false;
+        const std::size_t size = utility::binaryRecordSize<Record>();
+        if (reader.available() < size)
+        {
+            return reader.finished() ? ParseStatus::End : ParseStatus::NeedInput;
+        }
+        utility::decodeBinary(reader.data(), record);
+        reader.consume(size);
+        return ParseStatus::Parsed;
     }
 
-    radarIndex = static_cast<utility::SensorIndex>(static_cast<int>(radarIndexRaw));
-    timestampOut = static_cast<uint64_t>(timestampOutRaw);
-    base.sensor = radarIndex;
-    base.header.timestamp_us = static_cast<uint64_t>(timestampInRaw);
-    base.header.horizontalFov_rad = static_cast<float>(horizontalFov);
-    base.header.maximumRange_m = static_cast<float>(maximumRange);
-    base.header.azimuthPolarity = static_cast<float>(azimuthPolarity);
-    base.header.boresightAngle_rad = static_cast<float>(boresight);
-    base.header.sensorLongitudinal_m = static_cast<float>(longitudinalPos);
-    base.header.sensorLateral_m = static_cast<float>(lateralPos);
-
-    for (size_t i = 0; i < kCornerReturnCount; ++i)
+    while (true)
     {
-        double value = 0.0;
-        if (!(ss >> value))
+        const std::size_t available = reader.available();
+        const auto* newline = static_cast<const char*>(std::memchr(reader.data(), '\n', available));
+        std::size_t length = available;
+        if (newline)
         {
-            return false;
-        }
-        base.range_m[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.rangeRate_ms[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.rangeRateRaw_ms[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.azimuthRaw_rad[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.azimuth_rad[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.amplitude_dBsm[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.longitudinalOffset_m[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.lateralOffset_m[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.motionStatus[i] = static_cast<int8_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
+            length = static_cast<std::size_t>(newline - reader.data());
         }
-        base.radarValidReturn[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+        else if (!reader.finished())
         {
-            return false;
+            return ParseStatus::NeedInput;
         }
-        base.superResolutionDetection[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+        else if (available == 0U)
         {
-            return false;
+            return ParseStatus::End;
         }
-        base.nearTargetDetection[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.hostVehicleClutter[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+
+        const std::string_view line(reader.data(), length);
+        reader.consume(newline ? length + 1U : length);
+        if (!line.empty() && utility::parseText(line, record))
         {
-            return false;
+            return ParseStatus::Parsed;
         }
-        base.multibounceDetection[i] = static_cast<uint8_t>(value);
     }
+}
 
-    double lookType = 0.0;
-    double scanType = 0.0;
-    double lookIndex = 0.0;
-    ss >> lookType >> scanType >> lookIndex;
-    static_cast<void>(lookType);
-    static_cast<void>(scanType);
-    static_cast<void>(lookIndex);
+std::uint64_t captureTimestamp(const utility::CornerDetectionsRecord& record)
+{
+    return record.detections.header.timestamp_us;
+}
 
-    elevationRad.assign(kCornerReturnCount, 0.0F);
-    for (size_t i = 0; i < kCornerReturnCount; ++i)
-    {
-        double value = 0.0;
-        if (!(ss >> value))
-        {
-            break;
-        }
-        elevationRad[i] = static_cast<float>(value);
-    }
+std::uint64_t captureTimestamp(const utility::FrontDetectionsRecord& record)
+{
+    return record.detections.header.timestamp_us;
+}
 
-    return true;
+std::uint64_t captureTimestamp(const utility::RawTrackFusion& record)
+{
+    return record.timestamp_us;
 }
 
-bool parseFrontLine(const std::string& line,
-                    uint64_t& timestampOut,
-                    utility::RawFrontDetections& base,
-                    std::vector<float>& elevationRad)
+std::uint64_t arrivalTimestamp(const utility::CornerDetectionsRecord& record)
 {
-    std::istringstream ss(line);
-    double radarIndexRaw = 0.0;
-    double timestampOutRaw = 0.0;
-    double timestampInRaw = 0.0;
-    double horizontalFov = 0.0;
-    double maximumRange = 0.0;
-    double azimuthPolarity = 0.0;
-    double boresight = 0.0;
-    double longitudinalPos = 0.0;
-    double lateralPos = 0.0;
+    return record.publishTimestamp_us;
+}
 
-    if (!(ss >> radarIndexRaw >> timestampOutRaw >> timestampInRaw >> horizontalFov >> maximumRange >>
-          azimuthPolarity >> boresight >> longitudinalPos >> lateralPos))
-    {
-        return false;
-    }
+std::uint64_t arrivalTimestamp(const utility::FrontDetectionsRecord& record)
+{
+    return record.publishTimestamp_us;
+}
 
-    timestampOut = static_cast<uint64_t>(timestampOutRaw);
-    base.header.timestamp_us = static_cast<uint64_t>(timestampInRaw);
-    static_cast<void>(radarIndexRaw);
-    base.header.horizontalFov_rad = static_cast<float>(horizontalFov);
-    base.header.maximumRange_m = static_cast<float>(maximumRange);
-    base.header.azimuthPolarity = static_cast<float>(azimuthPolarity);
-    base.header.boresightAngle_rad = static_cast<float>(boresight);
-    base.header.sensorLongitudinal_m = static_cast<float>(longitudinalPos);
-    base.header.sensorLateral_m = static_cast<float>(lateralPos);
+std::uint64_t arrivalTimestamp(const utility::RawTrackFusion& record)
+{
+    return record.timestamp_us;
+}
 
-    for (size_t i = 0; i < kFrontReturnCount; ++i)
+std::size_t reorderChannel(const utility::CornerDetectionsRecord& record)
+{
+    const auto index = static_cast<std::size_t>(record.detections.sensor);
+    return index < static_cast<std::size_t>(utility::SensorIndex::Count) ? index : 0U;
+}
+
+template <typename Record>
+std::size_t reorderChannel(const Record&)
+{
+    return 0U;
+}
+
+// Merge timestamp of a record: when it was published.
+std::uint64_t mergeTimestamp(const RadarRecordBatch::Record& record)
+{
+    return std::visit([](const auto& typed) { return arrivalTimestamp(typed); }, record);
+}
+
+// Coroutine yielding a stream's records in file order. With reordering, records are fed into per-sensor
+// jitter buffers, using the newest publish timestamp read so far as the clock, and yielded as frames come due;
+// at end of input the buffers are drained in timestamp order. Suspends on the block read whenever the
+// buffered window runs out, so the scheduler can parse other streams meanwhile.
+template <typename Record>
+RecordSource recordSource(StreamState& stream, ReorderChannels<Record>& channels)
+{
+    using Buffer = core::FrameReorderBuffer<Record>;
+    RadarRecordBatch::Record slot{std::in_place_type<Record>};
+    Record& record = std::get<Record>(slot);
+    const bool reorder = stream.reorder.maxLatency_us > 0U;
+    std::uint64_t newestArrivalUs = 0U;
+    bool inputDrained = false;
+
+    while (true)
     {
-        double value = 0.0;
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.range_m[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.rangeRate_ms[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.rangeRateRaw_ms[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.azimuthRaw_rad[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.azimuth_rad[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.amplitude_dBsm[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.longitudinalOffset_m[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.lateralOffset_m[i] = static_cast<float>(value);
-        if (!(ss >> value))
+        if (reorder)
         {
-            return false;
+            const std::uint64_t now = inputDrained ? Buffer::kFlush : newestArrivalUs;
+            Buffer* due = nullptr;
+            for (auto& channel : channels)
+            {
+                if (channel && channel->releasable(now) &&
+                    (!due || channel->headTimestamp() < due->headTimestamp()))
+                {
+                    due = channel.get();
+                }
+            }
+            if (due)
+            {
+                due->release(now, record);
+                stream.releaseClockUs = std::max(newestArrivalUs, arrivalTimestamp(record));
+                co_yield slot;
+                continue;
+            }
+            if (inputDrained)
+            {
+                co_return;
+            }
         }
-        base.motionStatus[i] = static_cast<int8_t>(value);
-        if (!(ss >> value))
+
+        const ParseStatus status = parseNextRecord(stream, record);
+        if (status == ParseStatus::NeedInput)
         {
-            return false;
+            co_await stream.reader.pendingRead();
+            stream.reader.adoptBlock();
+            continue;
         }
-        base.radarValidReturn[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+        if (status == ParseStatus::End)
         {
-            return false;
+            if (!reorder)
+            {
+                co_return;
+            }
+            inputDrained = true;
+            continue;
         }
-        base.superResolutionDetection[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+        if (!reorder)
         {
-            return false;
+            stream.releaseClockUs = arrivalTimestamp(record);
+            co_yield slot;
+            continue;
         }
-        base.nearTargetDetection[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+
+        newestArrivalUs = std::max(newestArrivalUs, arrivalTimestamp(record));
+        const std::size_t index = reorderChannel(record);
+        if (index >= channels.size())
         {
-            return false;
+            channels.resize(index + 1U);
         }
-        base.hostVehicleClutter[i] = static_cast<uint8_t>(value);
-        if (!(ss >> value))
+        if (!channels[index])
         {
-            return false;
+            channels[index] = std::make_unique<Buffer>(stream.reorder);
         }
-        base.multibounceDetection[i] = static_cast<uint8_t>(value);
+        channels[index]->push(captureTimestamp(record), record);
     }
+}
 
-    double lookType = 0.0;
-    double scanType = 0.0;
-    double lookIndex = 0.0;
-    ss >> lookType >> scanType >> lookIndex;
-    static_cast<void>(lookType);
-    static_cast<void>(scanType);
-    static_cast<void>(lookIndex);
+// The one place that maps a stream type to its record type.
+RecordSource makeRecordSource(StreamState& stream)
+{
+    switch (stream.type)
+    {
+        case StreamType::FrontDetections:
+            return recordSource(stream, stream.frontChannels);
+        case StreamType::Tracks:
+            return recordSource(stream, stream.trackChannels);
+        default:
+            return recordSource(stream, stream.cornerChannels);
+    }
+}
 
-    elevationRad.assign(kFrontReturnCount, 0.0F);
-    for (size_t i = 0; i < kFrontReturnCount; ++i)
+template <typename Record>
+void collectReorderStatistics(const StreamState& stream,
+                              const ReorderChannels<Record>& channels,
+                              std::vector<SensorReorderStatistics>& out)
+{
+    for (std::size_t i = 0; i < channels.size(); ++i)
     {
-        double value = 0.0;
-        if (!(ss >> value))
+        if (!channels[i])
+        {
+            continue;
+        }
+        SensorReorderStatistics entry;
+        entry.source = stream.label;
+        if (stream.type == StreamType::CornerDetections)
         {
-            break;
+            entry.source += ":" + radarIndexLabel(static_cast<utility::SensorIndex>(i));
         }
-        elevationRad[i] = static_cast<float>(value);
+        entry.statistics = channels[i]->statistics();
+        out.push_back(entry);
     }
-
-    return true;
 }
 
-bool parseTrackLine(const std::string& line,
-                    uint64_t& timestampOut,
-                    utility::RawTrackFusion& base)
+template <typename Record>
+std::size_t bufferedFrames(const ReorderChannels<Record>& channels)
 {
-    std::istringstream ss(line);
-    double currentTime = 0.0;
-    double visionTimestamp = 0.0;
-    double fusionTimestamp = 0.0;
-    double fusionIndex = 0.0;
-    double imageFrameIndex = 0.0;
+    std::size_t frames = 0U;
+    for (const auto& channel : channels)
+    {
+        frames += channel ? channel->size() : 0U;
+    }
+    return frames;
+}
 
-    if (!(ss >> currentTime >> visionTimestamp >> fusionTimestamp >> fusionIndex >> imageFrameIndex))
+bool binaryStreamType(const utility::BinaryStreamHeader& header, StreamType& type)
+{
+    if (header.version != utility::kBinaryStreamVersion)
     {
         return false;
     }
 
-    timestampOut = static_cast<uint64_t>(currentTime);
-    base.timestamp_us = timestampOut;
-    base.visionTimestamp = static_cast<uint64_t>(visionTimestamp);
-    base.fusionTimestamp = static_cast<uint64_t>(fusionTimestamp);
-    base.fusionIndex = static_cast<uint32_t>(fusionIndex);
-    base.imageFrameIndex = static_cast<uint32_t>(imageFrameIndex);
-
-    for (size_t i = 0; i < kTrackCount; ++i)
+    switch (static_cast<utility::RecordTag>(header.recordTag))
     {
-        double value = 0.0;
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsLongitudinalPosition[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsLateralPosition[i] = static_cast<float>(value);
-
-        for (int skip = 0; skip < 2; ++skip)
-        {
-            if (!(ss >> value))
-            {
-                return false;
-            }
-        }
-
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.length[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.width[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.height[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.probabilityOfDetection[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.id[i] = static_cast<int32_t>(value);
-
-        for (int skip = 0; skip < 8; ++skip)
-        {
-            if (!(ss >> value))
-            {
-                return false;
-            }
-        }
-
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.movingFlag[i] = static_cast<std::uint8_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.stationaryFlag[i] = static_cast<std::uint8_t>(value);
-        if (!(ss >> value))
-        {
+        case utility::RecordTag::CornerDetections:
+            type = StreamType::CornerDetections;
+            return header.recordSize == utility::binaryRecordSize<utility::CornerDetectionsRecord>();
+        case utility::RecordTag::FrontDetections:
+            type = StreamType::FrontDetections;
+            return header.recordSize == utility::binaryRecordSize<utility::FrontDetectionsRecord>();
+        case utility::RecordTag::TrackFusion:
+            type = StreamType::Tracks;
+            return header.recordSize == utility::binaryRecordSize<utility::RawTrackFusion>();
+        default:
             return false;
-        }
-        base.moveableFlag[i] = static_cast<std::uint8_t>(value);
+    }
+}
 
-        for (int skip = 0; skip < 5; ++skip)
-        {
-            if (!(ss >> value))
-            {
-                return false;
-            }
-        }
+// Latency sources: one per corner radar, then the front radar. Tracks carry no separate capture time.
+constexpr std::size_t kCornerLatencySources = 4U;
+constexpr std::size_t kLatencySourceCount = kCornerLatencySources + 1U;
 
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vehicleFlag[i] = static_cast<std::uint8_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.status[i] = static_cast<std::uint8_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.objectClassification[i] = static_cast<std::uint16_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.objectClassificationConfidence[i] = static_cast<std::uint8_t>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsLateralVelocity[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsLongitudinalVelocity[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsLateralAcceleration[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsLongitudinalAcceleration[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsHeading[i] = static_cast<float>(value);
-        if (!(ss >> value))
-        {
-            return false;
-        }
-        base.vcsHeadingRate[i] = static_cast<float>(value);
+std::size_t latencySource(const RadarRecordBatch::Record& record)
+{
+    if (const auto* corner = std::get_if<utility::CornerDetectionsRecord>(&record))
+    {
+        const auto index = static_cast<std::size_t>(corner->detections.sensor);
+        return index < kCornerLatencySources ? index : kLatencySourceCount;
     }
+    return std::holds_alternative<utility::FrontDetectionsRecord>(record) ? kCornerLatencySources
+                                                                          : kLatencySourceCount;
+}
 
-    return true;
+std::string streamLabel(StreamType type)
+{
+    switch (type)
+    {
+        case StreamType::Tracks:
+            return "tracks";
+        case StreamType::FrontDetections:
+            return "front";
+        default:
+            return "corner";
+    }
 }
 
-void appendEnhancedDetections(const utility::EnhancedDetections& data,
-                              const utility::RadarCalibration& radarCal,
-                              int sensorIndex,
-                              const std::vector<float>& elevationRad,
-                              radar::BaseRadarSensor::PointCloud& outPoints)
+StreamType streamTypeFromName(const std::string& file)
 {
-    for (size_t i = 0; i < data.detections.size(); ++i)
+    const std::string lowerName = toLower(file);
+    if (lowerName.find("track") != std::string::npos)
     {
-        const auto& det = data.detections[i];
-        if (det.flags == 0U &&
-            det.range_m <= 0.0F &&
-            det.longitudinalOffset_m == 0.0F &&
-            det.lateralOffset_m == 0.0F)
-        {
-            continue;
-        }
+        return StreamType::Tracks;
+    }
+    if (lowerName.find("front") != std::string::npos)
+    {
+        return StreamType::FrontDetections;
+    }
+    return StreamType::CornerDetections;
+}
 
-        float detAngle = det.azimuth_rad;
-        if (detAngle == 0.0F && det.azimuthRaw_rad != 0.0F)
-        {
-            const float azimuthPolarity = data.header.azimuthPolarity == 0.0F ? 1.0F : data.header.azimuthPolarity;
-            detAngle = data.header.boresightAngle_rad + azimuthPolarity * det.azimuthRaw_rad;
-        }
+// Result of opening one input on a startup task; the error is logged by initialize() on its own thread.
+struct OpenedStream
+{
+    StreamState stream;
+    std::string error;
+};
 
-        float lateral = det.lateralOffset_m;
-        float longitudinal = det.longitudinalOffset_m;
-        if (lateral == 0.0F && longitudinal == 0.0F && det.range_m > 0.0F)
-        {
-            lateral = det.range_m * std::sin(detAngle);
-            longitudinal = det.range_m * std::cos(detAngle);
-        }
+OpenedStream openStream(fs::path path, StreamType type)
+{
+    OpenedStream opened;
+    StreamState& stream = opened.stream;
+    stream.path = std::move(path);
+    stream.file.open(stream.path, std::ios::in | std::ios::binary);
+    if (!stream.file)
+    {
+        opened.error = "Failed to open radar input file: " + stream.path.string();
+        return opened;
+    }
 
-        if (!std::isfinite(lateral) || !std::isfinite(longitudinal))
+    // Binary captures name their record type in the stream header; text captures go by file name.
+    utility::BinaryStreamHeader header;
+    if (utility::readBinaryStreamHeader(stream.file, header))
+    {
+        if (!binaryStreamType(header, type))
         {
-            continue;
+            opened.error = "Unsupported binary radar capture layout: " + stream.path.string();
+            return opened;
         }
+        stream.binary = true;
+    }
+    stream.type = type;
+    stream.label = streamLabel(type);
+    return opened;
+}
 
-        float elevationRadValue = 0.0F;
-        if (i < elevationRad.size())
-        {
-            elevationRadValue = elevationRad[i];
-        }
+// Converts one processed return straight into the output cloud. Padding returns are filtered by the pipeline's
+// fused pass, so only the non-finite check remains here.
+void appendDetection(const utility::EnhancedDetection& det,
+                     const utility::RawDetectionsHeader& header,
+                     const utility::RadarCalibration& radarCal,
+                     int sensorIndex,
+                     float elevationRadValue,
+                     radar::BaseRadarSensor::PointCloud& outPoints)
+{
+    float detAngle = det.azimuth_rad;
+    if (detAngle == 0.0F && det.azimuthRaw_rad != 0.0F)
+    {
+        const float azimuthPolarity = header.azimuthPolarity == 0.0F ? 1.0F : header.azimuthPolarity;
+        detAngle = header.boresightAngle_rad + azimuthPolarity * det.azimuthRaw_rad;
+    }
 
-        float z = det.elevationRaw_m;
-        if (z == 0.0F && elevationRadValue != 0.0F)
-        {
-            z = radarCal.vcs.height_m + det.range_m * std::sin(elevationRadValue);
-        }
+    float lateral = det.lateralOffset_m;
+    float longitudinal = det.longitudinalOffset_m;
+    if (lateral == 0.0F && longitudinal == 0.0F && det.range_m > 0.0F)
+    {
+        lateral = det.range_m * std::sin(detAngle);
+        longitudinal = det.range_m * std::cos(detAngle);
+    }
 
-        RadarPoint point{};
-        point.x = lateral;
-        point.y = longitudinal;
-        point.z = z;
-        point.intensity = 1.0F;
-        point.range_m = det.range_m;
-        point.rangeRate_ms = det.rangeRate_ms;
-        point.rangeRateRaw_ms = det.rangeRateRaw_ms;
-        point.azimuthRaw_rad = det.azimuthRaw_rad;
-        point.azimuth_rad = det.azimuth_rad;
-        point.amplitude_dBsm = det.amplitude_dBsm;
-        point.longitudinalOffset_m = det.longitudinalOffset_m;
-        point.lateralOffset_m = det.lateralOffset_m;
-        point.motionStatus = det.motionStatus;
-        point.fusedTrackIndex = det.fusedTrackIndex;
-        point.isStationary = det.isStationary;
-        point.isMoveable = det.isMoveable;
-        point.isStatic = det.isStatic;
-        point.stationaryProbability = det.stationaryProbability;
-        point.sensorIndex = sensorIndex;
-        point.horizontalFov_rad = data.header.horizontalFov_rad;
-        point.maximumRange_m = data.header.maximumRange_m;
-        point.azimuthPolarity = data.header.azimuthPolarity;
-        point.boresightAngle_rad = data.header.boresightAngle_rad;
-        point.sensorLongitudinal_m = data.header.sensorLongitudinal_m;
-        point.sensorLateral_m = data.header.sensorLateral_m;
-        point.elevationRaw_rad = elevationRadValue;
-
-        const std::uint8_t typeMask = det.flags;
-        point.radarValid = static_cast<std::uint8_t>(
-            (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::Valid)) != 0U);
-        point.superResolution = static_cast<std::uint8_t>(
-            (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::SuperResolution)) != 0U);
-        point.nearTarget = static_cast<std::uint8_t>(
-            (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::NearTarget)) != 0U);
-        point.hostVehicleClutter = static_cast<std::uint8_t>(
-            (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::HostVehicleClutter)) != 0U);
-        point.multibounce = static_cast<std::uint8_t>(
-            (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::MultiBounce)) != 0U);
-
-        outPoints.push_back(point);
+    if (!std::isfinite(lateral) || !std::isfinite(longitudinal))
+    {
+        return;
+    }
+
+    float z = det.elevationRaw_m;
+    if (z == 0.0F && elevationRadValue != 0.0F)
+    {
+        z = radarCal.vcs.height_m + det.range_m * std::sin(elevationRadValue);
     }
+
+    RadarPoint& point = outPoints.emplace_back();
+    point.x = lateral;
+    point.y = longitudinal;
+    point.z = z;
+    point.intensity = 1.0F;
+    point.range_m = det.range_m;
+    point.rangeRate_ms = det.rangeRate_ms;
+    point.rangeRateRaw_ms = det.rangeRateRaw_ms;
+    point.azimuthRaw_rad = det.azimuthRaw_rad;
+    point.azimuth_rad = det.azimuth_rad;
+    point.amplitude_dBsm = det.amplitude_dBsm;
+    point.longitudinalOffset_m = det.longitudinalOffset_m;
+    point.lateralOffset_m = det.lateralOffset_m;
+    point.motionStatus = det.motionStatus;
+    point.fusedTrackIndex = det.fusedTrackIndex;
+    point.isStationary = det.isStationary;
+    point.isMoveable = det.isMoveable;
+    point.isStatic = det.isStatic;
+    point.stationaryProbability = det.stationaryProbability;
+    point.sensorIndex = sensorIndex;
+    point.horizontalFov_rad = header.horizontalFov_rad;
+    point.maximumRange_m = header.maximumRange_m;
+    point.azimuthPolarity = header.azimuthPolarity;
+    point.boresightAngle_rad = header.boresightAngle_rad;
+    point.sensorLongitudinal_m = header.sensorLongitudinal_m;
+    point.sensorLateral_m = header.sensorLateral_m;
+    point.elevationRaw_rad = elevationRadValue;
+
+    const std::uint8_t typeMask = det.flags;
+    point.radarValid = static_cast<std::uint8_t>(
+        (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::Valid)) != 0U);
+    point.superResolution = static_cast<std::uint8_t>(
+        (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::SuperResolution)) != 0U);
+    point.nearTarget = static_cast<std::uint8_t>(
+        (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::NearTarget)) != 0U);
+    point.hostVehicleClutter = static_cast<std::uint8_t>(
+        (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::HostVehicleClutter)) != 0U);
+    point.multibounce = static_cast<std::uint8_t>(
+        (typeMask & static_cast<std::uint8_t>(utility::DetectionFlag::MultiBounce)) != 0U);
 }
 
 void appendTracks(const utility::EnhancedTracks& data,
@@ -675,6 +678,7 @@ struct RadarPlayback::Impl
 {
     explicit Impl(Settings settings)
         : settings(std::move(settings))
+        , processingSettings(this->settings.processingSettings)
     {
     }
 
@@ -685,8 +689,69 @@ struct RadarPlayback::Impl
     const utility::VehicleParameters* vehicleParameters = nullptr;
     std::vector<glm::vec2> contour;
     radar::core::RadarProcessingPipeline pipeline;
-    std::vector<StreamState> streams;
+    radar::core::SettingsReader<radar::core::ProcessingSettings> processingSettings;
+    std::unique_ptr<radar::core::StageProfiler> profiler;
+    std::unique_ptr<radar::core::LatencyAnalyzer> latency;
+    std::array<std::size_t, kLatencySourceCount> latencySources{};
+    // Each stream holds full record copies (RawTrackFusion is ~10 KB), so they are accounted separately.
+    std::vector<StreamState, radar::core::TaggedAllocator<StreamState, radar::core::MemoryTag::PlaybackStreams>>
+        streams;
+    // Reused between readNextFrame() calls so the record storage is allocated once.
+    RadarRecordBatch batch;
+    // Release clock of each record in the batch last returned by readNextRecords().
+    std::vector<std::uint64_t> batchReleaseUs;
+    // Min-heap of the streams' next records, and the streams whose next record is still to be parsed.
+    std::vector<MergeHead> heads;
+    std::vector<std::size_t> refill;
     bool initialized = false;
+    std::chrono::steady_clock::time_point initializeStart;
+    std::uint64_t timeToFirstFrameUs = 0U;
+
+    // Resumes the sources of every stream in refill until each has yielded its next record or ended. Streams
+    // are interleaved on this thread: one whose block read is still in flight is skipped while the others
+    // parse, and the thread only waits when every remaining stream is waiting for its read.
+    void refillHeads()
+    {
+        const bool reorder = settings.reorderLatencyUs > 0U;
+        while (!refill.empty())
+        {
+            bool progressed = false;
+            for (std::size_t i = 0; i < refill.size();)
+            {
+                StreamState& stream = streams[refill[i]];
+                if (!stream.source.ready())
+                {
+                    ++i;
+                    continue;
+                }
+                progressed = true;
+                const auto state = stream.source.resume();
+                if (state == RecordSource::State::Waiting)
+                {
+                    ++i;
+                    continue;
+                }
+                if (state == RecordSource::State::Yielded)
+                {
+                    const std::uint64_t timestampUs = mergeTimestamp(stream.source.value());
+                    // Released frames are in sensor-timestamp order; their publish times may still interleave.
+                    if (!reorder && stream.lastTimestampUs > 0U && timestampUs < stream.lastTimestampUs)
+                    {
+                        Logger::log(Logger::Level::Warning, "Non-monotonic timestamp in " + stream.path.string());
+                    }
+                    stream.lastTimestampUs = timestampUs;
+                    heads.push_back({timestampUs, refill[i]});
+                    std::push_heap(heads.begin(), heads.end(), mergesLater);
+                }
+                refill[i] = refill.back();
+                refill.pop_back();
+            }
+            if (!progressed)
+            {
+                streams[refill.front()].source.wait();
+            }
+        }
+    }
 };
 
 RadarPlayback::RadarPlayback(Settings settings)
@@ -694,7 +759,33 @@ RadarPlayback::RadarPlayback(Settings settings)
 {
 }
 
-RadarPlayback::~RadarPlayback() = default;
+RadarPlayback::~RadarPlayback()
+{
+    if (m_impl && m_impl->profiler)
+    {
+        Logger::log(Logger::Level::Info, "RadarPlayback stage profile:\n" + m_impl->profiler->report());
+    }
+
+    if (m_impl && m_impl->latency)
+    {
+        Logger::log(Logger::Level::Info, "RadarPlayback sensor latency:\n" + m_impl->latency->report());
+    }
+
+    if (m_impl && m_impl->settings.reorderLatencyUs > 0U)
+    {
+        std::ostringstream oss;
+        oss << "RadarPlayback reorder statistics:";
+        for (const auto& entry : reorderStatistics())
+        {
+            const auto& stats = entry.statistics;
+            oss << "\n  " << entry.source << ": received " << stats.received << ", released " << stats.released
+                << ", reordered " << stats.reordered << ", late " << stats.late << ", duplicates " << stats.duplicates
+                << ", forced " << stats.forcedReleases << ", overflows " << stats.overflows << ", max jitter "
+                << stats.maxJitter_us << " us";
+        }
+        Logger::log(Logger::Level::Info, oss.str());
+    }
+}
 
 RadarPlayback::RadarPlayback(RadarPlayback&&) noexcept = default;
 
@@ -707,12 +798,28 @@ bool RadarPlayback::initialize()
         return m_impl && m_impl->initialized;
     }
 
+    m_impl->initializeStart = std::chrono::steady_clock::now();
+    m_impl->timeToFirstFrameUs = 0U;
     m_impl->dataRoot = m_impl->settings.dataRoot;
     if (m_impl->dataRoot.empty())
     {
         m_impl->dataRoot = fs::current_path() / "data";
     }
 
+    // Inputs are opened and their headers validated on their own tasks while the vehicle configuration is
+    // parsed here; results are collected in input order so the merge order does not depend on scheduling.
+    std::vector<std::future<OpenedStream>> opening;
+    opening.reserve(m_impl->settings.inputFiles.size());
+    for (const auto& file : m_impl->settings.inputFiles)
+    {
+        fs::path path(file);
+        if (!path.is_absolute())
+        {
+            path = m_impl->dataRoot / file;
+        }
+        opening.push_back(std::async(std::launch::async, openStream, std::move(path), streamTypeFromName(file)));
+    }
+
     m_impl->vehicleConfigPath = m_impl->settings.vehicleConfigPath;
     if (m_impl->vehicleConfigPath.empty())
     {
@@ -740,39 +847,51 @@ bool RadarPlayback::initialize()
     m_impl->vehicleParameters = &m_impl->vehicleConfig.parameters();
     m_impl->contour = m_impl->vehicleParameters->contourIso;
     m_impl->pipeline.initialize(m_impl->vehicleParameters);
-
-    for (const auto& file : m_impl->settings.inputFiles)
+    if (m_impl->settings.enableStageProfiling)
+    {
+        m_impl->profiler = std::make_unique<radar::core::StageProfiler>();
+        m_impl->pipeline.setProfiler(m_impl->profiler.get());
+        Logger::log(Logger::Level::Info,
+                    m_impl->profiler->hardwareCountersAvailable()
+                        ? "Stage profiling enabled with hardware counters"
+                        : "Stage profiling enabled (hardware counters unavailable, wall time only)");
+    }
+    if (m_impl->settings.enableLatencyAnalysis)
     {
-        const std::string lowerName = toLower(file);
-        StreamType type = StreamType::CornerDetections;
-        std::string label = "corner";
-        if (lowerName.find("track") != std::string::npos)
+        m_impl->latency = std::make_unique<radar::core::LatencyAnalyzer>(m_impl->settings.latencyBudget);
+        const std::uint64_t cornerDelayUs =
+            utility::secondsToMicroseconds(m_impl->vehicleParameters->cornerHardwareDelay_s);
+        for (std::size_t i = 0; i < kCornerLatencySources; ++i)
         {
-            type = StreamType::Tracks;
-            label = "tracks";
+            m_impl->latencySources[i] = m_impl->latency->addSource(
+                "corner:" + radarIndexLabel(static_cast<utility::SensorIndex>(i)), cornerDelayUs);
         }
-        else if (lowerName.find("front") != std::string::npos)
+        m_impl->latencySources[kCornerLatencySources] = m_impl->latency->addSource(
+            "front", utility::secondsToMicroseconds(m_impl->vehicleParameters->frontCenterHardwareDelay_s));
+    }
+
+    for (auto& pending : opening)
+    {
+        OpenedStream opened = pending.get();
+        if (!opened.error.empty())
         {
-            type = StreamType::FrontDetections;
-            label = "front";
+            Logger::log(Logger::Level::Error, opened.error);
+            continue;
         }
 
-        fs::path path(file);
-        if (!path.is_absolute())
+        StreamState& stream = opened.stream;
+        stream.reorder.maxLatency_us = m_impl->settings.reorderLatencyUs;
+        stream.reorder.capacity = m_impl->settings.reorderCapacity;
+        stream.reorder.hugePages = m_impl->settings.reorderHugePages;
+        if (stream.type == StreamType::CornerDetections)
         {
-            path = m_impl->dataRoot / file;
+            stream.reorder.hardwareDelay_us =
+                utility::secondsToMicroseconds(m_impl->vehicleParameters->cornerHardwareDelay_s);
         }
-
-        StreamState stream{};
-        stream.type = type;
-        stream.label = label;
-        stream.path = path;
-        stream.file.open(path, std::ios::in);
-        if (!stream.file)
+        else if (stream.type == StreamType::FrontDetections)
         {
-            Logger::log(Logger::Level::Error,
-                        "Failed to open radar input file: " + path.string());
-            continue;
+            stream.reorder.hardwareDelay_us =
+                utility::secondsToMicroseconds(m_impl->vehicleParameters->frontCenterHardwareDelay_s);
         }
         m_impl->streams.push_back(std::move(stream));
     }
@@ -781,8 +900,26 @@ bool RadarPlayback::initialize()
     if (!m_impl->initialized)
     {
         Logger::log(Logger::Level::Error, "RadarPlayback has no valid input files.");
+        return false;
+    }
+
+    // Every stream starts reading its first block in the background; initialize() returns once the streams are
+    // open and the first readNextRecords() parses each stream as soon as its block arrives. The vector is
+    // complete, so the readers' and sources' stream references stay valid.
+    for (std::size_t i = 0; i < m_impl->streams.size(); ++i)
+    {
+        StreamState& stream = m_impl->streams[i];
+        stream.reader.start(stream.file);
+        stream.source = makeRecordSource(stream);
+        m_impl->refill.push_back(i);
     }
-    return m_impl->initialized;
+
+    const auto openedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                m_impl->initializeStart);
+    Logger::log(Logger::Level::Info,
+                "RadarPlayback opened " + std::to_string(m_impl->streams.size()) + " streams in " +
+                    std::to_string(openedUs.count()) + " us");
+    return true;
 }
 
 bool RadarPlayback::readNextFrame(RadarFrame& frame)
@@ -793,137 +930,161 @@ bool RadarPlayback::readNextFrame(RadarFrame& frame)
     }
 
     frame = RadarFrame{};
-
-    for (auto& stream : m_impl->streams)
+    if (m_impl->processingSettings.refresh())
     {
-        if (stream.exhausted || stream.hasPending)
-        {
-            continue;
-        }
+        m_impl->pipeline.applySettings(m_impl->processingSettings.settings());
+        Logger::log(Logger::Level::Info,
+                    "Processing settings v" + std::to_string(m_impl->processingSettings.adoptedVersion()) +
+                        " applied");
+    }
 
-        std::string line;
-        while (readNextNonEmptyLine(stream.file, line))
-        {
-            bool parsed = false;
-            if (stream.type == StreamType::CornerDetections)
-            {
-                stream.elevationRad.clear();
-                parsed = parseCornerLine(line,
-                                         stream.radarIndex,
-                                         stream.timestampUs,
-                                         stream.cornerData,
-                                         stream.elevationRad);
-            }
-            else if (stream.type == StreamType::FrontDetections)
-            {
-                stream.elevationRad.clear();
-                parsed = parseFrontLine(line, stream.timestampUs, stream.frontData, stream.elevationRad);
-            }
-            else
+    if (!readNextRecords(m_impl->batch))
+    {
+        return false;
+    }
+    const auto processStart = std::chrono::steady_clock::now();
+    processRecords(m_impl->batch, m_impl->pipeline, frame);
+    if (m_impl->latency)
+    {
+        // A record is processed once it has been released (on the playback clock) and the batch has run.
+        const auto processingUs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - processStart)
+                .count());
+        const auto& records = m_impl->batch.records;
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            const std::size_t source = latencySource(records[i]);
+            if (source >= kLatencySourceCount)
             {
-                parsed = parseTrackLine(line, stream.timestampUs, stream.trackData);
+                continue;
             }
-
-            if (parsed)
+            const std::size_t index = m_impl->latencySources[source];
+            if (m_impl->latency->record(index,
+                                        std::visit([](const auto& record) { return captureTimestamp(record); },
+                                                   records[i]),
+                                        mergeTimestamp(records[i]),
+                                        m_impl->batchReleaseUs[i] + processingUs))
             {
-                if (stream.lastTimestampUs > 0U && stream.timestampUs < stream.lastTimestampUs)
-                {
-                    Logger::log(Logger::Level::Warning,
-                                "Non-monotonic timestamp in " + stream.path.string());
-                }
-                stream.lastTimestampUs = stream.timestampUs;
-                stream.hasPending = true;
-                break;
+                Logger::log(Logger::Level::Warning,
+                            "RadarPlayback latency over budget for " + m_impl->latency->sources()[index].name);
             }
         }
-
-        if (!stream.hasPending && stream.file.eof())
-        {
-            stream.exhausted = true;
-        }
     }
+    return true;
+}
 
-    uint64_t earliestTimestamp = std::numeric_limits<uint64_t>::max();
-    for (const auto& stream : m_impl->streams)
+bool RadarPlayback::readNextRecords(RadarRecordBatch& batch)
+{
+    batch.records.clear();
+    if (m_impl)
     {
-        if (stream.hasPending)
-        {
-            earliestTimestamp = std::min(earliestTimestamp, stream.timestampUs);
-        }
+        m_impl->batchReleaseUs.clear();
+    }
+    if (!m_impl || !m_impl->initialized)
+    {
+        return false;
     }
 
-    if (earliestTimestamp == std::numeric_limits<uint64_t>::max())
+    m_impl->refillHeads();
+    auto& heads = m_impl->heads;
+    if (heads.empty())
     {
         return false;
     }
 
-    frame.timestampUs = earliestTimestamp;
+    // Every stream whose next record carries the earliest timestamp contributes it, in stream order.
+    batch.timestampUs = heads.front().timestampUs;
+    while (!heads.empty() && heads.front().timestampUs == batch.timestampUs)
+    {
+        std::pop_heap(heads.begin(), heads.end(), mergesLater);
+        const std::size_t index = heads.back().stream;
+        heads.pop_back();
+        batch.records.push_back(m_impl->streams[index].source.value());
+        m_impl->batchReleaseUs.push_back(m_impl->streams[index].releaseClockUs);
+        m_impl->refill.push_back(index);
+    }
 
-    for (auto& stream : m_impl->streams)
+    if (m_impl->timeToFirstFrameUs == 0U)
     {
-        if (!stream.hasPending || stream.timestampUs != earliestTimestamp)
-        {
-            continue;
-        }
+        m_impl->timeToFirstFrameUs = std::max<std::uint64_t>(
+            1U,
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                           std::chrono::steady_clock::now() - m_impl->initializeStart)
+                                           .count()));
+        Logger::log(Logger::Level::Info,
+                    "RadarPlayback time to first frame: " + std::to_string(m_impl->timeToFirstFrameUs) + " us");
+    }
+    return true;
+}
 
-        if (stream.type == StreamType::CornerDetections)
+void RadarPlayback::processRecords(const RadarRecordBatch& batch,
+                                   core::RadarProcessingPipeline& pipeline,
+                                   RadarFrame& frame) const
+{
+    frame = RadarFrame{};
+    frame.timestampUs = batch.timestampUs;
+    if (!m_impl || m_impl->vehicleParameters == nullptr)
+    {
+        return;
+    }
+
+    for (const auto& record : batch.records)
+    {
+        if (const auto* corner = std::get_if<utility::CornerDetectionsRecord>(&record))
         {
-            utility::EnhancedDetections output;
-            m_impl->pipeline.processCornerDetections(stream.radarIndex,
-                                                     stream.timestampUs,
-                                                     stream.cornerData,
-                                                     output);
-            const auto& radarCal = calibrationForSensor(*m_impl->vehicleParameters, stream.radarIndex);
+            const utility::SensorIndex radarIndex = corner->detections.sensor;
+            const auto& header = corner->detections.header;
+            const auto& radarCal = calibrationForSensor(*m_impl->vehicleParameters, radarIndex);
             const size_t before = frame.detections.size();
-            appendEnhancedDetections(output,
-                                     radarCal,
-                                     static_cast<int>(stream.radarIndex),
-                                     stream.elevationRad,
-                                     frame.detections);
+            pipeline.processCornerDetectionsFused(
+                radarIndex,
+                batch.timestampUs,
+                corner->detections,
+                [&](utility::SensorIndex, std::size_t slot, const utility::EnhancedDetection& det)
+                {
+                    appendDetection(det,
+                                    header,
+                                    radarCal,
+                                    static_cast<int>(radarIndex),
+                                    corner->elevationRaw_rad[slot],
+                                    frame.detections);
+                });
             if (frame.detections.size() > before)
             {
-                frame.sources.push_back("corner:" + radarIndexLabel(stream.radarIndex));
+                frame.sources.push_back("corner:" + radarIndexLabel(radarIndex));
                 frame.hasDetections = true;
             }
         }
-        else if (stream.type == StreamType::FrontDetections)
+        else if (const auto* front = std::get_if<utility::FrontDetectionsRecord>(&record))
         {
-            utility::EnhancedDetections outputShort;
-            utility::EnhancedDetections outputLong;
-            m_impl->pipeline.processFrontDetections(stream.timestampUs,
-                                                    stream.frontData,
-                                                    outputShort,
-                                                    outputLong);
+            const auto& header = front->detections.header;
             const auto& radarCalShort = calibrationForSensor(*m_impl->vehicleParameters,
                                                              utility::SensorIndex::FrontShort);
             const auto& radarCalLong = calibrationForSensor(*m_impl->vehicleParameters,
                                                             utility::SensorIndex::FrontLong);
-            std::vector<float> shortElev;
-            std::vector<float> longElev;
-            if (!stream.elevationRad.empty())
-            {
-                const size_t midpoint = std::min(kCornerReturnCount, stream.elevationRad.size());
-                shortElev.assign(stream.elevationRad.begin(),
-                                 stream.elevationRad.begin() + midpoint);
-                if (stream.elevationRad.size() > midpoint)
-                {
-                    longElev.assign(stream.elevationRad.begin() + midpoint, stream.elevationRad.end());
-                }
-            }
+            // Short-range returns are emitted first, so counting them tells the halves apart.
             const size_t beforeShort = frame.detections.size();
-            appendEnhancedDetections(outputShort,
-                                     radarCalShort,
-                                     static_cast<int>(utility::SensorIndex::FrontShort),
-                                     shortElev,
-                                     frame.detections);
-            const bool addedShort = frame.detections.size() > beforeShort;
-            const size_t beforeLong = frame.detections.size();
-            appendEnhancedDetections(outputLong,
-                                     radarCalLong,
-                                     static_cast<int>(utility::SensorIndex::FrontLong),
-                                     longElev,
-                                     frame.detections);
-            const bool addedLong = frame.detections.size() > beforeLong;
+            size_t shortCount = 0U;
+            pipeline.processFrontDetectionsFused(
+                batch.timestampUs,
+                front->detections,
+                [&](utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det)
+                {
+                    const bool isShort = sensor == utility::SensorIndex::FrontShort;
+                    const size_t before = frame.detections.size();
+                    appendDetection(det,
+                                    header,
+                                    isShort ? radarCalShort : radarCalLong,
+                                    static_cast<int>(sensor),
+                                    front->elevationRaw_rad[isShort ? slot : slot + kCornerReturnCount],
+                                    frame.detections);
+                    if (isShort)
+                    {
+                        shortCount += frame.detections.size() - before;
+                    }
+                });
+            const bool addedShort = shortCount > 0U;
+            const bool addedLong = frame.detections.size() > beforeShort + shortCount;
             if (addedShort)
             {
                 frame.sources.push_back("front:" + radarIndexLabel(utility::SensorIndex::FrontShort));
@@ -937,23 +1098,19 @@ bool RadarPlayback::readNextFrame(RadarFrame& frame)
                 frame.hasDetections = true;
             }
         }
-        else
+        else if (const auto* tracks = std::get_if<utility::RawTrackFusion>(&record))
         {
             utility::EnhancedTracks output;
-            m_impl->pipeline.processTrackFusion(stream.timestampUs,
-                                                stream.trackData,
-                                                output);
+            pipeline.processTrackFusion(batch.timestampUs, *tracks, output);
             appendTracks(output, frame.tracks);
             frame.sources.push_back("tracks");
             frame.hasTracks = !frame.tracks.empty();
         }
-
-        stream.hasPending = false;
     }
 
     frame.hasTracks = frame.hasTracks || !frame.tracks.empty();
     frame.hasDetections = frame.hasDetections || !frame.detections.empty();
-    return true;
+    pipeline.latestOdometry(frame.odometry);
 }
 
 const std::vector<glm::vec2>& RadarPlayback::vehicleContour() const noexcept
@@ -967,4 +1124,51 @@ const utility::VehicleParameters* RadarPlayback::vehicleParameters() const noexc
     return m_impl ? m_impl->vehicleParameters : nullptr;
 }
 
+std::uint64_t RadarPlayback::timeToFirstFrameUs() const noexcept
+{
+    return m_impl ? m_impl->timeToFirstFrameUs : 0U;
+}
+
+const core::StageProfiler* RadarPlayback::stageProfiler() const noexcept
+{
+    return m_impl ? m_impl->profiler.get() : nullptr;
+}
+
+const core::LatencyAnalyzer* RadarPlayback::latencyAnalyzer() const noexcept
+{
+    return m_impl ? m_impl->latency.get() : nullptr;
+}
+
+std::vector<SensorReorderStatistics> RadarPlayback::reorderStatistics() const
+{
+    std::vector<SensorReorderStatistics> statistics;
+    if (!m_impl)
+    {
+        return statistics;
+    }
+
+    for (const auto& stream : m_impl->streams)
+    {
+        collectReorderStatistics(stream, stream.cornerChannels, statistics);
+        collectReorderStatistics(stream, stream.frontChannels, statistics);
+        collectReorderStatistics(stream, stream.trackChannels, statistics);
+    }
+    return statistics;
+}
+
+std::size_t RadarPlayback::bufferedFrames() const noexcept
+{
+    std::size_t frames = 0U;
+    if (!m_impl)
+    {
+        return frames;
+    }
+    for (const auto& stream : m_impl->streams)
+    {
+        frames += radar::bufferedFrames(stream.cornerChannels) + radar::bufferedFrames(stream.frontChannels) +
+                  radar::bufferedFrames(stream.trackChannels);
+    }
+    return frames;
+}
+
 } // namespace radar
@@ -0,0 +1,614 @@
+#include "processing/ScenarioGenerator.hpp"
+
+#include "logging/Logger.hpp"
+#include "utility/radar_records.hpp"
+#include "utility/radar_types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <utility>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr float kPi = 3.14159265F;
+constexpr float kDegToRad = kPi / 180.0F;
+constexpr float kAzimuthPolarity = -1.0F;
+constexpr float kMinReturnRange_m = 0.5F;
+constexpr float kFrontShortRange_m = 70.0F;
+constexpr float kTrackVisibleRange_m = 150.0F;
+constexpr float kParkedTargetShare = 0.2F;
+constexpr std::uint64_t kPublishLatencyUs = 4000U;
+constexpr std::size_t kCornerMountCount = 4U;
+
+struct SensorMount
+{
+    const char* section;
+    float longitudinal_m;
+    float lateral_m;
+    float orientation_deg;
+    float horizontalFov_deg;
+    float maximumRange_m;
+    float height_m;
+};
+
+// Mounting positions follow the shipped Vehicle.ini (VCS: longitudinal forward, lateral right).
+constexpr std::array<SensorMount, kCornerMountCount> kCornerMounts = {{
+    {"SRR FWD LEFT", -0.5257F, -0.8325F, -59.8915F, 150.0F, 80.0F, 0.61F},
+    {"SRR FWD RIGHT", -0.5257F, 0.8325F, 62.347F, 150.0F, 80.0F, 0.61F},
+    {"SRR REAR LEFT", -4.6713F, -0.6747F, -119.2254F, 150.0F, 80.0F, 0.796F},
+    {"SRR REAR RIGHT", -4.6713F, 0.6747F, 122.0942F, 150.0F, 80.0F, 0.796F},
+}};
+constexpr SensorMount kFrontMount = {"MRR FRONT", -0.13F, -0.28F, -0.4437F, 100.0F, 200.0F, 0.2F};
+
+// std::mt19937 output is fixed by the standard but the distributions are not, so floats are mapped
+// by hand to keep captures identical across standard libraries.
+class ScenarioRandom
+{
+public:
+    explicit ScenarioRandom(std::uint32_t seed)
+        : m_engine(seed)
+    {
+    }
+
+    float uniform(float lo, float hi)
+    {
+        const float unit = static_cast<float>(m_engine() >> 8U) * (1.0F / 16777216.0F);
+        return lo + (hi - lo) * unit;
+    }
+
+private:
+    std::mt19937 m_engine;
+};
+
+struct EgoPose
+{
+    float x = 0.0F;
+    float y = 0.0F;
+    float heading = 0.0F;
+
+    void toBody(float worldX, float worldY, float& longitudinal, float& lateral) const
+    {
+        const float dx = worldX - x;
+        const float dy = worldY - y;
+        const float c = std::cos(heading);
+        const float s = std::sin(heading);
+        longitudinal = dx * c + dy * s;
+        lateral = -dx * s + dy * c;
+    }
+};
+
+struct Target
+{
+    float x0 = 0.0F;
+    float y = 0.0F;
+    float speed = 0.0F;
+    float length = 4.5F;
+    float width = 1.9F;
+    std::int32_t id = 0;
+
+    float x(float time_s) const
+    {
+        return x0 + speed * time_s;
+    }
+};
+
+struct Return
+{
+    bool valid = false;
+    float range_m = 0.0F;
+    float rangeRate_ms = 0.0F;
+    float azimuth_rad = 0.0F;
+    float amplitude_dBsm = 0.0F;
+    float longitudinal_m = 0.0F;
+    float lateral_m = 0.0F;
+    std::int8_t motionStatus = -1;
+    std::uint8_t multibounce = 0U;
+};
+
+struct ScanContext
+{
+    const SensorMount* mount = nullptr;
+    float maximumRange_m = 0.0F;
+    EgoPose pose;
+    float time_s = 0.0F;
+    float sensorVelocityLon = 0.0F;
+    float sensorVelocityLat = 0.0F;
+};
+
+float wrapToPi(float angle)
+{
+    while (angle > kPi)
+    {
+        angle -= 2.0F * kPi;
+    }
+    while (angle < -kPi)
+    {
+        angle += 2.0F * kPi;
+    }
+    return angle;
+}
+
+EgoPose egoPoseAt(const radar::ScenarioSettings& settings, float time_s)
+{
+    EgoPose pose;
+    pose.heading = settings.egoYawRate_rps * time_s;
+    if (std::abs(settings.egoYawRate_rps) < 1e-6F)
+    {
+        pose.x = settings.egoSpeed_mps * time_s;
+        return pose;
+    }
+
+    const float radius = settings.egoSpeed_mps / settings.egoYawRate_rps;
+    pose.x = radius * std::sin(pose.heading);
+    pose.y = radius * (1.0F - std::cos(pose.heading));
+    return pose;
+}
+
+ScanContext makeScanContext(const radar::ScenarioSettings& settings,
+                            const SensorMount& mount,
+                            float maximumRange_m,
+                            float time_s)
+{
+    ScanContext context;
+    context.mount = &mount;
+    context.maximumRange_m = maximumRange_m;
+    context.pose = egoPoseAt(settings, time_s);
+    context.time_s = time_s;
+    context.sensorVelocityLon = settings.egoSpeed_mps - settings.egoYawRate_rps * mount.lateral_m;
+    context.sensorVelocityLat = settings.egoYawRate_rps * mount.longitudinal_m;
+    return context;
+}
+
+// Builds a return from a body-frame position; targetVelocity is the over-ground velocity in body axes.
+bool makeReturn(const ScanContext& context,
+                float longitudinal_m,
+                float lateral_m,
+                float targetVelocityLon,
+                float targetVelocityLat,
+                float amplitude_dBsm,
+                Return& out)
+{
+    const float relLon = longitudinal_m - context.mount->longitudinal_m;
+    const float relLat = lateral_m - context.mount->lateral_m;
+    const float range = std::sqrt(relLon * relLon + relLat * relLat);
+    if (range < kMinReturnRange_m || range > context.maximumRange_m)
+    {
+        return false;
+    }
+
+    const float angle = std::atan2(relLat, relLon);
+    const float offBoresight = wrapToPi(angle - context.mount->orientation_deg * kDegToRad);
+    if (std::abs(offBoresight) > 0.5F * context.mount->horizontalFov_deg * kDegToRad)
+    {
+        return false;
+    }
+
+    const float velocityLon = targetVelocityLon - context.sensorVelocityLon;
+    const float velocityLat = targetVelocityLat - context.sensorVelocityLat;
+
+    out.valid = true;
+    out.range_m = range;
+    out.rangeRate_ms = velocityLon * std::cos(angle) + velocityLat * std::sin(angle);
+    out.azimuth_rad = offBoresight;
+    out.amplitude_dBsm = amplitude_dBsm;
+    out.longitudinal_m = longitudinal_m;
+    out.lateral_m = lateral_m;
+    const bool moving = std::abs(targetVelocityLon) + std::abs(targetVelocityLat) > 0.5F;
+    out.motionStatus = static_cast<std::int8_t>(moving ? 1 : 0);
+    return true;
+}
+
+void collectReturns(const radar::ScenarioSettings& settings,
+                    const ScanContext& context,
+                    const std::vector<Target>& targets,
+                    std::size_t budget,
+                    ScenarioRandom& rng,
+                    std::vector<Return>& out)
+{
+    out.clear();
+    const auto clutterCount = static_cast<std::size_t>(
+        std::lround(static_cast<float>(budget) * std::clamp(settings.clutterFraction, 0.0F, 1.0F)));
+    const std::size_t signalBudget = budget - std::min(budget, clutterCount);
+
+    const float c = std::cos(context.pose.heading);
+    const float s = std::sin(context.pose.heading);
+    Return candidate;
+    for (const auto& target : targets)
+    {
+        float lon = 0.0F;
+        float lat = 0.0F;
+        context.pose.toBody(target.x(context.time_s), target.y, lon, lat);
+        const float velocityLon = target.speed * c;
+        const float velocityLat = -target.speed * s;
+        if (makeReturn(context, lon, lat, velocityLon, velocityLat, rng.uniform(5.0F, 20.0F), candidate))
+        {
+            out.push_back(candidate);
+        }
+    }
+
+    // Guard rails on both road edges; landmarks are generated procedurally around the ego position.
+    const float spacing = std::max(0.1F, settings.landmarkSpacing_m);
+    const auto first = static_cast<long>(std::floor((context.pose.x - context.maximumRange_m) / spacing));
+    const auto last = static_cast<long>(std::ceil((context.pose.x + context.maximumRange_m) / spacing));
+    for (const float side : {-1.0F, 1.0F})
+    {
+        for (long k = first; k <= last; ++k)
+        {
+            float lon = 0.0F;
+            float lat = 0.0F;
+            context.pose.toBody(static_cast<float>(k) * spacing, side * settings.roadHalfWidth_m, lon, lat);
+            if (makeReturn(context, lon, lat, 0.0F, 0.0F, rng.uniform(-5.0F, 10.0F), candidate))
+            {
+                out.push_back(candidate);
+            }
+        }
+    }
+
+    std::stable_sort(out.begin(), out.end(), [](const Return& a, const Return& b) { return a.range_m < b.range_m; });
+    if (out.size() > signalBudget)
+    {
+        out.resize(signalBudget);
+    }
+
+    // Pad sparse scenes with ground scatter so the requested return count is always met.
+    const float halfFov = 0.5F * context.mount->horizontalFov_deg * kDegToRad;
+    const float boresight = context.mount->orientation_deg * kDegToRad;
+    std::size_t attempts = 0U;
+    while (out.size() < budget && attempts < budget * 8U)
+    {
+        ++attempts;
+        const float range = rng.uniform(2.0F, context.maximumRange_m * 0.9F);
+        const float angle = boresight + rng.uniform(-halfFov, halfFov);
+        const float lon = context.mount->longitudinal_m + range * std::cos(angle);
+        const float lat = context.mount->lateral_m + range * std::sin(angle);
+        const bool clutter = out.size() >= signalBudget;
+        if (!makeReturn(context, lon, lat, 0.0F, 0.0F, rng.uniform(-30.0F, -5.0F), candidate))
+        {
+            continue;
+        }
+        if (clutter)
+        {
+            candidate.rangeRate_ms = rng.uniform(-20.0F, 20.0F);
+            candidate.motionStatus = 1;
+            candidate.multibounce = static_cast<std::uint8_t>(rng.uniform(0.0F, 1.0F) < 0.5F ? 1U : 0U);
+        }
+        out.push_back(candidate);
+    }
+}
+
+template <typename Raw>
+void fillDetections(Raw& raw,
+                    std::uint64_t timestampUs,
+                    const SensorMount& mount,
+                    float maximumRange_m,
+                    const std::vector<Return>& slots)
+{
+    raw.header.timestamp_us = timestampUs;
+    raw.header.horizontalFov_rad = mount.horizontalFov_deg * kDegToRad;
+    raw.header.maximumRange_m = maximumRange_m;
+    raw.header.azimuthPolarity = kAzimuthPolarity;
+    raw.header.boresightAngle_rad = mount.orientation_deg * kDegToRad;
+    raw.header.sensorLongitudinal_m = mount.longitudinal_m;
+    raw.header.sensorLateral_m = mount.lateral_m;
+
+    const std::size_t count = std::min(slots.size(), raw.range_m.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Return& entry = slots[i];
+        if (!entry.valid)
+        {
+            raw.motionStatus[i] = -1;
+            continue;
+        }
+
+        raw.range_m[i] = entry.range_m;
+        raw.rangeRate_ms[i] = entry.rangeRate_ms;
+        raw.rangeRateRaw_ms[i] = entry.rangeRate_ms;
+        raw.azimuthRaw_rad[i] = entry.azimuth_rad * kAzimuthPolarity;
+        raw.azimuth_rad[i] = entry.azimuth_rad;
+        raw.amplitude_dBsm[i] = entry.amplitude_dBsm;
+        raw.longitudinalOffset_m[i] = entry.longitudinal_m;
+        raw.lateralOffset_m[i] = entry.lateral_m;
+        raw.motionStatus[i] = entry.motionStatus;
+        raw.radarValidReturn[i] = 1U;
+        raw.multibounceDetection[i] = entry.multibounce;
+    }
+}
+
+void fillTracks(utility::RawTrackFusion& record,
+                std::uint64_t timestampUs,
+                std::size_t scanIndex,
+                const radar::ScenarioSettings& settings,
+                const EgoPose& pose,
+                float time_s,
+                const std::vector<Target>& targets,
+                std::size_t firstTarget)
+{
+    record.timestamp_us = timestampUs;
+    record.visionTimestamp = timestampUs;
+    record.fusionTimestamp = timestampUs;
+    record.fusionIndex = static_cast<std::uint32_t>(scanIndex);
+    record.imageFrameIndex = static_cast<std::uint32_t>(scanIndex);
+
+    const float c = std::cos(pose.heading);
+    const float s = std::sin(pose.heading);
+    for (std::size_t slot = 0; slot < utility::kTrackCount; ++slot)
+    {
+        const std::size_t index = firstTarget + slot;
+        float lon = 0.0F;
+        float lat = 0.0F;
+        bool valid = index < targets.size();
+        if (valid)
+        {
+            pose.toBody(targets[index].x(time_s), targets[index].y, lon, lat);
+            valid = std::sqrt(lon * lon + lat * lat) <= kTrackVisibleRange_m;
+        }
+
+        if (!valid)
+        {
+            continue;
+        }
+
+        const Target& target = targets[index];
+        const bool moving = target.speed > 0.5F;
+        record.vcsLongitudinalPosition[slot] = lon;
+        record.vcsLateralPosition[slot] = lat;
+        record.length[slot] = target.length;
+        record.width[slot] = target.width;
+        record.height[slot] = 1.5F;
+        record.probabilityOfDetection[slot] = 0.95F;
+        record.id[slot] = target.id;
+        record.movingFlag[slot] = moving ? 1U : 0U;
+        record.stationaryFlag[slot] = moving ? 0U : 1U;
+        record.moveableFlag[slot] = 1U;
+        record.vehicleFlag[slot] = 1U;
+        record.status[slot] = static_cast<std::uint8_t>(utility::TrackStatus::Updated);
+        record.objectClassification[slot] = static_cast<std::uint16_t>(utility::TrackObjectClass::Car);
+        record.objectClassificationConfidence[slot] = 90U;
+        record.vcsLateralVelocity[slot] = -target.speed * s;
+        record.vcsLongitudinalVelocity[slot] = target.speed * c;
+        record.vcsHeading[slot] = -pose.heading;
+        record.vcsHeadingRate[slot] = -settings.egoYawRate_rps;
+    }
+}
+
+template <typename Record>
+void writeRecord(std::ostream& out, const Record& record, bool binary, std::string& line)
+{
+    if (binary)
+    {
+        utility::writeBinary(out, record);
+        return;
+    }
+
+    line.clear();
+    utility::appendText(record, line);
+    line.push_back('\n');
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+void writeVehicleConfig(std::ostream& out)
+{
+    out << "; Generated by radar::ScenarioGenerator.\n";
+    out << "[Geometry]\ndistRearAxle = 3.782\n\n";
+    out << "[Contour]\n";
+    const std::array<std::array<float, 2>, 12> contour = {{
+        {-0.775F, 0.822F}, {-0.956F, 0.71F}, {-1.09F, 0.25F}, {-1.09F, -0.25F},
+        {-0.956F, -0.71F}, {-0.775F, -0.822F}, {3.238F, -0.913F}, {3.6F, -0.715F},
+        {3.804F, -0.276F}, {3.804F, 0.276F}, {3.6F, 0.715F}, {3.238F, 0.913F},
+    }};
+    for (std::size_t i = 0; i < contour.size(); ++i)
+    {
+        out << "contourPt" << i << " = " << contour[i][0] << ',' << contour[i][1] << '\n';
+    }
+    out << "\n[Radar Common]\ncornerHardwareTimeDelay = 0.082\nfrontCenterHardwareTimeDelay = 0.062\n";
+
+    auto writeMount = [&out](const SensorMount& mount, float rangeRateAccuracy)
+    {
+        out << "\n[" << mount.section << "]\n";
+        out << "polarityVCS = " << kAzimuthPolarity << '\n';
+        out << "rangeRateAccuracy = " << rangeRateAccuracy << '\n';
+        out << "azimuthAccuracy = 1.0\n";
+        out << "orientationVCS = " << mount.orientation_deg << '\n';
+        out << "lonPosVCS = " << mount.longitudinal_m << '\n';
+        out << "latPosVCS = " << mount.lateral_m << '\n';
+        out << "heightAboveGround = " << mount.height_m << '\n';
+        out << "horizontalFieldOfView = " << mount.horizontalFov_deg << '\n';
+    };
+    for (const auto& mount : kCornerMounts)
+    {
+        writeMount(mount, 0.06F);
+    }
+    writeMount(kFrontMount, 0.05F);
+}
+
+std::string indexedName(const std::string& stem, std::size_t index, const char* extension)
+{
+    return index == 0U ? stem + extension : stem + "_" + std::to_string(index) + extension;
+}
+
+std::vector<Target> buildTargets(const radar::ScenarioSettings& settings, ScenarioRandom& rng)
+{
+    std::vector<Target> targets(settings.trackCount);
+    const std::array<float, 3> lanes = {-3.5F, 0.0F, 3.5F};
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        Target& target = targets[i];
+        target.id = static_cast<std::int32_t>(i + 1U);
+        const bool parked = rng.uniform(0.0F, 1.0F) < kParkedTargetShare;
+        target.y = parked ? (i % 2U == 0U ? -1.0F : 1.0F) * (settings.roadHalfWidth_m - 1.5F) : lanes[i % lanes.size()];
+        target.x0 = rng.uniform(-60.0F, 150.0F);
+        if (std::abs(target.y) < 1.0F && std::abs(target.x0) < 12.0F)
+        {
+            target.x0 += 24.0F;
+        }
+        target.speed = parked ? 0.0F : std::max(0.0F, settings.egoSpeed_mps + rng.uniform(-6.0F, 6.0F));
+        target.length = rng.uniform(3.8F, 5.5F);
+        target.width = rng.uniform(1.7F, 2.1F);
+    }
+    return targets;
+}
+} // namespace
+
+namespace radar
+{
+
+ScenarioGenerator::ScenarioGenerator(ScenarioSettings settings)
+    : m_settings(std::move(settings))
+{
+}
+
+const ScenarioSettings& ScenarioGenerator::settings() const noexcept
+{
+    return m_settings;
+}
+
+bool ScenarioGenerator::write(const fs::path& dataRoot, ScenarioCapture& capture) const
+{
+    capture = ScenarioCapture{};
+    std::error_code ec;
+    fs::create_directories(dataRoot, ec);
+
+    const std::size_t cornerFileCount = (m_settings.cornerSensorCount + kCornerMountCount - 1U) / kCornerMountCount;
+    const std::size_t trackFileCount = (m_settings.trackCount + utility::kTrackCount - 1U) / utility::kTrackCount;
+
+    std::vector<std::unique_ptr<std::ofstream>> cornerFiles;
+    std::vector<std::unique_ptr<std::ofstream>> trackFiles;
+    std::unique_ptr<std::ofstream> frontFile;
+    const bool binary = m_settings.binaryCaptures;
+    const char* extension = binary ? ".rdrb" : ".txt";
+    auto openCapture = [&](const std::string& name) -> std::unique_ptr<std::ofstream>
+    {
+        auto file =
+            std::make_unique<std::ofstream>(dataRoot / name, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file->is_open())
+        {
+            Logger::log(Logger::Level::Error, "ScenarioGenerator failed to open " + (dataRoot / name).string());
+            return nullptr;
+        }
+        capture.inputFiles.push_back(name);
+        return file;
+    };
+
+    for (std::size_t i = 0; i < cornerFileCount; ++i)
+    {
+        cornerFiles.push_back(openCapture(indexedName("scenarioCornerDetections", i, extension)));
+        if (binary && cornerFiles.back())
+        {
+            utility::writeBinaryStreamHeader<utility::CornerDetectionsRecord>(*cornerFiles.back());
+        }
+    }
+    if (m_settings.includeFrontRadar)
+    {
+        frontFile = openCapture(indexedName("scenarioFrontDetections", 0U, extension));
+        if (binary && frontFile)
+        {
+            utility::writeBinaryStreamHeader<utility::FrontDetectionsRecord>(*frontFile);
+        }
+    }
+    for (std::size_t i = 0; i < trackFileCount; ++i)
+    {
+        trackFiles.push_back(openCapture(indexedName("scenarioTracks", i, extension)));
+        if (binary && trackFiles.back())
+        {
+            utility::writeBinaryStreamHeader<utility::RawTrackFusion>(*trackFiles.back());
+        }
+    }
+
+    capture.vehicleConfigPath = dataRoot / "Vehicle.ini";
+    std::ofstream configFile(capture.vehicleConfigPath, std::ios::out | std::ios::trunc);
+    const bool filesOpen =
+        configFile.is_open() && (!m_settings.includeFrontRadar || frontFile) &&
+        std::all_of(cornerFiles.begin(), cornerFiles.end(), [](const auto& file) { return file != nullptr; }) &&
+        std::all_of(trackFiles.begin(), trackFiles.end(), [](const auto& file) { return file != nullptr; });
+    if (!filesOpen)
+    {
+        return false;
+    }
+    writeVehicleConfig(configFile);
+
+    ScenarioRandom rng(m_settings.seed);
+    const std::vector<Target> targets = buildTargets(m_settings, rng);
+
+    const float period_s = std::max(1e-3F, m_settings.scanPeriod_s);
+    const auto periodUs = static_cast<std::uint64_t>(std::llround(period_s * 1e6F));
+    capture.scanCount = std::max<std::size_t>(1U, static_cast<std::size_t>(m_settings.duration_s / period_s));
+    const std::size_t sensorCount = m_settings.cornerSensorCount + (m_settings.includeFrontRadar ? 1U : 0U);
+    const std::size_t cornerBudget = std::min(m_settings.returnsPerScan, utility::kCornerReturnCount);
+
+    std::vector<Return> returns;
+    std::vector<Return> slots;
+    std::string line;
+    auto cornerRecord = std::make_unique<utility::CornerDetectionsRecord>();
+    auto frontRecord = std::make_unique<utility::FrontDetectionsRecord>();
+    auto trackRecord = std::make_unique<utility::RawTrackFusion>();
+    for (std::size_t scan = 0; scan < capture.scanCount; ++scan)
+    {
+        const std::uint64_t scanStartUs = m_settings.startTimestampUs + scan * periodUs;
+
+        // Sensors are phase-shifted inside the scan so every sensor index sees strictly increasing timestamps.
+        for (std::size_t sensor = 0; sensor < m_settings.cornerSensorCount; ++sensor)
+        {
+            const std::uint64_t phaseUs = periodUs * sensor / sensorCount;
+            const float time_s = static_cast<float>(scan * periodUs + phaseUs) * 1e-6F;
+            const SensorMount& mount = kCornerMounts[sensor % kCornerMountCount];
+            const ScanContext context = makeScanContext(m_settings, mount, mount.maximumRange_m, time_s);
+            collectReturns(m_settings, context, targets, cornerBudget, rng, returns);
+
+            slots.assign(utility::kCornerReturnCount, Return{});
+            std::copy(returns.begin(), returns.end(), slots.begin());
+            *cornerRecord = utility::CornerDetectionsRecord{};
+            cornerRecord->publishTimestamp_us = scanStartUs + phaseUs + kPublishLatencyUs;
+            cornerRecord->detections.sensor = static_cast<utility::SensorIndex>(sensor % kCornerMountCount);
+            fillDetections(cornerRecord->detections, scanStartUs + phaseUs, mount, mount.maximumRange_m, slots);
+            writeRecord(*cornerFiles[sensor / kCornerMountCount], *cornerRecord, binary, line);
+            ++capture.detectionLineCount;
+        }
+
+        if (m_settings.includeFrontRadar)
+        {
+            const std::uint64_t phaseUs = periodUs * m_settings.cornerSensorCount / sensorCount;
+            const float time_s = static_cast<float>(scan * periodUs + phaseUs) * 1e-6F;
+            slots.assign(utility::kFrontReturnCount, Return{});
+
+            // Short-range half first, long-range half second, matching the capture layout.
+            const ScanContext shortContext = makeScanContext(m_settings, kFrontMount, kFrontShortRange_m, time_s);
+            collectReturns(m_settings, shortContext, targets, cornerBudget, rng, returns);
+            std::copy(returns.begin(), returns.end(), slots.begin());
+
+            const ScanContext longContext =
+                makeScanContext(m_settings, kFrontMount, kFrontMount.maximumRange_m, time_s);
+            collectReturns(m_settings, longContext, targets, cornerBudget, rng, returns);
+            std::copy(returns.begin(), returns.end(), slots.begin() + utility::kCornerReturnCount);
+
+            *frontRecord = utility::FrontDetectionsRecord{};
+            frontRecord->radarIndex = -1;
+            frontRecord->publishTimestamp_us = scanStartUs + phaseUs + kPublishLatencyUs;
+            fillDetections(frontRecord->detections, scanStartUs + phaseUs, kFrontMount, kFrontMount.maximumRange_m, slots);
+            writeRecord(*frontFile, *frontRecord, binary, line);
+            ++capture.detectionLineCount;
+        }
+
+        const float time_s = static_cast<float>(scan * periodUs) * 1e-6F;
+        const EgoPose pose = egoPoseAt(m_settings, time_s);
+        for (std::size_t file = 0; file < trackFiles.size(); ++file)
+        {
+            *trackRecord = utility::RawTrackFusion{};
+            fillTracks(*trackRecord, scanStartUs, scan, m_settings, pose, time_s, targets, file * utility::kTrackCount);
+            writeRecord(*trackFiles[file], *trackRecord, binary, line);
+            ++capture.trackLineCount;
+        }
+    }
+
+    Logger::log(Logger::Level::Info,
+                "ScenarioGenerator wrote " + std::to_string(capture.scanCount) + " scans to " + dataRoot.string());
+    return true;
+}
+
+} // namespace radar
@@ -3,10 +3,12 @@
 
 #include "sensors/TextRadarSensor.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <limits>
 #include <numeric>
+#include <system_error>
 #include <utility>
 
 namespace radar
@@ -17,11 +19,11 @@ namespace fs = std::filesystem;
 OfflineRadarDataReader::OfflineRadarDataReader(std::filesystem::path dataDirectory,
                                                std::vector<std::string> dataFiles)
     : m_dataDirectory(std::move(dataDirectory))
-    , m_files(std::move(dataFiles))
 {
-    for (const std::string& filename : m_files)
+    const std::vector<fs::path> roots = searchRoots();
+    for (std::string& filename : dataFiles)
     {
-        const fs::path resolved = findRadarFile(filename);
+        const fs::path resolved = findRadarFile(roots, filename);
         if (resolved.empty())
         {
             Logger::log(Logger::Level::Warning, "Offline radar file missing: " + filename);
@@ -31,6 +33,8 @@ OfflineRadarDataReader::OfflineRadarDataReader(std::filesystem::path dataDirecto
         auto sensor = std::make_unique<TextRadarSensor>(resolved);
         m_sensors.push_back(std::move(sensor));
         m_frames.emplace_back();
+        // Kept in sensor order so lastFrameSources() names the right file when an earlier one is missing.
+        m_files.push_back(std::move(filename));
         Logger::log(Logger::Level::Info, "Loaded radar file: " + resolved.string());
     }
 }
@@ -156,28 +160,48 @@ bool OfflineRadarDataReader::prepareFrames()
     return anyReady;
 }
 
-std::filesystem::path OfflineRadarDataReader::findRadarFile(const std::string& filename) const
+std::vector<std::filesystem::path> OfflineRadarDataReader::searchRoots() const
 {
-    const std::vector<fs::path> searchRoots = {
+    const fs::path cwd = fs::current_path();
+    const std::vector<fs::path> candidates = {
         m_dataDirectory,
-        fs::current_path(),
-        fs::current_path() / "data",
-        fs::current_path().parent_path() / "data",
-        fs::current_path().parent_path().parent_path() / "data",
-        fs::current_path() / ".." / "data",
-        fs::current_path() / ".." / ".." / "Test" / "data",
-        fs::current_path() / "Test" / "data",
+        cwd,
+        cwd / "data",
+        cwd.parent_path() / "data",
+        cwd.parent_path().parent_path() / "data",
+        cwd / ".." / "data",
+        cwd / ".." / ".." / "Test" / "data",
+        cwd / "Test" / "data",
     };
 
-    for (const fs::path& root : searchRoots)
+    // Several candidates name the same directory and most do not exist; settle both once for all files
+    // instead of stat-ing every candidate per file.
+    std::vector<fs::path> roots;
+    for (const fs::path& candidate : candidates)
     {
-        if (root.empty())
+        if (candidate.empty())
         {
             continue;
         }
+        const fs::path root = candidate.lexically_normal();
+        std::error_code error;
+        if (!fs::is_directory(root, error) || std::find(roots.begin(), roots.end(), root) != roots.end())
+        {
+            continue;
+        }
+        roots.push_back(root);
+    }
+    return roots;
+}
 
+std::filesystem::path OfflineRadarDataReader::findRadarFile(const std::vector<std::filesystem::path>& roots,
+                                                            const std::string& filename) const
+{
+    for (const fs::path& root : roots)
+    {
         const fs::path candidate = root / filename;
-        if (fs::exists(candidate))
+        std::error_code error;
+        if (fs::exists(candidate, error))
         {
             return fs::weakly_canonical(candidate);
         }
@@ -1,6 +1,7 @@
 #include "sensors/TextRadarSensor.hpp"
 
-#include <charconv>
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include "logging/Logger.hpp"
+#include "utility/radar_records.hpp"
 
 #include <glm/glm.hpp>
 
@@ -20,10 +22,100 @@ namespace
 constexpr size_t kMetadataFields = 9;
 constexpr float kMinIntensity = 0.001F;
 constexpr float kMaxPosition = 250.0F;
-constexpr size_t kRadarHeaderFields = 9;
-constexpr size_t kRadarReturnFields = 14;
-constexpr size_t kRadarTailFields = 3;
-constexpr size_t kRadarFieldsPerReturn = 15;
+
+template <typename Raw, size_t N>
+void appendReturns(const Raw& raw,
+                   const std::array<float, N>& elevationRaw_rad,
+                   size_t returnCount,
+                   int sensorIndex,
+                   float maxRange,
+                   BaseRadarSensor::PointCloud& destination)
+{
+    returnCount = std::min(returnCount, N);
+    destination.reserve(destination.size() + returnCount);
+    for (size_t index = 0; index < returnCount; ++index)
+    {
+        const float range_m = raw.range_m[index];
+        const float azimuth_rad = raw.azimuth_rad[index];
+        const float longitudinalOffset_m = raw.longitudinalOffset_m[index];
+        const float lateralOffset_m = raw.lateralOffset_m[index];
+
+        if (range_m <= 0.0F &&
+            longitudinalOffset_m == 0.0F &&
+            lateralOffset_m == 0.0F &&
+            raw.radarValidReturn[index] == 0 &&
+            raw.superResolutionDetection[index] == 0 &&
+            raw.nearTargetDetection[index] == 0 &&
+            raw.hostVehicleClutter[index] == 0 &&
+            raw.multibounceDetection[index] == 0)
+        {
+            continue;
+        }
+
+        float x = lateralOffset_m;
+        float y = longitudinalOffset_m;
+        if (x == 0.0F && y == 0.0F && range_m > 0.0F)
+        {
+            x = range_m * std::sin(azimuth_rad);
+            y = range_m * std::cos(azimuth_rad);
+        }
+
+        if (!std::isfinite(x) || !std::isfinite(y))
+        {
+            continue;
+        }
+
+        if (std::abs(x) > kMaxPosition || std::abs(y) > kMaxPosition)
+        {
+            continue;
+        }
+
+        if (maxRange > 0.0F)
+        {
+            const float distance = std::sqrt(x * x + y * y);
+            if (distance > maxRange)
+            {
+                continue;
+            }
+        }
+
+        const float elevation = elevationRaw_rad[index];
+        float z = 0.0F;
+        if (std::isfinite(elevation))
+        {
+            z = range_m * std::sin(elevation);
+        }
+
+        RadarPoint point{};
+        point.x = x;
+        point.y = y;
+        point.z = z;
+        point.intensity = 1.0F;
+        point.range_m = range_m;
+        point.rangeRate_ms = raw.rangeRate_ms[index];
+        point.rangeRateRaw_ms = raw.rangeRateRaw_ms[index];
+        point.azimuthRaw_rad = raw.azimuthRaw_rad[index];
+        point.azimuth_rad = azimuth_rad;
+        point.amplitude_dBsm = raw.amplitude_dBsm[index];
+        point.longitudinalOffset_m = longitudinalOffset_m;
+        point.lateralOffset_m = lateralOffset_m;
+        point.motionStatus = raw.motionStatus[index];
+        point.radarValid = raw.radarValidReturn[index];
+        point.superResolution = raw.superResolutionDetection[index];
+        point.nearTarget = raw.nearTargetDetection[index];
+        point.hostVehicleClutter = raw.hostVehicleClutter[index];
+        point.multibounce = raw.multibounceDetection[index];
+        point.sensorIndex = sensorIndex;
+        point.horizontalFov_rad = raw.header.horizontalFov_rad;
+        point.maximumRange_m = raw.header.maximumRange_m;
+        point.azimuthPolarity = raw.header.azimuthPolarity;
+        point.boresightAngle_rad = raw.header.boresightAngle_rad;
+        point.sensorLongitudinal_m = raw.header.sensorLongitudinal_m;
+        point.sensorLateral_m = raw.header.sensorLateral_m;
+        point.elevationRaw_rad = elevation;
+        destination.push_back(point);
+    }
+}
 }
 
 TextRadarSensor::TextRadarSensor(std::filesystem::path path)
@@ -112,143 +204,48 @@ bool TextRadarSensor::parseRadarReturnLine(const std::string& line,
                                            PointCloud& destination,
                                            uint64_t& timestampUs)
 {
-    std::istringstream tokenizer(line);
-    std::vector<double> tokens;
-    tokens.reserve(1024);
-    double value = 0.0;
-    while (tokenizer >> value)
-    {
-        tokens.push_back(value);
-    }
-
-    if (tokens.size() < kRadarHeaderFields + kRadarTailFields)
-    {
-        return false;
-    }
-
-    const size_t remaining = tokens.size() - (kRadarHeaderFields + kRadarTailFields);
-    if (remaining % kRadarFieldsPerReturn != 0)
-    {
-        return false;
-    }
-
-    const size_t returnCount = remaining / kRadarFieldsPerReturn;
-    if (returnCount == 0)
+    // Captures carry any number of returns: 9 header fields, 15 per return and 3 tail fields. Up to 64
+    // returns fit the corner record; longer lines go through the front record 128 returns at a time.
+    const size_t returnCount =
+        utility::textElementCount<utility::CornerDetectionsRecord>(utility::countTextTokens(line));
+    destination.clear();
+    if (returnCount == 0U)
     {
         return false;
     }
 
-    const int sensorIndex = static_cast<int>(tokens[0]);
-    timestampUs = static_cast<uint64_t>(tokens[1]);
-    const float horizontalFov_rad = static_cast<float>(tokens[3]);
-    const float maximumRange_m = static_cast<float>(tokens[4]);
-    const float azimuthPolarity = static_cast<float>(tokens[5]);
-    const float boresightAngle_rad = static_cast<float>(tokens[6]);
-    const float sensorLongitudinal_m = static_cast<float>(tokens[7]);
-    const float sensorLateral_m = static_cast<float>(tokens[8]);
-
-    const size_t returnsOffset = kRadarHeaderFields;
-    const size_t elevationOffset = returnsOffset + returnCount * kRadarReturnFields + kRadarTailFields;
-
-    destination.clear();
-    destination.reserve(returnCount);
-    for (size_t index = 0; index < returnCount; ++index)
+    if (returnCount <= utility::kCornerReturnCount)
     {
-        const size_t base = returnsOffset + index * kRadarReturnFields;
-        const float range_m = static_cast<float>(tokens[base + 0]);
-        const float rangeRate_ms = static_cast<float>(tokens[base + 1]);
-        const float rangeRateRaw_ms = static_cast<float>(tokens[base + 2]);
-        const float azimuthRaw_rad = static_cast<float>(tokens[base + 3]);
-        const float azimuth_rad = static_cast<float>(tokens[base + 4]);
-        const float amplitude_dBsm = static_cast<float>(tokens[base + 5]);
-        const float longitudinalOffset_m = static_cast<float>(tokens[base + 6]);
-        const float lateralOffset_m = static_cast<float>(tokens[base + 7]);
-        const int8_t motionStatus = static_cast<int8_t>(tokens[base + 8]);
-        const uint8_t radarValid = static_cast<uint8_t>(tokens[base + 9]);
-        const uint8_t superResolution = static_cast<uint8_t>(tokens[base + 10]);
-        const uint8_t nearTarget = static_cast<uint8_t>(tokens[base + 11]);
-        const uint8_t hostVehicleClutter = static_cast<uint8_t>(tokens[base + 12]);
-        const uint8_t multibounce = static_cast<uint8_t>(tokens[base + 13]);
-
-        if (range_m <= 0.0F &&
-            longitudinalOffset_m == 0.0F &&
-            lateralOffset_m == 0.0F &&
-            radarValid == 0 &&
-            superResolution == 0 &&
-            nearTarget == 0 &&
-            hostVehicleClutter == 0 &&
-            multibounce == 0)
-        {
-            continue;
-        }
-
-        float elevationRaw_rad = 0.0F;
-        if (elevationOffset + index < tokens.size())
+        utility::CornerDetectionsRecord record;
+        if (!utility::parseTextWindow(line, record, returnCount))
         {
-            elevationRaw_rad = static_cast<float>(tokens[elevationOffset + index]);
-        }
-
-        float x = lateralOffset_m;
-        float y = longitudinalOffset_m;
-        if (x == 0.0F && y == 0.0F && range_m > 0.0F)
-        {
-            x = range_m * std::sin(azimuth_rad);
-            y = range_m * std::cos(azimuth_rad);
-        }
-
-        if (!std::isfinite(x) || !std::isfinite(y))
-        {
-            continue;
-        }
-
-        if (std::abs(x) > kMaxPosition || std::abs(y) > kMaxPosition)
-        {
-            continue;
-        }
-
-        if (m_maxRange > 0.0F)
-        {
-            const float distance = std::sqrt(x * x + y * y);
-            if (distance > m_maxRange)
-            {
-                continue;
-            }
+            return false;
         }
+        timestampUs = record.publishTimestamp_us;
+        appendReturns(record.detections,
+                      record.elevationRaw_rad,
+                      returnCount,
+                      static_cast<int>(record.detections.sensor),
+                      m_maxRange,
+                      destination);
+        return !destination.empty();
+    }
 
-        float z = 0.0F;
-        if (std::isfinite(elevationRaw_rad))
+    utility::FrontDetectionsRecord record;
+    for (size_t first = 0; first < returnCount; first += utility::kFrontReturnCount)
+    {
+        if (!utility::parseTextWindow(line, record, returnCount, first))
         {
-            z = range_m * std::sin(elevationRaw_rad);
+            destination.clear();
+            return false;
         }
-
-        RadarPoint point{};
-        point.x = x;
-        point.y = y;
-        point.z = z;
-        point.intensity = 1.0F;
-        point.range_m = range_m;
-        point.rangeRate_ms = rangeRate_ms;
-        point.rangeRateRaw_ms = rangeRateRaw_ms;
-        point.azimuthRaw_rad = azimuthRaw_rad;
-        point.azimuth_rad = azimuth_rad;
-        point.amplitude_dBsm = amplitude_dBsm;
-        point.longitudinalOffset_m = longitudinalOffset_m;
-        point.lateralOffset_m = lateralOffset_m;
-        point.motionStatus = motionStatus;
-        point.radarValid = radarValid;
-        point.superResolution = superResolution;
-        point.nearTarget = nearTarget;
-        point.hostVehicleClutter = hostVehicleClutter;
-        point.multibounce = multibounce;
-        point.sensorIndex = sensorIndex;
-        point.horizontalFov_rad = horizontalFov_rad;
-        point.maximumRange_m = maximumRange_m;
-        point.azimuthPolarity = azimuthPolarity;
-        point.boresightAngle_rad = boresightAngle_rad;
-        point.sensorLongitudinal_m = sensorLongitudinal_m;
-        point.sensorLateral_m = sensorLateral_m;
-        point.elevationRaw_rad = elevationRaw_rad;
-        destination.push_back(point);
+        timestampUs = record.publishTimestamp_us;
+        appendReturns(record.detections,
+                      record.elevationRaw_rad,
+                      returnCount - first,
+                      record.radarIndex,
+                      m_maxRange,
+                      destination);
     }
 
     return !destination.empty();
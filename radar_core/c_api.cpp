@@ -0,0 +1,295 @@
+#include "radar_core/c_api.h"
+
+#include <memory>
+#include <new>
+
+#include "radar_core/processing_pipeline.hpp"
+#include "utility/vehicle_config.hpp"
+
+struct radar_core_pipeline
+{
+    utility::VehicleConfig vehicleConfig;
+    radar::core::RadarProcessingPipeline pipeline;
+};
+
+namespace
+{
+radar::core::DetectionColumns toDetectionColumns(const radar_core_detection_columns& input)
+{
+    radar::core::DetectionColumns columns;
+    columns.range_m = input.range_m;
+    columns.rangeRate_ms = input.range_rate_mps;
+    columns.rangeRateRaw_ms = input.range_rate_raw_mps;
+    columns.azimuthRaw_rad = input.azimuth_raw_rad;
+    columns.azimuth_rad = input.azimuth_rad;
+    columns.amplitude_dBsm = input.amplitude_dbsm;
+    columns.longitudinalOffset_m = input.longitudinal_offset_m;
+    columns.lateralOffset_m = input.lateral_offset_m;
+    columns.motionStatus = input.motion_status;
+    columns.radarValidReturn = input.valid;
+    columns.superResolutionDetection = input.super_resolution;
+    columns.nearTargetDetection = input.near_target;
+    columns.hostVehicleClutter = input.host_vehicle_clutter;
+    columns.multibounceDetection = input.multibounce;
+    return columns;
+}
+
+radar::core::TrackColumns toTrackColumns(const radar_core_track_columns& input)
+{
+    radar::core::TrackColumns columns;
+    columns.vcsLongitudinalPosition = input.longitudinal_position_m;
+    columns.vcsLateralPosition = input.lateral_position_m;
+    columns.vcsLongitudinalVelocity = input.longitudinal_velocity_mps;
+    columns.vcsLateralVelocity = input.lateral_velocity_mps;
+    columns.vcsLongitudinalAcceleration = input.longitudinal_acceleration_mps2;
+    columns.vcsLateralAcceleration = input.lateral_acceleration_mps2;
+    columns.vcsHeading = input.heading_rad;
+    columns.vcsHeadingRate = input.heading_rate_rps;
+    columns.length = input.length_m;
+    columns.width = input.width_m;
+    columns.height = input.height_m;
+    columns.stationaryFlag = input.stationary;
+    columns.moveableFlag = input.moveable;
+    return columns;
+}
+
+radar::core::TrackColumns offsetColumns(const radar::core::TrackColumns& columns, std::uint32_t first)
+{
+    radar::core::TrackColumns offset;
+    offset.vcsLongitudinalPosition = columns.vcsLongitudinalPosition + first;
+    offset.vcsLateralPosition = columns.vcsLateralPosition + first;
+    offset.vcsLongitudinalVelocity = columns.vcsLongitudinalVelocity + first;
+    offset.vcsLateralVelocity = columns.vcsLateralVelocity + first;
+    offset.vcsLongitudinalAcceleration = columns.vcsLongitudinalAcceleration + first;
+    offset.vcsLateralAcceleration = columns.vcsLateralAcceleration + first;
+    offset.vcsHeading = columns.vcsHeading + first;
+    offset.vcsHeadingRate = columns.vcsHeadingRate + first;
+    offset.length = columns.length + first;
+    offset.width = columns.width + first;
+    offset.height = columns.height + first;
+    offset.stationaryFlag = columns.stationaryFlag + first;
+    offset.moveableFlag = columns.moveableFlag + first;
+    return offset;
+}
+
+bool complete(const radar_core_detection_columns* columns)
+{
+    return columns && columns->range_m && columns->range_rate_mps && columns->range_rate_raw_mps &&
+           columns->azimuth_raw_rad && columns->azimuth_rad && columns->amplitude_dbsm &&
+           columns->longitudinal_offset_m && columns->lateral_offset_m && columns->motion_status && columns->valid &&
+           columns->super_resolution && columns->near_target && columns->host_vehicle_clutter && columns->multibounce;
+}
+
+bool complete(const radar_core_track_columns* columns)
+{
+    return columns && columns->longitudinal_position_m && columns->lateral_position_m &&
+           columns->longitudinal_velocity_mps && columns->lateral_velocity_mps &&
+           columns->longitudinal_acceleration_mps2 && columns->lateral_acceleration_mps2 && columns->heading_rad &&
+           columns->heading_rate_rps && columns->length_m && columns->width_m && columns->height_m &&
+           columns->stationary && columns->moveable;
+}
+
+// Checks a frame before any of it is processed and returns the number of returns its scans cover.
+bool validateFrame(const radar_core_frame& frame,
+                   const radar_core_scan* scans,
+                   bool detectionsComplete,
+                   bool tracksComplete,
+                   std::size_t& returns)
+{
+    returns = 0U;
+    if (frame.scan_count > 0U && !scans)
+    {
+        return false;
+    }
+    for (std::uint32_t n = 0; n < frame.scan_count; ++n)
+    {
+        const radar_core_scan& scan = scans[frame.first_scan + n];
+        const bool front = scan.sensor == RADAR_CORE_SENSOR_FRONT_SHORT;
+        if (scan.sensor > RADAR_CORE_SENSOR_FRONT_SHORT || (front && scan.short_range_count > scan.count))
+        {
+            return false;
+        }
+        returns += scan.count;
+    }
+    if (returns > 0U && !detectionsComplete)
+    {
+        return false;
+    }
+    return !frame.has_tracks ||
+           (frame.track_count <= RADAR_CORE_MAX_TRACKS && (frame.track_count == 0U || tracksComplete));
+}
+} // namespace
+
+extern "C" {
+
+radar_core_status radar_core_create(const char* vehicle_config_path, radar_core_pipeline** pipeline) noexcept
+{
+    if (!vehicle_config_path || !pipeline)
+    {
+        return RADAR_CORE_INVALID_ARGUMENT;
+    }
+    *pipeline = nullptr;
+
+    try
+    {
+        auto created = std::make_unique<radar_core_pipeline>();
+        if (!created->vehicleConfig.load(vehicle_config_path))
+        {
+            return RADAR_CORE_CONFIG_ERROR;
+        }
+        created->pipeline.initialize(&created->vehicleConfig.parameters());
+        *pipeline = created.release();
+        return RADAR_CORE_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return RADAR_CORE_INTERNAL_ERROR;
+    }
+    catch (...)
+    {
+        return RADAR_CORE_CONFIG_ERROR;
+    }
+}
+
+void radar_core_destroy(radar_core_pipeline* pipeline) noexcept
+{
+    delete pipeline;
+}
+
+radar_core_status radar_core_process_frames(radar_core_pipeline* pipeline,
+                                            const radar_core_frame* frames,
+                                            size_t frame_count,
+                                            const radar_core_scan* scans,
+                                            const radar_core_detection_columns* detections,
+                                            const radar_core_track_columns* tracks,
+                                            radar_core_results* results) noexcept
+{
+    if (!pipeline || !results || (frame_count > 0U && !frames))
+    {
+        return RADAR_CORE_INVALID_ARGUMENT;
+    }
+    results->written = 0U;
+    results->frames_processed = 0U;
+
+    try
+    {
+        const bool detectionsComplete = complete(detections);
+        const bool tracksComplete = complete(tracks);
+        const radar::core::DetectionColumns detectionColumns =
+            detectionsComplete ? toDetectionColumns(*detections) : radar::core::DetectionColumns{};
+        const radar::core::TrackColumns trackColumns =
+            tracksComplete ? toTrackColumns(*tracks) : radar::core::TrackColumns{};
+
+        auto& core = pipeline->pipeline;
+        const auto emit =
+            [results](utility::SensorIndex sensor, std::uint32_t sourceIndex, const utility::EnhancedDetection& det)
+        {
+            const std::size_t n = results->written++;
+            if (results->source_index)
+            {
+                results->source_index[n] = sourceIndex;
+            }
+            if (results->sensor)
+            {
+                results->sensor[n] = static_cast<std::uint8_t>(sensor);
+            }
+            if (results->is_stationary)
+            {
+                results->is_stationary[n] = det.isStationary;
+            }
+            if (results->is_moveable)
+            {
+                results->is_moveable[n] = det.isMoveable;
+            }
+            if (results->is_static)
+            {
+                results->is_static[n] = det.isStatic;
+            }
+            if (results->fused_track_index)
+            {
+                results->fused_track_index[n] = det.fusedTrackIndex;
+            }
+            if (results->stationary_probability)
+            {
+                results->stationary_probability[n] = det.stationaryProbability;
+            }
+        };
+
+        for (std::size_t f = 0; f < frame_count; ++f)
+        {
+            const radar_core_frame& frame = frames[f];
+            std::size_t returns = 0U;
+            if (!validateFrame(frame, scans, detectionsComplete, tracksComplete, returns))
+            {
+                return RADAR_CORE_INVALID_ARGUMENT;
+            }
+            if (returns > results->capacity - results->written)
+            {
+                return RADAR_CORE_RESULTS_FULL;
+            }
+
+            for (std::uint32_t n = 0; n < frame.scan_count; ++n)
+            {
+                const radar_core_scan& scan = scans[frame.first_scan + n];
+                if (scan.sensor == RADAR_CORE_SENSOR_FRONT_SHORT)
+                {
+                    const std::uint32_t longFirst = scan.first + scan.short_range_count;
+                    core.processFrontColumnsFused(
+                        frame.timestamp_us,
+                        scan.timestamp_us,
+                        detectionColumns,
+                        scan.first,
+                        scan.short_range_count,
+                        scan.count - scan.short_range_count,
+                        [&](utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det)
+                        {
+                            const std::uint32_t first =
+                                sensor == utility::SensorIndex::FrontShort ? scan.first : longFirst;
+                            emit(sensor, first + static_cast<std::uint32_t>(slot), det);
+                        });
+                }
+                else
+                {
+                    core.processCornerColumnsFused(
+                        static_cast<utility::SensorIndex>(scan.sensor),
+                        frame.timestamp_us,
+                        scan.timestamp_us,
+                        detectionColumns,
+                        scan.first,
+                        scan.count,
+                        [&](utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det)
+                        { emit(sensor, scan.first + static_cast<std::uint32_t>(slot), det); });
+                }
+            }
+
+            if (frame.has_tracks)
+            {
+                const radar::core::TrackColumns frameTracks = frame.track_count > 0U
+                                                                  ? offsetColumns(trackColumns, frame.first_track)
+                                                                  : radar::core::TrackColumns{};
+                core.processTrackColumns(frame.timestamp_us, frameTracks, frame.track_count);
+            }
+
+            if (results->odometry)
+            {
+                utility::OdometryEstimate estimate;
+                core.latestOdometry(estimate);
+                radar_core_odometry& odometry = results->odometry[f];
+                odometry.longitudinal_velocity_mps = estimate.vLon_mps;
+                odometry.lateral_velocity_mps = estimate.vLat_mps;
+                odometry.yaw_rate_rps = estimate.yawRate_rps;
+                odometry.inlier_count = estimate.inlierCount;
+                odometry.valid = estimate.valid ? 1U : 0U;
+            }
+            results->frames_processed = f + 1U;
+        }
+        return RADAR_CORE_OK;
+    }
+    catch (...)
+    {
+        // frames_processed still counts the frames that completed before the failure.
+        return RADAR_CORE_INTERNAL_ERROR;
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,182 @@
+#pragma once
+
+/*
+ * C interface of the radar_core library for embedding the processing pipeline in other services.
+ *
+ * All input and output buffers are owned by the caller and are only read or written during a call. Raw returns
+ * are passed as one array per field; a batch of frames refers to ranges of those arrays, so a caller can decode a
+ * block of frames straight into its own columns and hand them over without building per-frame records.
+ * A pipeline is not thread-safe; use one per thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(RADAR_CORE_SHARED)
+#if defined(_WIN32)
+#if defined(RADAR_CORE_BUILDING)
+#define RADAR_CORE_API __declspec(dllexport)
+#else
+#define RADAR_CORE_API __declspec(dllimport)
+#endif
+#else
+#define RADAR_CORE_API __attribute__((visibility("default")))
+#endif
+#else
+#define RADAR_CORE_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RADAR_CORE_MAX_TRACKS 96
+
+/* No entry point lets a C++ exception escape; C++ callers see that in the declarations. */
+#ifdef __cplusplus
+#define RADAR_CORE_NOEXCEPT noexcept
+#else
+#define RADAR_CORE_NOEXCEPT
+#endif
+
+typedef enum radar_core_status
+{
+    RADAR_CORE_OK = 0,
+    RADAR_CORE_INVALID_ARGUMENT = 1,
+    RADAR_CORE_CONFIG_ERROR = 2,
+    /* The next frame's returns do not fit into the remaining result capacity; see frames_processed. */
+    RADAR_CORE_RESULTS_FULL = 3,
+    /* Out of memory or another internal failure; destroy the pipeline, its state is unspecified. */
+    RADAR_CORE_INTERNAL_ERROR = 4
+} radar_core_status;
+
+/* Same values as utility::SensorIndex. */
+typedef enum radar_core_sensor
+{
+    RADAR_CORE_SENSOR_FRONT_LEFT = 0,
+    RADAR_CORE_SENSOR_FRONT_RIGHT = 1,
+    RADAR_CORE_SENSOR_REAR_LEFT = 2,
+    RADAR_CORE_SENSOR_REAR_RIGHT = 3,
+    RADAR_CORE_SENSOR_FRONT_SHORT = 4,
+    RADAR_CORE_SENSOR_FRONT_LONG = 5
+} radar_core_sensor;
+
+typedef struct radar_core_pipeline radar_core_pipeline;
+
+/* Raw returns, one array per field. All pointers are required. */
+typedef struct radar_core_detection_columns
+{
+    const float* range_m;
+    const float* range_rate_mps;
+    const float* range_rate_raw_mps;
+    const float* azimuth_raw_rad;
+    const float* azimuth_rad;
+    const float* amplitude_dbsm;
+    const float* longitudinal_offset_m;
+    const float* lateral_offset_m;
+    const int8_t* motion_status;
+    const uint8_t* valid;
+    const uint8_t* super_resolution;
+    const uint8_t* near_target;
+    const uint8_t* host_vehicle_clutter;
+    const uint8_t* multibounce;
+} radar_core_detection_columns;
+
+/* Live tracks (no invalid padding), one array per field. All pointers are required. */
+typedef struct radar_core_track_columns
+{
+    const float* longitudinal_position_m;
+    const float* lateral_position_m;
+    const float* longitudinal_velocity_mps;
+    const float* lateral_velocity_mps;
+    const float* longitudinal_acceleration_mps2;
+    const float* lateral_acceleration_mps2;
+    const float* heading_rad;
+    const float* heading_rate_rps;
+    const float* length_m;
+    const float* width_m;
+    const float* height_m;
+    const uint8_t* stationary;
+    const uint8_t* moveable;
+} radar_core_track_columns;
+
+/*
+ * One sensor scan: returns [first, first + count) of the detection columns. sensor is a corner radar, or
+ * RADAR_CORE_SENSOR_FRONT_SHORT for a front radar scan whose first short_range_count returns are the short-range
+ * half and the rest the long-range half. timestamp_us is the sensor timestamp from the scan header.
+ */
+typedef struct radar_core_scan
+{
+    uint64_t timestamp_us;
+    uint32_t sensor;
+    uint32_t first;
+    uint32_t count;
+    uint32_t short_range_count;
+} radar_core_scan;
+
+/*
+ * One frame (publish timestamp): scans [first_scan, first_scan + scan_count) are processed in order, then, if
+ * has_tracks is set, tracks [first_track, first_track + track_count) replace the association state for the
+ * following frames, like a track fusion record that shares the frame's timestamp.
+ */
+typedef struct radar_core_frame
+{
+    uint64_t timestamp_us;
+    uint32_t first_scan;
+    uint32_t scan_count;
+    uint32_t first_track;
+    uint32_t track_count;
+    uint8_t has_tracks;
+} radar_core_frame;
+
+typedef struct radar_core_odometry
+{
+    float longitudinal_velocity_mps;
+    float lateral_velocity_mps;
+    float yaw_rate_rps;
+    uint32_t inlier_count;
+    uint8_t valid;
+} radar_core_odometry;
+
+/*
+ * Results of a batch. Padding returns (no flags, no range, no offsets) are skipped, so one entry is written per
+ * remaining return, in scan order; source_index maps it back to the detection columns. Any column pointer may be
+ * NULL to skip that output. capacity is the length of the detection result columns; odometry, when set, receives
+ * one entry per frame. The call sets written and frames_processed.
+ */
+typedef struct radar_core_results
+{
+    size_t capacity;
+    uint32_t* source_index;
+    uint8_t* sensor;
+    uint8_t* is_stationary;
+    uint8_t* is_moveable;
+    uint8_t* is_static;
+    int8_t* fused_track_index;
+    float* stationary_probability;
+    radar_core_odometry* odometry;
+    size_t written;
+    size_t frames_processed;
+} radar_core_results;
+
+/* Loads the vehicle configuration (Vehicle.ini) and creates a pipeline with default processing settings. */
+RADAR_CORE_API radar_core_status radar_core_create(const char* vehicle_config_path,
+                                                   radar_core_pipeline** pipeline) RADAR_CORE_NOEXCEPT;
+RADAR_CORE_API void radar_core_destroy(radar_core_pipeline* pipeline) RADAR_CORE_NOEXCEPT;
+
+/*
+ * Processes frames in order. A frame is only started when all of its scans' returns fit into the remaining
+ * result capacity; otherwise the call stops with RADAR_CORE_RESULTS_FULL and the caller resumes from
+ * frames[frames_processed]. tracks may be NULL when no frame has tracks.
+ */
+RADAR_CORE_API radar_core_status radar_core_process_frames(radar_core_pipeline* pipeline,
+                                                           const radar_core_frame* frames,
+                                                           size_t frame_count,
+                                                           const radar_core_scan* scans,
+                                                           const radar_core_detection_columns* detections,
+                                                           const radar_core_track_columns* tracks,
+                                                           radar_core_results* results) RADAR_CORE_NOEXCEPT;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,156 @@
+#include "radar_core/frame_metrics.hpp"
+
+#include "radar_core/memory_accounting.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace radar::core
+{
+namespace
+{
+std::uint64_t trackedAllocations()
+{
+    std::uint64_t total = 0U;
+    for (const auto& usage : memoryFootprint())
+    {
+        total += usage.allocations;
+    }
+    return total;
+}
+
+float milliseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+} // namespace
+
+void FrameMetricsRing::defineStages(const std::vector<std::string>& names)
+{
+    if (m_stagesDefined.exchange(true, std::memory_order_relaxed))
+    {
+        return;
+    }
+    const std::size_t count = std::min(names.size(), kFrameMetricsStageCount);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto& name = m_stageNames[i];
+        const std::size_t length = std::min(names[i].size(), name.size() - 1U);
+        std::memcpy(name.data(), names[i].data(), length);
+        name[length] = '\0';
+    }
+    m_stageCount.store(count, std::memory_order_release);
+}
+
+std::size_t FrameMetricsRing::stageCount() const noexcept
+{
+    return m_stageCount.load(std::memory_order_acquire);
+}
+
+const char* FrameMetricsRing::stageName(std::size_t stage) const noexcept
+{
+    return stage < stageCount() ? m_stageNames[stage].data() : "";
+}
+
+void FrameMetricsRing::publish(const FrameMetricsSample& sample) noexcept
+{
+    const std::uint64_t index = m_published.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[index % kCapacity];
+
+    const auto words = std::bit_cast<std::array<std::uint32_t, kWords>>(sample);
+    slot.sequence.store(2U * index + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t w = 0; w < kWords; ++w)
+    {
+        slot.words[w].store(words[w], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2U * index + 2U, std::memory_order_release);
+    m_published.store(index + 1U, std::memory_order_release);
+}
+
+std::uint64_t FrameMetricsRing::published() const noexcept
+{
+    return m_published.load(std::memory_order_acquire);
+}
+
+std::size_t FrameMetricsRing::snapshot(std::vector<FrameMetricsSample>& out, std::size_t maxCount) const
+{
+    out.clear();
+    const std::uint64_t end = published();
+    const std::uint64_t count = std::min<std::uint64_t>({end, maxCount, kCapacity});
+    out.reserve(static_cast<std::size_t>(count));
+
+    std::array<std::uint32_t, kWords> words;
+    for (std::uint64_t index = end - count; index < end; ++index)
+    {
+        const Slot& slot = m_slots[index % kCapacity];
+        const std::uint64_t expected = 2U * index + 2U;
+        if (slot.sequence.load(std::memory_order_acquire) != expected)
+        {
+            continue;
+        }
+        for (std::size_t w = 0; w < kWords; ++w)
+        {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != expected)
+        {
+            // Overwritten by a newer frame while copying.
+            continue;
+        }
+        out.push_back(std::bit_cast<FrameMetricsSample>(words));
+    }
+    return out.size();
+}
+
+FrameMetricsRecorder::FrameMetricsRecorder(FrameMetricsRing& ring)
+    : m_ring(ring)
+{
+}
+
+void FrameMetricsRecorder::beginFrame()
+{
+    const auto now = std::chrono::steady_clock::now();
+    m_sample = FrameMetricsSample{};
+    m_sample.frameIndex = m_frameIndex;
+    m_sample.frameInterval_ms = m_frameIndex > 0U ? milliseconds(now - m_previousFrameStart) : 0.0F;
+    m_previousFrameStart = now;
+    m_frameStart = now;
+    m_lap = now;
+    m_allocationsAtStart = trackedAllocations();
+}
+
+void FrameMetricsRecorder::lap(std::size_t stage)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (stage < kFrameMetricsStageCount)
+    {
+        m_sample.stage_ms[stage] += milliseconds(now - m_lap);
+    }
+    m_lap = now;
+}
+
+void FrameMetricsRecorder::addStageTime(std::size_t stage, double seconds) noexcept
+{
+    if (stage < kFrameMetricsStageCount)
+    {
+        m_sample.stage_ms[stage] += static_cast<float>(seconds * 1e3);
+    }
+}
+
+void FrameMetricsRecorder::setQueueDepth(std::size_t depth) noexcept
+{
+    m_sample.queueDepth = static_cast<std::uint32_t>(depth);
+}
+
+void FrameMetricsRecorder::endFrame()
+{
+    m_sample.frameWork_ms = milliseconds(std::chrono::steady_clock::now() - m_frameStart);
+    m_sample.allocations = static_cast<std::uint32_t>(trackedAllocations() - m_allocationsAtStart);
+    m_ring.publish(m_sample);
+    ++m_frameIndex;
+}
+
+} // namespace radar::core
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace radar::core
+{
+
+constexpr std::size_t kFrameMetricsStageCount = 12U;
+constexpr std::size_t kFrameMetricsSensorCount = 6U;
+
+// Per-frame measurements published by an engine for live display.
+struct FrameMetricsSample
+{
+    std::uint64_t frameIndex = 0U;
+    // Wall time since the previous published frame; its inverse is the frame rate.
+    float frameInterval_ms = 0.0F;
+    // Read, process, map and render time of this frame, without the replay pacing sleep.
+    float frameWork_ms = 0.0F;
+    // Indexed like FrameMetricsRing::stageNames().
+    std::array<float, kFrameMetricsStageCount> stage_ms{};
+    std::uint32_t queueDepth = 0U;
+    // Tracked allocations (memory_accounting.hpp) made during the frame.
+    std::uint32_t allocations = 0U;
+    // Indexed by utility::SensorIndex.
+    std::array<std::uint32_t, kFrameMetricsSensorCount> pointsPerSensor{};
+};
+
+// Single-producer ring of the most recent frame samples that any number of threads can read without locks.
+// Each slot is guarded by a sequence number (seqlock) and stored as relaxed atomic words, so a reader never
+// blocks the producer and drops samples that were overwritten while it copied them.
+class FrameMetricsRing
+{
+public:
+    static constexpr std::size_t kCapacity = 1024U;
+
+    FrameMetricsRing() = default;
+    FrameMetricsRing(const FrameMetricsRing&) = delete;
+    FrameMetricsRing& operator=(const FrameMetricsRing&) = delete;
+
+    // Names the stage columns once, before the first publish(); later calls are ignored. Names are truncated
+    // to 31 characters and at most kFrameMetricsStageCount are kept.
+    void defineStages(const std::vector<std::string>& names);
+    std::size_t stageCount() const noexcept;
+    const char* stageName(std::size_t stage) const noexcept;
+
+    // Producer thread only.
+    void publish(const FrameMetricsSample& sample) noexcept;
+    // Number of samples published so far.
+    std::uint64_t published() const noexcept;
+    // Replaces out with up to maxCount of the newest samples, oldest first. Returns the number copied.
+    std::size_t snapshot(std::vector<FrameMetricsSample>& out, std::size_t maxCount) const;
+
+private:
+    static_assert(std::is_trivially_copyable_v<FrameMetricsSample>);
+    static_assert(sizeof(FrameMetricsSample) % sizeof(std::uint32_t) == 0U);
+    static constexpr std::size_t kWords = sizeof(FrameMetricsSample) / sizeof(std::uint32_t);
+
+    struct Slot
+    {
+        // 2n + 1 while sample n is written, 2n + 2 once it is complete.
+        std::atomic<std::uint64_t> sequence{0U};
+        std::array<std::atomic<std::uint32_t>, kWords> words{};
+    };
+
+    std::array<Slot, kCapacity> m_slots{};
+    std::atomic<std::uint64_t> m_published{0U};
+    std::array<std::array<char, 32>, kFrameMetricsStageCount> m_stageNames{};
+    std::atomic<std::size_t> m_stageCount{0U};
+    std::atomic<bool> m_stagesDefined{false};
+};
+
+// Builds one sample per frame on the producer thread and publishes it to a ring.
+class FrameMetricsRecorder
+{
+public:
+    explicit FrameMetricsRecorder(FrameMetricsRing& ring);
+
+    void beginFrame();
+    // Charges the time since beginFrame() or the previous lap() to a stage.
+    void lap(std::size_t stage);
+    // Adds time measured elsewhere (e.g. a StageProfiler delta) to a stage.
+    void addStageTime(std::size_t stage, double seconds) noexcept;
+    // Counts points per sensorIndex (any point type with an int sensorIndex member).
+    template <typename Points>
+    void countPoints(const Points& points) noexcept
+    {
+        for (const auto& point : points)
+        {
+            if (point.sensorIndex >= 0 && static_cast<std::size_t>(point.sensorIndex) < kFrameMetricsSensorCount)
+            {
+                ++m_sample.pointsPerSensor[static_cast<std::size_t>(point.sensorIndex)];
+            }
+        }
+    }
+    void setQueueDepth(std::size_t depth) noexcept;
+    // Stamps work time and allocations and publishes the sample.
+    void endFrame();
+
+private:
+    FrameMetricsRing& m_ring;
+    FrameMetricsSample m_sample;
+    std::chrono::steady_clock::time_point m_frameStart;
+    std::chrono::steady_clock::time_point m_lap;
+    std::chrono::steady_clock::time_point m_previousFrameStart;
+    std::uint64_t m_allocationsAtStart = 0U;
+    std::uint64_t m_frameIndex = 0U;
+};
+
+} // namespace radar::core
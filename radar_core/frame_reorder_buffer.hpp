@@ -0,0 +1,195 @@
+#pragma once
+
+#include "radar_core/huge_page_allocator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace radar::core
+{
+
+struct ReorderSettings
+{
+    // Extra wait beyond the hardware delay for frames that overtook each other in transport.
+    std::uint64_t maxLatency_us = 0U;
+    // Sensor to publish delay (VehicleParameters corner/front hardware delay).
+    std::uint64_t hardwareDelay_us = 0U;
+    // Frames held before the oldest is released early regardless of its deadline.
+    std::size_t capacity = 8U;
+    // Backing for the frame slots (capacity + 1 frames).
+    HugePageMode hugePages = HugePageMode::Off;
+};
+
+struct ReorderStatistics
+{
+    std::uint64_t received = 0U;
+    std::uint64_t released = 0U;
+    // Arrived behind a newer frame but was still released in timestamp order.
+    std::uint64_t reordered = 0U;
+    // Older than a frame that was already released; dropped.
+    std::uint64_t late = 0U;
+    std::uint64_t duplicates = 0U;
+    // Released before its deadline because the buffer was full.
+    std::uint64_t forcedReleases = 0U;
+    // Dropped because a full buffer was pushed again without being drained.
+    std::uint64_t overflows = 0U;
+    // Largest observed lag of a reordered frame behind the newest timestamp, for tuning maxLatency_us.
+    std::uint64_t maxJitter_us = 0U;
+    std::size_t maxDepth = 0U;
+};
+
+// Per-sensor jitter buffer. Frames are keyed by their sensor timestamp and released in timestamp order once
+// the caller's clock passes timestamp + hardwareDelay + maxLatency, so output latency is fixed by the
+// settings rather than by arrival jitter. The clock is supplied by the caller (publish timestamps in
+// playback), which keeps replays deterministic.
+template <typename Frame>
+class FrameReorderBuffer
+{
+public:
+    static constexpr std::uint64_t kFlush = std::numeric_limits<std::uint64_t>::max();
+
+    explicit FrameReorderBuffer(ReorderSettings settings = {})
+        : m_settings(settings)
+        , m_frames(HugePageAllocator<Frame>(settings.hugePages, MemoryTag::ReorderBuffers))
+    {
+        m_settings.capacity = std::max<std::size_t>(1U, m_settings.capacity);
+        // One spare slot: a push into a full buffer is accepted and the head becomes due immediately.
+        const std::size_t slots = m_settings.capacity + 1U;
+        m_frames.resize(slots);
+        m_order.reserve(slots);
+        m_free.reserve(slots);
+        for (std::size_t i = slots; i > 0U; --i)
+        {
+            m_free.push_back(i - 1U);
+        }
+    }
+
+    // Returns false when the frame was dropped (late, duplicate or overflow).
+    bool push(std::uint64_t timestamp_us, const Frame& frame)
+    {
+        m_statistics.received += 1U;
+        if (m_hasReleased && timestamp_us <= m_lastReleased_us)
+        {
+            m_statistics.late += 1U;
+            return false;
+        }
+
+        auto position = lowerBound(timestamp_us);
+        if (position != m_order.end() && position->timestamp_us == timestamp_us)
+        {
+            m_statistics.duplicates += 1U;
+            return false;
+        }
+
+        if (m_free.empty())
+        {
+            // The caller did not drain an over-full buffer; the oldest frame is lost.
+            m_free.push_back(m_order.front().slot);
+            m_order.erase(m_order.begin());
+            m_statistics.overflows += 1U;
+            position = lowerBound(timestamp_us);
+        }
+
+        if (timestamp_us < m_newest_us)
+        {
+            m_statistics.reordered += 1U;
+            m_statistics.maxJitter_us = std::max(m_statistics.maxJitter_us, m_newest_us - timestamp_us);
+        }
+        m_newest_us = std::max(m_newest_us, timestamp_us);
+
+        const std::size_t slot = m_free.back();
+        m_free.pop_back();
+        m_frames[slot] = frame;
+        m_order.insert(position, Entry{timestamp_us, slot});
+        m_statistics.maxDepth = std::max(m_statistics.maxDepth, m_order.size());
+        return true;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_order.empty();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_order.size();
+    }
+
+    // Timestamp of the next frame to be released, kFlush when empty.
+    std::uint64_t headTimestamp() const noexcept
+    {
+        return m_order.empty() ? kFlush : m_order.front().timestamp_us;
+    }
+
+    bool releasable(std::uint64_t now_us) const noexcept
+    {
+        return !m_order.empty() &&
+               (m_order.size() > m_settings.capacity || deadline(m_order.front().timestamp_us) <= now_us);
+    }
+
+    // Copies the head frame out when it is due at now_us; pass kFlush to drain at end of stream.
+    bool release(std::uint64_t now_us, Frame& frame)
+    {
+        if (!releasable(now_us))
+        {
+            return false;
+        }
+
+        const Entry head = m_order.front();
+        if (deadline(head.timestamp_us) > now_us)
+        {
+            m_statistics.forcedReleases += 1U;
+        }
+        m_order.erase(m_order.begin());
+        frame = m_frames[head.slot];
+        m_free.push_back(head.slot);
+        m_hasReleased = true;
+        m_lastReleased_us = head.timestamp_us;
+        m_statistics.released += 1U;
+        return true;
+    }
+
+    const ReorderStatistics& statistics() const noexcept
+    {
+        return m_statistics;
+    }
+
+    const ReorderSettings& settings() const noexcept
+    {
+        return m_settings;
+    }
+
+private:
+    struct Entry
+    {
+        std::uint64_t timestamp_us = 0U;
+        std::size_t slot = 0U;
+    };
+
+    typename std::vector<Entry>::iterator lowerBound(std::uint64_t timestamp_us)
+    {
+        return std::lower_bound(m_order.begin(), m_order.end(), timestamp_us,
+                                [](const Entry& entry, std::uint64_t value) { return entry.timestamp_us < value; });
+    }
+
+    std::uint64_t deadline(std::uint64_t timestamp_us) const noexcept
+    {
+        const std::uint64_t wait = m_settings.hardwareDelay_us + m_settings.maxLatency_us;
+        return timestamp_us > kFlush - wait ? kFlush : timestamp_us + wait;
+    }
+
+    ReorderSettings m_settings;
+    std::vector<Frame, HugePageAllocator<Frame>> m_frames;
+    // Buffered frames sorted by timestamp; small (capacity + 1), so sorted insertion beats a heap.
+    std::vector<Entry> m_order;
+    std::vector<std::size_t> m_free;
+    bool m_hasReleased = false;
+    std::uint64_t m_lastReleased_us = 0U;
+    std::uint64_t m_newest_us = 0U;
+    ReorderStatistics m_statistics;
+};
+
+} // namespace radar::core
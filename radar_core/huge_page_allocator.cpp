@@ -0,0 +1,251 @@
+#include "radar_core/huge_page_allocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace radar::core
+{
+namespace
+{
+std::atomic<std::uint64_t> s_explicitBytes{0U};
+std::atomic<std::uint64_t> s_transparentBytes{0U};
+std::atomic<std::uint64_t> s_fallbacks{0U};
+// Explicit-mode requests may end up on either backing; the few live MAP_HUGETLB mappings are remembered so
+// deallocateLarge() can subtract them from the right counter.
+std::mutex s_explicitMutex;
+std::vector<void*> s_explicitMappings;
+
+std::size_t roundUpToHugePage(std::size_t bytes)
+{
+    return (bytes + kHugePageSize - 1U) & ~(kHugePageSize - 1U);
+}
+
+#if defined(__linux__)
+// Over-allocates by one huge page and trims both ends so the mapping starts on a 2 MB boundary; THP can only
+// back aligned 2 MB ranges.
+void* mapAligned(std::size_t bytes)
+{
+    const std::size_t span = bytes + kHugePageSize;
+    void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    const auto start = reinterpret_cast<std::uintptr_t>(raw);
+    const auto aligned = (start + kHugePageSize - 1U) & ~(std::uintptr_t{kHugePageSize} - 1U);
+    const std::size_t head = aligned - start;
+    if (head > 0U)
+    {
+        munmap(raw, head);
+    }
+    const std::size_t tail = span - head - bytes;
+    if (tail > 0U)
+    {
+        munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+#endif
+} // namespace
+
+const char* hugePageModeName(HugePageMode mode)
+{
+    switch (mode)
+    {
+    case HugePageMode::Off:
+        return "off";
+    case HugePageMode::Transparent:
+        return "transparent";
+    case HugePageMode::Explicit:
+        return "explicit";
+    default:
+        return "?";
+    }
+}
+
+bool parseHugePageMode(const char* text, HugePageMode& mode)
+{
+    for (const auto candidate : {HugePageMode::Off, HugePageMode::Transparent, HugePageMode::Explicit})
+    {
+        if (std::strcmp(text, hugePageModeName(candidate)) == 0)
+        {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool usesLargeMapping(std::size_t bytes, HugePageMode mode) noexcept
+{
+#if defined(__linux__)
+    return mode != HugePageMode::Off && bytes >= kHugePageSize;
+#else
+    static_cast<void>(bytes);
+    static_cast<void>(mode);
+    return false;
+#endif
+}
+
+void* allocateLarge(std::size_t bytes, HugePageMode mode, LargeBacking* backing)
+{
+    if (backing)
+    {
+        *backing = LargeBacking::Heap;
+    }
+    if (!usesLargeMapping(bytes, mode))
+    {
+        if (mode != HugePageMode::Off && bytes >= kHugePageSize)
+        {
+            s_fallbacks.fetch_add(1U, std::memory_order_relaxed);
+        }
+        return ::operator new(bytes);
+    }
+
+#if defined(__linux__)
+    const std::size_t mappedBytes = roundUpToHugePage(bytes);
+    if (mode == HugePageMode::Explicit)
+    {
+        void* pointer =
+            mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pointer != MAP_FAILED)
+        {
+            try
+            {
+                const std::lock_guard<std::mutex> lock(s_explicitMutex);
+                s_explicitMappings.push_back(pointer);
+            }
+            catch (...)
+            {
+                munmap(pointer, mappedBytes);
+                throw;
+            }
+            s_explicitBytes.fetch_add(mappedBytes, std::memory_order_relaxed);
+            if (backing)
+            {
+                *backing = LargeBacking::Explicit;
+            }
+            return pointer;
+        }
+        s_fallbacks.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    void* pointer = mapAligned(mappedBytes);
+    if (!pointer)
+    {
+        throw std::bad_alloc();
+    }
+    // Advisory: succeeds even when THP is disabled system-wide, in which case the range stays on 4 KB pages.
+    if (madvise(pointer, mappedBytes, MADV_HUGEPAGE) != 0)
+    {
+        s_fallbacks.fetch_add(1U, std::memory_order_relaxed);
+    }
+    s_transparentBytes.fetch_add(mappedBytes, std::memory_order_relaxed);
+    if (backing)
+    {
+        *backing = LargeBacking::Transparent;
+    }
+    return pointer;
+#else
+    return ::operator new(bytes);
+#endif
+}
+
+void deallocateLarge(void* pointer, std::size_t bytes, HugePageMode mode) noexcept
+{
+    if (!pointer)
+    {
+        return;
+    }
+    if (!usesLargeMapping(bytes, mode))
+    {
+        ::operator delete(pointer);
+        return;
+    }
+#if defined(__linux__)
+    const std::size_t mappedBytes = roundUpToHugePage(bytes);
+    bool explicitMapping = false;
+    if (mode == HugePageMode::Explicit)
+    {
+        const std::lock_guard<std::mutex> lock(s_explicitMutex);
+        const auto it = std::find(s_explicitMappings.begin(), s_explicitMappings.end(), pointer);
+        if (it != s_explicitMappings.end())
+        {
+            *it = s_explicitMappings.back();
+            s_explicitMappings.pop_back();
+            explicitMapping = true;
+        }
+    }
+    (explicitMapping ? s_explicitBytes : s_transparentBytes).fetch_sub(mappedBytes, std::memory_order_relaxed);
+    munmap(pointer, mappedBytes);
+#endif
+}
+
+HugePageStatistics hugePageStatistics()
+{
+    HugePageStatistics statistics;
+    statistics.explicitBytes = s_explicitBytes.load(std::memory_order_relaxed);
+    statistics.transparentBytes = s_transparentBytes.load(std::memory_order_relaxed);
+    statistics.fallbacks = s_fallbacks.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::size_t residentHugePageBytes(const void* pointer, std::size_t bytes)
+{
+#if defined(__linux__)
+    std::ifstream smaps("/proc/self/smaps");
+    if (!smaps)
+    {
+        return 0U;
+    }
+
+    const auto begin = reinterpret_cast<std::uintptr_t>(pointer);
+    const auto end = begin + bytes;
+    bool inRange = false;
+    std::size_t total_kB = 0U;
+    std::string line;
+    while (std::getline(smaps, line))
+    {
+        unsigned long long start = 0U;
+        unsigned long long stop = 0U;
+        // Mapping header lines look like "7f12...-7f13... rw-p ...".
+        if (std::sscanf(line.c_str(), "%llx-%llx ", &start, &stop) == 2 && line.find(' ') > line.find('-'))
+        {
+            inRange = start < end && stop > begin;
+            continue;
+        }
+        if (!inRange)
+        {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string key;
+        std::size_t value_kB = 0U;
+        fields >> key >> value_kB;
+        if (key == "AnonHugePages:" || key == "Private_Hugetlb:" || key == "Shared_Hugetlb:")
+        {
+            total_kB += value_kB;
+        }
+    }
+    return total_kB * 1024U;
+#else
+    static_cast<void>(pointer);
+    static_cast<void>(bytes);
+    return 0U;
+#endif
+}
+
+} // namespace radar::core
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "radar_core/memory_accounting.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace radar::core
+{
+
+constexpr std::size_t kHugePageSize = std::size_t{2} * 1024U * 1024U;
+
+enum class HugePageMode : std::uint8_t
+{
+    // Plain heap allocation.
+    Off = 0,
+    // 2 MB aligned anonymous mapping with madvise(MADV_HUGEPAGE); the kernel backs it with transparent huge
+    // pages when it can (THP "madvise" or "always" mode).
+    Transparent,
+    // MAP_HUGETLB from the reserved hugetlbfs pool (vm.nr_hugepages); falls back to Transparent when the pool
+    // is empty or not configured.
+    Explicit
+};
+
+const char* hugePageModeName(HugePageMode mode);
+bool parseHugePageMode(const char* text, HugePageMode& mode);
+
+// How a large allocation was actually backed.
+enum class LargeBacking : std::uint8_t
+{
+    Heap = 0,
+    Transparent,
+    Explicit
+};
+
+struct HugePageStatistics
+{
+    // Bytes currently mapped with each backing; released mappings are subtracted.
+    std::uint64_t explicitBytes = 0U;
+    std::uint64_t transparentBytes = 0U;
+    // Requested Explicit or Transparent but had to use the next weaker backing.
+    std::uint64_t fallbacks = 0U;
+};
+
+// Allocations below kHugePageSize, or any allocation with mode Off, go to the regular heap: a mapping smaller
+// than one huge page cannot be huge-page backed and would only waste address space.
+bool usesLargeMapping(std::size_t bytes, HugePageMode mode) noexcept;
+void* allocateLarge(std::size_t bytes, HugePageMode mode, LargeBacking* backing = nullptr);
+void deallocateLarge(void* pointer, std::size_t bytes, HugePageMode mode) noexcept;
+HugePageStatistics hugePageStatistics();
+
+// Bytes of [pointer, pointer + bytes) currently backed by transparent or explicit huge pages, read from
+// /proc/self/smaps. Returns 0 where this cannot be determined (non-Linux).
+std::size_t residentHugePageBytes(const void* pointer, std::size_t bytes);
+
+// Standard allocator for long-lived buffers (occupancy grids, frame pools). The mode and the accounting tag
+// travel with the allocator, so containers can be configured per subsystem.
+template <typename T>
+class HugePageAllocator
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    HugePageAllocator() noexcept = default;
+    explicit HugePageAllocator(HugePageMode mode, MemoryTag tag = MemoryTag::Count) noexcept
+        : m_mode(mode)
+        , m_tag(tag)
+    {
+    }
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) noexcept
+        : m_mode(other.mode())
+        , m_tag(other.tag())
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        T* pointer = static_cast<T*>(allocateLarge(count * sizeof(T), m_mode));
+        recordAllocation(m_tag, count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        recordDeallocation(m_tag, count * sizeof(T));
+        deallocateLarge(pointer, count * sizeof(T), m_mode);
+    }
+
+    HugePageMode mode() const noexcept
+    {
+        return m_mode;
+    }
+
+    MemoryTag tag() const noexcept
+    {
+        return m_tag;
+    }
+
+    // Heap and mapped allocations are released differently, so only allocators on the same side compare equal.
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>& other) const noexcept
+    {
+        return (m_mode == HugePageMode::Off) == (other.mode() == HugePageMode::Off);
+    }
+
+private:
+    HugePageMode m_mode = HugePageMode::Off;
+    MemoryTag m_tag = MemoryTag::Count;
+};
+
+} // namespace radar::core
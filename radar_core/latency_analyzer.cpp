@@ -0,0 +1,221 @@
+#include "radar_core/latency_analyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace radar::core
+{
+namespace
+{
+// Bucket i > 0 holds values in (gamma^(i-2), gamma^(i-1)].
+const double kGamma = (1.0 + QuantileSketch::kRelativeAccuracy) / (1.0 - QuantileSketch::kRelativeAccuracy);
+const double kLogGamma = std::log(kGamma);
+
+void appendLatency(std::ostringstream& oss, const char* label, const QuantileSketch& sketch, double quantile)
+{
+    oss << label << " p50 " << sketch.quantile(0.5) / 1000.0 << " ms, p" << std::defaultfloat << std::setprecision(4)
+        << quantile * 100.0 << std::fixed << std::setprecision(2) << ' ' << sketch.quantile(quantile) / 1000.0
+        << " ms, max " << static_cast<double>(sketch.max()) / 1000.0 << " ms";
+}
+} // namespace
+
+void QuantileSketch::add(std::uint64_t value_us) noexcept
+{
+    m_buckets[bucketIndex(value_us)] += 1U;
+    m_min = m_count == 0U ? value_us : std::min(m_min, value_us);
+    m_max = m_count == 0U ? value_us : std::max(m_max, value_us);
+    m_count += 1U;
+    m_sum += static_cast<double>(value_us);
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) noexcept
+{
+    if (other.m_count == 0U)
+    {
+        return;
+    }
+    for (std::size_t i = 0; i < kBucketCount; ++i)
+    {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_min = m_count == 0U ? other.m_min : std::min(m_min, other.m_min);
+    m_max = m_count == 0U ? other.m_max : std::max(m_max, other.m_max);
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+}
+
+void QuantileSketch::clear() noexcept
+{
+    *this = QuantileSketch{};
+}
+
+std::uint64_t QuantileSketch::count() const noexcept
+{
+    return m_count;
+}
+
+std::uint64_t QuantileSketch::min() const noexcept
+{
+    return m_min;
+}
+
+std::uint64_t QuantileSketch::max() const noexcept
+{
+    return m_max;
+}
+
+double QuantileSketch::mean() const noexcept
+{
+    return m_count == 0U ? 0.0 : m_sum / static_cast<double>(m_count);
+}
+
+double QuantileSketch::quantile(double q) const noexcept
+{
+    if (m_count == 0U)
+    {
+        return 0.0;
+    }
+    const double clamped = std::clamp(q, 0.0, 1.0);
+    const auto rank = static_cast<std::uint64_t>(clamped * static_cast<double>(m_count - 1U));
+    std::uint64_t seen = 0U;
+    for (std::size_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += m_buckets[i];
+        if (seen > rank)
+        {
+            return std::clamp(bucketValue(i), static_cast<double>(m_min), static_cast<double>(m_max));
+        }
+    }
+    return static_cast<double>(m_max);
+}
+
+std::size_t QuantileSketch::bucketIndex(std::uint64_t value_us) noexcept
+{
+    if (value_us == 0U)
+    {
+        return 0U;
+    }
+    const double index = 1.0 + std::ceil(std::log(static_cast<double>(value_us)) / kLogGamma);
+    return std::min(static_cast<std::size_t>(index), kBucketCount - 1U);
+}
+
+double QuantileSketch::bucketValue(std::size_t index) noexcept
+{
+    if (index == 0U)
+    {
+        return 0.0;
+    }
+    // The point of the bucket with the same relative error to both of its bounds.
+    return 2.0 * std::pow(kGamma, static_cast<double>(index) - 1.0) / (kGamma + 1.0);
+}
+
+LatencyAnalyzer::LatencyAnalyzer(LatencyBudgetSettings settings)
+    : m_settings(settings)
+{
+}
+
+const LatencyBudgetSettings& LatencyAnalyzer::settings() const noexcept
+{
+    return m_settings;
+}
+
+std::size_t LatencyAnalyzer::addSource(std::string name, std::uint64_t hardwareDelay_us)
+{
+    SourceLatency source;
+    source.name = std::move(name);
+    source.captureBudget_us = hardwareDelay_us + m_settings.transportAllowance_us;
+    source.pipelineBudget_us = m_settings.pipelineBudget_us;
+    m_sources.push_back(std::move(source));
+    return m_sources.size() - 1U;
+}
+
+const std::vector<SourceLatency>& LatencyAnalyzer::sources() const noexcept
+{
+    return m_sources;
+}
+
+bool LatencyAnalyzer::record(std::size_t sourceIndex,
+                             std::uint64_t capture_us,
+                             std::uint64_t publish_us,
+                             std::uint64_t processed_us)
+{
+    if (sourceIndex >= m_sources.size())
+    {
+        return false;
+    }
+    SourceLatency& source = m_sources[sourceIndex];
+    if (publish_us >= capture_us)
+    {
+        source.captureToPublish.add(publish_us - capture_us);
+    }
+    else
+    {
+        source.clockSkewed += 1U;
+    }
+    source.publishToProcessed.add(processed_us > publish_us ? processed_us - publish_us : 0U);
+
+    const std::uint64_t samples = source.publishToProcessed.count();
+    if (samples < m_settings.minSamples || samples % kCheckInterval != 0U)
+    {
+        return false;
+    }
+    return checkBudgets(source);
+}
+
+bool LatencyAnalyzer::checkBudgets(SourceLatency& source) const
+{
+    const bool wasOver = source.overCaptureBudget || source.overPipelineBudget;
+    const auto over = [this](const QuantileSketch& sketch, std::uint64_t budget_us)
+    {
+        return sketch.count() >= m_settings.minSamples &&
+               sketch.quantile(m_settings.quantile) > static_cast<double>(budget_us);
+    };
+    source.overCaptureBudget = source.overCaptureBudget || over(source.captureToPublish, source.captureBudget_us);
+    source.overPipelineBudget =
+        source.overPipelineBudget || over(source.publishToProcessed, source.pipelineBudget_us);
+    return !wasOver && (source.overCaptureBudget || source.overPipelineBudget);
+}
+
+bool LatencyAnalyzer::overBudget() const noexcept
+{
+    return std::any_of(m_sources.begin(),
+                       m_sources.end(),
+                       [](const SourceLatency& source)
+                       { return source.overCaptureBudget || source.overPipelineBudget; });
+}
+
+std::string LatencyAnalyzer::report() const
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    for (const auto& source : m_sources)
+    {
+        if (source.publishToProcessed.count() == 0U)
+        {
+            continue;
+        }
+        oss << "  " << source.name << " (" << source.publishToProcessed.count() << " frames): ";
+        appendLatency(oss, "capture->publish", source.captureToPublish, m_settings.quantile);
+        oss << "; ";
+        appendLatency(oss, "publish->processed", source.publishToProcessed, m_settings.quantile);
+        if (source.clockSkewed > 0U)
+        {
+            oss << "; " << source.clockSkewed << " clock-skewed";
+        }
+        if (source.overCaptureBudget)
+        {
+            oss << " [over capture budget " << static_cast<double>(source.captureBudget_us) / 1000.0 << " ms]";
+        }
+        if (source.overPipelineBudget)
+        {
+            oss << " [over pipeline budget " << static_cast<double>(source.pipelineBudget_us) / 1000.0 << " ms]";
+        }
+        oss << '\n';
+    }
+    return oss.str();
+}
+
+} // namespace radar::core
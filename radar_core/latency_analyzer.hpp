@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace radar::core
+{
+
+// Fixed-memory quantile estimate of durations in microseconds. Samples are counted in logarithmic buckets
+// (as in DDSketch), so every quantile is within kRelativeAccuracy of the exact sample quantile, the memory
+// does not grow with the number of samples and two sketches merge by adding their buckets.
+class QuantileSketch
+{
+public:
+    static constexpr double kRelativeAccuracy = 0.01;
+    // Bucket 0 holds 0 us; the last bucket also collects everything above gamma^1021 us, about 12 minutes.
+    static constexpr std::size_t kBucketCount = 1024U;
+
+    void add(std::uint64_t value_us) noexcept;
+    void merge(const QuantileSketch& other) noexcept;
+    void clear() noexcept;
+
+    std::uint64_t count() const noexcept;
+    std::uint64_t min() const noexcept;
+    std::uint64_t max() const noexcept;
+    double mean() const noexcept;
+    // q in [0, 1]; 0 with no samples. Clamped to the exact minimum and maximum.
+    double quantile(double q) const noexcept;
+
+private:
+    static std::size_t bucketIndex(std::uint64_t value_us) noexcept;
+    static double bucketValue(std::size_t index) noexcept;
+
+    std::array<std::uint32_t, kBucketCount> m_buckets{};
+    std::uint64_t m_count = 0U;
+    std::uint64_t m_min = 0U;
+    std::uint64_t m_max = 0U;
+    double m_sum = 0.0;
+};
+
+struct LatencyBudgetSettings
+{
+    // Quantile compared against the budgets.
+    double quantile = 0.99;
+    // Capture to publish budget: the sensor's hardware delay plus this allowance for transport.
+    std::uint64_t transportAllowance_us = 10000U;
+    // Publish to processed budget: time frames are held (reordering) plus processing time.
+    std::uint64_t pipelineBudget_us = 20000U;
+    // Samples a source needs before it can be flagged.
+    std::uint64_t minSamples = 32U;
+};
+
+struct SourceLatency
+{
+    std::string name;
+    QuantileSketch captureToPublish;
+    QuantileSketch publishToProcessed;
+    std::uint64_t captureBudget_us = 0U;
+    std::uint64_t pipelineBudget_us = 0U;
+    // Frames whose publish timestamp was older than their capture timestamp (unsynchronised clocks); their
+    // capture to publish latency is not sketched.
+    std::uint64_t clockSkewed = 0U;
+    // Set at the first check where the quantile exceeded the budget; stays set for the rest of the run.
+    bool overCaptureBudget = false;
+    bool overPipelineBudget = false;
+};
+
+// Per-sensor latency distributions built incrementally while frames are processed: capture to publish
+// (sensor header timestamp to output timestamp) and publish to processed. Budgets are checked every few
+// samples, so a sensor is flagged while the run is still going.
+class LatencyAnalyzer
+{
+public:
+    explicit LatencyAnalyzer(LatencyBudgetSettings settings = {});
+
+    const LatencyBudgetSettings& settings() const noexcept;
+    // Adds a source and returns its index. hardwareDelay_us is its nominal capture to publish delay.
+    std::size_t addSource(std::string name, std::uint64_t hardwareDelay_us);
+    const std::vector<SourceLatency>& sources() const noexcept;
+
+    // Returns true when this sample put the source over one of its budgets for the first time.
+    bool record(std::size_t source, std::uint64_t capture_us, std::uint64_t publish_us, std::uint64_t processed_us);
+    bool overBudget() const noexcept;
+    // One line per source with p50/p99/max of both latencies; flagged sources are marked.
+    std::string report() const;
+
+private:
+    static constexpr std::uint64_t kCheckInterval = 16U;
+
+    bool checkBudgets(SourceLatency& source) const;
+
+    LatencyBudgetSettings m_settings;
+    std::vector<SourceLatency> m_sources;
+};
+
+} // namespace radar::core
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RADAR_CORE_HAS_SSE2 1
+#else
+#define RADAR_CORE_HAS_SSE2 0
+#endif
+
+namespace radar::core
+{
+
+// Writes the indices of the non-zero bytes in values[0, count) to indices, in ascending order, and returns how
+// many were written. indices must have room for count entries and count must not exceed 256.
+// SSE2 builds test 16 bytes per compare and walk the resulting bit mask, so all-zero blocks cost one compare;
+// the tail (and non-SSE2 builds) use a branchless scalar loop.
+inline std::size_t compactNonZeroIndices(const std::uint8_t* values, std::size_t count, std::uint8_t* indices)
+{
+    std::size_t written = 0U;
+    std::size_t i = 0U;
+#if RADAR_CORE_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16U <= count; i += 16U)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        auto mask = static_cast<std::uint32_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero))) & 0xFFFFU;
+        while (mask != 0U)
+        {
+            indices[written++] = static_cast<std::uint8_t>(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            mask &= mask - 1U;
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        indices[written] = static_cast<std::uint8_t>(i);
+        written += values[i] != 0U ? 1U : 0U;
+    }
+    return written;
+}
+
+} // namespace radar::core
@@ -0,0 +1,147 @@
+#include "radar_core/memory_accounting.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace radar::core
+{
+namespace
+{
+struct TagCounters
+{
+    std::atomic<std::uint64_t> current{0U};
+    std::atomic<std::uint64_t> peak{0U};
+    std::atomic<std::uint64_t> allocations{0U};
+};
+
+std::array<TagCounters, kMemoryTagCount> s_counters;
+
+double toMiB(std::uint64_t bytes)
+{
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+} // namespace
+
+const char* memoryTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::PlaybackStreams:
+        return "playback streams";
+    case MemoryTag::ReorderBuffers:
+        return "reorder buffers";
+    case MemoryTag::PipelineScratch:
+        return "pipeline scratch";
+    case MemoryTag::MappingGrid:
+        return "mapping grid";
+    case MemoryTag::WorldTiles:
+        return "world tiles";
+    case MemoryTag::VisualizerHistory:
+        return "visualizer history";
+    case MemoryTag::VisualizerVertices:
+        return "visualizer vertices";
+    default:
+        return "?";
+    }
+}
+
+void recordAllocation(MemoryTag tag, std::size_t bytes) noexcept
+{
+    if (tag >= MemoryTag::Count)
+    {
+        return;
+    }
+    auto& counters = s_counters[static_cast<std::size_t>(tag)];
+    counters.allocations.fetch_add(1U, std::memory_order_relaxed);
+    const std::uint64_t current = counters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::uint64_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+}
+
+void recordDeallocation(MemoryTag tag, std::size_t bytes) noexcept
+{
+    if (tag >= MemoryTag::Count)
+    {
+        return;
+    }
+    s_counters[static_cast<std::size_t>(tag)].current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryTagUsage memoryUsage(MemoryTag tag)
+{
+    MemoryTagUsage usage;
+    if (tag >= MemoryTag::Count)
+    {
+        return usage;
+    }
+    const auto& counters = s_counters[static_cast<std::size_t>(tag)];
+    usage.currentBytes = counters.current.load(std::memory_order_relaxed);
+    usage.peakBytes = counters.peak.load(std::memory_order_relaxed);
+    usage.allocations = counters.allocations.load(std::memory_order_relaxed);
+    return usage;
+}
+
+std::array<MemoryTagUsage, kMemoryTagCount> memoryFootprint()
+{
+    std::array<MemoryTagUsage, kMemoryTagCount> footprint{};
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+    {
+        footprint[i] = memoryUsage(static_cast<MemoryTag>(i));
+    }
+    return footprint;
+}
+
+std::uint64_t residentSetBytes()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t sizePages = 0U;
+    std::uint64_t residentPages = 0U;
+    if (!(statm >> sizePages >> residentPages))
+    {
+        return 0U;
+    }
+    return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0U;
+#endif
+}
+
+std::string memoryFootprintReport()
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << std::left << std::setw(22) << "owner" << std::right << std::setw(14) << "current MiB" << std::setw(12)
+        << "peak MiB" << std::setw(14) << "allocations" << '\n';
+
+    std::uint64_t totalCurrent = 0U;
+    std::uint64_t totalPeak = 0U;
+    const auto footprint = memoryFootprint();
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+    {
+        const auto& usage = footprint[i];
+        totalCurrent += usage.currentBytes;
+        totalPeak += usage.peakBytes;
+        oss << std::left << std::setw(22) << memoryTagName(static_cast<MemoryTag>(i)) << std::right << std::setw(14)
+            << toMiB(usage.currentBytes) << std::setw(12) << toMiB(usage.peakBytes) << std::setw(14)
+            << usage.allocations << '\n';
+    }
+    // Peaks of different owners need not coincide, so the summed peak is an upper bound.
+    oss << std::left << std::setw(22) << "tagged total" << std::right << std::setw(14) << toMiB(totalCurrent)
+        << std::setw(12) << toMiB(totalPeak) << '\n';
+    if (const std::uint64_t rss = residentSetBytes(); rss > 0U)
+    {
+        oss << std::left << std::setw(22) << "process RSS" << std::right << std::setw(14) << toMiB(rss) << '\n';
+    }
+    return oss.str();
+}
+
+} // namespace radar::core
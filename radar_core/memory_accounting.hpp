@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <string>
+
+namespace radar::core
+{
+
+// Owners of the long-lived buffers that dominate resident memory during a replay.
+enum class MemoryTag : std::uint8_t
+{
+    PlaybackStreams = 0,
+    ReorderBuffers,
+    PipelineScratch,
+    MappingGrid,
+    WorldTiles,
+    VisualizerHistory,
+    VisualizerVertices,
+    // Not a tag: allocations made with it are not tracked.
+    Count
+};
+
+constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+struct MemoryTagUsage
+{
+    std::uint64_t currentBytes = 0U;
+    std::uint64_t peakBytes = 0U;
+    std::uint64_t allocations = 0U;
+};
+
+const char* memoryTagName(MemoryTag tag);
+
+// Lock-free (relaxed atomics); safe to call from any thread.
+void recordAllocation(MemoryTag tag, std::size_t bytes) noexcept;
+void recordDeallocation(MemoryTag tag, std::size_t bytes) noexcept;
+
+MemoryTagUsage memoryUsage(MemoryTag tag);
+std::array<MemoryTagUsage, kMemoryTagCount> memoryFootprint();
+// Resident set size of the whole process (Linux /proc/self/statm), 0 where unavailable.
+std::uint64_t residentSetBytes();
+// Table of current / peak bytes per tag plus the process RSS for comparison.
+std::string memoryFootprintReport();
+
+// Heap allocator that charges its allocations to a tag. Use for containers owned by one subsystem; the
+// tag is part of the type, so containers of different owners do not mix by accident.
+template <typename T, MemoryTag Tag>
+class TaggedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() noexcept = default;
+
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        T* pointer = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+        recordAllocation(Tag, count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        recordDeallocation(Tag, count * sizeof(T));
+        ::operator delete(pointer, std::align_val_t{alignof(T)});
+    }
+
+    template <typename U>
+    bool operator==(const TaggedAllocator<U, Tag>&) const noexcept
+    {
+        return true;
+    }
+};
+
+} // namespace radar::core
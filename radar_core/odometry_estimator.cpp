@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -11,12 +12,7 @@ namespace radar::core
 {
 namespace
 {
-struct Sample
-{
-    float cosAngle = 0.0f;
-    float sinAngle = 0.0f;
-    float rangeRate = 0.0f;
-};
+using Sample = OdometrySample;
 
 float predictedRangeRate(const Sample& sample, float vLon, float vLat)
 {
@@ -38,6 +34,53 @@ bool solvePair(const Sample& a, const Sample& b, float& vLon, float& vLat)
     vLat = (a11 * b.rangeRate - a.rangeRate * a21) / det;
     return true;
 }
+
+std::uint32_t countInliers(const ScratchVector<Sample>& samples, float vLon, float vLat, float threshold)
+{
+    std::uint32_t inliers = 0U;
+    for (const auto& sample : samples)
+    {
+        const float residual = std::abs(predictedRangeRate(sample, vLon, vLat) - sample.rangeRate);
+        inliers += residual <= threshold ? 1U : 0U;
+    }
+    return inliers;
+}
+
+// Weighted least squares over the samples within gate of (vLon, vLat), Cauchy weights on the residual.
+// Leaves the velocity unchanged when the normal equations are degenerate.
+void refineWeighted(const ScratchVector<Sample>& samples, float gate, float scale, float& vLon, float& vLat)
+{
+    float sxx = 0.0f;
+    float sxy = 0.0f;
+    float syy = 0.0f;
+    float sxb = 0.0f;
+    float syb = 0.0f;
+    for (const auto& sample : samples)
+    {
+        const float residual = predictedRangeRate(sample, vLon, vLat) - sample.rangeRate;
+        if (std::abs(residual) > gate)
+        {
+            continue;
+        }
+        const float normalized = residual / scale;
+        const float weight = 1.0f / (1.0f + normalized * normalized);
+        const float x = -sample.cosAngle;
+        const float y = -sample.sinAngle;
+        sxx += weight * x * x;
+        sxy += weight * x * y;
+        syy += weight * y * y;
+        sxb += weight * x * sample.rangeRate;
+        syb += weight * y * sample.rangeRate;
+    }
+
+    const float det = sxx * syy - sxy * sxy;
+    if (det <= 1e-6f * std::max(1.0f, sxx * syy))
+    {
+        return;
+    }
+    vLon = (syy * sxb - sxy * syb) / det;
+    vLat = (sxx * syb - sxy * sxb) / det;
+}
 } // namespace
 
 RadarOdometryEstimator::RadarOdometryEstimator(OdometrySettings settings)
@@ -59,7 +102,7 @@ void RadarOdometryEstimator::updateSettings(const OdometrySettings& settings)
 bool RadarOdometryEstimator::processDetections(const utility::RadarCalibration& calibration,
                                                const utility::EnhancedDetections& detections)
 {
-    std::vector<Sample> samples;
+    ScratchVector<Sample> samples;
     samples.reserve(detections.detections.size());
 
     const std::uint8_t validMask = static_cast<std::uint8_t>(utility::DetectionFlag::Valid) |
@@ -80,58 +123,25 @@ bool RadarOdometryEstimator::processDetections(const utility::RadarCalibration&
         samples.push_back({std::cos(angle), std::sin(angle), det.rangeRate_ms});
     }
 
+    return processSamples(samples, detections.header.timestamp_us);
+}
+
+bool RadarOdometryEstimator::processSamples(const ScratchVector<OdometrySample>& samples,
+                                            std::uint64_t timestamp_us)
+{
     if (samples.size() < 2U)
     {
         return false;
     }
 
-    std::mt19937 rng(42);
-    std::uniform_int_distribution<std::size_t> dist(0, samples.size() - 1U);
-
     float bestVLon = 0.0f;
     float bestVLat = 0.0f;
-    std::uint32_t bestInliers = 0U;
     const float threshold = std::max(0.05f, m_settings.inlierThreshold_mps);
+    const std::uint32_t bestInliers = m_settings.method == OdometryMethod::Histogram
+                                          ? histogramHypothesis(samples, threshold, bestVLon, bestVLat)
+                                          : ransacHypothesis(samples, threshold, bestVLon, bestVLat);
 
-    const int iterations = std::max(1, m_settings.maxIterations);
-    for (int iter = 0; iter < iterations; ++iter)
-    {
-        const std::size_t i = dist(rng);
-        std::size_t j = dist(rng);
-        if (samples.size() > 1U)
-        {
-            while (j == i)
-            {
-                j = dist(rng);
-            }
-        }
-
-        float vLon = 0.0f;
-        float vLat = 0.0f;
-        if (!solvePair(samples[i], samples[j], vLon, vLat))
-        {
-            continue;
-        }
-
-        std::uint32_t inliers = 0U;
-        for (const auto& sample : samples)
-        {
-            const float residual = std::abs(predictedRangeRate(sample, vLon, vLat) - sample.rangeRate);
-            if (residual <= threshold)
-            {
-                ++inliers;
-            }
-        }
-
-        if (inliers > bestInliers)
-        {
-            bestInliers = inliers;
-            bestVLon = vLon;
-            bestVLat = vLat;
-        }
-    }
-
-    std::vector<Sample> inlierSamples;
+    ScratchVector<Sample> inlierSamples;
     const bool useInliers = bestInliers >= static_cast<std::uint32_t>(m_settings.minInliers);
     if (useInliers)
     {
@@ -163,7 +173,7 @@ bool RadarOdometryEstimator::processDetections(const utility::RadarCalibration&
 
     const Eigen::Vector2f solution = A.colPivHouseholderQr().solve(b);
 
-    m_lastEstimate.timestamp_us = detections.header.timestamp_us;
+    m_lastEstimate.timestamp_us = timestamp_us;
     m_lastEstimate.vLon_mps = solution(0);
     m_lastEstimate.vLat_mps = solution(1);
     m_lastEstimate.yawRate_rps = 0.0f;
@@ -181,6 +191,170 @@ bool RadarOdometryEstimator::processDetections(const utility::RadarCalibration&
     return m_lastEstimate.valid;
 }
 
+std::uint32_t RadarOdometryEstimator::ransacHypothesis(const ScratchVector<OdometrySample>& samples,
+                                                       float threshold,
+                                                       float& vLon,
+                                                       float& vLat) const
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> dist(0, samples.size() - 1U);
+
+    std::uint32_t bestInliers = 0U;
+    const int iterations = std::max(1, m_settings.maxIterations);
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        const std::size_t i = dist(rng);
+        std::size_t j = dist(rng);
+        if (samples.size() > 1U)
+        {
+            while (j == i)
+            {
+                j = dist(rng);
+            }
+        }
+
+        float candidateLon = 0.0f;
+        float candidateLat = 0.0f;
+        if (!solvePair(samples[i], samples[j], candidateLon, candidateLat))
+        {
+            continue;
+        }
+
+        const std::uint32_t inliers = countInliers(samples, candidateLon, candidateLat, threshold);
+        if (inliers > bestInliers)
+        {
+            bestInliers = inliers;
+            vLon = candidateLon;
+            vLat = candidateLat;
+        }
+    }
+    return bestInliers;
+}
+
+std::uint32_t RadarOdometryEstimator::histogramHypothesis(const ScratchVector<OdometrySample>& samples,
+                                                          float threshold,
+                                                          float& vLon,
+                                                          float& vLat)
+{
+    // Coarse pass over the whole search window, then a fine pass over the 3 x 3 coarse cells around its peak.
+    constexpr int kFineBinsPerCoarseBin = 4;
+    const float coarseBinSize = std::max(0.1f, m_settings.histogramBinSize_mps);
+    const float maxSpeed = std::max(coarseBinSize, m_settings.histogramMaxSpeed_mps);
+    const int coarseBins = std::clamp(static_cast<int>(std::ceil(2.0f * maxSpeed / coarseBinSize)), 2, 256);
+    if (!votePeak(samples, threshold, 0.0f, 0.0f, coarseBinSize, coarseBins, vLon, vLat))
+    {
+        return 0U;
+    }
+    const float fineBinSize = coarseBinSize / static_cast<float>(kFineBinsPerCoarseBin);
+    votePeak(samples, threshold, vLon, vLat, fineBinSize, 3 * kFineBinsPerCoarseBin, vLon, vLat);
+
+    // The bin centre can sit up to half a bin diagonal off the true velocity, so the first refinement gates
+    // wider than the inlier threshold; the second one re-gates around the refined estimate.
+    refineWeighted(samples, threshold + 0.71f * fineBinSize, threshold, vLon, vLat);
+    refineWeighted(samples, threshold, threshold, vLon, vLat);
+    return countInliers(samples, vLon, vLat, threshold);
+}
+
+bool RadarOdometryEstimator::votePeak(const ScratchVector<OdometrySample>& samples,
+                                      float threshold,
+                                      float centerLon,
+                                      float centerLat,
+                                      float binSize,
+                                      int bins,
+                                      float& peakLon,
+                                      float& peakLat)
+{
+    const auto binCount = static_cast<std::size_t>(bins);
+    const float halfSpan = 0.5f * static_cast<float>(bins) * binSize;
+    const float originLon = centerLon - halfSpan;
+    const float originLat = centerLat - halfSpan;
+    const float invBinSize = 1.0f / binSize;
+    const float lastBin = static_cast<float>(bins);
+
+    // A constraint is walked along the axis with the smaller coefficient (|slope| <= 1, band coefficient at
+    // least 1/sqrt(2)), so the band it votes per step never spans more than `width` bins. Every step adds a
+    // 0/1 vote to exactly `width` cells instead of looping over a data-dependent span, which keeps the inner
+    // loop free of mispredicted branches. Lines walked along vLon and along vLat go to separate accumulators
+    // so the band is always contiguous; rows are padded by `width` so the fixed-width write stays in bounds.
+    const float maxHalfBand = threshold * 1.4143f + 0.5f * binSize;
+    const auto width = static_cast<std::size_t>(2.0f * maxHalfBand * invBinSize) + 2U;
+    const std::size_t stride = binCount + width;
+    m_votes.assign(2U * binCount * stride, 0U);
+    m_bandLow.resize(binCount);
+    m_bandSpan.resize(binCount);
+    std::uint16_t* const lonMajor = m_votes.data();
+    std::uint16_t* const latMajor = lonMajor + binCount * stride;
+
+    // Votes are 16-bit; a frame never carries anywhere near that many returns.
+    const std::size_t voters = std::min<std::size_t>(samples.size(), std::numeric_limits<std::uint16_t>::max());
+    for (std::size_t n = 0; n < voters; ++n)
+    {
+        const Sample& sample = samples[n];
+        // Constraint line: cosAngle * vLon + sinAngle * vLat = -rangeRate.
+        const bool stepLon = std::abs(sample.sinAngle) >= std::abs(sample.cosAngle);
+        const float stepCoefficient = stepLon ? sample.cosAngle : sample.sinAngle;
+        const float bandCoefficient = stepLon ? sample.sinAngle : sample.cosAngle;
+        const float stepOrigin = stepLon ? originLon : originLat;
+        const float bandOrigin = stepLon ? originLat : originLon;
+        const float slope = -stepCoefficient / bandCoefficient;
+        // Velocities within threshold of the constraint, anywhere inside the step's bin.
+        const float halfBand = threshold / std::abs(bandCoefficient) + 0.5f * binSize * std::abs(slope);
+
+        // Band limits for every step: straight float code the compiler vectorizes. Bins are floored by
+        // truncating after a +1 shift (values are clamped to [-1, bins]), since std::floor is a library call
+        // without SSE4.1.
+        const float firstCenter =
+            slope * (stepOrigin + 0.5f * binSize) - sample.rangeRate / bandCoefficient - bandOrigin;
+        const float centerStep = slope * binSize;
+        for (std::size_t step = 0; step < binCount; ++step)
+        {
+            const float center = firstCenter + static_cast<float>(step) * centerStep;
+            const float low = std::min(std::max((center - halfBand) * invBinSize, -1.0f), lastBin);
+            const float high = std::min(std::max((center + halfBand) * invBinSize, -1.0f), lastBin);
+            const std::int32_t first = std::max(0, static_cast<std::int32_t>(low + 1.0f) - 1);
+            const std::int32_t last = std::min(bins - 1, static_cast<std::int32_t>(high + 1.0f) - 1);
+            m_bandLow[step] = first;
+            m_bandSpan[step] = last - first;
+        }
+
+        std::uint16_t* row = stepLon ? lonMajor : latMajor;
+        for (std::size_t step = 0; step < binCount; ++step, row += stride)
+        {
+            std::uint16_t* cells = row + m_bandLow[step];
+            const std::int32_t span = m_bandSpan[step];
+            for (std::size_t k = 0; k < width; ++k)
+            {
+                cells[k] = static_cast<std::uint16_t>(cells[k] + (static_cast<std::int32_t>(k) <= span ? 1U : 0U));
+            }
+        }
+    }
+
+    std::uint32_t best = 0U;
+    std::size_t bestLon = 0U;
+    std::size_t bestLat = 0U;
+    for (std::size_t lon = 0; lon < binCount; ++lon)
+    {
+        for (std::size_t lat = 0; lat < binCount; ++lat)
+        {
+            const std::uint32_t votes =
+                static_cast<std::uint32_t>(lonMajor[lon * stride + lat]) + latMajor[lat * stride + lon];
+            if (votes > best)
+            {
+                best = votes;
+                bestLon = lon;
+                bestLat = lat;
+            }
+        }
+    }
+    if (best == 0U)
+    {
+        return false;
+    }
+    peakLon = originLon + (static_cast<float>(bestLon) + 0.5f) * binSize;
+    peakLat = originLat + (static_cast<float>(bestLat) + 0.5f) * binSize;
+    return true;
+}
+
 bool RadarOdometryEstimator::latestEstimate(utility::OdometryEstimate& out) const noexcept
 {
     out = m_lastEstimate;
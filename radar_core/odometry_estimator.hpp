@@ -8,6 +8,14 @@
 namespace radar::core
 {
 
+// Direction cosines of one valid return (ISO frame) and its measured range rate.
+struct OdometrySample
+{
+    float cosAngle = 0.0f;
+    float sinAngle = 0.0f;
+    float rangeRate = 0.0f;
+};
+
 class RadarOdometryEstimator
 {
 public:
@@ -18,12 +26,38 @@ public:
 
     bool processDetections(const utility::RadarCalibration& calibration,
                            const utility::EnhancedDetections& detections);
+    // Same fit on samples the caller already extracted (the pipeline's fused path collects them in its pass).
+    bool processSamples(const ScratchVector<OdometrySample>& samples, std::uint64_t timestamp_us);
 
     bool latestEstimate(utility::OdometryEstimate& out) const noexcept;
 
 private:
+    // Each returns the inlier count of its velocity hypothesis.
+    std::uint32_t ransacHypothesis(const ScratchVector<OdometrySample>& samples,
+                                   float threshold,
+                                   float& vLon,
+                                   float& vLat) const;
+    std::uint32_t histogramHypothesis(const ScratchVector<OdometrySample>& samples,
+                                      float threshold,
+                                      float& vLon,
+                                      float& vLat);
+    // Votes every sample's constraint into a bins x bins histogram centred on (centerLon, centerLat) and
+    // returns the centre of the fullest bin; false when no constraint crosses the window.
+    bool votePeak(const ScratchVector<OdometrySample>& samples,
+                  float threshold,
+                  float centerLon,
+                  float centerLat,
+                  float binSize,
+                  int bins,
+                  float& peakLon,
+                  float& peakLat);
+
     OdometrySettings m_settings;
     utility::OdometryEstimate m_lastEstimate;
+    // Histogram accumulators and per-step bin bands, kept between frames (the default coarse grid is 7 KB).
+    ScratchVector<std::uint16_t> m_votes;
+    ScratchVector<std::int32_t> m_bandLow;
+    ScratchVector<std::int32_t> m_bandSpan;
 };
 
 } // namespace radar::core
@@ -0,0 +1,332 @@
+#include "radar_core/perf_counters.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace radar::core
+{
+namespace
+{
+#if defined(__linux__)
+struct CounterConfig
+{
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+constexpr std::array<CounterConfig, kPerfCounterCount> kCounterConfigs = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8U) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)},
+}};
+
+int openCounter(const CounterConfig& counter, int groupFd)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = counter.type;
+    attr.config = counter.config;
+    attr.disabled = groupFd == -1 ? 1U : 0U;
+    attr.exclude_kernel = 1U;
+    attr.exclude_hv = 1U;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+// Per-item columns in report(); cycles and instructions are shown as IPC.
+constexpr std::array<PerfCounter, 4> kReportedCounters = {
+    PerfCounter::L1DataMisses, PerfCounter::LastLevelCacheMisses, PerfCounter::BranchMisses, PerfCounter::DataTlbMisses};
+
+const char* counterName(PerfCounter counter)
+{
+    switch (counter)
+    {
+    case PerfCounter::Cycles:
+        return "cycles";
+    case PerfCounter::Instructions:
+        return "instructions";
+    case PerfCounter::L1DataMisses:
+        return "L1D miss";
+    case PerfCounter::LastLevelCacheMisses:
+        return "LLC miss";
+    case PerfCounter::BranchMisses:
+        return "br miss";
+    case PerfCounter::DataTlbMisses:
+        return "dTLB miss";
+    default:
+        return "?";
+    }
+}
+} // namespace
+
+PerfCounterGroup::PerfCounterGroup()
+{
+    m_fds.fill(-1);
+    m_slots.fill(-1);
+
+#if defined(__linux__)
+    m_leaderFd = openCounter(kCounterConfigs[0], -1);
+    if (m_leaderFd < 0)
+    {
+        return;
+    }
+
+    m_fds[0] = m_leaderFd;
+    m_slots[0] = 0;
+    m_memberCount = 1U;
+    for (std::size_t i = 1; i < kPerfCounterCount; ++i)
+    {
+        const int fd = openCounter(kCounterConfigs[i], m_leaderFd);
+        if (fd < 0)
+        {
+            continue;
+        }
+        m_fds[i] = fd;
+        m_slots[i] = static_cast<int>(m_memberCount);
+        ++m_memberCount;
+    }
+
+    ioctl(m_leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerfCounterGroup::~PerfCounterGroup()
+{
+#if defined(__linux__)
+    for (std::size_t i = kPerfCounterCount; i > 0U; --i)
+    {
+        if (m_fds[i - 1U] >= 0)
+        {
+            close(m_fds[i - 1U]);
+        }
+    }
+#endif
+}
+
+bool PerfCounterGroup::available() const noexcept
+{
+    return m_leaderFd >= 0;
+}
+
+bool PerfCounterGroup::supports(PerfCounter counter) const noexcept
+{
+    return m_slots[static_cast<std::size_t>(counter)] >= 0;
+}
+
+bool PerfCounterGroup::read(PerfCounterSample& sample) const
+{
+#if defined(__linux__)
+    if (m_leaderFd < 0)
+    {
+        return false;
+    }
+
+    // PERF_FORMAT_GROUP layout: { nr, time_enabled, time_running, value[nr] } - one syscall for the whole group.
+    std::array<std::uint64_t, kPerfCounterCount + 3U> buffer{};
+    const auto bytes = ::read(m_leaderFd, buffer.data(), sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(3U * sizeof(std::uint64_t)) || buffer[0] != m_memberCount)
+    {
+        return false;
+    }
+
+    sample.timeEnabled_ns = buffer[1];
+    sample.timeRunning_ns = buffer[2];
+    for (std::size_t i = 0; i < kPerfCounterCount; ++i)
+    {
+        sample.values[i] = m_slots[i] >= 0 ? buffer[static_cast<std::size_t>(m_slots[i]) + 3U] : 0U;
+    }
+    return true;
+#else
+    static_cast<void>(sample);
+    return false;
+#endif
+}
+
+PerfCounterSample PerfCounterSample::deltaSince(const PerfCounterSample& start) const
+{
+    PerfCounterSample delta;
+    delta.timeEnabled_ns = timeEnabled_ns > start.timeEnabled_ns ? timeEnabled_ns - start.timeEnabled_ns : 0U;
+    delta.timeRunning_ns = timeRunning_ns > start.timeRunning_ns ? timeRunning_ns - start.timeRunning_ns : 0U;
+    if (delta.timeRunning_ns == 0U)
+    {
+        return delta;
+    }
+
+    const double scale = delta.timeRunning_ns >= delta.timeEnabled_ns
+                             ? 1.0
+                             : static_cast<double>(delta.timeEnabled_ns) / static_cast<double>(delta.timeRunning_ns);
+    for (std::size_t i = 0; i < kPerfCounterCount; ++i)
+    {
+        const std::uint64_t raw = values[i] > start.values[i] ? values[i] - start.values[i] : 0U;
+        delta.values[i] = static_cast<std::uint64_t>(static_cast<double>(raw) * scale);
+    }
+    return delta;
+}
+
+double StageStatistics::instructionsPerCycle() const
+{
+    const auto cycles = counters[PerfCounter::Cycles];
+    return cycles == 0U ? 0.0 : static_cast<double>(counters[PerfCounter::Instructions]) / static_cast<double>(cycles);
+}
+
+double StageStatistics::perItem(PerfCounter counter) const
+{
+    return items == 0U ? 0.0 : static_cast<double>(counters[counter]) / static_cast<double>(items);
+}
+
+StageProfiler::Scope::Scope(StageProfiler* profiler, std::size_t stage, std::size_t items)
+    : m_profiler(profiler)
+    , m_stage(stage)
+    , m_items(items)
+{
+    if (!m_profiler)
+    {
+        return;
+    }
+
+    if (m_profiler->m_counters)
+    {
+        m_profiler->m_counters->read(m_startCounters);
+    }
+    m_start = std::chrono::steady_clock::now();
+}
+
+StageProfiler::Scope::~Scope()
+{
+    if (!m_profiler || m_stage >= m_profiler->m_stages.size())
+    {
+        return;
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    PerfCounterSample endCounters;
+    const bool counted = m_profiler->m_counters && m_profiler->m_counters->read(endCounters);
+
+    auto& stage = m_profiler->m_stages[m_stage];
+    stage.calls += 1U;
+    stage.items += m_items;
+    stage.wallTime_s += std::chrono::duration<double>(end - m_start).count();
+    if (counted)
+    {
+        const PerfCounterSample delta = endCounters.deltaSince(m_startCounters);
+        for (std::size_t i = 0; i < kPerfCounterCount; ++i)
+        {
+            stage.counters.values[i] += delta.values[i];
+        }
+        stage.counters.timeEnabled_ns += delta.timeEnabled_ns;
+        stage.counters.timeRunning_ns += delta.timeRunning_ns;
+    }
+}
+
+StageProfiler::StageProfiler(bool useHardwareCounters)
+{
+    if (useHardwareCounters)
+    {
+        m_counters = std::make_unique<PerfCounterGroup>();
+        if (!m_counters->available())
+        {
+            m_counters.reset();
+        }
+    }
+}
+
+StageProfiler::~StageProfiler() = default;
+
+std::size_t StageProfiler::addStage(const std::string& name)
+{
+    const auto it = std::find_if(m_stages.begin(), m_stages.end(),
+                                 [&name](const StageStatistics& stage) { return stage.name == name; });
+    if (it != m_stages.end())
+    {
+        return static_cast<std::size_t>(std::distance(m_stages.begin(), it));
+    }
+
+    StageStatistics stage;
+    stage.name = name;
+    m_stages.push_back(stage);
+    return m_stages.size() - 1U;
+}
+
+bool StageProfiler::hardwareCountersAvailable() const noexcept
+{
+    return m_counters != nullptr;
+}
+
+const std::vector<StageStatistics>& StageProfiler::stages() const noexcept
+{
+    return m_stages;
+}
+
+void StageProfiler::reset()
+{
+    for (auto& stage : m_stages)
+    {
+        const std::string name = stage.name;
+        stage = StageStatistics{};
+        stage.name = name;
+    }
+}
+
+std::string StageProfiler::report() const
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << std::left << std::setw(28) << "stage" << std::right << std::setw(10) << "calls" << std::setw(12) << "items"
+        << std::setw(12) << "wall ms" << std::setw(10) << "ns/item";
+    if (m_counters)
+    {
+        oss << std::setw(8) << "IPC";
+        for (const auto counter : kReportedCounters)
+        {
+            oss << std::setw(14) << (std::string(counterName(counter)) + "/item");
+        }
+    }
+    oss << '\n';
+
+    for (const auto& stage : m_stages)
+    {
+        const double nsPerItem = stage.items == 0U ? 0.0 : stage.wallTime_s * 1e9 / static_cast<double>(stage.items);
+        oss << std::left << std::setw(28) << stage.name << std::right << std::setw(10) << stage.calls
+            << std::setw(12) << stage.items << std::setw(12) << stage.wallTime_s * 1e3 << std::setw(10) << nsPerItem;
+        if (m_counters)
+        {
+            oss << std::setw(8) << stage.instructionsPerCycle();
+            for (const auto counter : kReportedCounters)
+            {
+                if (m_counters->supports(counter))
+                {
+                    oss << std::setw(14) << stage.perItem(counter);
+                }
+                else
+                {
+                    oss << std::setw(14) << "n/a";
+                }
+            }
+        }
+        oss << '\n';
+    }
+
+    if (!m_counters)
+    {
+        oss << "(hardware counters unavailable; wall time only)\n";
+    }
+    return oss.str();
+}
+
+} // namespace radar::core
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace radar::core
+{
+
+enum class PerfCounter : std::uint8_t
+{
+    Cycles = 0,
+    Instructions,
+    L1DataMisses,
+    LastLevelCacheMisses,
+    BranchMisses,
+    DataTlbMisses,
+    Count
+};
+
+constexpr std::size_t kPerfCounterCount = static_cast<std::size_t>(PerfCounter::Count);
+
+// Raw cumulative counts plus the group's enabled / running times. When the PMU multiplexes the group it only
+// counts while running, so intervals are scaled by their own enabled / running ratio in deltaSince().
+struct PerfCounterSample
+{
+    std::array<std::uint64_t, kPerfCounterCount> values{};
+    std::uint64_t timeEnabled_ns = 0U;
+    std::uint64_t timeRunning_ns = 0U;
+
+    std::uint64_t operator[](PerfCounter counter) const
+    {
+        return values[static_cast<std::size_t>(counter)];
+    }
+
+    // Estimated events between start and this sample; zero for an interval the group never ran in.
+    PerfCounterSample deltaSince(const PerfCounterSample& start) const;
+};
+
+// perf_event_open counter group bound to the constructing thread. Only user-space events are counted so the
+// group opens with perf_event_paranoid <= 2. When the syscall is unavailable (non-Linux, containers without
+// CAP_PERFMON, seccomp) available() is false and read() reports nothing.
+class PerfCounterGroup
+{
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const noexcept;
+    bool supports(PerfCounter counter) const noexcept;
+    bool read(PerfCounterSample& sample) const;
+
+private:
+    int m_leaderFd = -1;
+    std::array<int, kPerfCounterCount> m_fds{};
+    // Position of each counter in the group read buffer, -1 when the PMU does not expose it.
+    std::array<int, kPerfCounterCount> m_slots{};
+    std::size_t m_memberCount = 0U;
+};
+
+struct StageStatistics
+{
+    std::string name;
+    std::uint64_t calls = 0U;
+    std::uint64_t items = 0U;
+    double wallTime_s = 0.0;
+    PerfCounterSample counters;
+
+    double instructionsPerCycle() const;
+    double perItem(PerfCounter counter) const;
+};
+
+// Aggregates wall time and hardware counters per named stage. Not thread-safe: use one profiler per
+// processing thread, created on that thread.
+class StageProfiler
+{
+public:
+    // RAII sample around one stage invocation; a null profiler makes it a no-op.
+    class Scope
+    {
+    public:
+        Scope(StageProfiler* profiler, std::size_t stage, std::size_t items);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StageProfiler* m_profiler = nullptr;
+        std::size_t m_stage = 0U;
+        std::size_t m_items = 0U;
+        std::chrono::steady_clock::time_point m_start;
+        PerfCounterSample m_startCounters;
+    };
+
+    explicit StageProfiler(bool useHardwareCounters = true);
+    ~StageProfiler();
+
+    // Returns the id of the stage with this name, registering it on first use.
+    std::size_t addStage(const std::string& name);
+    bool hardwareCountersAvailable() const noexcept;
+    const std::vector<StageStatistics>& stages() const noexcept;
+    void reset();
+    std::string report() const;
+
+private:
+    std::unique_ptr<PerfCounterGroup> m_counters;
+    std::vector<StageStatistics> m_stages;
+};
+
+} // namespace radar::core
@@ -1,28 +1,95 @@
 #pragma once
 
+#include "radar_core/memory_accounting.hpp"
+
 #include <cstdint>
+#include <vector>
 
 namespace radar::core
 {
 
+// Per-frame working buffers of the processing pipeline, charged to MemoryTag::PipelineScratch.
+template <typename T>
+using ScratchVector = std::vector<T, TaggedAllocator<T, MemoryTag::PipelineScratch>>;
+
 struct DetectionAssociationSettings
 {
     float boundingBoxScale = 1.1f;
     float rangeRateSigma = 3.0f;
     float velocityVariance = 0.05f;
     float headingRateVariance = 0.05f;
+
+    bool operator==(const DetectionAssociationSettings&) const = default;
 };
 
 struct StationaryClassificationSettings
 {
     float nSigma = 3.0f;
+
+    bool operator==(const StationaryClassificationSettings&) const = default;
+};
+
+enum class OdometryMethod
+{
+    // Random pair sampling; maxIterations hypotheses per frame.
+    Ransac = 0,
+    // Deterministic: every return votes its range-rate constraint line into a 2-D velocity histogram, and the
+    // peak is refined by weighted least squares.
+    Histogram = 1
 };
 
 struct OdometrySettings
 {
+    OdometryMethod method = OdometryMethod::Ransac;
     int maxIterations = 120;
     float inlierThreshold_mps = 0.35f;
     int minInliers = 6;
+    // Histogram search window (|vLon| and |vLat| up to this speed) and coarse bin size; the fine pass around
+    // the coarse peak uses a quarter of it.
+    float histogramMaxSpeed_mps = 40.0f;
+    float histogramBinSize_mps = 2.0f;
+
+    bool operator==(const OdometrySettings&) const = default;
+};
+
+// Caller-owned raw returns, one array per field, indexed like the arrays of utility::RawCornerDetections.
+// Used by the columnar pipeline entry points so embedders can hand over their buffers without building
+// fixed-size records; every pointer must cover the returns that are processed.
+struct DetectionColumns
+{
+    const float* range_m = nullptr;
+    const float* rangeRate_ms = nullptr;
+    const float* rangeRateRaw_ms = nullptr;
+    const float* azimuthRaw_rad = nullptr;
+    const float* azimuth_rad = nullptr;
+    const float* amplitude_dBsm = nullptr;
+    const float* longitudinalOffset_m = nullptr;
+    const float* lateralOffset_m = nullptr;
+    const std::int8_t* motionStatus = nullptr;
+    const std::uint8_t* radarValidReturn = nullptr;
+    const std::uint8_t* superResolutionDetection = nullptr;
+    const std::uint8_t* nearTargetDetection = nullptr;
+    const std::uint8_t* hostVehicleClutter = nullptr;
+    const std::uint8_t* multibounceDetection = nullptr;
+};
+
+// Caller-owned live tracks (no Invalid padding), one array per field named as in utility::RawTrackFusion.
+// Only what detection association needs is read.
+struct TrackColumns
+{
+    const float* vcsLongitudinalPosition = nullptr;
+    const float* vcsLateralPosition = nullptr;
+    const float* vcsLongitudinalVelocity = nullptr;
+    const float* vcsLateralVelocity = nullptr;
+    const float* vcsLongitudinalAcceleration = nullptr;
+    const float* vcsLateralAcceleration = nullptr;
+    const float* vcsHeading = nullptr;
+    const float* vcsHeadingRate = nullptr;
+    const float* length = nullptr;
+    const float* width = nullptr;
+    const float* height = nullptr;
+    const std::uint8_t* stationaryFlag = nullptr;
+    const std::uint8_t* moveableFlag = nullptr;
 };
 
 struct ProcessingSettings
@@ -30,6 +97,8 @@ struct ProcessingSettings
     DetectionAssociationSettings association;
     StationaryClassificationSettings stationary;
     OdometrySettings odometry;
+
+    bool operator==(const ProcessingSettings&) const = default;
 };
 
 } // namespace radar::core
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <limits>
 
+#include "radar_core/mask_compaction.hpp"
 #include "utility/math_utils.hpp"
 
 namespace radar::core
@@ -46,12 +47,81 @@ float yawCompensation(const utility::VehicleMotionState& state,
            ((calibration.iso.longitudinal_m * std::sin(detAngle)) -
             (calibration.iso.lateral_m * std::cos(detAngle)));
 }
+
+// Requests every cache line of a record ahead of its use, so the columns of the next frame load while the
+// current one is processed.
+void prefetchRecord(const void* record, std::size_t bytes)
+{
+    constexpr std::size_t kCacheLine = 64U;
+    const auto* first = static_cast<const char*>(record);
+    for (std::size_t offset = 0U; offset < bytes; offset += kCacheLine)
+    {
+#if RADAR_CORE_HAS_SSE2
+        _mm_prefetch(first + offset, _MM_HINT_T0);
+#elif defined(__GNUC__)
+        __builtin_prefetch(first + offset);
+#else
+        static_cast<void>(first);
+#endif
+    }
+}
+
+void beginBatchFrame(std::uint64_t timestamp_us, ProcessedBatch& output)
+{
+    ProcessedBatch::Frame frame;
+    frame.timestamp_us = timestamp_us;
+    frame.first = static_cast<std::uint32_t>(output.detections.size());
+    output.frames.push_back(frame);
+}
+
+void endBatchFrame(bool valid, ProcessedBatch& output)
+{
+    auto& frame = output.frames.back();
+    frame.count = static_cast<std::uint32_t>(output.detections.size()) - frame.first;
+    frame.valid = valid;
+}
+
+// Emit target of the batch calls: appends to the arena, whose capacity was reserved for the whole batch.
+struct BatchAppend
+{
+    ProcessedBatch& output;
+
+    void operator()(utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det) const
+    {
+        output.detections.push_back(det);
+        output.sensors.push_back(sensor);
+        output.slots.push_back(static_cast<std::uint8_t>(slot));
+    }
+};
+
+void reserveBatch(ProcessedBatch& output, std::size_t frameCount, std::size_t returnsPerFrame)
+{
+    output.frames.reserve(frameCount);
+    output.detections.reserve(frameCount * returnsPerFrame);
+    output.sensors.reserve(frameCount * returnsPerFrame);
+    output.slots.reserve(frameCount * returnsPerFrame);
+}
 } // namespace
 
+std::span<const utility::EnhancedDetection> ProcessedBatch::frameDetections(std::size_t frame) const
+{
+    const Frame& entry = frames[frame];
+    return std::span<const utility::EnhancedDetection>(detections).subspan(entry.first, entry.count);
+}
+
+void ProcessedBatch::clear()
+{
+    frames.clear();
+    detections.clear();
+    sensors.clear();
+    slots.clear();
+}
+
 RadarProcessingPipeline::RadarProcessingPipeline(ProcessingSettings settings)
     : m_settings(settings)
     , m_odometry(settings.odometry)
 {
+    m_tracks.reserve(utility::kTrackCount);
 }
 
 void RadarProcessingPipeline::initialize(const utility::VehicleParameters* parameters)
@@ -59,6 +129,17 @@ void RadarProcessingPipeline::initialize(const utility::VehicleParameters* param
     m_parameters = parameters;
 }
 
+void RadarProcessingPipeline::applySettings(const ProcessingSettings& settings)
+{
+    m_settings = settings;
+    m_odometry.updateSettings(settings.odometry);
+}
+
+const ProcessingSettings& RadarProcessingPipeline::settings() const noexcept
+{
+    return m_settings;
+}
+
 void RadarProcessingPipeline::updateVehicleState(const utility::VehicleMotionState& state)
 {
     m_motionState = state;
@@ -87,6 +168,7 @@ bool RadarProcessingPipeline::processCornerDetections(utility::SensorIndex senso
     const auto& calibration = m_parameters->radarCalibrations[static_cast<std::size_t>(sensor)];
     if (!m_hasExternalMotionState)
     {
+        const StageProfiler::Scope scope(m_profiler, m_profileStages[ProfileOdometry], output.detections.size());
         if (m_odometry.processDetections(calibration, output))
         {
             m_odometry.latestEstimate(m_lastOdometry);
@@ -125,6 +207,7 @@ bool RadarProcessingPipeline::processFrontDetections(std::uint64_t timestamp_us,
     if (!m_hasExternalMotionState)
     {
         const auto& calibration = m_parameters->radarCalibrations[static_cast<std::size_t>(utility::SensorIndex::FrontShort)];
+        const StageProfiler::Scope scope(m_profiler, m_profileStages[ProfileOdometry], outputShort.detections.size());
         if (m_odometry.processDetections(calibration, outputShort))
         {
             m_odometry.latestEstimate(m_lastOdometry);
@@ -137,23 +220,126 @@ bool RadarProcessingPipeline::processFrontDetections(std::uint64_t timestamp_us,
     return (updateShort && updateLong) ? m_lastOdometry.valid : false;
 }
 
+bool RadarProcessingPipeline::processCornerBatch(utility::SensorIndex sensor,
+                                                 std::span<const std::uint64_t> timestamps_us,
+                                                 std::span<const utility::RawCornerDetections> frames,
+                                                 std::span<const TrackSnapshot> tracks,
+                                                 ProcessedBatch& output)
+{
+    output.clear();
+    if (!m_parameters || timestamps_us.size() != frames.size())
+    {
+        return false;
+    }
+
+    reserveBatch(output, frames.size(), utility::kCornerReturnCount);
+    const std::uint64_t delayUs = utility::secondsToMicroseconds(m_parameters->cornerHardwareDelay_s);
+    const FusedContext context = fusedContext(sensor, true);
+    BatchAppend append{output};
+    std::size_t nextSnapshot = 0U;
+    sizeTrackBoxes();
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        if (i + 1U < frames.size())
+        {
+            prefetchRecord(&frames[i + 1U], sizeof(utility::RawCornerDetections));
+        }
+        const utility::RawCornerDetections& input = frames[i];
+        const std::uint64_t timestamp_us = timestamps_us[i];
+        applyTrackSnapshots(tracks, nextSnapshot, timestamp_us, output);
+        beginBatchFrame(timestamp_us, output);
+
+        const bool updateValid = updateSensorStatus(sensor, input.header.timestamp_us);
+        predictTrackBoxes(timestamp_us > delayUs ? timestamp_us - delayUs : 0U);
+        fuseReturns(context, input, 0U, utility::kCornerReturnCount, append);
+        const bool odometryValid = finishFusedOdometry(input.header.timestamp_us);
+        endBatchFrame(updateValid ? odometryValid : false, output);
+    }
+    applyTrackSnapshots(tracks, nextSnapshot, std::numeric_limits<std::uint64_t>::max(), output);
+    return true;
+}
+
+bool RadarProcessingPipeline::processFrontBatch(std::span<const std::uint64_t> timestamps_us,
+                                                std::span<const utility::RawFrontDetections> frames,
+                                                std::span<const TrackSnapshot> tracks,
+                                                ProcessedBatch& output)
+{
+    output.clear();
+    if (!m_parameters || timestamps_us.size() != frames.size())
+    {
+        return false;
+    }
+
+    constexpr std::size_t kShortCount = utility::kCornerReturnCount;
+    constexpr std::size_t kLongCount = utility::kFrontReturnCount - utility::kCornerReturnCount;
+    reserveBatch(output, frames.size(), utility::kFrontReturnCount);
+    const std::uint64_t delayUs = utility::secondsToMicroseconds(m_parameters->frontCenterHardwareDelay_s);
+    // Odometry only uses the short-range half, as in processFrontDetections().
+    const FusedContext shortContext = fusedContext(utility::SensorIndex::FrontShort, true);
+    const FusedContext longContext = fusedContext(utility::SensorIndex::FrontLong, false);
+    BatchAppend append{output};
+    std::size_t nextSnapshot = 0U;
+    sizeTrackBoxes();
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        if (i + 1U < frames.size())
+        {
+            prefetchRecord(&frames[i + 1U], sizeof(utility::RawFrontDetections));
+        }
+        const utility::RawFrontDetections& input = frames[i];
+        const std::uint64_t timestamp_us = timestamps_us[i];
+        applyTrackSnapshots(tracks, nextSnapshot, timestamp_us, output);
+        beginBatchFrame(timestamp_us, output);
+
+        const bool updateShort = updateSensorStatus(utility::SensorIndex::FrontShort, input.header.timestamp_us);
+        const bool updateLong = updateSensorStatus(utility::SensorIndex::FrontLong, input.header.timestamp_us);
+        predictTrackBoxes(timestamp_us > delayUs ? timestamp_us - delayUs : 0U);
+        fuseReturns(shortContext, input, 0U, kShortCount, append);
+        fuseReturns(longContext, input, kShortCount, kLongCount, append);
+        const bool odometryValid = finishFusedOdometry(input.header.timestamp_us);
+        endBatchFrame((updateShort && updateLong) ? odometryValid : false, output);
+    }
+    applyTrackSnapshots(tracks, nextSnapshot, std::numeric_limits<std::uint64_t>::max(), output);
+    return true;
+}
+
+void RadarProcessingPipeline::applyTrackSnapshots(std::span<const TrackSnapshot> tracks,
+                                                  std::size_t& next,
+                                                  std::uint64_t timestamp_us,
+                                                  ProcessedBatch& output)
+{
+    const std::size_t first = next;
+    for (; next < tracks.size() && tracks[next].timestamp_us <= timestamp_us; ++next)
+    {
+        if (tracks[next].tracks)
+        {
+            processTrackFusion(tracks[next].timestamp_us, *tracks[next].tracks, output.tracks);
+        }
+    }
+    if (next != first)
+    {
+        sizeTrackBoxes();
+    }
+}
+
 void RadarProcessingPipeline::processTrackFusion(std::uint64_t timestamp_us,
                                                  const utility::RawTrackFusion& input,
                                                  utility::EnhancedTracks& output)
 {
+    static_assert(utility::kTrackCount <= 256U, "track slots are compacted into 8-bit indices");
+
+    // Most of the fixed-size record is Invalid padding: gather the valid slots first, then fill both outputs
+    // in place from that list. Both vectors keep their capacity, so steady-state frames do not allocate.
+    std::array<std::uint8_t, utility::kTrackCount> validSlots{};
+    const std::size_t count = compactNonZeroIndices(input.status.data(), utility::kTrackCount, validSlots.data());
     output.timestamp_us = timestamp_us;
-    output.tracks.clear();
-    m_tracks.clear();
+    output.tracks.resize(count);
+    m_tracks.resize(count);
 
-    for (std::size_t i = 0; i < utility::kTrackCount; ++i)
+    for (std::size_t n = 0; n < count; ++n)
     {
-        const auto status = static_cast<utility::TrackStatus>(input.status[i]);
-        if (status == utility::TrackStatus::Invalid)
-        {
-            continue;
-        }
-
-        utility::EnhancedTrack track;
+        const std::size_t i = validSlots[n];
+        utility::EnhancedTrack& track = output.tracks[n];
         track.vcsLongitudinalPosition = input.vcsLongitudinalPosition[i];
         track.vcsLateralPosition = input.vcsLateralPosition[i];
         track.vcsLateralVelocity = input.vcsLateralVelocity[i];
@@ -173,11 +359,9 @@ void RadarProcessingPipeline::processTrackFusion(std::uint64_t timestamp_us,
         track.isStationary = input.stationaryFlag[i] != 0U;
         track.isMoveable = input.moveableFlag[i] != 0U;
         track.isVehicle = input.vehicleFlag[i] != 0U;
-        track.status = status;
-
-        output.tracks.push_back(track);
+        track.status = static_cast<utility::TrackStatus>(input.status[i]);
 
-        TrackState state;
+        TrackState& state = m_tracks[n];
         state.position = glm::vec2(track.vcsLongitudinalPosition, track.vcsLateralPosition);
         state.velocity = glm::vec2(track.vcsLongitudinalVelocity, track.vcsLateralVelocity);
         state.acceleration = glm::vec2(track.vcsLongitudinalAcceleration, track.vcsLateralAcceleration);
@@ -189,7 +373,31 @@ void RadarProcessingPipeline::processTrackFusion(std::uint64_t timestamp_us,
         state.isStationary = track.isStationary;
         state.isMoveable = track.isMoveable;
         state.movingVotes = 0.0f;
-        m_tracks.push_back(state);
+    }
+
+    m_tracksTimestamp_us = timestamp_us;
+}
+
+void RadarProcessingPipeline::processTrackColumns(std::uint64_t timestamp_us,
+                                                  const TrackColumns& input,
+                                                  std::size_t count)
+{
+    count = std::min(count, utility::kTrackCount);
+    m_tracks.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        TrackState& state = m_tracks[i];
+        state.position = glm::vec2(input.vcsLongitudinalPosition[i], input.vcsLateralPosition[i]);
+        state.velocity = glm::vec2(input.vcsLongitudinalVelocity[i], input.vcsLateralVelocity[i]);
+        state.acceleration = glm::vec2(input.vcsLongitudinalAcceleration[i], input.vcsLateralAcceleration[i]);
+        state.length = input.length[i];
+        state.width = input.width[i];
+        state.height = input.height[i];
+        state.heading = input.vcsHeading[i];
+        state.headingRate = input.vcsHeadingRate[i];
+        state.isStationary = input.stationaryFlag[i] != 0U;
+        state.isMoveable = input.moveableFlag[i] != 0U;
+        state.movingVotes = 0.0f;
     }
 
     m_tracksTimestamp_us = timestamp_us;
@@ -201,6 +409,18 @@ bool RadarProcessingPipeline::latestOdometry(utility::OdometryEstimate& out) con
     return m_lastOdometry.valid;
 }
 
+void RadarProcessingPipeline::setProfiler(StageProfiler* profiler)
+{
+    m_profiler = profiler;
+    if (m_profiler)
+    {
+        m_profileStages[ProfileClassify] = m_profiler->addStage("pipeline.classifyDetections");
+        m_profileStages[ProfileAssociate] = m_profiler->addStage("pipeline.associateDetections");
+        m_profileStages[ProfileOdometry] = m_profiler->addStage("pipeline.odometry");
+        m_profileStages[ProfileFused] = m_profiler->addStage("pipeline.fusedDetections");
+    }
+}
+
 bool RadarProcessingPipeline::updateSensorStatus(utility::SensorIndex sensor, std::uint64_t timestamp_us)
 {
     auto& state = m_sensorStates[static_cast<std::size_t>(sensor)];
@@ -223,6 +443,151 @@ bool RadarProcessingPipeline::updateSensorStatus(utility::SensorIndex sensor, st
     return false;
 }
 
+std::uint64_t RadarProcessingPipeline::observationTime(std::uint64_t timestamp_us, float hardwareDelay_s) const
+{
+    const std::uint64_t delayUs = utility::secondsToMicroseconds(hardwareDelay_s);
+    return timestamp_us > delayUs ? timestamp_us - delayUs : 0U;
+}
+
+void RadarProcessingPipeline::prepareTrackBoxes(std::uint64_t timestamp_us)
+{
+    sizeTrackBoxes();
+    predictTrackBoxes(timestamp_us);
+}
+
+void RadarProcessingPipeline::sizeTrackBoxes()
+{
+    const float boxScale = m_settings.association.boundingBoxScale;
+    m_trackBoxes.resize(m_tracks.size());
+    for (std::size_t i = 0; i < m_tracks.size(); ++i)
+    {
+        m_trackBoxes[i].halfLength = std::max(m_tracks[i].length, 0.1f) * 0.5f * boxScale;
+        m_trackBoxes[i].halfWidth = std::max(m_tracks[i].width, 0.1f) * 0.5f * boxScale;
+    }
+}
+
+void RadarProcessingPipeline::predictTrackBoxes(std::uint64_t timestamp_us)
+{
+    const float dt_s = utility::microsecondsToSeconds<float>(timestamp_us > m_tracksTimestamp_us
+                                                                ? timestamp_us - m_tracksTimestamp_us
+                                                                : 0U);
+    for (std::size_t i = 0; i < m_tracks.size(); ++i)
+    {
+        const TrackState& track = m_tracks[i];
+        const float heading = track.heading + track.headingRate * dt_s;
+        TrackBox& box = m_trackBoxes[i];
+        box.center = track.position + (track.velocity * dt_s) + (track.acceleration * (0.5f * dt_s * dt_s));
+        box.cosHeading = std::cos(-heading);
+        box.sinHeading = std::sin(-heading);
+    }
+}
+
+RadarProcessingPipeline::FusedContext RadarProcessingPipeline::fusedContext(utility::SensorIndex sensor,
+                                                                            bool collectOdometry) const
+{
+    FusedContext context;
+    context.sensor = sensor;
+    context.calibration = &m_parameters->radarCalibrations[static_cast<std::size_t>(sensor)];
+    const float sigmaRangeRate = context.calibration->rangeRateAccuracy_mps / 3.0f;
+    context.rangeRateVar = utility::squared(std::max(0.01f, sigmaRangeRate));
+    context.collectOdometry = collectOdometry && !m_hasExternalMotionState;
+    return context;
+}
+
+void RadarProcessingPipeline::fuseDetection(const FusedContext& context, utility::EnhancedDetection& det)
+{
+    const auto& calibration = *context.calibration;
+    // One angle (and one sin/cos pair) serves classification, the association range-rate model and odometry.
+    const float detAngle = detectionAngleRad(det, calibration);
+    const float cosAngle = std::cos(detAngle);
+    const float sinAngle = std::sin(detAngle);
+    const float rangeRateScale = std::sqrt(std::max(context.rangeRateVar, 1e-4f));
+
+    const float yawTerm = m_motionState.yawRate_rps *
+                          ((calibration.iso.longitudinal_m * sinAngle) - (calibration.iso.lateral_m * cosAngle));
+    const float compensatedRangeRate = det.rangeRate_ms + yawTerm;
+    const float predictedStationary = -(m_motionState.vLon_mps * cosAngle + m_motionState.vLat_mps * sinAngle);
+    const float stationaryDistance = std::abs(compensatedRangeRate - predictedStationary) / rangeRateScale;
+    det.isStationary = static_cast<std::uint8_t>(stationaryDistance <= m_settings.stationary.nSigma);
+    det.stationaryProbability = std::clamp(stationaryProbabilityFromDistance(stationaryDistance), 0.0f, 1.0f);
+    det.isStatic = det.isStationary;
+
+    const std::uint8_t validMask = static_cast<std::uint8_t>(utility::DetectionFlag::Valid) |
+                                   static_cast<std::uint8_t>(utility::DetectionFlag::SuperResolution);
+    if ((det.flags & validMask) == 0U)
+    {
+        return;
+    }
+
+    if (context.collectOdometry && std::isfinite(det.rangeRate_ms))
+    {
+        m_odometrySamples.push_back({cosAngle, sinAngle, det.rangeRate_ms});
+    }
+
+    if (m_trackBoxes.empty())
+    {
+        return;
+    }
+
+    const glm::vec2 detPos = detectionPositionVcs(det, calibration);
+    float bestDistance = std::numeric_limits<float>::max();
+    std::size_t bestIndex = m_trackBoxes.size();
+    for (std::size_t i = 0; i < m_trackBoxes.size(); ++i)
+    {
+        const TrackBox& box = m_trackBoxes[i];
+        const glm::vec2 delta = detPos - box.center;
+        const float localX = delta.x * box.cosHeading - delta.y * box.sinHeading;
+        const float localY = delta.x * box.sinHeading + delta.y * box.cosHeading;
+        if (!(std::abs(localX) <= box.halfLength && std::abs(localY) <= box.halfWidth))
+        {
+            continue;
+        }
+
+        const glm::vec2 relativeVelocity =
+            glm::vec2(m_motionState.vLon_mps, m_motionState.vLat_mps) - m_tracks[i].velocity;
+        const float predictedRangeRate = relativeVelocity.x * -cosAngle + relativeVelocity.y * -sinAngle;
+        const float mDist = std::abs(det.rangeRate_ms - predictedRangeRate) / rangeRateScale;
+        if (mDist <= m_settings.association.rangeRateSigma && mDist < bestDistance)
+        {
+            bestDistance = mDist;
+            bestIndex = i;
+        }
+    }
+
+    if (bestIndex < m_trackBoxes.size())
+    {
+        auto& track = m_tracks[bestIndex];
+        std::uint8_t moveable = track.isMoveable ? 1U : 0U;
+        if (!track.isMoveable)
+        {
+            const float vote = det.isStationary ? -det.stationaryProbability : (1.0f - det.stationaryProbability);
+            track.movingVotes = utility::clamp(track.movingVotes + vote, -100.0f, 100.0f);
+            moveable = track.movingVotes > 0.0f ? 1U : 0U;
+        }
+
+        det.isMoveable = moveable;
+        det.isStatic = static_cast<std::uint8_t>((det.isStationary != 0U) && (det.isMoveable == 0U));
+        det.fusedTrackIndex = static_cast<std::int8_t>(bestIndex);
+    }
+}
+
+bool RadarProcessingPipeline::finishFusedOdometry(std::uint64_t timestamp_us)
+{
+    if (!m_hasExternalMotionState)
+    {
+        const StageProfiler::Scope scope(m_profiler, m_profileStages[ProfileOdometry], m_odometrySamples.size());
+        if (m_odometry.processSamples(m_odometrySamples, timestamp_us))
+        {
+            m_odometry.latestEstimate(m_lastOdometry);
+            m_motionState.vLon_mps = m_lastOdometry.vLon_mps;
+            m_motionState.vLat_mps = m_lastOdometry.vLat_mps;
+            m_motionState.yawRate_rps = m_lastOdometry.yawRate_rps;
+        }
+    }
+    m_odometrySamples.clear();
+    return m_lastOdometry.valid;
+}
+
 void RadarProcessingPipeline::mapCornerDetections(const utility::RawCornerDetections& input,
                                                   utility::EnhancedDetections& output) const
 {
@@ -284,6 +649,7 @@ void RadarProcessingPipeline::classifyDetections(utility::SensorIndex sensor,
                                                  std::uint64_t /*timestamp_us*/,
                                                  utility::EnhancedDetections& detections)
 {
+    const StageProfiler::Scope scope(m_profiler, m_profileStages[ProfileClassify], detections.detections.size());
     const auto& calibration = m_parameters->radarCalibrations[static_cast<std::size_t>(sensor)];
     const float sigmaRangeRate = calibration.rangeRateAccuracy_mps / 3.0f;
     const float rangeRateVar = utility::squared(std::max(0.01f, sigmaRangeRate));
@@ -318,6 +684,7 @@ void RadarProcessingPipeline::associateDetections(utility::SensorIndex sensor,
         return;
     }
 
+    const StageProfiler::Scope scope(m_profiler, m_profileStages[ProfileAssociate], detections.detections.size());
     const auto& calibration = m_parameters->radarCalibrations[static_cast<std::size_t>(sensor)];
     const float sigmaRangeRate = calibration.rangeRateAccuracy_mps / 3.0f;
     const float rangeRateVar = utility::squared(std::max(0.01f, sigmaRangeRate));
@@ -326,9 +693,9 @@ void RadarProcessingPipeline::associateDetections(utility::SensorIndex sensor,
                                                                 ? timestamp_us - m_tracksTimestamp_us
                                                                 : 0U);
 
-    std::vector<OrientedBox> boxes;
+    ScratchVector<OrientedBox> boxes;
     boxes.reserve(m_tracks.size());
-    std::vector<glm::vec2> centers;
+    ScratchVector<glm::vec2> centers;
     centers.reserve(m_tracks.size());
 
     for (const auto& track : m_tracks)
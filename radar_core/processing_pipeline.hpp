@@ -2,21 +2,59 @@
 
 #include <array>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "radar_core/odometry_estimator.hpp"
+#include "radar_core/perf_counters.hpp"
 #include "radar_core/processing_common.hpp"
 #include "utility/radar_types.hpp"
 
 namespace radar::core
 {
 
+// Track record that becomes the association state of a batch call before its first frame with
+// timestamp_us >= this timestamp_us.
+struct TrackSnapshot
+{
+    std::uint64_t timestamp_us = 0U;
+    const utility::RawTrackFusion* tracks = nullptr;
+};
+
+// Output arena of the batch calls: the emitted detections of every frame back to back, with the sensor and
+// record slot of each in parallel arrays. Reused across calls, so steady-state batches do not allocate.
+struct ProcessedBatch
+{
+    struct Frame
+    {
+        std::uint64_t timestamp_us = 0U;
+        // [first, first + count) of detections.
+        std::uint32_t first = 0U;
+        std::uint32_t count = 0U;
+        // What the per-frame call would have returned.
+        bool valid = false;
+    };
+
+    ScratchVector<Frame> frames;
+    ScratchVector<utility::EnhancedDetection> detections;
+    ScratchVector<utility::SensorIndex> sensors;
+    ScratchVector<std::uint8_t> slots;
+    // The last track snapshot applied, as processTrackFusion() returns it.
+    utility::EnhancedTracks tracks;
+
+    std::span<const utility::EnhancedDetection> frameDetections(std::size_t frame) const;
+    void clear();
+};
+
 class RadarProcessingPipeline
 {
 public:
     explicit RadarProcessingPipeline(ProcessingSettings settings = {});
 
     void initialize(const utility::VehicleParameters* parameters);
+    // Swaps thresholds in place; track, sensor and odometry state carry over.
+    void applySettings(const ProcessingSettings& settings);
+    const ProcessingSettings& settings() const noexcept;
     void updateVehicleState(const utility::VehicleMotionState& state);
 
     bool processCornerDetections(utility::SensorIndex sensor,
@@ -29,12 +67,72 @@ public:
                                 utility::EnhancedDetections& outputShort,
                                 utility::EnhancedDetections& outputLong);
 
+    // Single-pass variants of the two calls above. Each raw return is read from its columns once; padding
+    // returns are skipped, the rest are classified, associated, fed to odometry and handed to
+    // emit(sensor, slot, detection) in slot order, without materializing EnhancedDetections. slot indexes the
+    // sensor's half of the record (FrontLong starts at 0). Classification and track state end up identical to
+    // the staged calls.
+    template <typename Emit>
+    bool processCornerDetectionsFused(utility::SensorIndex sensor,
+                                      std::uint64_t timestamp_us,
+                                      const utility::RawCornerDetections& input,
+                                      Emit&& emit);
+
+    template <typename Emit>
+    bool processFrontDetectionsFused(std::uint64_t timestamp_us,
+                                     const utility::RawFrontDetections& input,
+                                     Emit&& emit);
+
+    // Columnar variants of the fused calls for embedders: returns [first, first + count) of caller-owned
+    // columns form one corner scan, or one front scan whose first shortCount returns are the short-range half.
+    // scanTimestamp_us is the scan header time the records carry in header.timestamp_us.
+    template <typename Emit>
+    bool processCornerColumnsFused(utility::SensorIndex sensor,
+                                   std::uint64_t timestamp_us,
+                                   std::uint64_t scanTimestamp_us,
+                                   const DetectionColumns& input,
+                                   std::size_t first,
+                                   std::size_t count,
+                                   Emit&& emit);
+
+    template <typename Emit>
+    bool processFrontColumnsFused(std::uint64_t timestamp_us,
+                                  std::uint64_t scanTimestamp_us,
+                                  const DetectionColumns& input,
+                                  std::size_t first,
+                                  std::size_t shortCount,
+                                  std::size_t longCount,
+                                  Emit&& emit);
+
+    // Batch variants of the fused calls for offline runs: timestamps_us[i] is the timestamp_us of frames[i], and
+    // each snapshot is applied with processTrackFusion() before the first frame at or after its time (the rest
+    // after the last frame). Results and state match calling the per-frame API in that order, but calibration,
+    // variances and track box sizes are set up once per call (box sizes once per snapshot) and the next record
+    // is prefetched while the current one is processed. output is cleared first; returns false, with output
+    // empty, when the pipeline is not initialized or the two spans differ in size.
+    bool processCornerBatch(utility::SensorIndex sensor,
+                            std::span<const std::uint64_t> timestamps_us,
+                            std::span<const utility::RawCornerDetections> frames,
+                            std::span<const TrackSnapshot> tracks,
+                            ProcessedBatch& output);
+    bool processFrontBatch(std::span<const std::uint64_t> timestamps_us,
+                           std::span<const utility::RawFrontDetections> frames,
+                           std::span<const TrackSnapshot> tracks,
+                           ProcessedBatch& output);
+
     void processTrackFusion(std::uint64_t timestamp_us,
                             const utility::RawTrackFusion& input,
                             utility::EnhancedTracks& output);
 
+    // Replaces the association state with count live tracks, as processTrackFusion() does for a record.
+    // count must not exceed utility::kTrackCount.
+    void processTrackColumns(std::uint64_t timestamp_us, const TrackColumns& input, std::size_t count);
+
     bool latestOdometry(utility::OdometryEstimate& out) const noexcept;
 
+    // Optional per-stage profiling; the profiler must outlive the pipeline or be cleared with nullptr.
+    void setProfiler(StageProfiler* profiler);
+
 private:
     struct SensorUpdateState
     {
@@ -58,8 +156,66 @@ private:
         float movingVotes = 0.0f;
     };
 
+    // Track box of the fused path with its rotation precomputed once per frame instead of per detection.
+    struct TrackBox
+    {
+        glm::vec2 center{0.0f};
+        float halfLength = 0.0f;
+        float halfWidth = 0.0f;
+        float cosHeading = 1.0f;
+        float sinHeading = 0.0f;
+    };
+
+    struct FusedContext
+    {
+        utility::SensorIndex sensor = utility::SensorIndex::FrontLeft;
+        const utility::RadarCalibration* calibration = nullptr;
+        float rangeRateVar = 0.0f;
+        bool collectOdometry = false;
+    };
+
     bool updateSensorStatus(utility::SensorIndex sensor, std::uint64_t timestamp_us);
 
+    // Shared bodies of the record and columnar fused calls.
+    template <typename Raw, typename Emit>
+    bool fuseCornerScan(utility::SensorIndex sensor,
+                        std::uint64_t timestamp_us,
+                        std::uint64_t scanTimestamp_us,
+                        const Raw& input,
+                        std::size_t first,
+                        std::size_t count,
+                        Emit& emit);
+    template <typename Raw, typename Emit>
+    bool fuseFrontScan(std::uint64_t timestamp_us,
+                       std::uint64_t scanTimestamp_us,
+                       const Raw& input,
+                       std::size_t first,
+                       std::size_t shortCount,
+                       std::size_t longCount,
+                       Emit& emit);
+
+    std::uint64_t observationTime(std::uint64_t timestamp_us, float hardwareDelay_s) const;
+    void prepareTrackBoxes(std::uint64_t timestamp_us);
+    // The two halves of prepareTrackBoxes(): box sizes depend only on the tracks and settings, centers and
+    // rotations on the time they are predicted to.
+    void sizeTrackBoxes();
+    void predictTrackBoxes(std::uint64_t timestamp_us);
+    // Applies the snapshots from next on that are due at timestamp_us and advances next past them.
+    void applyTrackSnapshots(std::span<const TrackSnapshot> tracks,
+                             std::size_t& next,
+                             std::uint64_t timestamp_us,
+                             ProcessedBatch& output);
+    FusedContext fusedContext(utility::SensorIndex sensor, bool collectOdometry) const;
+    template <typename Raw, typename Emit>
+    void fuseReturns(const FusedContext& context,
+                     const Raw& input,
+                     std::size_t first,
+                     std::size_t count,
+                     Emit& emit);
+    void fuseDetection(const FusedContext& context, utility::EnhancedDetection& det);
+    // Runs odometry on the samples collected by fuseDetection() and returns the latest estimate's validity.
+    bool finishFusedOdometry(std::uint64_t timestamp_us);
+
     void mapCornerDetections(const utility::RawCornerDetections& input,
                              utility::EnhancedDetections& output) const;
     void mapFrontDetections(const utility::RawFrontDetections& input,
@@ -80,7 +236,7 @@ private:
     const utility::VehicleParameters* m_parameters = nullptr;
 
     std::array<SensorUpdateState, static_cast<std::size_t>(utility::SensorIndex::Count)> m_sensorStates{};
-    std::vector<TrackState> m_tracks;
+    ScratchVector<TrackState> m_tracks;
     std::uint64_t m_tracksTimestamp_us = 0U;
 
     utility::VehicleMotionState m_motionState{};
@@ -88,6 +244,152 @@ private:
 
     RadarOdometryEstimator m_odometry;
     utility::OdometryEstimate m_lastOdometry{};
+
+    ScratchVector<TrackBox> m_trackBoxes;
+    ScratchVector<OdometrySample> m_odometrySamples;
+
+    enum ProfileStage : std::size_t
+    {
+        ProfileClassify = 0,
+        ProfileAssociate,
+        ProfileOdometry,
+        ProfileFused,
+        ProfileStageCount
+    };
+
+    StageProfiler* m_profiler = nullptr;
+    std::array<std::size_t, ProfileStageCount> m_profileStages{};
 };
 
+template <typename Emit>
+bool RadarProcessingPipeline::processCornerDetectionsFused(utility::SensorIndex sensor,
+                                                           std::uint64_t timestamp_us,
+                                                           const utility::RawCornerDetections& input,
+                                                           Emit&& emit)
+{
+    return fuseCornerScan(sensor, timestamp_us, input.header.timestamp_us, input, 0U, utility::kCornerReturnCount, emit);
+}
+
+template <typename Emit>
+bool RadarProcessingPipeline::processFrontDetectionsFused(std::uint64_t timestamp_us,
+                                                          const utility::RawFrontDetections& input,
+                                                          Emit&& emit)
+{
+    return fuseFrontScan(timestamp_us,
+                         input.header.timestamp_us,
+                         input,
+                         0U,
+                         utility::kCornerReturnCount,
+                         utility::kFrontReturnCount - utility::kCornerReturnCount,
+                         emit);
+}
+
+template <typename Emit>
+bool RadarProcessingPipeline::processCornerColumnsFused(utility::SensorIndex sensor,
+                                                        std::uint64_t timestamp_us,
+                                                        std::uint64_t scanTimestamp_us,
+                                                        const DetectionColumns& input,
+                                                        std::size_t first,
+                                                        std::size_t count,
+                                                        Emit&& emit)
+{
+    return fuseCornerScan(sensor, timestamp_us, scanTimestamp_us, input, first, count, emit);
+}
+
+template <typename Emit>
+bool RadarProcessingPipeline::processFrontColumnsFused(std::uint64_t timestamp_us,
+                                                       std::uint64_t scanTimestamp_us,
+                                                       const DetectionColumns& input,
+                                                       std::size_t first,
+                                                       std::size_t shortCount,
+                                                       std::size_t longCount,
+                                                       Emit&& emit)
+{
+    return fuseFrontScan(timestamp_us, scanTimestamp_us, input, first, shortCount, longCount, emit);
+}
+
+template <typename Raw, typename Emit>
+bool RadarProcessingPipeline::fuseCornerScan(utility::SensorIndex sensor,
+                                             std::uint64_t timestamp_us,
+                                             std::uint64_t scanTimestamp_us,
+                                             const Raw& input,
+                                             std::size_t first,
+                                             std::size_t count,
+                                             Emit& emit)
+{
+    if (!m_parameters)
+    {
+        return false;
+    }
+
+    const bool updateValid = updateSensorStatus(sensor, scanTimestamp_us);
+    prepareTrackBoxes(observationTime(timestamp_us, m_parameters->cornerHardwareDelay_s));
+    fuseReturns(fusedContext(sensor, true), input, first, count, emit);
+    const bool odometryValid = finishFusedOdometry(scanTimestamp_us);
+    return updateValid ? odometryValid : false;
+}
+
+template <typename Raw, typename Emit>
+bool RadarProcessingPipeline::fuseFrontScan(std::uint64_t timestamp_us,
+                                            std::uint64_t scanTimestamp_us,
+                                            const Raw& input,
+                                            std::size_t first,
+                                            std::size_t shortCount,
+                                            std::size_t longCount,
+                                            Emit& emit)
+{
+    if (!m_parameters)
+    {
+        return false;
+    }
+
+    const bool updateShort = updateSensorStatus(utility::SensorIndex::FrontShort, scanTimestamp_us);
+    const bool updateLong = updateSensorStatus(utility::SensorIndex::FrontLong, scanTimestamp_us);
+    prepareTrackBoxes(observationTime(timestamp_us, m_parameters->frontCenterHardwareDelay_s));
+    // Odometry only uses the short-range half, as in processFrontDetections().
+    fuseReturns(fusedContext(utility::SensorIndex::FrontShort, true), input, first, shortCount, emit);
+    fuseReturns(fusedContext(utility::SensorIndex::FrontLong, false), input, first + shortCount, longCount, emit);
+    const bool odometryValid = finishFusedOdometry(scanTimestamp_us);
+    return (updateShort && updateLong) ? odometryValid : false;
+}
+
+template <typename Raw, typename Emit>
+void RadarProcessingPipeline::fuseReturns(const FusedContext& context,
+                                          const Raw& input,
+                                          std::size_t first,
+                                          std::size_t count,
+                                          Emit& emit)
+{
+    const StageProfiler::Scope scope(m_profiler, m_profileStages[ProfileFused], count);
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        const std::size_t i = first + slot;
+        const std::uint8_t flags = utility::packDetectionFlags(input.radarValidReturn[i],
+                                                               input.superResolutionDetection[i],
+                                                               input.nearTargetDetection[i],
+                                                               input.hostVehicleClutter[i],
+                                                               input.multibounceDetection[i]);
+        // Padding slots of the fixed-size record: nothing to classify, associate or emit.
+        if (flags == 0U && input.range_m[i] <= 0.0f && input.longitudinalOffset_m[i] == 0.0f &&
+            input.lateralOffset_m[i] == 0.0f)
+        {
+            continue;
+        }
+
+        utility::EnhancedDetection det;
+        det.range_m = input.range_m[i];
+        det.rangeRate_ms = input.rangeRate_ms[i];
+        det.rangeRateRaw_ms = input.rangeRateRaw_ms[i];
+        det.azimuthRaw_rad = input.azimuthRaw_rad[i];
+        det.azimuth_rad = input.azimuth_rad[i];
+        det.amplitude_dBsm = input.amplitude_dBsm[i];
+        det.longitudinalOffset_m = input.longitudinalOffset_m[i];
+        det.lateralOffset_m = input.lateralOffset_m[i];
+        det.motionStatus = input.motionStatus[i];
+        det.flags = flags;
+        fuseDetection(context, det);
+        emit(context.sensor, slot, det);
+    }
+}
+
 } // namespace radar::core
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace radar::core
+{
+
+// Immutable, versioned settings snapshot.
+template <typename Settings>
+struct SettingsSnapshot
+{
+    std::uint64_t version = 0U;
+    Settings settings;
+};
+
+// RCU-style settings publication: a writer (config watcher, UI) publishes whole immutable snapshots and
+// workers adopt them at frame boundaries. Readers poll an atomic version counter, which is lock-free and
+// costs one load per frame; the shared_ptr is only loaded when the version changed. Old snapshots stay
+// alive until the last worker drops them, so a frame never sees a half-applied configuration.
+template <typename Settings>
+class SettingsChannel
+{
+public:
+    using Snapshot = SettingsSnapshot<Settings>;
+
+    explicit SettingsChannel(Settings initial = {})
+        : m_current(std::make_shared<const Snapshot>(Snapshot{1U, std::move(initial)}))
+    {
+    }
+
+    SettingsChannel(const SettingsChannel&) = delete;
+    SettingsChannel& operator=(const SettingsChannel&) = delete;
+
+    // Returns the new version. Publishers are expected to be serialized (one watcher per channel).
+    std::uint64_t publish(Settings settings)
+    {
+        const std::uint64_t version = m_version.load(std::memory_order_relaxed) + 1U;
+        m_current.store(std::make_shared<const Snapshot>(Snapshot{version, std::move(settings)}),
+                        std::memory_order_release);
+        m_version.store(version, std::memory_order_release);
+        return version;
+    }
+
+    std::uint64_t version() const noexcept
+    {
+        return m_version.load(std::memory_order_acquire);
+    }
+
+    std::shared_ptr<const Snapshot> snapshot() const
+    {
+        return m_current.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<std::shared_ptr<const Snapshot>> m_current;
+    std::atomic<std::uint64_t> m_version{1U};
+};
+
+// Per-worker view of a channel. Holds the adopted snapshot so settings() stays stable for the whole frame.
+template <typename Settings>
+class SettingsReader
+{
+public:
+    SettingsReader() = default;
+    explicit SettingsReader(std::shared_ptr<const SettingsChannel<Settings>> channel)
+        : m_channel(std::move(channel))
+    {
+    }
+
+    bool attached() const noexcept
+    {
+        return m_channel != nullptr;
+    }
+
+    // Call at a frame boundary. Returns true when a newer snapshot was adopted.
+    bool refresh()
+    {
+        if (!m_channel || m_channel->version() == adoptedVersion())
+        {
+            return false;
+        }
+        m_snapshot = m_channel->snapshot();
+        return true;
+    }
+
+    std::uint64_t adoptedVersion() const noexcept
+    {
+        return m_snapshot ? m_snapshot->version : 0U;
+    }
+
+    // Only valid after refresh() returned true at least once.
+    const Settings& settings() const noexcept
+    {
+        return m_snapshot->settings;
+    }
+
+private:
+    std::shared_ptr<const SettingsChannel<Settings>> m_channel;
+    std::shared_ptr<const typename SettingsChannel<Settings>::Snapshot> m_snapshot;
+};
+
+} // namespace radar::core
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <utility>
+
+namespace radar::core
+{
+
+// Coroutine that produces a stream of values and may wait for background I/O in between. The body co_yields
+// values (by reference: the value lives in the coroutine frame until the next resume()) and co_awaits a
+// std::future to pause until a background read has finished. A scheduler drives many of these on one thread:
+// resume() runs a coroutine only up to its next value or its next wait on a future that is not ready yet, so
+// while one stream waits for its read the others keep parsing.
+template <typename T>
+class StreamGenerator
+{
+public:
+    enum class State
+    {
+        // value() holds the next value.
+        Yielded,
+        // Suspended on a future that was not ready; resume() again once ready() holds.
+        Waiting,
+        Done
+    };
+
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // Suspends until the future is ready without consuming it; the body reads the result afterwards.
+    template <typename U>
+    struct FutureAwaiter
+    {
+        const std::future<U>& future;
+        promise_type& promise;
+
+        bool await_ready() const
+        {
+            return isReady(&future);
+        }
+
+        void await_suspend(Handle) noexcept
+        {
+            promise.awaited = &future;
+            promise.ready = &isReady;
+            promise.wait = &waitFor;
+        }
+
+        void await_resume() noexcept
+        {
+            promise.awaited = nullptr;
+        }
+
+        static bool isReady(const void* awaited)
+        {
+            return static_cast<const std::future<U>*>(awaited)->wait_for(std::chrono::seconds(0)) ==
+                   std::future_status::ready;
+        }
+
+        static void waitFor(const void* awaited)
+        {
+            static_cast<const std::future<U>*>(awaited)->wait();
+        }
+    };
+
+    struct promise_type
+    {
+        const T* value = nullptr;
+        const void* awaited = nullptr;
+        bool (*ready)(const void*) = nullptr;
+        void (*wait)(const void*) = nullptr;
+
+        StreamGenerator get_return_object() noexcept
+        {
+            return StreamGenerator(Handle::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always yield_value(const T& yielded) noexcept
+        {
+            value = &yielded;
+            return {};
+        }
+
+        template <typename U>
+        FutureAwaiter<U> await_transform(const std::future<U>& future) noexcept
+        {
+            return FutureAwaiter<U>{future, *this};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        // Stream bodies report failures by ending the stream; an escaping exception is a bug.
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    StreamGenerator() = default;
+
+    StreamGenerator(StreamGenerator&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, {}))
+    {
+    }
+
+    StreamGenerator& operator=(StreamGenerator&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    StreamGenerator(const StreamGenerator&) = delete;
+    StreamGenerator& operator=(const StreamGenerator&) = delete;
+
+    ~StreamGenerator()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(m_handle);
+    }
+
+    // Runs the body to its next co_yield, its next co_await on a future that is not ready, or its end. A
+    // Waiting generator must only be resumed again once ready() holds.
+    State resume()
+    {
+        if (!m_handle || m_handle.done())
+        {
+            return State::Done;
+        }
+        auto& promise = m_handle.promise();
+        promise.value = nullptr;
+        m_handle.resume();
+        if (m_handle.done())
+        {
+            return State::Done;
+        }
+        return promise.awaited ? State::Waiting : State::Yielded;
+    }
+
+    // True unless the body is suspended on a future that has not finished yet.
+    bool ready() const
+    {
+        const auto& promise = m_handle.promise();
+        return !promise.awaited || promise.ready(promise.awaited);
+    }
+
+    // Blocks until ready().
+    void wait() const
+    {
+        const auto& promise = m_handle.promise();
+        if (promise.awaited)
+        {
+            promise.wait(promise.awaited);
+        }
+    }
+
+    // Valid after resume() returned Yielded, until the next resume().
+    const T& value() const noexcept
+    {
+        return *m_handle.promise().value;
+    }
+
+private:
+    explicit StreamGenerator(Handle handle) noexcept
+        : m_handle(handle)
+    {
+    }
+
+    void reset() noexcept
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+            m_handle = {};
+        }
+    }
+
+    Handle m_handle;
+};
+
+} // namespace radar::core
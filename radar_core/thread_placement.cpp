@@ -0,0 +1,292 @@
+#include "radar_core/thread_placement.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace radar::core
+{
+namespace
+{
+bool parseInt(std::string_view text, int& value)
+{
+    const char* begin = text.data();
+    const char* end = text.data() + text.size();
+    const auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+std::string_view trim(std::string_view text)
+{
+    const auto first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    const auto last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1U);
+}
+
+bool parseRole(std::string_view name, ThreadRole& role)
+{
+    for (std::size_t i = 0; i < kThreadRoleCount; ++i)
+    {
+        if (name == threadRoleName(static_cast<ThreadRole>(i)))
+        {
+            role = static_cast<ThreadRole>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void appendCpuList(std::ostringstream& out, const std::vector<int>& cpus)
+{
+    if (cpus.empty())
+    {
+        out << "any";
+        return;
+    }
+    for (std::size_t i = 0; i < cpus.size(); ++i)
+    {
+        out << (i == 0U ? "" : ",") << cpus[i];
+    }
+}
+} // namespace
+
+const char* threadRoleName(ThreadRole role)
+{
+    switch (role)
+    {
+    case ThreadRole::Reader:
+        return "reader";
+    case ThreadRole::Render:
+        return "render";
+    case ThreadRole::Worker:
+        return "worker";
+    default:
+        return "?";
+    }
+}
+
+bool parseCpuList(std::string_view text, std::vector<int>& cpus)
+{
+    cpus.clear();
+    text = trim(text);
+    while (!text.empty())
+    {
+        const auto comma = text.find(',');
+        const std::string_view item = trim(text.substr(0, comma));
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1U);
+
+        const auto dash = item.find('-');
+        int first = 0;
+        int last = 0;
+        if (dash == std::string_view::npos)
+        {
+            if (!parseInt(item, first))
+            {
+                return false;
+            }
+            last = first;
+        }
+        else if (!parseInt(item.substr(0, dash), first) || !parseInt(item.substr(dash + 1U), last))
+        {
+            return false;
+        }
+
+        if (first < 0 || last < first || last >= kMaxCpuCount)
+        {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return !cpus.empty();
+}
+
+bool parseThreadPlacement(std::string_view spec, ThreadPlacementSettings& settings)
+{
+    ThreadPlacementSettings parsed;
+    while (!spec.empty())
+    {
+        const auto separator = spec.find(';');
+        const std::string_view entry = trim(spec.substr(0, separator));
+        spec = separator == std::string_view::npos ? std::string_view{} : spec.substr(separator + 1U);
+        if (entry.empty())
+        {
+            continue;
+        }
+        if (entry == "mlock")
+        {
+            parsed.lockMemory = true;
+            continue;
+        }
+
+        const auto equals = entry.find('=');
+        ThreadRole role = ThreadRole::Render;
+        if (equals == std::string_view::npos || !parseRole(trim(entry.substr(0, equals)), role))
+        {
+            return false;
+        }
+
+        std::string_view value = trim(entry.substr(equals + 1U));
+        ThreadPlacement& placement = parsed[role];
+        const auto at = value.find('@');
+        if (at != std::string_view::npos)
+        {
+            if (!parseInt(trim(value.substr(at + 1U)), placement.realtimePriority) ||
+                placement.realtimePriority < 1 || placement.realtimePriority > 99)
+            {
+                return false;
+            }
+            value = trim(value.substr(0, at));
+        }
+        if (!value.empty() && !parseCpuList(value, placement.cpus))
+        {
+            return false;
+        }
+    }
+
+    settings = std::move(parsed);
+    return true;
+}
+
+bool applyThreadPlacement(ThreadRole role,
+                          const ThreadPlacement& placement,
+                          const std::string& threadName,
+                          AppliedPlacement& applied)
+{
+    applied = AppliedPlacement{};
+    applied.role = role;
+    applied.threadName = threadName;
+    applied.requestedCpus = placement.cpus;
+    applied.requestedPriority = placement.realtimePriority;
+
+#if defined(__linux__)
+    const pthread_t self = pthread_self();
+    if (!threadName.empty())
+    {
+        // Kernel thread names are limited to 15 characters; the name only helps top -H / perf.
+        pthread_setname_np(self, threadName.substr(0, 15).c_str());
+    }
+
+    bool ok = true;
+    if (!placement.cpus.empty())
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (const int cpu : placement.cpus)
+        {
+            if (cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        const int result = pthread_setaffinity_np(self, sizeof(set), &set);
+        applied.affinityApplied = result == 0;
+        if (result != 0)
+        {
+            applied.error += std::string("affinity: ") + std::strerror(result) + "; ";
+            ok = false;
+        }
+    }
+
+    if (placement.realtimePriority > 0)
+    {
+        sched_param parameters{};
+        parameters.sched_priority = placement.realtimePriority;
+        const int result = pthread_setschedparam(self, SCHED_FIFO, &parameters);
+        applied.priorityApplied = result == 0;
+        if (result != 0)
+        {
+            applied.error += std::string("SCHED_FIFO: ") + std::strerror(result) + "; ";
+            ok = false;
+        }
+    }
+
+    cpu_set_t effective;
+    CPU_ZERO(&effective);
+    if (pthread_getaffinity_np(self, sizeof(effective), &effective) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &effective))
+            {
+                applied.effectiveCpus.push_back(cpu);
+            }
+        }
+    }
+    return ok;
+#else
+    if (placement.empty())
+    {
+        return true;
+    }
+    applied.error = "thread placement is not supported on this platform";
+    return false;
+#endif
+}
+
+bool lockProcessMemory(std::string& error)
+{
+#if defined(__linux__)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        error = std::string("mlockall: ") + std::strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    error = "memory locking is not supported on this platform";
+    return false;
+#endif
+}
+
+std::string formatPlacementReport(const std::vector<AppliedPlacement>& threads, bool memoryLocked)
+{
+    std::ostringstream out;
+    out << "Thread placement (memory " << (memoryLocked ? "locked" : "not locked") << ")\n";
+    for (const auto& thread : threads)
+    {
+        out << "  " << threadRoleName(thread.role);
+        if (!thread.threadName.empty())
+        {
+            out << " [" << thread.threadName << ']';
+        }
+        out << ": cpus requested=";
+        appendCpuList(out, thread.requestedCpus);
+        out << " effective=";
+        appendCpuList(out, thread.effectiveCpus);
+        out << ", policy=";
+        if (thread.requestedPriority > 0)
+        {
+            out << "SCHED_FIFO/" << thread.requestedPriority << (thread.priorityApplied ? "" : " (not applied)");
+        }
+        else
+        {
+            out << "default";
+        }
+        if (!thread.error.empty())
+        {
+            out << ", errors: " << thread.error;
+        }
+        out << '\n';
+    }
+    return out.str();
+}
+
+} // namespace radar::core
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace radar::core
+{
+
+// Engine thread roles. Processing runs inline on the render loop in both engines, so Render covers
+// "processing + GL"; Worker applies to every thread of a helper pool.
+enum class ThreadRole : std::uint8_t
+{
+    Reader = 0,
+    Render,
+    Worker,
+    Count
+};
+
+constexpr std::size_t kThreadRoleCount = static_cast<std::size_t>(ThreadRole::Count);
+
+struct ThreadPlacement
+{
+    // Allowed CPUs; empty leaves the inherited affinity untouched.
+    std::vector<int> cpus;
+    // SCHED_FIFO priority (1..99); 0 keeps the default time-sharing policy.
+    int realtimePriority = 0;
+
+    bool empty() const noexcept
+    {
+        return cpus.empty() && realtimePriority == 0;
+    }
+};
+
+struct ThreadPlacementSettings
+{
+    std::array<ThreadPlacement, kThreadRoleCount> roles{};
+    // mlockall(MCL_CURRENT | MCL_FUTURE) before the engine threads start, so page faults cannot stall them.
+    bool lockMemory = false;
+
+    bool empty() const noexcept
+    {
+        return !lockMemory && std::all_of(roles.begin(), roles.end(), [](const auto& role) { return role.empty(); });
+    }
+
+    const ThreadPlacement& operator[](ThreadRole role) const
+    {
+        return roles[static_cast<std::size_t>(role)];
+    }
+
+    ThreadPlacement& operator[](ThreadRole role)
+    {
+        return roles[static_cast<std::size_t>(role)];
+    }
+};
+
+// What was actually applied to one thread; failures are reported, never fatal.
+struct AppliedPlacement
+{
+    ThreadRole role = ThreadRole::Render;
+    std::string threadName;
+    std::vector<int> requestedCpus;
+    // Affinity read back after applying, i.e. the CPUs the thread can really run on.
+    std::vector<int> effectiveCpus;
+    int requestedPriority = 0;
+    bool affinityApplied = false;
+    bool priorityApplied = false;
+    std::string error;
+};
+
+const char* threadRoleName(ThreadRole role);
+
+// Upper bound on CPU indices accepted in a placement spec (Linux' CPU_SETSIZE is 1024).
+constexpr int kMaxCpuCount = 4096;
+
+// "2,4-6" -> {2, 4, 5, 6}. Returns false on malformed input or a CPU index of kMaxCpuCount or more.
+bool parseCpuList(std::string_view text, std::vector<int>& cpus);
+
+// Semicolon separated "role=cpus[@priority]" entries plus an optional "mlock" flag, e.g.
+// "reader=2;render=3@80;worker=4-7;mlock". Unknown roles make the whole spec invalid.
+bool parseThreadPlacement(std::string_view spec, ThreadPlacementSettings& settings);
+
+// Applies the placement to the calling thread and reads the result back. Returns false when any requested
+// part could not be applied (e.g. SCHED_FIFO without CAP_SYS_NICE); the reason is stored in applied.error.
+bool applyThreadPlacement(ThreadRole role,
+                          const ThreadPlacement& placement,
+                          const std::string& threadName,
+                          AppliedPlacement& applied);
+
+bool lockProcessMemory(std::string& error);
+
+std::string formatPlacementReport(const std::vector<AppliedPlacement>& threads, bool memoryLocked);
+
+} // namespace radar::core
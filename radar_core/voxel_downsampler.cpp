@@ -0,0 +1,167 @@
+#include "radar_core/voxel_downsampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace radar::core
+{
+namespace
+{
+constexpr std::size_t kMinSlotCount = 256U;
+constexpr std::uint64_t kAxisMask = (1ULL << 21U) - 1ULL;
+// Key layout: x and y 21 bits each, height 16 bits, sensor 6 bits.
+constexpr std::uint64_t kHeightMask = (1ULL << 16U) - 1ULL;
+constexpr std::uint64_t kSensorMask = (1ULL << 6U) - 1ULL;
+constexpr float kMinCellSize_m = 0.01f;
+
+std::uint64_t packAxis(float scaled)
+{
+    const auto index = static_cast<std::int64_t>(std::floor(scaled));
+    return static_cast<std::uint64_t>(index) & kAxisMask;
+}
+
+std::size_t hashKey(std::uint64_t key)
+{
+    // Fibonacci hashing spreads the packed cell coordinates across the table.
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 17U);
+}
+} // namespace
+
+VoxelDownsampler::VoxelDownsampler(VoxelDownsampleSettings settings)
+{
+    updateSettings(settings);
+}
+
+void VoxelDownsampler::updateSettings(const VoxelDownsampleSettings& settings)
+{
+    m_settings = settings;
+    m_inverseCellSize = 1.0f / std::max(kMinCellSize_m, m_settings.cellSize_m);
+    m_inverseCellHeight = m_settings.cellHeight_m > 0.0f ? 1.0f / std::max(kMinCellSize_m, m_settings.cellHeight_m)
+                                                         : 0.0f;
+}
+
+const VoxelDownsampleSettings& VoxelDownsampler::settings() const noexcept
+{
+    return m_settings;
+}
+
+void VoxelDownsampler::beginFrame(std::size_t expectedPoints)
+{
+    m_cells.clear();
+    m_cells.reserve(expectedPoints);
+    m_cellKeys.clear();
+    m_cellKeys.reserve(expectedPoints);
+    reserveSlots(expectedPoints);
+
+    // Slots are tagged with the frame epoch so the table never has to be cleared between frames.
+    ++m_epoch;
+    if (m_epoch == 0U)
+    {
+        std::fill(m_slots.begin(), m_slots.end(), Slot{});
+        m_epoch = 1U;
+    }
+}
+
+void VoxelDownsampler::addPoint(std::uint32_t index, const VoxelPointSample& sample)
+{
+    if (!std::isfinite(sample.x) || !std::isfinite(sample.y))
+    {
+        return;
+    }
+
+    if (m_cells.size() * 2U >= m_slots.size())
+    {
+        // More points than announced in beginFrame(); grow the table and re-insert the cells seen so far.
+        reserveSlots(m_slots.size());
+        m_epoch = 1U;
+        for (std::uint32_t cellIndex = 0; cellIndex < m_cellKeys.size(); ++cellIndex)
+        {
+            std::size_t slotIndex = hashKey(m_cellKeys[cellIndex]) & m_slotMask;
+            while (m_slots[slotIndex].epoch == m_epoch)
+            {
+                slotIndex = (slotIndex + 1U) & m_slotMask;
+            }
+            m_slots[slotIndex] = Slot{m_cellKeys[cellIndex], m_epoch, cellIndex};
+        }
+    }
+
+    const std::uint64_t key = cellKey(sample);
+    std::size_t slotIndex = hashKey(key) & m_slotMask;
+    while (true)
+    {
+        Slot& slot = m_slots[slotIndex];
+        if (slot.epoch != m_epoch)
+        {
+            slot.key = key;
+            slot.epoch = m_epoch;
+            slot.cell = static_cast<std::uint32_t>(m_cells.size());
+
+            VoxelCell cell;
+            cell.representative = index;
+            cell.count = 1U;
+            cell.amplitude_dBsm = sample.amplitude_dBsm;
+            cell.rangeRate_ms = sample.rangeRate_ms;
+            cell.stationaryProbability = sample.stationaryProbability;
+            m_cells.push_back(cell);
+            m_cellKeys.push_back(key);
+            return;
+        }
+
+        if (slot.key == key)
+        {
+            VoxelCell& cell = m_cells[slot.cell];
+            cell.count += 1U;
+            cell.rangeRate_ms += sample.rangeRate_ms;
+            cell.stationaryProbability += sample.stationaryProbability;
+            if (sample.amplitude_dBsm > cell.amplitude_dBsm)
+            {
+                cell.amplitude_dBsm = sample.amplitude_dBsm;
+                cell.representative = index;
+            }
+            return;
+        }
+
+        slotIndex = (slotIndex + 1U) & m_slotMask;
+    }
+}
+
+const std::vector<VoxelCell>& VoxelDownsampler::finishFrame()
+{
+    for (auto& cell : m_cells)
+    {
+        const float inverseCount = 1.0f / static_cast<float>(cell.count);
+        cell.rangeRate_ms *= inverseCount;
+        cell.stationaryProbability *= inverseCount;
+    }
+    return m_cells;
+}
+
+std::uint64_t VoxelDownsampler::cellKey(const VoxelPointSample& sample) const
+{
+    const std::uint64_t ix = packAxis(sample.x * m_inverseCellSize);
+    const std::uint64_t iy = packAxis(sample.y * m_inverseCellSize);
+    const std::uint64_t iz = m_inverseCellHeight > 0.0f && std::isfinite(sample.z)
+                                 ? packAxis(sample.z * m_inverseCellHeight) & kHeightMask
+                                 : 0U;
+    const std::uint64_t sensor = static_cast<std::uint64_t>(sample.sensor) & kSensorMask;
+    return ix | (iy << 21U) | (iz << 42U) | (sensor << 58U);
+}
+
+void VoxelDownsampler::reserveSlots(std::size_t expectedPoints)
+{
+    std::size_t required = kMinSlotCount;
+    while (required < expectedPoints * 2U)
+    {
+        required <<= 1U;
+    }
+    if (required <= m_slots.size())
+    {
+        return;
+    }
+
+    m_slots.assign(required, Slot{});
+    m_slotMask = required - 1U;
+    m_epoch = 0U;
+}
+
+} // namespace radar::core
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace radar::core
+{
+
+struct VoxelDownsampleSettings
+{
+    bool enabled = false;
+    float cellSize_m = 0.25f;
+    // Vertical cell extent; values <= 0 collapse all heights into a single layer (2-D cells).
+    float cellHeight_m = 0.0f;
+};
+
+struct VoxelPointSample
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float amplitude_dBsm = 0.0f;
+    float rangeRate_ms = 0.0f;
+    float stationaryProbability = 0.0f;
+    // Range rates are radial to the measuring radar, so returns of different sensors never share a cell.
+    std::int32_t sensor = 0;
+};
+
+// One output cell: the strongest return is kept as representative, range rate and stationary
+// probability are averaged over all returns of one sensor that fell into the cell. Other fields, such as
+// motion flags, are the representative's own.
+struct VoxelCell
+{
+    std::uint32_t representative = 0U;
+    std::uint32_t count = 0U;
+    float amplitude_dBsm = 0.0f;
+    float rangeRate_ms = 0.0f;
+    float stationaryProbability = 0.0f;
+};
+
+class VoxelDownsampler
+{
+public:
+    explicit VoxelDownsampler(VoxelDownsampleSettings settings = {});
+
+    void updateSettings(const VoxelDownsampleSettings& settings);
+    const VoxelDownsampleSettings& settings() const noexcept;
+
+    void beginFrame(std::size_t expectedPoints);
+    void addPoint(std::uint32_t index, const VoxelPointSample& sample);
+    const std::vector<VoxelCell>& finishFrame();
+
+    // Works on any point type exposing x/y/z, amplitude_dBsm, rangeRate_ms, stationaryProbability and sensorIndex.
+    template <typename Point>
+    void downsample(const std::vector<Point>& input, std::vector<Point>& output);
+
+private:
+    struct Slot
+    {
+        std::uint64_t key = 0U;
+        std::uint32_t epoch = 0U;
+        std::uint32_t cell = 0U;
+    };
+
+    std::uint64_t cellKey(const VoxelPointSample& sample) const;
+    void reserveSlots(std::size_t expectedPoints);
+
+    VoxelDownsampleSettings m_settings;
+    float m_inverseCellSize = 4.0f;
+    float m_inverseCellHeight = 0.0f;
+    std::vector<Slot> m_slots;
+    std::size_t m_slotMask = 0U;
+    std::uint32_t m_epoch = 0U;
+    std::vector<VoxelCell> m_cells;
+    std::vector<std::uint64_t> m_cellKeys;
+};
+
+template <typename Point>
+void VoxelDownsampler::downsample(const std::vector<Point>& input, std::vector<Point>& output)
+{
+    output.clear();
+    beginFrame(input.size());
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        const Point& point = input[i];
+        addPoint(static_cast<std::uint32_t>(i),
+                 {point.x,
+                  point.y,
+                  point.z,
+                  point.amplitude_dBsm,
+                  point.rangeRate_ms,
+                  point.stationaryProbability,
+                  static_cast<std::int32_t>(point.sensorIndex)});
+    }
+
+    const auto& cells = finishFrame();
+    output.reserve(cells.size());
+    for (const auto& cell : cells)
+    {
+        Point point = input[cell.representative];
+        point.amplitude_dBsm = cell.amplitude_dBsm;
+        point.rangeRate_ms = cell.rangeRate_ms;
+        point.stationaryProbability = cell.stationaryProbability;
+        output.push_back(point);
+    }
+}
+
+} // namespace radar::core
@@ -0,0 +1,699 @@
+#include "radar_core/world_tile_store.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace radar::core
+{
+namespace
+{
+constexpr char kTileFileMagic[8] = {'R', 'D', 'R', 'T', 'I', 'L', 'E', 'S'};
+constexpr std::uint32_t kTileFileVersion = 1U;
+constexpr std::uint64_t kHeaderBytes = 64U;
+// Records start on cache-line boundaries.
+constexpr std::uint64_t kRecordAlignment = 64U;
+constexpr std::uint64_t kRecordKeyBytes = 8U;
+constexpr std::uint64_t kInitialFileTiles = 64U;
+constexpr int kMaxTileCells = 1024;
+// Keeps cell indices well inside int64 and tile indices inside int32.
+constexpr double kMaxCellIndex = 1e12;
+
+struct TileFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t tileCells;
+    float cellSize_m;
+    std::uint32_t reserved;
+    std::uint64_t tileCount;
+};
+static_assert(sizeof(TileFileHeader) <= kHeaderBytes);
+
+std::int64_t floorDiv(std::int64_t value, std::int64_t divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+} // namespace
+
+// Read-write shared mapping of the tile file that can grow. Used by the worker thread only.
+class WorldTileStore::TileFile
+{
+public:
+    ~TileFile()
+    {
+        close();
+    }
+
+    bool open(const std::filesystem::path& path, std::string& error)
+    {
+#if defined(_WIN32)
+        m_file = CreateFileW(path.c_str(),
+                             GENERIC_READ | GENERIC_WRITE,
+                             FILE_SHARE_READ,
+                             nullptr,
+                             OPEN_ALWAYS,
+                             FILE_ATTRIBUTE_NORMAL,
+                             nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            error = "CreateFile failed: " + std::to_string(GetLastError());
+            return false;
+        }
+        LARGE_INTEGER size{};
+        GetFileSizeEx(m_file, &size);
+        m_size = static_cast<std::uint64_t>(size.QuadPart);
+#else
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (m_fd < 0)
+        {
+            error = std::string("open: ") + std::strerror(errno);
+            return false;
+        }
+        struct stat status{};
+        if (fstat(m_fd, &status) != 0)
+        {
+            error = std::string("fstat: ") + std::strerror(errno);
+            return false;
+        }
+        m_size = static_cast<std::uint64_t>(status.st_size);
+#endif
+        return m_size == 0U || map(error);
+    }
+
+    // Grows the file to at least bytes and remaps it; existing contents are kept.
+    bool reserve(std::uint64_t bytes, std::string& error)
+    {
+        if (bytes <= m_size)
+        {
+            return true;
+        }
+        unmap();
+#if defined(_WIN32)
+        LARGE_INTEGER size{};
+        size.QuadPart = static_cast<LONGLONG>(bytes);
+        if (!SetFilePointerEx(m_file, size, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file))
+        {
+            error = "SetEndOfFile failed: " + std::to_string(GetLastError());
+            remapAfterFailure();
+            return false;
+        }
+#else
+        if (ftruncate(m_fd, static_cast<off_t>(bytes)) != 0)
+        {
+            error = std::string("ftruncate: ") + std::strerror(errno);
+            remapAfterFailure();
+            return false;
+        }
+#endif
+        m_size = bytes;
+        return map(error);
+    }
+
+    std::byte* data() const noexcept
+    {
+        return m_data;
+    }
+
+    std::uint64_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    void sync()
+    {
+        if (!m_data)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        FlushViewOfFile(m_data, 0);
+        FlushFileBuffers(m_file);
+#else
+        msync(m_data, static_cast<std::size_t>(m_size), MS_SYNC);
+#endif
+    }
+
+    void close()
+    {
+        unmap();
+#if defined(_WIN32)
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+#endif
+    }
+
+private:
+    bool map(std::string& error)
+    {
+#if defined(_WIN32)
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+        if (!m_mapping)
+        {
+            error = "CreateFileMapping failed: " + std::to_string(GetLastError());
+            return false;
+        }
+        m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (!m_data)
+        {
+            error = "MapViewOfFile failed: " + std::to_string(GetLastError());
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+            return false;
+        }
+#else
+        void* data = mmap(nullptr, static_cast<std::size_t>(m_size), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (data == MAP_FAILED)
+        {
+            error = std::string("mmap: ") + std::strerror(errno);
+            return false;
+        }
+        m_data = static_cast<std::byte*>(data);
+#endif
+        return true;
+    }
+
+    // Keeps the existing records readable after a failed growth.
+    void remapAfterFailure()
+    {
+        std::string ignored;
+        if (m_size > 0U)
+        {
+            map(ignored);
+        }
+    }
+
+    void unmap()
+    {
+        if (!m_data)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+#else
+        munmap(m_data, static_cast<std::size_t>(m_size));
+#endif
+        m_data = nullptr;
+    }
+
+#if defined(_WIN32)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+    std::byte* m_data = nullptr;
+    std::uint64_t m_size = 0U;
+};
+
+WorldTileStore::WorldTileStore() = default;
+
+WorldTileStore::~WorldTileStore()
+{
+    close();
+}
+
+bool WorldTileStore::open(const Settings& settings, std::string& error)
+{
+    close();
+    if (!(settings.cellSize_m > 0.0F) || settings.tileCells <= 0 || settings.tileCells > kMaxTileCells ||
+        settings.activeRadius < 0 || settings.prefetchTiles < 0)
+    {
+        error = "invalid world tile settings";
+        return false;
+    }
+
+    m_settings = settings;
+    m_tileSize_m = settings.cellSize_m * static_cast<float>(settings.tileCells);
+    m_cellsPerTile = static_cast<std::size_t>(settings.tileCells) * static_cast<std::size_t>(settings.tileCells);
+    m_recordBytes = (kRecordKeyBytes + m_cellsPerTile * sizeof(float) + kRecordAlignment - 1U) / kRecordAlignment *
+                    kRecordAlignment;
+
+    auto file = std::make_unique<TileFile>();
+    if (!file->open(settings.tileFile, error))
+    {
+        error = settings.tileFile.string() + ": " + error;
+        return false;
+    }
+
+    // Reuse the tiles of a previous drive when the file was written with the same geometry.
+    m_diskSlots.clear();
+    TileFileHeader header{};
+    if (file->size() >= kHeaderBytes)
+    {
+        std::memcpy(&header, file->data(), sizeof(header));
+    }
+    const bool compatible = file->size() >= kHeaderBytes &&
+                            std::memcmp(header.magic, kTileFileMagic, sizeof(kTileFileMagic)) == 0 &&
+                            header.version == kTileFileVersion &&
+                            header.tileCells == static_cast<std::uint32_t>(settings.tileCells) &&
+                            header.cellSize_m == settings.cellSize_m;
+    if (compatible)
+    {
+        const std::uint64_t tiles = std::min(header.tileCount, (file->size() - kHeaderBytes) / m_recordBytes);
+        for (std::uint64_t slot = 0; slot < tiles; ++slot)
+        {
+            TileKey key = 0U;
+            std::memcpy(&key, file->data() + kHeaderBytes + slot * m_recordBytes, sizeof(key));
+            m_diskSlots[key] = slot;
+        }
+    }
+    else
+    {
+        if (!file->reserve(kHeaderBytes + kInitialFileTiles * m_recordBytes, error))
+        {
+            error = settings.tileFile.string() + ": " + error;
+            return false;
+        }
+        header = TileFileHeader{};
+        std::memcpy(header.magic, kTileFileMagic, sizeof(kTileFileMagic));
+        header.version = kTileFileVersion;
+        header.tileCells = static_cast<std::uint32_t>(settings.tileCells);
+        header.cellSize_m = settings.cellSize_m;
+        std::memcpy(file->data(), &header, sizeof(header));
+    }
+    m_file = std::move(file);
+    m_tilesOnDisk.store(m_diskSlots.size(), std::memory_order_relaxed);
+    m_fileBytes.store(m_file->size(), std::memory_order_relaxed);
+
+    // Room for the window and its prefetch band, the ring kept as hysteresis and tiles in flight.
+    const auto side = static_cast<std::size_t>(2 * settings.activeRadius + 3 + settings.prefetchTiles);
+    const std::size_t poolTiles = side * side;
+    m_cells.assign(poolTiles * m_cellsPerTile, 0.0F);
+    m_dirty.assign(poolTiles, 0U);
+    m_freeBuffers.resize(poolTiles);
+    // Popped from the back, so buffer 0 is handed out first.
+    std::iota(m_freeBuffers.rbegin(), m_freeBuffers.rend(), 0U);
+    m_resident.clear();
+    m_pendingPageIns.clear();
+    m_cachedTile = nullptr;
+    m_droppedUpdates = 0U;
+    m_pageIns.store(0U, std::memory_order_relaxed);
+    m_diskPageIns.store(0U, std::memory_order_relaxed);
+    m_pageOuts.store(0U, std::memory_order_relaxed);
+    m_failedPageOuts.store(0U, std::memory_order_relaxed);
+
+    m_stop = false;
+    m_worker = std::thread(&WorldTileStore::workerLoop, this);
+    return true;
+}
+
+void WorldTileStore::close()
+{
+    if (!m_worker.joinable())
+    {
+        return;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [key, buffer] : m_resident)
+        {
+            m_jobs.push_back({JobKind::PageOut, key, buffer});
+        }
+        m_stop = true;
+    }
+    m_resident.clear();
+    m_wake.notify_one();
+    m_worker.join();
+
+    m_file->sync();
+    m_file.reset();
+    m_diskSlots.clear();
+    m_jobs.clear();
+    m_completed.clear();
+    m_pendingPageIns.clear();
+    m_freeBuffers.clear();
+    m_cachedTile = nullptr;
+    m_cells = {};
+    m_dirty.clear();
+}
+
+bool WorldTileStore::isOpen() const noexcept
+{
+    return m_worker.joinable();
+}
+
+const WorldTileStore::Settings& WorldTileStore::settings() const noexcept
+{
+    return m_settings;
+}
+
+void WorldTileStore::setVehiclePosition(float x_m, float y_m, float velocityX_mps, float velocityY_mps)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    adoptCompletedJobs();
+    m_cachedTile = nullptr;
+
+    TileKey centre = 0U;
+    int cell = 0;
+    if (!locate(x_m, y_m, centre, cell))
+    {
+        return;
+    }
+    const std::int32_t centreX = tileX(centre);
+    const std::int32_t centreY = tileY(centre);
+
+    // Wanted tiles, most urgent first: the window around the vehicle by distance, then the same window
+    // around each look-ahead point.
+    m_wanted.clear();
+    const auto addWindow = [this](std::int32_t tx, std::int32_t ty, float x, float y)
+    {
+        const std::size_t first = m_wanted.size();
+        const int radius = m_settings.activeRadius;
+        for (int dy = -radius; dy <= radius; ++dy)
+        {
+            for (int dx = -radius; dx <= radius; ++dx)
+            {
+                const TileKey key = makeKey(tx + dx, ty + dy);
+                if (std::find(m_wanted.begin(), m_wanted.begin() + static_cast<std::ptrdiff_t>(first), key) ==
+                    m_wanted.begin() + static_cast<std::ptrdiff_t>(first))
+                {
+                    m_wanted.push_back(key);
+                }
+            }
+        }
+        const auto distance = [this, x, y](TileKey key)
+        {
+            const float dx = (static_cast<float>(tileX(key)) + 0.5F) * m_tileSize_m - x;
+            const float dy = (static_cast<float>(tileY(key)) + 0.5F) * m_tileSize_m - y;
+            return dx * dx + dy * dy;
+        };
+        std::sort(m_wanted.begin() + static_cast<std::ptrdiff_t>(first),
+                  m_wanted.end(),
+                  [&distance](TileKey a, TileKey b) { return distance(a) < distance(b); });
+    };
+    addWindow(centreX, centreY, x_m, y_m);
+
+    const float speed = std::hypot(velocityX_mps, velocityY_mps);
+    if (speed >= m_settings.minPrefetchSpeed_mps && m_settings.prefetchTiles > 0)
+    {
+        for (int step = 1; step <= m_settings.prefetchTiles; ++step)
+        {
+            const float ahead = static_cast<float>(step) * m_tileSize_m / speed;
+            const float aheadX = x_m + velocityX_mps * ahead;
+            const float aheadY = y_m + velocityY_mps * ahead;
+            TileKey key = 0U;
+            if (locate(aheadX, aheadY, key, cell))
+            {
+                addWindow(tileX(key), tileY(key), aheadX, aheadY);
+            }
+        }
+    }
+
+    // Evict tiles that are neither wanted nor within one tile of the window (hysteresis against a vehicle
+    // driving along a tile border).
+    const int keepRadius = m_settings.activeRadius + 1;
+    m_evictions.clear();
+    for (const auto& [key, buffer] : m_resident)
+    {
+        const int distance = std::max(std::abs(tileX(key) - centreX), std::abs(tileY(key) - centreY));
+        if (distance > keepRadius && std::find(m_wanted.begin(), m_wanted.end(), key) == m_wanted.end())
+        {
+            m_evictions.push_back(key);
+        }
+    }
+
+    bool queued = false;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        for (const TileKey key : m_evictions)
+        {
+            const auto it = m_resident.find(key);
+            m_jobs.push_back({JobKind::PageOut, key, it->second});
+            m_resident.erase(it);
+            queued = true;
+        }
+        for (const TileKey key : m_wanted)
+        {
+            if (m_freeBuffers.empty())
+            {
+                // The rest of the look-ahead is requested again once page-outs return their buffers.
+                break;
+            }
+            if (m_resident.count(key) != 0U || !m_pendingPageIns.insert(key).second)
+            {
+                continue;
+            }
+            m_jobs.push_back({JobKind::PageIn, key, m_freeBuffers.back()});
+            m_freeBuffers.pop_back();
+            queued = true;
+        }
+    }
+    if (queued)
+    {
+        m_wake.notify_one();
+    }
+}
+
+bool WorldTileStore::addLogOdds(float x_m, float y_m, float delta, float minLogOdds, float maxLogOdds)
+{
+    TileKey key = 0U;
+    int cell = 0;
+    if (!isOpen() || !locate(x_m, y_m, key, cell))
+    {
+        ++m_droppedUpdates;
+        return false;
+    }
+
+    float* tile = m_cachedTile;
+    if (!tile || key != m_cachedKey)
+    {
+        const auto it = m_resident.find(key);
+        if (it == m_resident.end())
+        {
+            ++m_droppedUpdates;
+            return false;
+        }
+        tile = tileCells(it->second);
+        m_dirty[it->second] = 1U;
+        m_cachedKey = key;
+        m_cachedTile = tile;
+    }
+    tile[cell] = std::clamp(tile[cell] + delta, minLogOdds, maxLogOdds);
+    return true;
+}
+
+float WorldTileStore::logOdds(float x_m, float y_m) const
+{
+    TileKey key = 0U;
+    int cell = 0;
+    if (!isOpen() || !locate(x_m, y_m, key, cell))
+    {
+        return 0.0F;
+    }
+    const auto it = m_resident.find(key);
+    if (it == m_resident.end())
+    {
+        return 0.0F;
+    }
+    return m_cells[static_cast<std::size_t>(it->second) * m_cellsPerTile + static_cast<std::size_t>(cell)];
+}
+
+void WorldTileStore::flush()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_jobs.empty() && !m_workerBusy; });
+    }
+    adoptCompletedJobs();
+}
+
+WorldTileStore::Statistics WorldTileStore::statistics() const
+{
+    Statistics statistics;
+    statistics.residentTiles = m_resident.size();
+    statistics.poolTiles = m_dirty.size();
+    statistics.pendingPageIns = m_pendingPageIns.size();
+    statistics.pageIns = m_pageIns.load(std::memory_order_relaxed);
+    statistics.diskPageIns = m_diskPageIns.load(std::memory_order_relaxed);
+    statistics.pageOuts = m_pageOuts.load(std::memory_order_relaxed);
+    statistics.tilesOnDisk = m_tilesOnDisk.load(std::memory_order_relaxed);
+    statistics.fileBytes = m_fileBytes.load(std::memory_order_relaxed);
+    statistics.failedPageOuts = m_failedPageOuts.load(std::memory_order_relaxed);
+    statistics.droppedUpdates = m_droppedUpdates;
+    return statistics;
+}
+
+WorldTileStore::TileKey WorldTileStore::makeKey(std::int32_t tx, std::int32_t ty) noexcept
+{
+    return (static_cast<TileKey>(static_cast<std::uint32_t>(ty)) << 32U) | static_cast<std::uint32_t>(tx);
+}
+
+std::int32_t WorldTileStore::tileX(TileKey key) noexcept
+{
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(key & 0xFFFFFFFFU));
+}
+
+std::int32_t WorldTileStore::tileY(TileKey key) noexcept
+{
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32U));
+}
+
+float* WorldTileStore::tileCells(std::uint32_t buffer) noexcept
+{
+    return m_cells.data() + static_cast<std::size_t>(buffer) * m_cellsPerTile;
+}
+
+bool WorldTileStore::locate(float x_m, float y_m, TileKey& key, int& cell) const noexcept
+{
+    const double cellX = std::floor(static_cast<double>(x_m) / m_settings.cellSize_m);
+    const double cellY = std::floor(static_cast<double>(y_m) / m_settings.cellSize_m);
+    // Also rejects NaN.
+    if (!(std::abs(cellX) < kMaxCellIndex) || !(std::abs(cellY) < kMaxCellIndex))
+    {
+        return false;
+    }
+    const auto ix = static_cast<std::int64_t>(cellX);
+    const auto iy = static_cast<std::int64_t>(cellY);
+    const std::int64_t tx = floorDiv(ix, m_settings.tileCells);
+    const std::int64_t ty = floorDiv(iy, m_settings.tileCells);
+    key = makeKey(static_cast<std::int32_t>(tx), static_cast<std::int32_t>(ty));
+    cell = static_cast<int>((iy - ty * m_settings.tileCells) * m_settings.tileCells + (ix - tx * m_settings.tileCells));
+    return true;
+}
+
+void WorldTileStore::adoptCompletedJobs()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_adopting.swap(m_completed);
+    }
+    for (const Job& job : m_adopting)
+    {
+        if (job.kind == JobKind::PageIn)
+        {
+            m_pendingPageIns.erase(job.key);
+            m_dirty[job.buffer] = 0U;
+            m_resident.emplace(job.key, job.buffer);
+        }
+        else
+        {
+            m_freeBuffers.push_back(job.buffer);
+        }
+    }
+    m_adopting.clear();
+}
+
+void WorldTileStore::workerLoop()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+            if (m_jobs.empty())
+            {
+                return;
+            }
+            job = m_jobs.front();
+            m_jobs.pop_front();
+            m_workerBusy = true;
+        }
+
+        runJob(job);
+
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_completed.push_back(job);
+            m_workerBusy = false;
+        }
+        m_idle.notify_all();
+    }
+}
+
+void WorldTileStore::runJob(const Job& job)
+{
+    const std::size_t tileBytes = m_cellsPerTile * sizeof(float);
+    float* cells = tileCells(job.buffer);
+    const auto slot = m_diskSlots.find(job.key);
+
+    if (job.kind == JobKind::PageIn)
+    {
+        if (slot != m_diskSlots.end())
+        {
+            const std::byte* record = m_file->data() + kHeaderBytes + slot->second * m_recordBytes;
+            std::memcpy(cells, record + kRecordKeyBytes, tileBytes);
+            m_diskPageIns.fetch_add(1U, std::memory_order_relaxed);
+        }
+        else
+        {
+            std::fill(cells, cells + m_cellsPerTile, 0.0F);
+        }
+        m_pageIns.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+
+    // Tiles that were never written since their page-in already match the file (or are all zero).
+    if (m_dirty[job.buffer] == 0U)
+    {
+        return;
+    }
+
+    const bool append = slot == m_diskSlots.end();
+    const std::uint64_t index = append ? m_diskSlots.size() : slot->second;
+    const std::uint64_t required = kHeaderBytes + (index + 1U) * m_recordBytes;
+    if (append && required > m_file->size())
+    {
+        std::string error;
+        if (!m_file->reserve(std::max(required, m_file->size() * 2U), error))
+        {
+            // The tile is lost; the store keeps serving the tiles already on disk.
+            m_failedPageOuts.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        }
+        m_fileBytes.store(m_file->size(), std::memory_order_relaxed);
+    }
+
+    std::byte* record = m_file->data() + kHeaderBytes + index * m_recordBytes;
+    std::memcpy(record, &job.key, sizeof(job.key));
+    std::memcpy(record + kRecordKeyBytes, cells, tileBytes);
+    m_pageOuts.fetch_add(1U, std::memory_order_relaxed);
+
+    if (append)
+    {
+        // The count is bumped after the record is complete, so a file cut short never lists a partial tile.
+        m_diskSlots.emplace(job.key, index);
+        TileFileHeader header{};
+        std::memcpy(&header, m_file->data(), sizeof(header));
+        header.tileCount = m_diskSlots.size();
+        std::memcpy(m_file->data(), &header, sizeof(header));
+        m_tilesOnDisk.store(m_diskSlots.size(), std::memory_order_relaxed);
+    }
+}
+
+} // namespace radar::core
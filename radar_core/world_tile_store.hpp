@@ -0,0 +1,181 @@
+#pragma once
+
+#include "radar_core/memory_accounting.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace radar::core
+{
+
+// World-referenced log-odds map of square tiles, larger than RAM. Only an active window of tiles around the
+// vehicle (plus the tiles ahead along the direction of travel) is resident, in a fixed pool of tile buffers;
+// the rest lives in a memory-mapped tile file. A worker thread pages tiles in and out, so the updating
+// thread never touches the file: it queues requests, adopts finished page-ins at the next recentre and drops
+// updates that land on a tile that is not resident yet.
+class WorldTileStore
+{
+public:
+    struct Settings
+    {
+        std::filesystem::path tileFile = "radar_world_tiles.bin";
+        float cellSize_m = 0.5F;
+        // Cells per tile side.
+        int tileCells = 64;
+        // Tiles kept around the vehicle's tile in every direction (a (2r+1)^2 window).
+        int activeRadius = 2;
+        // The window is also requested this many tiles ahead along the velocity.
+        int prefetchTiles = 2;
+        // Below this speed (m/s) nothing is prefetched.
+        float minPrefetchSpeed_mps = 0.5F;
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    struct Statistics
+    {
+        std::size_t residentTiles = 0U;
+        std::size_t poolTiles = 0U;
+        std::size_t pendingPageIns = 0U;
+        std::uint64_t pageIns = 0U;
+        // Page-ins served from the tile file (the rest were new, zeroed tiles).
+        std::uint64_t diskPageIns = 0U;
+        std::uint64_t pageOuts = 0U;
+        std::uint64_t tilesOnDisk = 0U;
+        std::uint64_t fileBytes = 0U;
+        // Dirty tiles lost because the tile file could not grow.
+        std::uint64_t failedPageOuts = 0U;
+        // Cell updates dropped because their tile was not resident.
+        std::uint64_t droppedUpdates = 0U;
+    };
+
+    WorldTileStore();
+    // Writes every dirty resident tile back and stops the worker.
+    ~WorldTileStore();
+    WorldTileStore(const WorldTileStore&) = delete;
+    WorldTileStore& operator=(const WorldTileStore&) = delete;
+
+    // Opens (or creates) the tile file and starts the worker. An existing file written with a different cell
+    // size or tile size is discarded. Returns false with a reason when the file cannot be mapped.
+    bool open(const Settings& settings, std::string& error);
+    void close();
+    bool isOpen() const noexcept;
+    const Settings& settings() const noexcept;
+
+    // Updating thread only. Recentres the active window on (x, y) (world metres), adopts finished page-ins,
+    // evicts tiles that left the window and queues page-ins, nearest first. Never waits for the worker.
+    void setVehiclePosition(float x_m, float y_m, float velocityX_mps, float velocityY_mps);
+    // Adds delta to the cell containing (x, y), clamped to [minLogOdds, maxLogOdds]. Returns false (and
+    // counts a dropped update) when that tile is not resident.
+    bool addLogOdds(float x_m, float y_m, float delta, float minLogOdds, float maxLogOdds);
+    // Log-odds of the cell containing (x, y); 0 for tiles that are not resident.
+    float logOdds(float x_m, float y_m) const;
+    // Calls visit(x_m, y_m, logOdds) for the centre of every resident cell at or above threshold.
+    template <typename Visit>
+    void forEachCellAbove(float threshold, Visit visit) const
+    {
+        for (const auto& [key, buffer] : m_resident)
+        {
+            const float* cells = m_cells.data() + static_cast<std::size_t>(buffer) * m_cellsPerTile;
+            const float originX = static_cast<float>(tileX(key)) * m_tileSize_m + 0.5F * m_settings.cellSize_m;
+            const float originY = static_cast<float>(tileY(key)) * m_tileSize_m + 0.5F * m_settings.cellSize_m;
+            for (int cy = 0; cy < m_settings.tileCells; ++cy)
+            {
+                for (int cx = 0; cx < m_settings.tileCells; ++cx)
+                {
+                    const float value = cells[cy * m_settings.tileCells + cx];
+                    if (value >= threshold)
+                    {
+                        visit(originX + static_cast<float>(cx) * m_settings.cellSize_m,
+                              originY + static_cast<float>(cy) * m_settings.cellSize_m,
+                              value);
+                    }
+                }
+            }
+        }
+    }
+    // Blocks until the worker has finished every queued page-in and page-out and adopts the page-ins. Meant
+    // for tests and shutdown, not for the update loop.
+    void flush();
+    Statistics statistics() const;
+
+private:
+    using TileKey = std::uint64_t;
+
+    enum class JobKind : std::uint8_t
+    {
+        PageIn = 0,
+        PageOut
+    };
+
+    struct Job
+    {
+        JobKind kind = JobKind::PageIn;
+        TileKey key = 0U;
+        std::uint32_t buffer = 0U;
+    };
+
+    class TileFile;
+
+    static TileKey makeKey(std::int32_t tx, std::int32_t ty) noexcept;
+    static std::int32_t tileX(TileKey key) noexcept;
+    static std::int32_t tileY(TileKey key) noexcept;
+
+    float* tileCells(std::uint32_t buffer) noexcept;
+    bool locate(float x_m, float y_m, TileKey& key, int& cell) const noexcept;
+    void adoptCompletedJobs();
+    void workerLoop();
+    void runJob(const Job& job);
+
+    Settings m_settings;
+    float m_tileSize_m = 0.0F;
+    std::size_t m_cellsPerTile = 0U;
+    std::uint64_t m_recordBytes = 0U;
+
+    // Tile buffers; a buffer belongs to the updating thread while free or resident and to the worker while a
+    // job for it is queued.
+    std::vector<float, TaggedAllocator<float, MemoryTag::WorldTiles>> m_cells;
+    std::vector<std::uint8_t> m_dirty;
+    std::vector<std::uint32_t> m_freeBuffers;
+    std::unordered_map<TileKey, std::uint32_t> m_resident;
+    std::unordered_set<TileKey> m_pendingPageIns;
+    std::vector<TileKey> m_wanted;
+    std::vector<TileKey> m_evictions;
+    TileKey m_cachedKey = 0U;
+    float* m_cachedTile = nullptr;
+    std::uint64_t m_droppedUpdates = 0U;
+
+    // Shared with the worker.
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<Job> m_jobs;
+    std::vector<Job> m_completed;
+    std::vector<Job> m_adopting;
+    bool m_workerBusy = false;
+    bool m_stop = false;
+    std::atomic<std::uint64_t> m_pageIns{0U};
+    std::atomic<std::uint64_t> m_diskPageIns{0U};
+    std::atomic<std::uint64_t> m_pageOuts{0U};
+    std::atomic<std::uint64_t> m_tilesOnDisk{0U};
+    std::atomic<std::uint64_t> m_fileBytes{0U};
+    std::atomic<std::uint64_t> m_failedPageOuts{0U};
+
+    // Worker thread only.
+    std::unique_ptr<TileFile> m_file;
+    std::unordered_map<TileKey, std::uint64_t> m_diskSlots;
+    std::thread m_worker;
+};
+
+} // namespace radar::core
@@ -0,0 +1,103 @@
+#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in float aStationaryProbability;
+layout(location = 2) in float aRangeRate;
+// bits 0-2: sensor palette slot, bits 3-5: detection type, bits 6-7: motion (0 static, 1 moving, 2 other),
+// bit 8: stationary, bit 9: moveable
+layout(location = 3) in uint aAttributes;
+
+uniform mat4 uViewProjection;
+uniform float uPointSize;
+uniform float uElevationScale;
+// 0 static, 1 moving, 2 all
+uniform int uMotionFilter;
+// Bit per detection type; Unknown (bit 5) has no toggle and is always set.
+uniform uint uTypeMask;
+// 0 motion state, 1 radar unit, 2 detection type
+uniform int uColorMode;
+// 0 constant, 1 probability, 2 time decay
+uniform int uAlphaMode;
+uniform float uAlphaConstant;
+uniform float uIntensityScale;
+uniform float uRangeRateScale;
+uniform float uDecayPerSecond;
+uniform float uAgeSeconds;
+uniform vec3 uMotionColors[3];
+uniform vec3 uSensorColors[6];
+uniform vec3 uTypeColors[6];
+
+out vec3 vColor;
+out float vAlpha;
+
+void cull()
+{
+    // Outside the clip volume, so the point is dropped before rasterization.
+    gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+    gl_PointSize = 0.0;
+    vColor = vec3(0.0);
+    vAlpha = 0.0;
+}
+
+void main()
+{
+    uint sensor = aAttributes & 0x7u;
+    uint type = (aAttributes >> 3u) & 0x7u;
+    int motion = int((aAttributes >> 6u) & 0x3u);
+    bool stationary = ((aAttributes >> 8u) & 1u) != 0u;
+    bool moveable = ((aAttributes >> 9u) & 1u) != 0u;
+
+    if ((uMotionFilter == 0 && motion != 0) || (uMotionFilter == 1 && motion != 1) ||
+        ((uTypeMask >> type) & 1u) == 0u)
+    {
+        cull();
+        return;
+    }
+
+    float alpha = uAlphaConstant;
+    if (uAlphaMode == 1)
+    {
+        float probability = aStationaryProbability;
+        if (probability <= 0.0)
+        {
+            probability = exp(-abs(aRangeRate) / uRangeRateScale);
+        }
+        if (stationary || motion == 0)
+        {
+            alpha = probability;
+        }
+        else if (moveable || motion == 1)
+        {
+            alpha = 1.0 - probability;
+        }
+        else
+        {
+            alpha = 0.5;
+        }
+    }
+    else if (uAlphaMode == 2)
+    {
+        alpha = exp(-uDecayPerSecond * uAgeSeconds);
+    }
+    alpha = clamp(alpha * uIntensityScale, 0.05, 1.0);
+    if (alpha <= 0.05)
+    {
+        cull();
+        return;
+    }
+
+    if (uColorMode == 1)
+    {
+        vColor = uSensorColors[sensor];
+    }
+    else if (uColorMode == 2)
+    {
+        vColor = uTypeColors[type];
+    }
+    else
+    {
+        vColor = uMotionColors[motion];
+    }
+    vAlpha = alpha;
+    gl_PointSize = uPointSize;
+    gl_Position = uViewProjection * vec4(aPosition.xy, aPosition.z * uElevationScale, 1.0);
+}
@@ -1,8 +1,10 @@
 #include "radar/include/engine/RadarPlaybackEngine.hpp"
 #include "radar/include/processing/RadarPlayback.hpp"
 
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 int main(int argc, char** argv)
@@ -24,8 +26,28 @@ int main(int argc, char** argv)
     radar::RadarPlayback::Settings settings;
     settings.inputFiles = radarFiles;
     settings.dataRoot = std::filesystem::current_path() / "data";
+    // Per-stage rows of the visualizer's Performance panel.
+    settings.enableStageProfiling = true;
+    // Per-sensor latency distributions are logged on exit; sensors over budget are warned about as they run.
+    settings.enableLatencyAnalysis = true;
+    // Edits to RuntimeSettings.ini are picked up while the engine runs.
+    auto runtimeSettings = std::make_shared<radar::RuntimeSettingsWatcher>(settings.dataRoot / "RuntimeSettings.ini");
+    settings.processingSettings = runtimeSettings->processingChannel();
     radar::RadarPlayback playback(std::move(settings));
     radar::RadarPlaybackEngine engine(std::move(playback));
+    engine.setRuntimeSettings(runtimeSettings);
+    if (const char* placement = std::getenv("RADAR_THREAD_PLACEMENT"))
+    {
+        radar::core::ThreadPlacementSettings threadPlacement;
+        if (radar::core::parseThreadPlacement(placement, threadPlacement))
+        {
+            engine.setThreadPlacement(std::move(threadPlacement));
+        }
+        else
+        {
+            std::cerr << "Ignoring invalid RADAR_THREAD_PLACEMENT: " << placement << '\n';
+        }
+    }
     engine.run();
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,354 @@
+#include "radar_core/c_api.h"
+
+#include "radar_core/processing_pipeline.hpp"
+#include "utility/vehicle_config.hpp"
+
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace
+{
+// One corner scan, one front scan and a track fusion record per frame, kept both as raw records for the C++
+// pipeline and as back-to-back columns for the C API.
+struct Capture
+{
+    std::vector<utility::RawCornerDetections> corners;
+    std::vector<utility::RawFrontDetections> fronts;
+    std::vector<utility::RawTrackFusion> tracks;
+
+    std::vector<float> range;
+    std::vector<float> rangeRate;
+    std::vector<float> rangeRateRaw;
+    std::vector<float> azimuthRaw;
+    std::vector<float> azimuth;
+    std::vector<float> amplitude;
+    std::vector<float> longitudinal;
+    std::vector<float> lateral;
+    std::vector<std::int8_t> motion;
+    std::vector<std::uint8_t> valid;
+    std::vector<std::uint8_t> zero;
+
+    std::vector<float> trackLon;
+    std::vector<float> trackLat;
+    std::vector<float> trackVLon;
+    std::vector<float> trackVLat;
+    std::vector<float> trackZero;
+    std::vector<float> trackLength;
+    std::vector<float> trackWidth;
+    std::vector<std::uint8_t> trackFlags;
+
+    std::vector<radar_core_scan> scans;
+    std::vector<radar_core_frame> frames;
+
+    radar_core_detection_columns detectionColumns() const
+    {
+        return {range.data(),        rangeRate.data(), rangeRateRaw.data(), azimuthRaw.data(), azimuth.data(),
+                amplitude.data(),    longitudinal.data(), lateral.data(),   motion.data(),     valid.data(),
+                zero.data(),         zero.data(),      zero.data(),         zero.data()};
+    }
+
+    radar_core_track_columns trackColumns() const
+    {
+        return {trackLon.data(),    trackLat.data(),   trackVLon.data(),  trackVLat.data(), trackZero.data(),
+                trackZero.data(),   trackZero.data(),  trackZero.data(),  trackLength.data(), trackWidth.data(),
+                trackZero.data(),   trackFlags.data(), trackFlags.data()};
+    }
+};
+
+template <typename Record>
+void appendReturns(Capture& capture, Record& record, std::size_t count, std::mt19937& rng, std::size_t used)
+{
+    std::uniform_real_distribution<float> angle(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> range(2.0f, 40.0f);
+    std::uniform_real_distribution<float> rangeRate(-12.0f, 2.0f);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Unused slots stay zero, which the pipeline treats as padding.
+        if (i < used)
+        {
+            record.range_m[i] = range(rng);
+            record.rangeRate_ms[i] = rangeRate(rng);
+            record.azimuthRaw_rad[i] = angle(rng);
+            record.azimuth_rad[i] = record.azimuthRaw_rad[i];
+            record.longitudinalOffset_m[i] = record.range_m[i] * std::cos(record.azimuth_rad[i]);
+            record.lateralOffset_m[i] = record.range_m[i] * std::sin(record.azimuth_rad[i]);
+            record.radarValidReturn[i] = 1U;
+        }
+        capture.range.push_back(record.range_m[i]);
+        capture.rangeRate.push_back(record.rangeRate_ms[i]);
+        capture.rangeRateRaw.push_back(record.rangeRateRaw_ms[i]);
+        capture.azimuthRaw.push_back(record.azimuthRaw_rad[i]);
+        capture.azimuth.push_back(record.azimuth_rad[i]);
+        capture.amplitude.push_back(record.amplitude_dBsm[i]);
+        capture.longitudinal.push_back(record.longitudinalOffset_m[i]);
+        capture.lateral.push_back(record.lateralOffset_m[i]);
+        capture.motion.push_back(record.motionStatus[i]);
+        capture.valid.push_back(record.radarValidReturn[i]);
+        capture.zero.push_back(0U);
+    }
+}
+
+Capture makeCapture(std::size_t frameCount)
+{
+    Capture capture;
+    std::mt19937 rng(5U);
+    for (std::size_t f = 0; f < frameCount; ++f)
+    {
+        const std::uint64_t timestamp = 100000U + 50000U * f;
+        radar_core_frame frame{};
+        frame.timestamp_us = timestamp;
+        frame.first_scan = static_cast<std::uint32_t>(capture.scans.size());
+        frame.scan_count = 2U;
+
+        utility::RawCornerDetections corner;
+        corner.sensor = utility::SensorIndex::RearLeft;
+        corner.header.timestamp_us = timestamp - 1000U;
+        radar_core_scan cornerScan{corner.header.timestamp_us, RADAR_CORE_SENSOR_REAR_LEFT,
+                                   static_cast<std::uint32_t>(capture.range.size()),
+                                   static_cast<std::uint32_t>(utility::kCornerReturnCount), 0U};
+        appendReturns(capture, corner, utility::kCornerReturnCount, rng, 40U);
+        capture.corners.push_back(corner);
+        capture.scans.push_back(cornerScan);
+
+        utility::RawFrontDetections front;
+        front.header.timestamp_us = timestamp - 500U;
+        radar_core_scan frontScan{front.header.timestamp_us, RADAR_CORE_SENSOR_FRONT_SHORT,
+                                  static_cast<std::uint32_t>(capture.range.size()),
+                                  static_cast<std::uint32_t>(utility::kFrontReturnCount),
+                                  static_cast<std::uint32_t>(utility::kCornerReturnCount)};
+        appendReturns(capture, front, utility::kFrontReturnCount, rng, 100U);
+        capture.fronts.push_back(front);
+        capture.scans.push_back(frontScan);
+
+        // Tracks every other frame, so association state carries over between them.
+        utility::RawTrackFusion tracks;
+        tracks.timestamp_us = timestamp;
+        if (f % 2U == 0U)
+        {
+            frame.has_tracks = 1U;
+            frame.first_track = static_cast<std::uint32_t>(capture.trackLon.size());
+            frame.track_count = 3U;
+            for (std::size_t i = 0; i < frame.track_count; ++i)
+            {
+                const float lon = 5.0f + 8.0f * static_cast<float>(i);
+                tracks.status[i] = static_cast<std::uint8_t>(utility::TrackStatus::Updated);
+                tracks.vcsLongitudinalPosition[i] = lon;
+                tracks.vcsLongitudinalVelocity[i] = -3.0f;
+                tracks.length[i] = 6.0f;
+                tracks.width[i] = 4.0f;
+                capture.trackLon.push_back(lon);
+                capture.trackLat.push_back(0.0f);
+                capture.trackVLon.push_back(-3.0f);
+                capture.trackVLat.push_back(0.0f);
+                capture.trackZero.push_back(0.0f);
+                capture.trackLength.push_back(6.0f);
+                capture.trackWidth.push_back(4.0f);
+                capture.trackFlags.push_back(0U);
+            }
+        }
+        capture.tracks.push_back(tracks);
+        capture.frames.push_back(frame);
+    }
+    return capture;
+}
+
+struct Result
+{
+    std::uint32_t sourceIndex = 0U;
+    std::uint8_t sensor = 0U;
+    std::uint8_t isStationary = 0U;
+    std::uint8_t isStatic = 0U;
+    std::int8_t fusedTrackIndex = -1;
+    float stationaryProbability = 0.0f;
+};
+
+struct ResultColumns
+{
+    explicit ResultColumns(std::size_t capacity)
+        : sourceIndex(capacity)
+        , sensor(capacity)
+        , isStationary(capacity)
+        , isStatic(capacity)
+        , fusedTrackIndex(capacity)
+        , stationaryProbability(capacity)
+    {
+        results.capacity = capacity;
+        results.source_index = sourceIndex.data();
+        results.sensor = sensor.data();
+        results.is_stationary = isStationary.data();
+        results.is_static = isStatic.data();
+        results.fused_track_index = fusedTrackIndex.data();
+        results.stationary_probability = stationaryProbability.data();
+    }
+
+    void append(std::vector<Result>& out) const
+    {
+        for (std::size_t i = 0; i < results.written; ++i)
+        {
+            out.push_back({sourceIndex[i], sensor[i], isStationary[i], isStatic[i], fusedTrackIndex[i],
+                           stationaryProbability[i]});
+        }
+    }
+
+    std::vector<std::uint32_t> sourceIndex;
+    std::vector<std::uint8_t> sensor;
+    std::vector<std::uint8_t> isStationary;
+    std::vector<std::uint8_t> isStatic;
+    std::vector<std::int8_t> fusedTrackIndex;
+    std::vector<float> stationaryProbability;
+    radar_core_results results{};
+};
+
+std::filesystem::path writeVehicleConfig()
+{
+    const auto path = test_helpers::makeTempDir("radar_core_c_api") / "Vehicle.ini";
+    test_helpers::writeFile(path, test_helpers::buildVehicleConfigIni(1.2f, true, false));
+    return path;
+}
+} // namespace
+
+TEST(RadarCoreCApiTest, MatchesRecordPipelineOnColumns)
+{
+    const auto configPath = writeVehicleConfig();
+    const Capture capture = makeCapture(6U);
+
+    // Reference: the record-based fused calls the playback uses.
+    utility::VehicleConfig config;
+    ASSERT_TRUE(config.load(configPath));
+    radar::core::RadarProcessingPipeline reference;
+    reference.initialize(&config.parameters());
+    std::vector<Result> expected;
+    std::vector<utility::OdometryEstimate> expectedOdometry;
+    for (std::size_t f = 0; f < capture.frames.size(); ++f)
+    {
+        const auto& frame = capture.frames[f];
+        const std::uint32_t cornerFirst = capture.scans[frame.first_scan].first;
+        const std::uint32_t frontFirst = capture.scans[frame.first_scan + 1U].first;
+        const auto collect = [&](std::uint32_t first)
+        {
+            return [&, first](utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det)
+            {
+                const std::size_t offset = sensor == utility::SensorIndex::FrontLong ? utility::kCornerReturnCount : 0U;
+                expected.push_back({first + static_cast<std::uint32_t>(offset + slot), static_cast<std::uint8_t>(sensor),
+                                    det.isStationary, det.isStatic, det.fusedTrackIndex, det.stationaryProbability});
+            };
+        };
+        reference.processCornerDetectionsFused(utility::SensorIndex::RearLeft, frame.timestamp_us,
+                                               capture.corners[f], collect(cornerFirst));
+        reference.processFrontDetectionsFused(frame.timestamp_us, capture.fronts[f], collect(frontFirst));
+        if (frame.has_tracks)
+        {
+            utility::EnhancedTracks tracks;
+            reference.processTrackFusion(frame.timestamp_us, capture.tracks[f], tracks);
+        }
+        utility::OdometryEstimate estimate;
+        reference.latestOdometry(estimate);
+        expectedOdometry.push_back(estimate);
+    }
+
+    radar_core_pipeline* pipeline = nullptr;
+    ASSERT_EQ(radar_core_create(configPath.string().c_str(), &pipeline), RADAR_CORE_OK);
+    const auto detections = capture.detectionColumns();
+    const auto tracks = capture.trackColumns();
+    ResultColumns columns(capture.range.size());
+    std::vector<radar_core_odometry> odometry(capture.frames.size());
+    columns.results.odometry = odometry.data();
+    ASSERT_EQ(radar_core_process_frames(pipeline, capture.frames.data(), capture.frames.size(), capture.scans.data(),
+                                        &detections, &tracks, &columns.results),
+              RADAR_CORE_OK);
+    EXPECT_EQ(columns.results.frames_processed, capture.frames.size());
+    radar_core_destroy(pipeline);
+
+    std::vector<Result> actual;
+    columns.append(actual);
+    ASSERT_EQ(actual.size(), expected.size());
+    bool associated = false;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(actual[i].sourceIndex, expected[i].sourceIndex) << i;
+        EXPECT_EQ(actual[i].sensor, expected[i].sensor) << i;
+        EXPECT_EQ(actual[i].isStationary, expected[i].isStationary) << i;
+        EXPECT_EQ(actual[i].isStatic, expected[i].isStatic) << i;
+        EXPECT_EQ(actual[i].fusedTrackIndex, expected[i].fusedTrackIndex) << i;
+        EXPECT_EQ(actual[i].stationaryProbability, expected[i].stationaryProbability) << i;
+        associated = associated || expected[i].fusedTrackIndex >= 0;
+    }
+    EXPECT_TRUE(associated);
+    for (std::size_t f = 0; f < odometry.size(); ++f)
+    {
+        EXPECT_EQ(odometry[f].valid != 0U, expectedOdometry[f].valid) << f;
+        EXPECT_EQ(odometry[f].longitudinal_velocity_mps, expectedOdometry[f].vLon_mps) << f;
+    }
+}
+
+TEST(RadarCoreCApiTest, StopsBeforeAFrameThatDoesNotFitAndResumes)
+{
+    const auto configPath = writeVehicleConfig();
+    const Capture capture = makeCapture(3U);
+    radar_core_pipeline* pipeline = nullptr;
+    ASSERT_EQ(radar_core_create(configPath.string().c_str(), &pipeline), RADAR_CORE_OK);
+    const auto detections = capture.detectionColumns();
+    const auto tracks = capture.trackColumns();
+
+    // Room for one frame's returns (padding included) but not two.
+    const std::size_t perFrame = utility::kCornerReturnCount + utility::kFrontReturnCount;
+    ResultColumns columns(perFrame + perFrame / 2U);
+    EXPECT_EQ(radar_core_process_frames(pipeline, capture.frames.data(), capture.frames.size(), capture.scans.data(),
+                                        &detections, &tracks, &columns.results),
+              RADAR_CORE_RESULTS_FULL);
+    EXPECT_EQ(columns.results.frames_processed, 1U);
+    EXPECT_EQ(columns.results.written, 140U);
+
+    const std::size_t done = columns.results.frames_processed;
+    EXPECT_EQ(radar_core_process_frames(pipeline, capture.frames.data() + done, capture.frames.size() - done,
+                                        capture.scans.data(), &detections, &tracks, &columns.results),
+              RADAR_CORE_RESULTS_FULL);
+    EXPECT_EQ(columns.results.frames_processed, 1U);
+    radar_core_destroy(pipeline);
+}
+
+TEST(RadarCoreCApiTest, EntryPointsDoNotThrow)
+{
+    radar_core_pipeline* pipeline = nullptr;
+    radar_core_results results{};
+    static_assert(noexcept(radar_core_create(nullptr, &pipeline)));
+    static_assert(noexcept(radar_core_destroy(pipeline)));
+    static_assert(noexcept(radar_core_process_frames(pipeline, nullptr, 0U, nullptr, nullptr, nullptr, &results)));
+    EXPECT_EQ(radar_core_process_frames(pipeline, nullptr, 0U, nullptr, nullptr, nullptr, &results),
+              RADAR_CORE_INVALID_ARGUMENT);
+}
+
+TEST(RadarCoreCApiTest, RejectsInvalidArguments)
+{
+    radar_core_pipeline* pipeline = nullptr;
+    EXPECT_EQ(radar_core_create(nullptr, &pipeline), RADAR_CORE_INVALID_ARGUMENT);
+    EXPECT_EQ(radar_core_create("missing/Vehicle.ini", &pipeline), RADAR_CORE_CONFIG_ERROR);
+    EXPECT_EQ(pipeline, nullptr);
+
+    const auto configPath = writeVehicleConfig();
+    ASSERT_EQ(radar_core_create(configPath.string().c_str(), &pipeline), RADAR_CORE_OK);
+    Capture capture = makeCapture(1U);
+    ResultColumns columns(capture.range.size());
+
+    // Returns without columns.
+    EXPECT_EQ(radar_core_process_frames(pipeline, capture.frames.data(), 1U, capture.scans.data(), nullptr, nullptr,
+                                        &columns.results),
+              RADAR_CORE_INVALID_ARGUMENT);
+
+    // Long-range sensor is not a scan kind of its own.
+    const auto detections = capture.detectionColumns();
+    const auto tracks = capture.trackColumns();
+    capture.scans[1].sensor = RADAR_CORE_SENSOR_FRONT_LONG;
+    EXPECT_EQ(radar_core_process_frames(pipeline, capture.frames.data(), 1U, capture.scans.data(), &detections,
+                                        &tracks, &columns.results),
+              RADAR_CORE_INVALID_ARGUMENT);
+    EXPECT_EQ(columns.results.frames_processed, 0U);
+    radar_core_destroy(pipeline);
+}
@@ -0,0 +1,154 @@
+#include "radar_core/frame_metrics.hpp"
+#include "radar_core/memory_accounting.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Every field is derived from the frame index, so a torn copy shows up as a mismatch.
+radar::core::FrameMetricsSample makeSample(std::uint64_t index)
+{
+    radar::core::FrameMetricsSample sample;
+    sample.frameIndex = index;
+    sample.frameInterval_ms = static_cast<float>(index % 1000U);
+    sample.frameWork_ms = static_cast<float>(index % 977U);
+    for (std::size_t i = 0; i < sample.stage_ms.size(); ++i)
+    {
+        sample.stage_ms[i] = static_cast<float>((index + i) % 991U);
+    }
+    sample.queueDepth = static_cast<std::uint32_t>(index);
+    sample.allocations = static_cast<std::uint32_t>(index * 3U);
+    for (std::size_t i = 0; i < sample.pointsPerSensor.size(); ++i)
+    {
+        sample.pointsPerSensor[i] = static_cast<std::uint32_t>(index + i);
+    }
+    return sample;
+}
+
+bool consistent(const radar::core::FrameMetricsSample& sample)
+{
+    const auto expected = makeSample(sample.frameIndex);
+    return sample.frameInterval_ms == expected.frameInterval_ms && sample.frameWork_ms == expected.frameWork_ms &&
+           sample.stage_ms == expected.stage_ms && sample.queueDepth == expected.queueDepth &&
+           sample.allocations == expected.allocations && sample.pointsPerSensor == expected.pointsPerSensor;
+}
+
+struct FakePoint
+{
+    int sensorIndex = -1;
+};
+} // namespace
+
+TEST(FrameMetricsRingTest, KeepsTheNewestSamplesInOrder)
+{
+    auto ring = std::make_unique<radar::core::FrameMetricsRing>();
+    std::vector<radar::core::FrameMetricsSample> samples;
+    EXPECT_EQ(ring->snapshot(samples, 10U), 0U);
+
+    const std::uint64_t total = radar::core::FrameMetricsRing::kCapacity + 37U;
+    for (std::uint64_t i = 0; i < total; ++i)
+    {
+        ring->publish(makeSample(i));
+    }
+    EXPECT_EQ(ring->published(), total);
+
+    ASSERT_EQ(ring->snapshot(samples, 5U), 5U);
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        EXPECT_EQ(samples[i].frameIndex, total - 5U + i);
+        EXPECT_TRUE(consistent(samples[i]));
+    }
+
+    // Never more than the ring holds.
+    ASSERT_EQ(ring->snapshot(samples, total), radar::core::FrameMetricsRing::kCapacity);
+    EXPECT_EQ(samples.front().frameIndex, total - radar::core::FrameMetricsRing::kCapacity);
+}
+
+TEST(FrameMetricsRingTest, StageNamesAreDefinedOnce)
+{
+    auto ring = std::make_unique<radar::core::FrameMetricsRing>();
+    EXPECT_EQ(ring->stageCount(), 0U);
+    EXPECT_STREQ(ring->stageName(0U), "");
+
+    ring->defineStages({"frame.read", std::string(40U, 'x')});
+    ring->defineStages({"ignored"});
+    ASSERT_EQ(ring->stageCount(), 2U);
+    EXPECT_STREQ(ring->stageName(0U), "frame.read");
+    EXPECT_EQ(std::string(ring->stageName(1U)), std::string(31U, 'x'));
+}
+
+TEST(FrameMetricsRingTest, ReadersNeverSeeTornSamples)
+{
+    auto ring = std::make_unique<radar::core::FrameMetricsRing>();
+    std::atomic<bool> done{false};
+    std::thread producer(
+        [&]()
+        {
+            for (std::uint64_t i = 0; i < 200000U; ++i)
+            {
+                ring->publish(makeSample(i));
+            }
+            done.store(true);
+        });
+
+    std::vector<radar::core::FrameMetricsSample> samples;
+    std::size_t checked = 0U;
+    bool torn = false;
+    bool ordered = true;
+    while (!done.load())
+    {
+        ring->snapshot(samples, 256U);
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            torn = torn || !consistent(samples[i]);
+            ordered = ordered && (i == 0U || samples[i].frameIndex > samples[i - 1U].frameIndex);
+        }
+        checked += samples.size();
+    }
+    producer.join();
+    EXPECT_FALSE(torn);
+    EXPECT_TRUE(ordered);
+    EXPECT_GT(checked, 0U);
+}
+
+TEST(FrameMetricsRecorderTest, FillsOneSamplePerFrame)
+{
+    auto ring = std::make_unique<radar::core::FrameMetricsRing>();
+    radar::core::FrameMetricsRecorder recorder(*ring);
+
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        recorder.beginFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        recorder.lap(0U);
+        std::vector<int, radar::core::TaggedAllocator<int, radar::core::MemoryTag::PipelineScratch>> scratch(16U);
+        recorder.lap(1U);
+        recorder.addStageTime(2U, 0.004);
+        recorder.addStageTime(radar::core::kFrameMetricsStageCount, 1.0);
+        recorder.countPoints(std::vector<FakePoint>{{0}, {4}, {4}, {-1}, {9}});
+        recorder.setQueueDepth(3U);
+        recorder.endFrame();
+    }
+
+    std::vector<radar::core::FrameMetricsSample> samples;
+    ASSERT_EQ(ring->snapshot(samples, 10U), 2U);
+    const auto& first = samples[0];
+    EXPECT_EQ(first.frameIndex, 0U);
+    EXPECT_EQ(first.frameInterval_ms, 0.0F);
+    EXPECT_GE(first.stage_ms[0], 2.0F);
+    EXPECT_FLOAT_EQ(first.stage_ms[2], 4.0F);
+    EXPECT_GE(first.frameWork_ms, first.stage_ms[0] + first.stage_ms[1]);
+    EXPECT_EQ(first.allocations, 1U);
+    EXPECT_EQ(first.queueDepth, 3U);
+    EXPECT_EQ(first.pointsPerSensor[0], 1U);
+    EXPECT_EQ(first.pointsPerSensor[4], 2U);
+    EXPECT_GE(samples[1].frameInterval_ms, 2.0F);
+}
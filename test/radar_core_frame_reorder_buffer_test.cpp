@@ -0,0 +1,86 @@
+#include "radar_core/frame_reorder_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using Buffer = radar::core::FrameReorderBuffer<int>;
+
+radar::core::ReorderSettings makeSettings(std::uint64_t latency, std::uint64_t delay, std::size_t capacity)
+{
+    radar::core::ReorderSettings settings;
+    settings.maxLatency_us = latency;
+    settings.hardwareDelay_us = delay;
+    settings.capacity = capacity;
+    return settings;
+}
+
+std::vector<int> drain(Buffer& buffer, std::uint64_t now)
+{
+    std::vector<int> released;
+    int frame = 0;
+    while (buffer.release(now, frame))
+    {
+        released.push_back(frame);
+    }
+    return released;
+}
+} // namespace
+
+TEST(FrameReorderBufferTest, ReleasesInTimestampOrderAfterDeadline)
+{
+    Buffer buffer(makeSettings(20U, 80U, 8U));
+    EXPECT_TRUE(buffer.push(1000U, 1));
+    EXPECT_TRUE(buffer.push(1100U, 3));
+    EXPECT_TRUE(buffer.push(1050U, 2));
+
+    EXPECT_TRUE(drain(buffer, 1099U).empty());
+    EXPECT_EQ(drain(buffer, 1150U), (std::vector<int>{1, 2}));
+    EXPECT_EQ(drain(buffer, Buffer::kFlush), (std::vector<int>{3}));
+
+    const auto& stats = buffer.statistics();
+    EXPECT_EQ(stats.received, 3U);
+    EXPECT_EQ(stats.released, 3U);
+    EXPECT_EQ(stats.reordered, 1U);
+    EXPECT_EQ(stats.maxJitter_us, 50U);
+    EXPECT_EQ(stats.forcedReleases, 0U);
+}
+
+TEST(FrameReorderBufferTest, DropsLateAndDuplicateFrames)
+{
+    Buffer buffer(makeSettings(0U, 0U, 8U));
+    EXPECT_TRUE(buffer.push(200U, 1));
+    EXPECT_FALSE(buffer.push(200U, 9));
+    EXPECT_EQ(drain(buffer, 200U), (std::vector<int>{1}));
+
+    EXPECT_FALSE(buffer.push(150U, 2));
+    EXPECT_FALSE(buffer.push(200U, 3));
+    EXPECT_TRUE(buffer.push(250U, 4));
+
+    const auto& stats = buffer.statistics();
+    EXPECT_EQ(stats.late, 2U);
+    EXPECT_EQ(stats.duplicates, 1U);
+    EXPECT_EQ(buffer.size(), 1U);
+}
+
+TEST(FrameReorderBufferTest, FullBufferReleasesOldestEarly)
+{
+    Buffer buffer(makeSettings(1000U, 0U, 2U));
+    EXPECT_TRUE(buffer.push(10U, 1));
+    EXPECT_TRUE(buffer.push(20U, 2));
+    EXPECT_FALSE(buffer.releasable(30U));
+
+    EXPECT_TRUE(buffer.push(30U, 3));
+    EXPECT_EQ(drain(buffer, 30U), (std::vector<int>{1}));
+    EXPECT_EQ(buffer.statistics().forcedReleases, 1U);
+    EXPECT_EQ(buffer.statistics().maxDepth, 3U);
+
+    // Pushing into an over-full buffer without draining loses the oldest frame.
+    EXPECT_TRUE(buffer.push(40U, 4));
+    EXPECT_TRUE(buffer.push(50U, 5));
+    EXPECT_EQ(buffer.statistics().overflows, 1U);
+    EXPECT_EQ(drain(buffer, Buffer::kFlush), (std::vector<int>{3, 4, 5}));
+}
@@ -0,0 +1,61 @@
+#include "radar_core/huge_page_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+TEST(HugePageAllocatorTest, SmallOrDisabledAllocationsStayOnHeap)
+{
+    EXPECT_FALSE(radar::core::usesLargeMapping(radar::core::kHugePageSize, radar::core::HugePageMode::Off));
+    EXPECT_FALSE(radar::core::usesLargeMapping(4096U, radar::core::HugePageMode::Explicit));
+
+    radar::core::LargeBacking backing = radar::core::LargeBacking::Explicit;
+    void* pointer = radar::core::allocateLarge(4096U, radar::core::HugePageMode::Transparent, &backing);
+    ASSERT_NE(pointer, nullptr);
+    EXPECT_EQ(backing, radar::core::LargeBacking::Heap);
+    radar::core::deallocateLarge(pointer, 4096U, radar::core::HugePageMode::Transparent);
+
+    radar::core::HugePageMode mode = radar::core::HugePageMode::Off;
+    EXPECT_TRUE(radar::core::parseHugePageMode("explicit", mode));
+    EXPECT_EQ(mode, radar::core::HugePageMode::Explicit);
+    EXPECT_FALSE(radar::core::parseHugePageMode("always", mode));
+}
+
+TEST(HugePageAllocatorTest, LargeBuffersAreAlignedAndFallBack)
+{
+    const std::size_t count = radar::core::kHugePageSize / sizeof(float) * 3U / 2U;
+    const auto initial = radar::core::hugePageStatistics();
+    for (const auto mode : {radar::core::HugePageMode::Transparent, radar::core::HugePageMode::Explicit})
+    {
+        std::vector<float, radar::core::HugePageAllocator<float>> grid(
+            count, 1.0F, radar::core::HugePageAllocator<float>(mode));
+        if (radar::core::usesLargeMapping(count * sizeof(float), mode))
+        {
+            // Explicit falls back to an aligned THP mapping when no hugetlbfs pages are reserved.
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(grid.data()) % radar::core::kHugePageSize, 0U);
+            EXPECT_LE(radar::core::residentHugePageBytes(grid.data(), count * sizeof(float)),
+                      2U * radar::core::kHugePageSize);
+            const auto mapped = radar::core::hugePageStatistics();
+            EXPECT_EQ(mapped.transparentBytes + mapped.explicitBytes,
+                      initial.transparentBytes + initial.explicitBytes + 2U * radar::core::kHugePageSize);
+        }
+        grid.back() = 2.0F;
+        EXPECT_FLOAT_EQ(grid.front(), 1.0F);
+        EXPECT_FLOAT_EQ(grid.back(), 2.0F);
+
+        // Reassignment propagates the allocator, as FusedRadarMapping::initializeGrid relies on.
+        grid = std::vector<float, radar::core::HugePageAllocator<float>>(
+            16U, 0.0F, radar::core::HugePageAllocator<float>(radar::core::HugePageMode::Off));
+        EXPECT_EQ(grid.get_allocator().mode(), radar::core::HugePageMode::Off);
+    }
+
+    // Every mapping has been released again.
+    const auto statistics = radar::core::hugePageStatistics();
+#if defined(__linux__)
+    EXPECT_EQ(statistics.transparentBytes + statistics.explicitBytes,
+              initial.transparentBytes + initial.explicitBytes);
+#else
+    EXPECT_GT(statistics.fallbacks, 0U);
+#endif
+}
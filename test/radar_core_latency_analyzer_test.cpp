@@ -0,0 +1,114 @@
+#include "radar_core/latency_analyzer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+double exactQuantile(std::vector<std::uint64_t> values, double q)
+{
+    std::sort(values.begin(), values.end());
+    return static_cast<double>(values[static_cast<std::size_t>(q * static_cast<double>(values.size() - 1U))]);
+}
+} // namespace
+
+TEST(QuantileSketchTest, QuantilesStayWithinRelativeAccuracy)
+{
+    std::mt19937 rng(7U);
+    std::lognormal_distribution<double> latency(std::log(80000.0), 0.3);
+    radar::core::QuantileSketch sketch;
+    std::vector<std::uint64_t> values;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const auto value = static_cast<std::uint64_t>(latency(rng));
+        sketch.add(value);
+        values.push_back(value);
+    }
+
+    EXPECT_EQ(sketch.count(), values.size());
+    EXPECT_EQ(sketch.min(), *std::min_element(values.begin(), values.end()));
+    EXPECT_EQ(sketch.max(), *std::max_element(values.begin(), values.end()));
+    for (const double q : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0})
+    {
+        const double exact = exactQuantile(values, q);
+        EXPECT_NEAR(sketch.quantile(q), exact, exact * radar::core::QuantileSketch::kRelativeAccuracy) << q;
+    }
+}
+
+TEST(QuantileSketchTest, MergesAndClears)
+{
+    radar::core::QuantileSketch low;
+    radar::core::QuantileSketch high;
+    for (std::uint64_t value = 0U; value < 100U; ++value)
+    {
+        low.add(value);
+        high.add(1000U + value);
+    }
+    low.merge(high);
+    EXPECT_EQ(low.count(), 200U);
+    EXPECT_EQ(low.min(), 0U);
+    EXPECT_EQ(low.max(), 1099U);
+    EXPECT_DOUBLE_EQ(low.mean(), (49.5 + 1049.5) / 2.0);
+    EXPECT_NEAR(low.quantile(0.75), 1049.0, 1049.0 * radar::core::QuantileSketch::kRelativeAccuracy);
+
+    low.clear();
+    EXPECT_EQ(low.count(), 0U);
+    EXPECT_DOUBLE_EQ(low.quantile(0.5), 0.0);
+}
+
+TEST(LatencyAnalyzerTest, FlagsOnlySourcesOverBudgetOnce)
+{
+    radar::core::LatencyBudgetSettings settings;
+    settings.transportAllowance_us = 5000U;
+    settings.pipelineBudget_us = 20000U;
+    settings.minSamples = 32U;
+    radar::core::LatencyAnalyzer analyzer(settings);
+    const std::size_t fast = analyzer.addSource("corner:front_left", 80000U);
+    const std::size_t slow = analyzer.addSource("front", 60000U);
+
+    std::vector<int> flagged;
+    for (std::uint64_t frame = 0U; frame < 200U; ++frame)
+    {
+        const std::uint64_t capture = frame * 50000U;
+        // The front radar publishes 75 ms after capture against a 65 ms budget; processing is within budget.
+        if (analyzer.record(fast, capture, capture + 82000U, capture + 90000U))
+        {
+            flagged.push_back(0);
+        }
+        if (analyzer.record(slow, capture, capture + 75000U, capture + 80000U))
+        {
+            flagged.push_back(1);
+        }
+    }
+
+    EXPECT_EQ(flagged, (std::vector<int>{1}));
+    EXPECT_TRUE(analyzer.overBudget());
+    const auto& sources = analyzer.sources();
+    EXPECT_FALSE(sources[fast].overCaptureBudget || sources[fast].overPipelineBudget);
+    EXPECT_TRUE(sources[slow].overCaptureBudget);
+    EXPECT_FALSE(sources[slow].overPipelineBudget);
+    EXPECT_NEAR(sources[slow].captureToPublish.quantile(0.99), 75000.0, 750.0);
+    EXPECT_NEAR(sources[fast].publishToProcessed.quantile(0.5), 8000.0, 80.0);
+    EXPECT_NE(analyzer.report().find("front (200 frames)"), std::string::npos);
+    EXPECT_NE(analyzer.report().find("[over capture budget 65.00 ms]"), std::string::npos);
+}
+
+TEST(LatencyAnalyzerTest, CountsClockSkewInsteadOfSketchingIt)
+{
+    radar::core::LatencyAnalyzer analyzer;
+    const std::size_t source = analyzer.addSource("corner:rear_left", 80000U);
+    EXPECT_FALSE(analyzer.record(source, 1000U, 900U, 950U));
+    EXPECT_FALSE(analyzer.record(99U, 0U, 0U, 0U));
+
+    const auto& latency = analyzer.sources()[source];
+    EXPECT_EQ(latency.clockSkewed, 1U);
+    EXPECT_EQ(latency.captureToPublish.count(), 0U);
+    EXPECT_EQ(latency.publishToProcessed.count(), 1U);
+    EXPECT_EQ(latency.publishToProcessed.max(), 50U);
+}
@@ -0,0 +1,67 @@
+#include "radar_core/huge_page_allocator.hpp"
+#include "radar_core/memory_accounting.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+using ScratchFloats =
+    std::vector<float, radar::core::TaggedAllocator<float, radar::core::MemoryTag::PipelineScratch>>;
+} // namespace
+
+TEST(MemoryAccountingTest, TaggedContainersTrackCurrentAndPeak)
+{
+    // Counters are process-wide, so compare against a baseline rather than absolute values.
+    const auto before = radar::core::memoryUsage(radar::core::MemoryTag::PipelineScratch);
+
+    ScratchFloats values;
+    values.reserve(1024U);
+    const auto grown = radar::core::memoryUsage(radar::core::MemoryTag::PipelineScratch);
+    EXPECT_EQ(grown.currentBytes, before.currentBytes + 1024U * sizeof(float));
+    EXPECT_GE(grown.peakBytes, grown.currentBytes);
+    EXPECT_EQ(grown.allocations, before.allocations + 1U);
+
+    values.clear();
+    values.shrink_to_fit();
+    const auto released = radar::core::memoryUsage(radar::core::MemoryTag::PipelineScratch);
+    EXPECT_EQ(released.currentBytes, before.currentBytes);
+    EXPECT_GE(released.peakBytes, grown.currentBytes);
+}
+
+TEST(MemoryAccountingTest, HugePageAllocatorChargesItsTag)
+{
+    const auto before = radar::core::memoryUsage(radar::core::MemoryTag::MappingGrid);
+    {
+        std::vector<float, radar::core::HugePageAllocator<float>> grid(
+            256U,
+            0.0F,
+            radar::core::HugePageAllocator<float>(radar::core::HugePageMode::Off, radar::core::MemoryTag::MappingGrid));
+        EXPECT_EQ(radar::core::memoryUsage(radar::core::MemoryTag::MappingGrid).currentBytes,
+                  before.currentBytes + 256U * sizeof(float));
+
+        // Untagged allocators are not charged anywhere.
+        const auto footprint = radar::core::memoryFootprint();
+        std::vector<float, radar::core::HugePageAllocator<float>> untracked(
+            256U, 0.0F, radar::core::HugePageAllocator<float>(radar::core::HugePageMode::Off));
+        const auto after = radar::core::memoryFootprint();
+        for (std::size_t index = 0U; index < radar::core::kMemoryTagCount; ++index)
+        {
+            EXPECT_EQ(after[index].currentBytes, footprint[index].currentBytes);
+        }
+    }
+    EXPECT_EQ(radar::core::memoryUsage(radar::core::MemoryTag::MappingGrid).currentBytes, before.currentBytes);
+}
+
+TEST(MemoryAccountingTest, ReportListsEveryTag)
+{
+    const std::string report = radar::core::memoryFootprintReport();
+    for (std::size_t index = 0U; index < radar::core::kMemoryTagCount; ++index)
+    {
+        EXPECT_NE(report.find(radar::core::memoryTagName(static_cast<radar::core::MemoryTag>(index))),
+                  std::string::npos);
+    }
+    EXPECT_NE(report.find("process RSS"), std::string::npos);
+}
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 namespace
 {
 utility::EnhancedDetections makeDetections(const std::vector<std::pair<float, float>>& anglesAndRates)
@@ -61,3 +63,46 @@ TEST(RadarOdometryEstimatorTest, EstimatesVelocityFromDetections)
     EXPECT_NEAR(std::abs(estimate.vLat_mps), std::abs(vLat), 1e-2f);
     EXPECT_TRUE(estimate.valid);
 }
+
+TEST(RadarOdometryEstimatorTest, HistogramEstimatesVelocityUnderHeavyClutter)
+{
+    radar::core::OdometrySettings settings;
+    settings.method = radar::core::OdometryMethod::Histogram;
+    radar::core::RadarOdometryEstimator estimator(settings);
+
+    const float vLon = 12.3f;
+    const float vLat = -0.7f;
+    radar::core::ScratchVector<radar::core::OdometrySample> samples;
+    // 16 stationary returns spread around the vehicle, 24 movers with unrelated range rates.
+    for (int i = 0; i < 40; ++i)
+    {
+        const float angle = -utility::kPi + static_cast<float>(i) * (2.0f * utility::kPi / 40.0f);
+        radar::core::OdometrySample sample{std::cos(angle), std::sin(angle), 0.0f};
+        if (i % 5 < 2)
+        {
+            const float noise = (i % 2 == 0) ? 0.05f : -0.05f;
+            sample.rangeRate = -(vLon * sample.cosAngle + vLat * sample.sinAngle) + noise;
+        }
+        else
+        {
+            sample.rangeRate = -25.0f + static_cast<float>((i * 17) % 50);
+        }
+        samples.push_back(sample);
+    }
+
+    ASSERT_TRUE(estimator.processSamples(samples, 77U));
+    utility::OdometryEstimate estimate;
+    ASSERT_TRUE(estimator.latestEstimate(estimate));
+    EXPECT_NEAR(estimate.vLon_mps, vLon, 0.05f);
+    EXPECT_NEAR(estimate.vLat_mps, vLat, 0.05f);
+    EXPECT_GE(estimate.inlierCount, 16U);
+    EXPECT_EQ(estimate.timestamp_us, 77U);
+
+    // No random sampling: the same frame gives the same estimate.
+    radar::core::RadarOdometryEstimator again(settings);
+    ASSERT_TRUE(again.processSamples(samples, 77U));
+    utility::OdometryEstimate repeated;
+    again.latestEstimate(repeated);
+    EXPECT_EQ(repeated.vLon_mps, estimate.vLon_mps);
+    EXPECT_EQ(repeated.vLat_mps, estimate.vLat_mps);
+}
@@ -0,0 +1,90 @@
+#include "radar_core/perf_counters.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+std::uint64_t busyWork(std::size_t count)
+{
+    std::vector<std::uint64_t> values(count);
+    std::iota(values.begin(), values.end(), 1U);
+    return std::accumulate(values.begin(), values.end(), std::uint64_t{0});
+}
+} // namespace
+
+TEST(StageProfilerTest, AggregatesCallsItemsAndWallTime)
+{
+    radar::core::StageProfiler profiler(false);
+    const std::size_t stage = profiler.addStage("work");
+    EXPECT_EQ(profiler.addStage("work"), stage);
+    EXPECT_FALSE(profiler.hardwareCountersAvailable());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const radar::core::StageProfiler::Scope scope(&profiler, stage, 10U);
+        EXPECT_GT(busyWork(1000U), 0U);
+    }
+
+    ASSERT_EQ(profiler.stages().size(), 1U);
+    const auto& stats = profiler.stages().front();
+    EXPECT_EQ(stats.calls, 3U);
+    EXPECT_EQ(stats.items, 30U);
+    EXPECT_GT(stats.wallTime_s, 0.0);
+    EXPECT_EQ(stats.instructionsPerCycle(), 0.0);
+    EXPECT_NE(profiler.report().find("work"), std::string::npos);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.stages().front().calls, 0U);
+    EXPECT_EQ(profiler.stages().front().name, "work");
+}
+
+TEST(StageProfilerTest, NullProfilerScopeIsNoOp)
+{
+    const radar::core::StageProfiler::Scope scope(nullptr, 0U, 5U);
+    SUCCEED();
+}
+
+TEST(StageProfilerTest, CountsHardwareEventsWhenAvailable)
+{
+    radar::core::StageProfiler profiler;
+    if (!profiler.hardwareCountersAvailable())
+    {
+        GTEST_SKIP() << "perf_event_open not permitted in this environment";
+    }
+
+    const std::size_t stage = profiler.addStage("work");
+    {
+        const radar::core::StageProfiler::Scope scope(&profiler, stage, 100000U);
+        EXPECT_GT(busyWork(100000U), 0U);
+    }
+
+    const auto& stats = profiler.stages().front();
+    EXPECT_GT(stats.counters[radar::core::PerfCounter::Cycles], 0U);
+    EXPECT_GT(stats.instructionsPerCycle(), 0.0);
+}
+
+TEST(PerfCounterSampleTest, ScalesEachIntervalByItsOwnRunningTime)
+{
+    using radar::core::PerfCounter;
+    radar::core::PerfCounterSample start;
+    start.values[0] = 1000U;
+    start.timeEnabled_ns = 1000U;
+    start.timeRunning_ns = 1000U;
+
+    // Multiplexed for half of the interval: 100 counted events stand for 200.
+    radar::core::PerfCounterSample end = start;
+    end.values[0] = 1100U;
+    end.timeEnabled_ns = 2000U;
+    end.timeRunning_ns = 1500U;
+    EXPECT_EQ(end.deltaSince(start)[PerfCounter::Cycles], 200U);
+
+    // An interval the group was never scheduled in contributes nothing instead of wrapping.
+    radar::core::PerfCounterSample idle = end;
+    idle.timeEnabled_ns = 3000U;
+    EXPECT_EQ(idle.deltaSince(end)[PerfCounter::Cycles], 0U);
+    EXPECT_EQ(start.deltaSince(end)[PerfCounter::Cycles], 0U);
+}
@@ -1,9 +1,13 @@
 #include "radar_core/processing_pipeline.hpp"
 
+#include "radar_core/mask_compaction.hpp"
 #include "utility/math_utils.hpp"
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 namespace
 {
 utility::VehicleParameters makeVehicleParameters()
@@ -135,3 +139,262 @@ TEST(RadarProcessingPipelineTest, ProcessesFrontDetections)
     EXPECT_NE(outputShort.detections[0].flags, 0U);
     EXPECT_NE(outputLong.detections[0].flags, 0U);
 }
+
+TEST(RadarProcessingPipelineTest, FusedPathMatchesStagedPath)
+{
+    auto params = makeVehicleParameters();
+    radar::core::RadarProcessingPipeline staged;
+    radar::core::RadarProcessingPipeline fused;
+    staged.initialize(&params);
+    fused.initialize(&params);
+
+    utility::EnhancedTracks tracksOutput;
+    staged.processTrackFusion(900U, makeTrackFusion(), tracksOutput);
+    fused.processTrackFusion(900U, makeTrackFusion(), tracksOutput);
+
+    const auto expectSame = [](const utility::EnhancedDetection& expected, const utility::EnhancedDetection& actual)
+    {
+        EXPECT_EQ(actual.range_m, expected.range_m);
+        EXPECT_EQ(actual.flags, expected.flags);
+        EXPECT_EQ(actual.isStationary, expected.isStationary);
+        EXPECT_EQ(actual.isMoveable, expected.isMoveable);
+        EXPECT_EQ(actual.isStatic, expected.isStatic);
+        EXPECT_EQ(actual.fusedTrackIndex, expected.fusedTrackIndex);
+        EXPECT_EQ(actual.stationaryProbability, expected.stationaryProbability);
+    };
+
+    // Ego speed ~10 m/s with a few movers; odometry feeds back into the next frame's classification.
+    for (std::uint64_t frame = 0U; frame < 4U; ++frame)
+    {
+        auto corner = makeCornerDetections();
+        corner.header.timestamp_us = 1000U + frame * 50000U;
+        for (std::size_t i = 0; i < 40U; ++i)
+        {
+            const float azimuth = -0.6f + 0.03f * static_cast<float>(i);
+            corner.range_m[i] = 5.0f + static_cast<float>(i);
+            corner.azimuthRaw_rad[i] = azimuth;
+            corner.azimuth_rad[i] = azimuth;
+            corner.rangeRate_ms[i] = (i % 7U == 0U) ? 2.0f : -10.0f * std::cos(azimuth);
+            corner.longitudinalOffset_m[i] = 0.0f;
+            corner.lateralOffset_m[i] = 0.0f;
+            corner.radarValidReturn[i] = 1U;
+        }
+        corner.longitudinalOffset_m[0] = 1.0f;
+        corner.lateralOffset_m[0] = 1.0f;
+
+        utility::EnhancedDetections expected;
+        const bool stagedValid =
+            staged.processCornerDetections(corner.sensor, corner.header.timestamp_us, corner, expected);
+        std::vector<std::size_t> slots;
+        const bool fusedValid = fused.processCornerDetectionsFused(
+            corner.sensor,
+            corner.header.timestamp_us,
+            corner,
+            [&](utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det)
+            {
+                EXPECT_EQ(sensor, corner.sensor);
+                slots.push_back(slot);
+                expectSame(expected.detections[slot], det);
+            });
+        EXPECT_EQ(fusedValid, stagedValid);
+        // Padding slots (40..63) are never emitted.
+        ASSERT_EQ(slots.size(), 40U);
+        EXPECT_EQ(slots.back(), 39U);
+    }
+
+    utility::OdometryEstimate stagedOdometry;
+    utility::OdometryEstimate fusedOdometry;
+    EXPECT_TRUE(staged.latestOdometry(stagedOdometry));
+    EXPECT_TRUE(fused.latestOdometry(fusedOdometry));
+    EXPECT_EQ(fusedOdometry.vLon_mps, stagedOdometry.vLon_mps);
+    EXPECT_EQ(fusedOdometry.inlierCount, stagedOdometry.inlierCount);
+
+    utility::EnhancedDetections expectedShort;
+    utility::EnhancedDetections expectedLong;
+    staged.processFrontDetections(2000000U, makeFrontDetections(), expectedShort, expectedLong);
+    std::size_t emitted = 0U;
+    fused.processFrontDetectionsFused(
+        2000000U,
+        makeFrontDetections(),
+        [&](utility::SensorIndex sensor, std::size_t slot, const utility::EnhancedDetection& det)
+        {
+            ++emitted;
+            expectSame(sensor == utility::SensorIndex::FrontShort ? expectedShort.detections[slot]
+                                                                   : expectedLong.detections[slot],
+                       det);
+        });
+    EXPECT_EQ(emitted, 2U);
+}
+
+TEST(RadarProcessingPipelineTest, BatchMatchesPerFrameCalls)
+{
+    auto params = makeVehicleParameters();
+    params.cornerHardwareDelay_s = 0.02f;
+    radar::core::RadarProcessingPipeline single;
+    radar::core::RadarProcessingPipeline batched;
+    single.initialize(&params);
+    batched.initialize(&params);
+
+    std::vector<utility::RawCornerDetections> frames;
+    std::vector<std::uint64_t> timestamps;
+    for (std::uint64_t frame = 0U; frame < 6U; ++frame)
+    {
+        auto corner = makeCornerDetections();
+        corner.header.timestamp_us = 1000U + frame * 50000U;
+        for (std::size_t i = 0; i < 30U + frame; ++i)
+        {
+            const float azimuth = -0.6f + 0.03f * static_cast<float>(i);
+            corner.range_m[i] = 2.0f + 0.5f * static_cast<float>(i);
+            corner.azimuthRaw_rad[i] = azimuth;
+            corner.azimuth_rad[i] = azimuth;
+            corner.rangeRate_ms[i] = (i % 5U == 0U) ? 1.0f : -8.0f * std::cos(azimuth);
+            corner.longitudinalOffset_m[i] = 0.0f;
+            corner.lateralOffset_m[i] = 0.0f;
+            corner.radarValidReturn[i] = 1U;
+        }
+        timestamps.push_back(corner.header.timestamp_us + 30000U);
+        frames.push_back(corner);
+    }
+    // A stale frame, to cover the per-sensor update check.
+    frames[4].header.timestamp_us = frames[3].header.timestamp_us;
+
+    // A stationary box over the near returns, then one moving away over the far ones.
+    auto first = makeTrackFusion();
+    first.vcsLongitudinalPosition[0] = 5.0f;
+    first.vcsLateralPosition[0] = -0.5f;
+    first.length[0] = 8.0f;
+    first.width[0] = 4.0f;
+    auto movedTracks = first;
+    movedTracks.vcsLongitudinalPosition[0] = 12.0f;
+    movedTracks.vcsLongitudinalVelocity[0] = 3.0f;
+    // Before the first frame, between frames 2 and 3 (applied before frame 3) and after the last one.
+    const std::vector<radar::core::TrackSnapshot> snapshots = {
+        {900U, &first}, {timestamps[2] + 10U, &movedTracks}, {timestamps.back() + 10U, &first}};
+
+    std::vector<utility::EnhancedDetections> expected(frames.size());
+    std::vector<bool> expectedValid;
+    utility::EnhancedTracks expectedTracks;
+    std::size_t nextSnapshot = 0U;
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        for (; nextSnapshot < snapshots.size() && snapshots[nextSnapshot].timestamp_us <= timestamps[i]; ++nextSnapshot)
+        {
+            const auto& snapshot = snapshots[nextSnapshot];
+            single.processTrackFusion(snapshot.timestamp_us, *snapshot.tracks, expectedTracks);
+        }
+        expectedValid.push_back(single.processCornerDetectionsFused(
+            frames[i].sensor,
+            timestamps[i],
+            frames[i],
+            [&](utility::SensorIndex, std::size_t, const utility::EnhancedDetection& det)
+            { expected[i].detections.push_back(det); }));
+    }
+    single.processTrackFusion(snapshots.back().timestamp_us, *snapshots.back().tracks, expectedTracks);
+
+    radar::core::ProcessedBatch batch;
+    ASSERT_TRUE(batched.processCornerBatch(utility::SensorIndex::FrontLeft, timestamps, frames, snapshots, batch));
+    ASSERT_EQ(batch.frames.size(), frames.size());
+    ASSERT_EQ(batch.sensors.size(), batch.detections.size());
+    ASSERT_EQ(batch.slots.size(), batch.detections.size());
+    std::size_t associated = 0U;
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        EXPECT_EQ(batch.frames[i].timestamp_us, timestamps[i]);
+        EXPECT_EQ(batch.frames[i].valid, expectedValid[i]) << i;
+        const auto detections = batch.frameDetections(i);
+        ASSERT_EQ(detections.size(), expected[i].detections.size());
+        for (std::size_t n = 0; n < detections.size(); ++n)
+        {
+            const auto& want = expected[i].detections[n];
+            EXPECT_EQ(detections[n].range_m, want.range_m);
+            EXPECT_EQ(detections[n].isStationary, want.isStationary);
+            EXPECT_EQ(detections[n].isMoveable, want.isMoveable);
+            EXPECT_EQ(detections[n].fusedTrackIndex, want.fusedTrackIndex);
+            EXPECT_EQ(detections[n].stationaryProbability, want.stationaryProbability);
+            EXPECT_EQ(batch.slots[batch.frames[i].first + n], n);
+            associated += want.fusedTrackIndex >= 0 ? 1U : 0U;
+        }
+    }
+    EXPECT_GT(associated, 0U);
+    EXPECT_FALSE(batch.frames[4].valid);
+    EXPECT_EQ(batch.tracks.timestamp_us, expectedTracks.timestamp_us);
+
+    utility::OdometryEstimate singleOdometry;
+    utility::OdometryEstimate batchedOdometry;
+    EXPECT_EQ(batched.latestOdometry(batchedOdometry), single.latestOdometry(singleOdometry));
+    EXPECT_EQ(batchedOdometry.vLon_mps, singleOdometry.vLon_mps);
+
+    // Front batches split each record into its short- and long-range halves.
+    const std::vector<utility::RawFrontDetections> front = {makeFrontDetections()};
+    const std::vector<std::uint64_t> frontTimestamps = {front[0].header.timestamp_us};
+    ASSERT_TRUE(batched.processFrontBatch(frontTimestamps, front, {}, batch));
+    ASSERT_EQ(batch.detections.size(), 2U);
+    EXPECT_EQ(batch.sensors[0], utility::SensorIndex::FrontShort);
+    EXPECT_EQ(batch.sensors[1], utility::SensorIndex::FrontLong);
+    EXPECT_EQ(batch.slots[1], 0U);
+
+    EXPECT_FALSE(batched.processFrontBatch({}, front, {}, batch));
+    EXPECT_TRUE(batch.frames.empty());
+}
+
+TEST(RadarProcessingPipelineTest, CompactsValidTrackSlotsInOrder)
+{
+    radar::core::RadarProcessingPipeline pipeline;
+    utility::RawTrackFusion input;
+    // Slots straddling the 16-byte blocks of the compaction, including the last one.
+    const std::vector<std::size_t> validSlots = {0U, 15U, 16U, 47U, 80U, 95U};
+    for (const std::size_t slot : validSlots)
+    {
+        input.status[slot] = static_cast<std::uint8_t>(utility::TrackStatus::Coasted);
+        input.id[slot] = static_cast<std::int32_t>(slot);
+        input.vcsLongitudinalPosition[slot] = static_cast<float>(slot);
+        input.stationaryFlag[slot] = 1U;
+    }
+
+    utility::EnhancedTracks output;
+    pipeline.processTrackFusion(900U, input, output);
+    ASSERT_EQ(output.tracks.size(), validSlots.size());
+    for (std::size_t n = 0; n < validSlots.size(); ++n)
+    {
+        EXPECT_EQ(output.tracks[n].id, static_cast<std::int32_t>(validSlots[n]));
+        EXPECT_EQ(output.tracks[n].vcsLongitudinalPosition, static_cast<float>(validSlots[n]));
+        EXPECT_EQ(output.tracks[n].status, utility::TrackStatus::Coasted);
+        EXPECT_TRUE(output.tracks[n].isStationary);
+        EXPECT_FALSE(output.tracks[n].isMoving);
+    }
+
+    // A following frame with fewer tracks shrinks the output instead of appending to it.
+    pipeline.processTrackFusion(1000U, makeTrackFusion(), output);
+    ASSERT_EQ(output.tracks.size(), 1U);
+    EXPECT_EQ(output.timestamp_us, 1000U);
+    EXPECT_EQ(output.tracks[0].id, 42);
+    EXPECT_TRUE(output.tracks[0].isMoving);
+    EXPECT_FALSE(output.tracks[0].isStationary);
+
+    pipeline.processTrackFusion(1100U, utility::RawTrackFusion{}, output);
+    EXPECT_TRUE(output.tracks.empty());
+}
+
+TEST(MaskCompactionTest, MatchesScalarScanIncludingTail)
+{
+    std::vector<std::uint8_t> values(101U, 0U);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<std::uint8_t>((i * 37U + 11U) % 5U == 0U ? (i % 7U) + 1U : 0U);
+    }
+    values[100] = 3U;
+
+    std::vector<std::uint8_t> expected;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        if (values[i] != 0U)
+        {
+            expected.push_back(static_cast<std::uint8_t>(i));
+        }
+    }
+
+    std::vector<std::uint8_t> indices(values.size(), 0U);
+    const std::size_t count = radar::core::compactNonZeroIndices(values.data(), values.size(), indices.data());
+    indices.resize(count);
+    EXPECT_EQ(indices, expected);
+}
@@ -0,0 +1,83 @@
+#include "radar_core/stream_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <vector>
+
+namespace
+{
+using Generator = radar::core::StreamGenerator<int>;
+
+Generator countTo(int last)
+{
+    for (int value = 1; value <= last; ++value)
+    {
+        co_yield value;
+    }
+}
+
+// Yields first, then the value of each future once it is ready.
+Generator yieldAfter(int first, std::vector<std::future<int>>& futures)
+{
+    co_yield first;
+    for (auto& future : futures)
+    {
+        co_await future;
+        const int value = future.get();
+        co_yield value;
+    }
+}
+} // namespace
+
+TEST(StreamGeneratorTest, YieldsValuesInOrderThenEnds)
+{
+    Generator generator = countTo(3);
+    std::vector<int> values;
+    while (generator.resume() == Generator::State::Yielded)
+    {
+        values.push_back(generator.value());
+    }
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(generator.resume(), Generator::State::Done);
+    EXPECT_EQ(Generator().resume(), Generator::State::Done);
+}
+
+TEST(StreamGeneratorTest, WaitsOnFuturesThatAreNotReady)
+{
+    std::promise<int> late;
+    std::promise<int> early;
+    std::vector<std::future<int>> futures;
+    futures.push_back(late.get_future());
+    futures.push_back(early.get_future());
+    early.set_value(20);
+
+    Generator generator = yieldAfter(5, futures);
+    ASSERT_EQ(generator.resume(), Generator::State::Yielded);
+    EXPECT_EQ(generator.value(), 5);
+
+    EXPECT_EQ(generator.resume(), Generator::State::Waiting);
+    EXPECT_FALSE(generator.ready());
+    late.set_value(10);
+    generator.wait();
+    EXPECT_TRUE(generator.ready());
+    ASSERT_EQ(generator.resume(), Generator::State::Yielded);
+    EXPECT_EQ(generator.value(), 10);
+
+    // A future that is already ready does not suspend.
+    ASSERT_EQ(generator.resume(), Generator::State::Yielded);
+    EXPECT_EQ(generator.value(), 20);
+    EXPECT_EQ(generator.resume(), Generator::State::Done);
+}
+
+TEST(StreamGeneratorTest, MovesOwnershipOfTheCoroutine)
+{
+    Generator source = countTo(2);
+    ASSERT_EQ(source.resume(), Generator::State::Yielded);
+    Generator moved = std::move(source);
+    EXPECT_FALSE(source);
+    ASSERT_TRUE(moved);
+    EXPECT_EQ(moved.value(), 1);
+    ASSERT_EQ(moved.resume(), Generator::State::Yielded);
+    EXPECT_EQ(moved.value(), 2);
+}
@@ -0,0 +1,67 @@
+#include "radar_core/thread_placement.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPlacementTest, ParsesCpuListsAndPlacementSpecs)
+{
+    std::vector<int> cpus;
+    ASSERT_TRUE(radar::core::parseCpuList("4-6, 2,5", cpus));
+    EXPECT_EQ(cpus, (std::vector<int>{2, 4, 5, 6}));
+    EXPECT_FALSE(radar::core::parseCpuList("3-1", cpus));
+    EXPECT_FALSE(radar::core::parseCpuList("a", cpus));
+    EXPECT_FALSE(radar::core::parseCpuList("0-2147483647", cpus));
+    EXPECT_FALSE(radar::core::parseCpuList("4096", cpus));
+    EXPECT_TRUE(radar::core::parseCpuList("4095", cpus));
+
+    radar::core::ThreadPlacementSettings settings;
+    ASSERT_TRUE(radar::core::parseThreadPlacement("reader=2; render=3@80;worker=4-5;mlock", settings));
+    EXPECT_TRUE(settings.lockMemory);
+    EXPECT_EQ(settings[radar::core::ThreadRole::Reader].cpus, (std::vector<int>{2}));
+    EXPECT_EQ(settings[radar::core::ThreadRole::Reader].realtimePriority, 0);
+    EXPECT_EQ(settings[radar::core::ThreadRole::Render].cpus, (std::vector<int>{3}));
+    EXPECT_EQ(settings[radar::core::ThreadRole::Render].realtimePriority, 80);
+    EXPECT_EQ(settings[radar::core::ThreadRole::Worker].cpus, (std::vector<int>{4, 5}));
+
+    // Priority only keeps the inherited affinity.
+    ASSERT_TRUE(radar::core::parseThreadPlacement("render=@10", settings));
+    EXPECT_TRUE(settings[radar::core::ThreadRole::Render].cpus.empty());
+    EXPECT_EQ(settings[radar::core::ThreadRole::Render].realtimePriority, 10);
+    EXPECT_FALSE(settings.lockMemory);
+
+    EXPECT_FALSE(radar::core::parseThreadPlacement("gpu=1", settings));
+    EXPECT_FALSE(radar::core::parseThreadPlacement("render=1@100", settings));
+    EXPECT_TRUE(radar::core::parseThreadPlacement("", settings));
+    EXPECT_TRUE(settings.empty());
+}
+
+TEST(ThreadPlacementTest, AppliesAffinityToCallingThreadAndReports)
+{
+    radar::core::AppliedPlacement inherited;
+    std::thread([&]() { radar::core::applyThreadPlacement(radar::core::ThreadRole::Worker, {}, "probe", inherited); })
+        .join();
+#if !defined(__linux__)
+    GTEST_SKIP() << "Thread placement is only implemented on Linux";
+#endif
+    ASSERT_FALSE(inherited.effectiveCpus.empty());
+    EXPECT_TRUE(inherited.error.empty());
+
+    radar::core::ThreadPlacement placement;
+    placement.cpus = {inherited.effectiveCpus.back()};
+    radar::core::AppliedPlacement applied;
+    bool ok = false;
+    std::thread([&]() { ok = radar::core::applyThreadPlacement(radar::core::ThreadRole::Reader, placement, "reader", applied); })
+        .join();
+    EXPECT_TRUE(ok) << applied.error;
+    EXPECT_TRUE(applied.affinityApplied);
+    EXPECT_EQ(applied.effectiveCpus, placement.cpus);
+
+    const std::string report = radar::core::formatPlacementReport({inherited, applied}, false);
+    EXPECT_NE(report.find("worker [probe]: cpus requested=any"), std::string::npos);
+    EXPECT_NE(report.find("reader [reader]: cpus requested=" + std::to_string(placement.cpus.front())),
+              std::string::npos);
+    EXPECT_NE(report.find("policy=default"), std::string::npos);
+}
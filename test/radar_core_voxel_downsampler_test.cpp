@@ -0,0 +1,122 @@
+#include "radar_core/voxel_downsampler.hpp"
+
+#include "sensors/BaseRadarSensor.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+radar::RadarPoint makePoint(float x, float y, float amplitude, float rangeRate, float stationaryProbability)
+{
+    radar::RadarPoint point;
+    point.x = x;
+    point.y = y;
+    point.amplitude_dBsm = amplitude;
+    point.rangeRate_ms = rangeRate;
+    point.stationaryProbability = stationaryProbability;
+    point.radarValid = 1U;
+    return point;
+}
+} // namespace
+
+TEST(VoxelDownsamplerTest, MergesPointsSharingACell)
+{
+    radar::core::VoxelDownsampleSettings settings;
+    settings.enabled = true;
+    settings.cellSize_m = 1.0f;
+    radar::core::VoxelDownsampler downsampler(settings);
+
+    radar::BaseRadarSensor::PointCloud input;
+    input.push_back(makePoint(0.1f, 0.1f, -10.0f, 1.0f, 0.2f));
+    input.push_back(makePoint(0.6f, 0.9f, -5.0f, 3.0f, 0.6f));
+    input.push_back(makePoint(2.5f, -1.5f, -20.0f, -2.0f, 1.0f));
+
+    radar::BaseRadarSensor::PointCloud output;
+    downsampler.downsample(input, output);
+
+    ASSERT_EQ(output.size(), 2U);
+    EXPECT_FLOAT_EQ(output[0].x, 0.6f);
+    EXPECT_FLOAT_EQ(output[0].amplitude_dBsm, -5.0f);
+    EXPECT_FLOAT_EQ(output[0].rangeRate_ms, 2.0f);
+    EXPECT_FLOAT_EQ(output[0].stationaryProbability, 0.4f);
+    EXPECT_FLOAT_EQ(output[1].x, 2.5f);
+    EXPECT_FLOAT_EQ(output[1].rangeRate_ms, -2.0f);
+}
+
+TEST(VoxelDownsamplerTest, ReusesTableAcrossFramesAndGrowsOnDemand)
+{
+    radar::core::VoxelDownsampleSettings settings;
+    settings.cellSize_m = 0.5f;
+    radar::core::VoxelDownsampler downsampler(settings);
+
+    radar::BaseRadarSensor::PointCloud dense;
+    for (int i = 0; i < 2000; ++i)
+    {
+        dense.push_back(makePoint(static_cast<float>(i % 100) * 0.5f, static_cast<float>(i / 100) * 0.5f, 0.0f, 0.0f, 0.0f));
+    }
+
+    radar::BaseRadarSensor::PointCloud output;
+    downsampler.downsample(dense, output);
+    EXPECT_EQ(output.size(), dense.size());
+
+    // Announce fewer points than are added so the table has to grow mid-frame.
+    downsampler.beginFrame(4U);
+    for (std::uint32_t i = 0; i < dense.size(); ++i)
+    {
+        downsampler.addPoint(i, {dense[i].x, dense[i].y, 0.0f, 0.0f, 0.0f, 0.0f});
+        downsampler.addPoint(i, {dense[i].x + 0.1f, dense[i].y + 0.1f, 0.0f, 0.0f, 0.0f, 0.0f});
+    }
+    const auto& cells = downsampler.finishFrame();
+    ASSERT_EQ(cells.size(), dense.size());
+    for (const auto& cell : cells)
+    {
+        EXPECT_EQ(cell.count, 2U);
+    }
+
+    radar::BaseRadarSensor::PointCloud sparse;
+    sparse.push_back(makePoint(-3.2f, 4.1f, 1.0f, 0.0f, 0.0f));
+    downsampler.downsample(sparse, output);
+    ASSERT_EQ(output.size(), 1U);
+    EXPECT_FLOAT_EQ(output[0].x, -3.2f);
+}
+
+TEST(VoxelDownsamplerTest, SeparatesHeightLayersWhenConfigured)
+{
+    radar::core::VoxelDownsampleSettings settings;
+    settings.cellSize_m = 1.0f;
+    radar::core::VoxelDownsampler flat(settings);
+    settings.cellHeight_m = 1.0f;
+    radar::core::VoxelDownsampler layered(settings);
+
+    radar::BaseRadarSensor::PointCloud input;
+    input.push_back(makePoint(0.5f, 0.5f, 0.0f, 0.0f, 0.0f));
+    input.push_back(makePoint(0.5f, 0.5f, 0.0f, 0.0f, 0.0f));
+    input[1].z = 2.5f;
+
+    radar::BaseRadarSensor::PointCloud output;
+    flat.downsample(input, output);
+    EXPECT_EQ(output.size(), 1U);
+    layered.downsample(input, output);
+    EXPECT_EQ(output.size(), 2U);
+}
+
+TEST(VoxelDownsamplerTest, KeepsSensorsApart)
+{
+    radar::core::VoxelDownsampleSettings settings;
+    settings.enabled = true;
+    settings.cellSize_m = 1.0f;
+    radar::core::VoxelDownsampler downsampler(settings);
+
+    // Same cell, but each range rate is radial to its own radar.
+    radar::BaseRadarSensor::PointCloud input;
+    input.push_back(makePoint(0.1f, 0.1f, -10.0f, 4.0f, 0.0f));
+    input.push_back(makePoint(0.2f, 0.2f, -5.0f, -4.0f, 0.0f));
+    input[0].sensorIndex = 0;
+    input[1].sensorIndex = 1;
+
+    radar::BaseRadarSensor::PointCloud output;
+    downsampler.downsample(input, output);
+    ASSERT_EQ(output.size(), 2U);
+    EXPECT_FLOAT_EQ(output[0].rangeRate_ms, 4.0f);
+    EXPECT_FLOAT_EQ(output[1].rangeRate_ms, -4.0f);
+}
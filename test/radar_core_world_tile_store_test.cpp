@@ -0,0 +1,152 @@
+#include "radar_core/world_tile_store.hpp"
+
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace
+{
+radar::core::WorldTileStore::Settings smallTiles(const std::filesystem::path& file)
+{
+    radar::core::WorldTileStore::Settings settings;
+    settings.tileFile = file;
+    settings.cellSize_m = 1.0F;
+    settings.tileCells = 8;
+    settings.activeRadius = 1;
+    settings.prefetchTiles = 2;
+    return settings;
+}
+} // namespace
+
+TEST(WorldTileStoreTest, UpdatesOnlyResidentTilesWithoutWaiting)
+{
+    const auto file = test_helpers::makeTempDir("world_tiles_resident") / "tiles.bin";
+    radar::core::WorldTileStore store;
+    std::string error;
+    ASSERT_TRUE(store.open(smallTiles(file), error)) << error;
+
+    // Page-ins are only adopted at the next recentre, so the first update after the first recentre drops.
+    store.setVehiclePosition(4.0F, 4.0F, 0.0F, 0.0F);
+    EXPECT_FALSE(store.addLogOdds(4.0F, 4.0F, 1.0F, -5.0F, 5.0F));
+    EXPECT_EQ(store.statistics().droppedUpdates, 1U);
+
+    store.flush();
+    EXPECT_EQ(store.statistics().residentTiles, 9U);
+    EXPECT_TRUE(store.addLogOdds(4.0F, 4.0F, 1.0F, -5.0F, 5.0F));
+    EXPECT_TRUE(store.addLogOdds(4.2F, 4.9F, 10.0F, -5.0F, 5.0F));
+    EXPECT_TRUE(store.addLogOdds(-3.5F, -7.5F, -1.0F, -5.0F, 5.0F));
+    EXPECT_FLOAT_EQ(store.logOdds(4.5F, 4.5F), 5.0F);
+    EXPECT_FLOAT_EQ(store.logOdds(-3.9F, -7.1F), -1.0F);
+    EXPECT_FALSE(store.addLogOdds(40.0F, 4.0F, 1.0F, -5.0F, 5.0F));
+
+    int occupied = 0;
+    store.forEachCellAbove(1.0F,
+                           [&occupied](float x, float y, float value)
+                           {
+                               EXPECT_FLOAT_EQ(x, 4.5F);
+                               EXPECT_FLOAT_EQ(y, 4.5F);
+                               EXPECT_FLOAT_EQ(value, 5.0F);
+                               ++occupied;
+                           });
+    EXPECT_EQ(occupied, 1);
+}
+
+TEST(WorldTileStoreTest, KeepsMemoryBoundedOverALongDrive)
+{
+    const auto file = test_helpers::makeTempDir("world_tiles_drive") / "tiles.bin";
+    radar::core::WorldTileStore store;
+    std::string error;
+    ASSERT_TRUE(store.open(smallTiles(file), error)) << error;
+    const auto pool = radar::core::memoryUsage(radar::core::MemoryTag::WorldTiles).currentBytes;
+
+    // 2 km at 10 m/s and 10 Hz; the store is flushed each frame so every tile under the vehicle is resident.
+    std::size_t missed = 0U;
+    for (int frame = 0; frame < 2000; ++frame)
+    {
+        const float x = static_cast<float>(frame);
+        store.setVehiclePosition(x, 0.5F, 10.0F, 0.0F);
+        store.flush();
+        missed += store.addLogOdds(x, 0.5F, 1.0F, -5.0F, 5.0F) ? 0U : 1U;
+        EXPECT_LE(store.statistics().residentTiles, store.statistics().poolTiles);
+    }
+
+    const auto statistics = store.statistics();
+    EXPECT_EQ(missed, 0U);
+    EXPECT_EQ(radar::core::memoryUsage(radar::core::MemoryTag::WorldTiles).currentBytes, pool);
+    EXPECT_GE(statistics.tilesOnDisk, 2000U / 8U - 3U);
+    EXPECT_GT(statistics.pageOuts, 0U);
+    EXPECT_EQ(statistics.failedPageOuts, 0U);
+    // 8x8 tiles are 320-byte records; the file grows by doubling.
+    EXPECT_LT(statistics.fileBytes, 4U * 320U * statistics.tilesOnDisk);
+}
+
+TEST(WorldTileStoreTest, PrefetchesAheadAlongTheVelocity)
+{
+    const auto file = test_helpers::makeTempDir("world_tiles_prefetch") / "tiles.bin";
+    radar::core::WorldTileStore store;
+    std::string error;
+    ASSERT_TRUE(store.open(smallTiles(file), error)) << error;
+
+    store.setVehiclePosition(4.0F, 4.0F, 0.0F, -10.0F);
+    store.flush();
+    // Two tiles ahead plus the window radius: y in [-24, -16) is resident, the same distance behind is not.
+    EXPECT_TRUE(store.addLogOdds(4.0F, -20.0F, 1.0F, -5.0F, 5.0F));
+    EXPECT_FALSE(store.addLogOdds(4.0F, 28.0F, 1.0F, -5.0F, 5.0F));
+    EXPECT_FALSE(store.addLogOdds(28.0F, 4.0F, 1.0F, -5.0F, 5.0F));
+}
+
+TEST(WorldTileStoreTest, PagesEvictedTilesBackInAndAcrossSessions)
+{
+    const auto file = test_helpers::makeTempDir("world_tiles_persist") / "tiles.bin";
+    std::string error;
+    {
+        radar::core::WorldTileStore store;
+        ASSERT_TRUE(store.open(smallTiles(file), error)) << error;
+        store.setVehiclePosition(0.5F, 0.5F, 0.0F, 0.0F);
+        store.flush();
+        ASSERT_TRUE(store.addLogOdds(0.5F, 0.5F, 2.5F, -5.0F, 5.0F));
+
+        // Drive away until the tile is evicted, then come back.
+        store.setVehiclePosition(200.0F, 0.5F, 0.0F, 0.0F);
+        store.flush();
+        EXPECT_FLOAT_EQ(store.logOdds(0.5F, 0.5F), 0.0F);
+        EXPECT_EQ(store.statistics().tilesOnDisk, 1U);
+        store.setVehiclePosition(0.5F, 0.5F, 0.0F, 0.0F);
+        store.flush();
+        EXPECT_FLOAT_EQ(store.logOdds(0.5F, 0.5F), 2.5F);
+        EXPECT_EQ(store.statistics().diskPageIns, 1U);
+        ASSERT_TRUE(store.addLogOdds(0.5F, 0.5F, 1.0F, -5.0F, 5.0F));
+    }
+
+    radar::core::WorldTileStore reopened;
+    ASSERT_TRUE(reopened.open(smallTiles(file), error)) << error;
+    EXPECT_EQ(reopened.statistics().tilesOnDisk, 1U);
+    reopened.setVehiclePosition(0.5F, 0.5F, 0.0F, 0.0F);
+    reopened.flush();
+    EXPECT_FLOAT_EQ(reopened.logOdds(0.5F, 0.5F), 3.5F);
+    reopened.close();
+
+    // A different tile geometry starts an empty map.
+    auto coarse = smallTiles(file);
+    coarse.tileCells = 16;
+    ASSERT_TRUE(reopened.open(coarse, error)) << error;
+    EXPECT_EQ(reopened.statistics().tilesOnDisk, 0U);
+}
+
+TEST(WorldTileStoreTest, RejectsInvalidSettings)
+{
+    radar::core::WorldTileStore store;
+    std::string error;
+    auto settings = smallTiles(test_helpers::makeTempDir("world_tiles_invalid") / "tiles.bin");
+    settings.tileCells = 0;
+    EXPECT_FALSE(store.open(settings, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_FALSE(store.isOpen());
+
+    settings = smallTiles(test_helpers::makeTempDir("world_tiles_invalid") / "missing" / "tiles.bin");
+    error.clear();
+    EXPECT_FALSE(store.open(settings, error));
+    EXPECT_FALSE(error.empty());
+}
@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 namespace fs = std::filesystem;
 
 namespace
@@ -88,3 +90,24 @@ TEST(RadarPlaybackEngineTest, RunsSingleFrame)
     radar::RadarPlaybackEngine engine(std::move(playback));
     engine.run();
 }
+
+TEST(RadarEngineTest, ReaderThreadReportsPlacement)
+{
+    auto sensor = std::make_unique<StubSensor>();
+    auto* sensorPtr = sensor.get();
+    radar::RadarEngine engine(std::move(sensor));
+
+    radar::core::ThreadPlacementSettings placement;
+    ASSERT_TRUE(radar::core::parseThreadPlacement("reader=0", placement));
+    engine.setThreadPlacement(placement);
+
+    // Run on a helper thread so the render placement does not stick to the test runner's main thread.
+    std::thread([&]() { engine.run(); }).join();
+    EXPECT_EQ(sensorPtr->readCount, 2);
+
+    const auto applied = engine.appliedThreadPlacement();
+    ASSERT_EQ(applied.size(), 2U);
+    EXPECT_EQ(applied[0].role, radar::core::ThreadRole::Render);
+    EXPECT_EQ(applied[1].role, radar::core::ThreadRole::Reader);
+    EXPECT_EQ(applied[1].threadName, "radar-reader");
+}
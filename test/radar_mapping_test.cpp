@@ -1,8 +1,50 @@
 #include "mapping/FusedRadarMapping.hpp"
 #include "mapping/RadarVirtualSensorMapping.hpp"
 
+#include "test_helpers.hpp"
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace
+{
+// Closed-form plausibility as FusedRadarMapping evaluated it before the tables.
+float referencePlausibility(const radar::FusedRadarMapping::Settings& settings,
+                            float range_m,
+                            float azimuth_rad,
+                            float amplitude_dBsm)
+{
+    const auto sigmoid = [](float value, float growthRate, float midpoint)
+    { return 1.0f / (1.0f + std::exp(-growthRate * (value - midpoint))); };
+    float azimuthDeg = std::fmod(azimuth_rad * 57.2957795f + 180.0f, 360.0f);
+    azimuthDeg = std::abs((azimuthDeg < 0.0f ? azimuthDeg + 360.0f : azimuthDeg) - 180.0f);
+    const float range = sigmoid(range_m, -4.39444915f / settings.plausibilityRangeBandwidth,
+                                settings.plausibilityRangeMidpoint);
+    const float azimuth = sigmoid(azimuthDeg, -4.39444915f / settings.plausibilityAzimuthBandwidth,
+                                  settings.plausibilityAzimuthMidpoint);
+    const float amplitude = sigmoid(amplitude_dBsm, 4.39444915f / settings.plausibilityAmplitudeBandwidth,
+                                    settings.plausibilityAmplitudeMidpoint);
+    using Method = radar::FusedRadarMapping::PlausibilityCombinationMethod;
+    switch (settings.plausibilityMethod)
+    {
+        case Method::Average:
+            return (range + azimuth + amplitude) / 3.0f;
+        case Method::Product:
+            return range * azimuth * amplitude;
+        case Method::Minimum:
+            return std::min({range, azimuth, amplitude});
+        default:
+            return range_m > settings.customCombinationRangeThreshold ? std::min(range, azimuth) * amplitude
+                                                                      : range * amplitude;
+    }
+}
+} // namespace
+
 TEST(FusedRadarMappingTest, UpdatesAndResetsOccupiedCells)
 {
     radar::FusedRadarMapping::Settings settings;
@@ -32,6 +74,21 @@ TEST(FusedRadarMappingTest, UpdatesAndResetsOccupiedCells)
     const auto occupied = mapping.occupiedCells();
     EXPECT_FALSE(occupied.empty());
 
+    std::vector<radar::MapVertex> vertices(occupied.size() + 1U);
+    ASSERT_EQ(mapping.writeOccupiedCells(vertices, {-1.0f, 2.0f}), occupied.size());
+    EXPECT_FLOAT_EQ(vertices.front().position.x, -occupied.front().x);
+    EXPECT_FLOAT_EQ(vertices.front().position.y, occupied.front().y + 2.0f);
+    EXPECT_EQ(mapping.writeOccupiedCells(std::span<radar::MapVertex>(vertices.data(), 1U)), 1U);
+
+    const radar::OccupancyGridView grid = mapping.gridView();
+    ASSERT_TRUE(grid.valid());
+    EXPECT_EQ(grid.size, 6);
+    EXPECT_FLOAT_EQ(grid.origin.x, -2.5f);
+    const auto occupiedInView = std::count_if(grid.logOdds,
+                                              grid.logOdds + grid.size * grid.size,
+                                              [&](float value) { return value >= grid.occupiedThreshold; });
+    EXPECT_EQ(static_cast<std::size_t>(occupiedInView), occupied.size());
+
     mapping.reset();
     EXPECT_TRUE(mapping.occupiedCells().empty());
 }
@@ -63,6 +120,88 @@ TEST(FusedRadarMappingTest, AppliesSettingsAndHitModel)
     EXPECT_EQ(mapping.settings().mapRadius, 4.0f);
 }
 
+TEST(FusedRadarMappingTest, DownsamplesOnlyValidReturns)
+{
+    radar::FusedRadarMapping::Settings settings;
+    settings.cellSize = 0.5f;
+    settings.mapRadius = 2.0f;
+    settings.radarModel = radar::FusedRadarMapping::RadarModel::Hits;
+    settings.enablePlausibilityScaling = false;
+    settings.enableFreespace = false;
+    settings.minPlausibility = 0.0f;
+    settings.occupiedThreshold = 0.0f;
+    settings.enableDownsampling = true;
+    settings.downsampleCellSize = 1.0f;
+    radar::FusedRadarMapping mapping(settings);
+
+    // A stronger invalid return in the same voxel must not take the valid one with it.
+    radar::RadarPoint valid{};
+    valid.x = 0.5f;
+    valid.y = 0.5f;
+    valid.range_m = 0.8f;
+    valid.radarValid = 1U;
+    valid.amplitude_dBsm = 50.0f;
+    valid.isStationary = 1U;
+    radar::RadarPoint invalid = valid;
+    invalid.x = 0.6f;
+    invalid.radarValid = 0U;
+    invalid.amplitude_dBsm = 60.0f;
+
+    mapping.update({invalid, valid});
+    EXPECT_FALSE(mapping.occupiedCells().empty());
+}
+
+TEST(FusedRadarMappingTest, AppliesEachDetectionBeforeTheNext)
+{
+    // Saturating increments: the near hit lies in the far detection's free-space cone, so the clamped result
+    // depends on whether the far cone or the near hit is applied last.
+    radar::FusedRadarMapping::Settings settings;
+    settings.cellSize = 0.5f;
+    settings.mapRadius = 10.0f;
+    settings.radarModel = radar::FusedRadarMapping::RadarModel::Hits;
+    settings.enablePlausibilityScaling = false;
+    settings.minPlausibility = 0.0f;
+    settings.hitIncrement = 3.0f;
+    settings.missDecrement = 3.0f;
+    settings.maxLogOdds = 1.0f;
+    settings.minLogOdds = -1.0f;
+    settings.srrRangeAccuracy_m = 0.01f;
+    settings.mrrRangeAccuracy_m = 0.01f;
+
+    const auto detection = [](float y)
+    {
+        // On the axis through cell centres so the cone covers the near cell.
+        radar::RadarPoint point{};
+        point.x = 0.25f;
+        point.y = y;
+        point.sensorLateral_m = 0.25f;
+        point.range_m = y;
+        point.radarValid = 1U;
+        point.isStationary = 1U;
+        point.amplitude_dBsm = 50.0f;
+        return point;
+    };
+    const radar::RadarPoint far = detection(8.25f);
+    const radar::RadarPoint near = detection(4.25f);
+
+    radar::FusedRadarMapping batched(settings);
+    batched.update({far, near});
+    radar::FusedRadarMapping sequential(settings);
+    sequential.update({far});
+    sequential.update({near});
+
+    const radar::OccupancyGridView grid = batched.gridView();
+    const radar::OccupancyGridView reference = sequential.gridView();
+    ASSERT_TRUE(grid.valid());
+    ASSERT_TRUE(grid.sameGeometry(reference));
+    const std::size_t cells = static_cast<std::size_t>(grid.size) * static_cast<std::size_t>(grid.size);
+    EXPECT_TRUE(std::equal(grid.logOdds, grid.logOdds + cells, reference.logOdds));
+
+    const int nearX = static_cast<int>(std::floor((near.x - grid.origin.x) / grid.cellSize));
+    const int nearY = static_cast<int>(std::floor((near.y - grid.origin.y) / grid.cellSize));
+    EXPECT_FLOAT_EQ(grid.logOdds[nearY * grid.size + nearX], settings.maxLogOdds);
+}
+
 TEST(RadarVirtualSensorMappingTest, SegmentCountClamps)
 {
     radar::RadarVirtualSensorMapping mapping;
@@ -91,3 +230,354 @@ TEST(RadarVirtualSensorMappingTest, UpdatesRingFromDetections)
     const float length = glm::length(ring.front());
     EXPECT_NEAR(length, 5.0f, 0.1f);
 }
+
+TEST(RadarVirtualSensorMappingTest, LooksUpSegmentsInEveryQuadrant)
+{
+    radar::RadarVirtualSensorMapping mapping;
+    mapping.setSegmentCount(72);
+    mapping.setVehicleContour({{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}});
+
+    std::vector<glm::vec2> detections;
+    for (std::size_t i = 0; i < 72U; ++i)
+    {
+        // Offset from the segment centre so the lookup boundary checks get exercised.
+        const float angle = (static_cast<float>(i) + 0.9f) * glm::two_pi<float>() / 72.0f;
+        const float range = 3.0f + 0.1f * static_cast<float>(i);
+        detections.emplace_back(range * std::cos(angle), range * std::sin(angle));
+    }
+    mapping.update(detections, {});
+
+    const auto ring = mapping.ring(50.0f);
+    ASSERT_EQ(ring.size(), 72U);
+    for (std::size_t i = 0; i < ring.size(); ++i)
+    {
+        EXPECT_NEAR(glm::length(ring[i]), 3.0f + 0.1f * static_cast<float>(i), 1e-4f) << i;
+    }
+}
+
+TEST(RadarVirtualSensorMappingTest, WritesRingAndSegmentsIntoVertexSpans)
+{
+    radar::RadarVirtualSensorMapping mapping;
+    std::vector<radar::MapVertex> vertices(64U);
+    EXPECT_EQ(mapping.writeRing(10.0f, vertices), 0U);
+
+    mapping.setSegmentCount(12);
+    mapping.setVehicleContour({{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}});
+    mapping.update({glm::vec2(5.0f, 0.5f), glm::vec2(-2.0f, 4.0f)}, {});
+
+    const radar::MapVertexTransform transform{-1.0f, 3.5f};
+    const auto ring = mapping.ring(10.0f);
+    ASSERT_EQ(mapping.ringVertexCount(), ring.size());
+    ASSERT_EQ(mapping.writeRing(10.0f, vertices, transform), ring.size());
+    for (std::size_t i = 0; i < ring.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(vertices[i].position.x, -ring[i].x) << i;
+        EXPECT_FLOAT_EQ(vertices[i].position.y, ring[i].y + 3.5f) << i;
+        EXPECT_FLOAT_EQ(vertices[i].position.z, 0.0f) << i;
+    }
+
+    const auto segments = mapping.segments(10.0f);
+    ASSERT_EQ(mapping.segmentVertexCount(), segments.size() * 2U);
+    ASSERT_EQ(mapping.writeSegments(10.0f, vertices), segments.size() * 2U);
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(vertices[2U * i].position.x, segments[i].start.x) << i;
+        EXPECT_FLOAT_EQ(vertices[2U * i].position.y, segments[i].start.y) << i;
+        EXPECT_FLOAT_EQ(vertices[2U * i + 1U].position.x, segments[i].end.x) << i;
+        EXPECT_FLOAT_EQ(vertices[2U * i + 1U].position.y, segments[i].end.y) << i;
+    }
+
+    // A span that cannot hold the whole output is left untouched.
+    EXPECT_EQ(mapping.writeSegments(10.0f, std::span<radar::MapVertex>(vertices.data(), 23U)), 0U);
+}
+
+TEST(RadarVirtualSensorMappingTest, PersistsSegmentsUnderEgoMotion)
+{
+    radar::RadarVirtualSensorMapping mapping;
+    mapping.setSegmentCount(72);
+    mapping.setVehicleContour({{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}});
+    const float centre = glm::radians(2.5f);
+    const std::vector<glm::vec2> ahead = {glm::vec2(10.0f * std::cos(centre), 10.0f * std::sin(centre))};
+
+    // Driving forward at 5 m/s: the wall ahead is held and approaches by 0.5 m per 100 ms scan without hits.
+    radar::RadarVirtualSensorMapping::EgoMotion forward;
+    forward.velocity = glm::vec2(5.0f, 0.0f);
+    mapping.update(ahead, {}, 0U, &forward);
+    mapping.update({}, {}, 100000U, &forward);
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[0]), 9.5f, 0.02f);
+    for (std::uint64_t t = 200000U; t <= 400000U; t += 100000U)
+    {
+        mapping.update({}, {}, t, &forward);
+    }
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[0]), 8.0f, 0.05f);
+
+    // Not confirmed for longer than holdUs.
+    mapping.update({}, {}, 500000U, &forward);
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[0]), 50.0f, 1e-3f);
+
+    // Turning left by 10 degrees per scan moves the end two segments clockwise.
+    radar::RadarVirtualSensorMapping::EgoMotion turning;
+    turning.yawRate = glm::radians(100.0f);
+    mapping.reset();
+    mapping.update(ahead, {}, 0U, &turning);
+    mapping.update({}, {}, 100000U, &turning);
+    const auto turned = mapping.ring(50.0f);
+    EXPECT_NEAR(glm::length(turned[70]), 10.0f, 0.02f);
+    EXPECT_NEAR(glm::length(turned[0]), 50.0f, 1e-3f);
+
+    // Without ego motion the state cannot be carried and the ring is this scan's alone.
+    mapping.update({}, {}, 200000U, nullptr);
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[70]), 50.0f, 1e-3f);
+}
+
+TEST(RadarVirtualSensorMappingTest, CarriesSegmentsInMapPointOrder)
+{
+    radar::RadarVirtualSensorMapping mapping;
+    mapping.setSegmentCount(72);
+    mapping.setVehicleContour({{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}});
+    // Segment 18 is centred straight ahead (+y, longitudinal), segment 0 just left of +x (lateral).
+    const auto at = [](float degrees)
+    { return glm::vec2(10.0f * std::cos(glm::radians(degrees)), 10.0f * std::sin(glm::radians(degrees))); };
+    const std::vector<glm::vec2> walls = {at(92.5f), at(2.5f)};
+
+    // Forward-only odometry at 5 m/s: the wall ahead approaches by 0.5 m per 100 ms, the side wall stays.
+    const auto forward = radar::RadarVirtualSensorMapping::EgoMotion::fromVehicleFrame(5.0f, 0.0f, 0.0f);
+    EXPECT_EQ(forward.velocity.x, 0.0f);
+    EXPECT_EQ(forward.velocity.y, 5.0f);
+    mapping.update(walls, {}, 0U, &forward);
+    mapping.update({}, {}, 100000U, &forward);
+    const auto ring = mapping.ring(50.0f);
+    EXPECT_NEAR(glm::length(ring[18]), 9.5f, 0.02f);
+    EXPECT_NEAR(glm::length(ring[0]), 10.0f, 0.05f);
+}
+
+TEST(RadarVirtualSensorMappingTest, FiltersRecedingEndsAndTakesCloserHits)
+{
+    radar::RadarVirtualSensorMapping mapping;
+    mapping.setSegmentCount(72);
+    mapping.setVehicleContour({{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}});
+    const float centre = glm::radians(2.5f);
+    const auto at = [centre](float range)
+    { return std::vector<glm::vec2>{glm::vec2(range * std::cos(centre), range * std::sin(centre))}; };
+
+    const radar::RadarVirtualSensorMapping::EgoMotion still;
+    mapping.update(at(5.0f), {}, 0U, &still);
+    mapping.update(at(10.0f), {}, 50000U, &still);
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[0]), 5.0f + mapping.persistence().recedeGain * 5.0f, 1e-3f);
+    mapping.update(at(4.0f), {}, 100000U, &still);
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[0]), 4.0f, 1e-3f);
+
+    // A gap longer than maxGapUs restarts from the scan.
+    mapping.update(at(10.0f), {}, 100000U + mapping.persistence().maxGapUs + 1U, &still);
+    EXPECT_NEAR(glm::length(mapping.ring(50.0f)[0]), 10.0f, 1e-3f);
+}
+
+TEST(RadarVirtualSensorMappingTest, MarchesSegmentRaysThroughTheGrid)
+{
+    radar::RadarVirtualSensorMapping mapping;
+    // Not a multiple of the ray lanes, so the last group is padded.
+    mapping.setSegmentCount(30);
+    mapping.setVehicleContour({{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}});
+
+    // A wall 6 m ahead, a block on the left and a single cell behind.
+    const auto makeGrid = [](float cellSize, std::vector<float>& logOdds)
+    {
+        const int size = static_cast<int>(std::lround(20.0f / cellSize));
+        logOdds.assign(static_cast<std::size_t>(size * size), -1.0f);
+        const radar::OccupancyGridView grid{logOdds.data(), size, cellSize, glm::vec2(-10.0f, -10.0f), 0.2f};
+        const auto mark = [&](float x, float y)
+        {
+            const int ix = static_cast<int>(std::floor((x + 10.0f) / cellSize));
+            const int iy = static_cast<int>(std::floor((y + 10.0f) / cellSize));
+            logOdds[static_cast<std::size_t>(iy * size + ix)] = 1.0f;
+        };
+        for (float x = -9.9f; x < 10.0f; x += 0.1f)
+        {
+            mark(x, 6.1f);
+        }
+        mark(-6.6f, -0.2f);
+        mark(-6.6f, 0.2f);
+        mark(0.7f, -7.7f);
+        return grid;
+    };
+
+    const auto expectMatchesReference = [&](const radar::OccupancyGridView& grid)
+    {
+        constexpr float kFallback = 100.0f;
+        const auto ring = mapping.ring(kFallback);
+        ASSERT_EQ(ring.size(), 30U);
+        std::size_t hits = 0U;
+        for (std::size_t i = 0; i < ring.size(); ++i)
+        {
+            // Walk the segment ray in 1 mm steps from the contour to the grid edge.
+            const float angle = (static_cast<float>(i) + 0.5f) * glm::two_pi<float>() / 30.0f;
+            const glm::vec2 direction(std::cos(angle), std::sin(angle));
+            const float start = std::min(1.0f / std::fabs(direction.x), 1.0f / std::fabs(direction.y));
+            float reference = kFallback;
+            for (float t = start + 1e-5f; t < 20.0f; t += 1e-3f)
+            {
+                const int ix = static_cast<int>(std::floor((direction.x * t + 10.0f) / grid.cellSize));
+                const int iy = static_cast<int>(std::floor((direction.y * t + 10.0f) / grid.cellSize));
+                if (ix < 0 || iy < 0 || ix >= grid.size || iy >= grid.size)
+                {
+                    break;
+                }
+                if (grid.logOdds[iy * grid.size + ix] >= grid.occupiedThreshold)
+                {
+                    reference = t;
+                    break;
+                }
+            }
+            hits += reference < kFallback ? 1U : 0U;
+            EXPECT_NEAR(glm::length(ring[i]), reference, 2e-3f) << i;
+        }
+        EXPECT_GT(hits, 5U);
+        EXPECT_LT(hits, ring.size());
+    };
+
+    std::vector<float> coarseCells;
+    const auto coarse = makeGrid(0.5f, coarseCells);
+    mapping.updateFromGrid(coarse, {});
+    expectMatchesReference(coarse);
+
+    // A different geometry rebuilds the traversal; new values in the same geometry are picked up as they are.
+    std::vector<float> fineCells;
+    const auto fine = makeGrid(0.25f, fineCells);
+    mapping.updateFromGrid(fine, {});
+    expectMatchesReference(fine);
+    std::fill(fineCells.begin(), fineCells.end(), -1.0f);
+    mapping.updateFromGrid(fine, {});
+    for (const auto& point : mapping.ring(50.0f))
+    {
+        EXPECT_NEAR(glm::length(point), 50.0f, 1e-3f);
+    }
+
+    // Track footprints still cut the segments they cross.
+    const std::array<glm::vec2, 4> footprint = {
+        glm::vec2(-1.0f, 3.0f), glm::vec2(1.0f, 3.0f), glm::vec2(1.0f, 4.0f), glm::vec2(-1.0f, 4.0f)};
+    mapping.updateFromGrid(fine, {footprint});
+    const auto ring = mapping.ring(50.0f);
+    // Segment 7 of 30 is centred at 90 deg.
+    EXPECT_NEAR(glm::length(ring[7]), 3.0f, 1e-3f);
+}
+
+TEST(FusedRadarMappingTest, TabulatedPlausibilityMatchesClosedForm)
+{
+    std::vector<float> ranges;
+    std::vector<float> azimuths;
+    std::vector<float> amplitudes;
+    for (int i = 0; i < 400; ++i)
+    {
+        ranges.push_back(0.05f + 0.3f * static_cast<float>(i));
+        // Includes raw fallback azimuths beyond +-pi, which wrap.
+        azimuths.push_back(-7.0f + 0.035f * static_cast<float>(i));
+        amplitudes.push_back(-60.0f + 0.25f * static_cast<float>(i));
+    }
+
+    using Method = radar::FusedRadarMapping::PlausibilityCombinationMethod;
+    for (const Method method : {Method::Average, Method::Product, Method::Minimum, Method::Custom})
+    {
+        radar::FusedRadarMapping::Settings settings;
+        settings.plausibilityMethod = method;
+        radar::FusedRadarMapping mapping(settings);
+
+        std::vector<float> plausibility(ranges.size());
+        mapping.computePlausibility(ranges.data(), azimuths.data(), amplitudes.data(), ranges.size(),
+                                    plausibility.data());
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            EXPECT_NEAR(plausibility[i], referencePlausibility(settings, ranges[i], azimuths[i], amplitudes[i]),
+                        2e-4f)
+                << "method " << static_cast<int>(method) << " sample " << i;
+        }
+    }
+
+    // Tables are rebuilt when the settings change.
+    radar::FusedRadarMapping::Settings settings;
+    radar::FusedRadarMapping mapping(settings);
+    settings.plausibilityRangeMidpoint = 20.0f;
+    settings.plausibilityAmplitudeBandwidth = 2.0f;
+    mapping.applySettings(settings);
+    float plausibility = 0.0f;
+    mapping.computePlausibility(&ranges[50], &azimuths[200], &amplitudes[150], 1U, &plausibility);
+    EXPECT_NEAR(plausibility, referencePlausibility(settings, ranges[50], azimuths[200], amplitudes[150]), 2e-4f);
+
+    settings.enablePlausibilityScaling = false;
+    mapping.applySettings(settings);
+    mapping.computePlausibility(&ranges[50], &azimuths[200], &amplitudes[150], 1U, &plausibility);
+    EXPECT_EQ(plausibility, 1.0f);
+}
+
+TEST(FusedRadarMappingTest, DeadReckonsTheWorldPose)
+{
+    radar::FusedRadarMapping::WorldPose pose;
+    pose.advance(glm::vec2(0.0f, 10.0f), 0.0f, 1.0f);
+    EXPECT_NEAR(pose.position.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(pose.position.y, 10.0f, 1e-5f);
+
+    // A quarter circle of radius 10 m in 20 steps ends within a few centimetres of the exact arc.
+    radar::FusedRadarMapping::WorldPose turn;
+    const float yawRate = 3.14159265f / 2.0f;
+    for (int step = 0; step < 20; ++step)
+    {
+        turn.advance(glm::vec2(0.0f, 10.0f * yawRate), yawRate, 0.05f);
+    }
+    EXPECT_NEAR(turn.heading_rad, yawRate, 1e-5f);
+    EXPECT_NEAR(turn.position.x, -10.0f, 0.05f);
+    EXPECT_NEAR(turn.position.y, 10.0f, 0.05f);
+    EXPECT_NEAR(turn.velocity.x, -10.0f * yawRate, 1e-3f);
+    EXPECT_NEAR(turn.velocity.y, 0.0f, 1e-3f);
+}
+
+TEST(FusedRadarMappingTest, AccumulatesPosedUpdatesIntoTheWorldMap)
+{
+    radar::FusedRadarMapping::Settings settings;
+    settings.cellSize = 1.0f;
+    settings.mapRadius = 4.0f;
+    settings.radarModel = radar::FusedRadarMapping::RadarModel::Hits;
+    settings.enableFreespace = false;
+    settings.enablePlausibilityScaling = false;
+    settings.minPlausibility = 0.0f;
+    settings.occupiedThreshold = 0.1f;
+    settings.enableWorldMap = true;
+    settings.worldTileFile = (test_helpers::makeTempDir("fused_world_map") / "tiles.bin").string();
+    settings.worldTileCells = 16;
+    settings.worldActiveRadius = 1;
+    radar::FusedRadarMapping mapping(settings);
+    ASSERT_NE(mapping.worldMap(), nullptr);
+
+    radar::RadarPoint point{};
+    point.x = 1.2f;
+    point.y = 2.2f;
+    point.range_m = 2.5f;
+    point.radarValid = 1U;
+    point.sensorIndex = 4;
+    point.amplitude_dBsm = 50.0f;
+    point.isStationary = 1U;
+
+    // Turned left by 90 degrees: the grid cell centred at (1, 2) lies at (98.3, 51.3) in the world.
+    radar::FusedRadarMapping::WorldPose pose;
+    pose.position = glm::vec2(100.3f, 50.3f);
+    pose.heading_rad = 3.14159265f / 2.0f;
+
+    // The first posed update only requests the tiles around the pose.
+    mapping.update({point}, pose);
+    EXPECT_TRUE(mapping.occupiedWorldCells().empty());
+    EXPECT_GT(mapping.worldMap()->statistics().droppedUpdates, 0U);
+
+    mapping.flushWorldMap();
+    mapping.update({point}, pose);
+    const auto cells = mapping.occupiedWorldCells();
+    ASSERT_EQ(cells.size(), 1U);
+    EXPECT_FLOAT_EQ(cells[0].x, 98.5f);
+    EXPECT_FLOAT_EQ(cells[0].y, 51.5f);
+    EXPECT_FLOAT_EQ(mapping.worldMap()->logOdds(98.5f, 51.5f), settings.hitIncrement);
+
+    // Unposed updates leave the world map alone; disabling it closes the store.
+    mapping.update({point});
+    EXPECT_FLOAT_EQ(mapping.worldMap()->logOdds(98.5f, 51.5f), settings.hitIncrement);
+    settings.enableWorldMap = false;
+    mapping.applySettings(settings);
+    EXPECT_EQ(mapping.worldMap(), nullptr);
+    EXPECT_TRUE(mapping.occupiedWorldCells().empty());
+}
@@ -0,0 +1,90 @@
+#include "mapping/FusedRadarMapping.hpp"
+#include "processing/ParameterSweep.hpp"
+#include "processing/RadarPlayback.hpp"
+#include "processing/ScenarioGenerator.hpp"
+
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+TEST(ParameterSweepTest, MatchesIndependentReplayPerVariant)
+{
+    radar::ScenarioSettings scenario;
+    scenario.duration_s = 1.0F;
+    const fs::path dataDir = test_helpers::makeTempDir("parameter_sweep");
+    radar::ScenarioCapture capture;
+    ASSERT_TRUE(radar::ScenarioGenerator(scenario).write(dataDir, capture));
+
+    radar::SweepVariant baseline;
+    baseline.name = "baseline";
+    radar::SweepVariant loose;
+    loose.name = "loose";
+    loose.processing.stationary.nSigma = 6.0F;
+    loose.processing.odometry.inlierThreshold_mps = 0.8F;
+
+    radar::ParameterSweep::Settings settings;
+    settings.dataRoot = dataDir;
+    settings.inputFiles = capture.inputFiles;
+    settings.vehicleConfigPath = capture.vehicleConfigPath;
+    settings.workerCount = 2U;
+    // Small chunks so decoding and processing alternate many times.
+    settings.chunkFrames = 3U;
+    radar::ParameterSweep sweep(settings);
+    sweep.addVariant(baseline);
+    sweep.addVariant(loose);
+    ASSERT_TRUE(sweep.run());
+    ASSERT_EQ(sweep.results().size(), 2U);
+    EXPECT_GT(sweep.decodedFrames(), 0U);
+
+    for (const auto* variant : {&baseline, &loose})
+    {
+        radar::RadarPlayback::Settings playbackSettings;
+        playbackSettings.dataRoot = dataDir;
+        playbackSettings.inputFiles = capture.inputFiles;
+        playbackSettings.vehicleConfigPath = capture.vehicleConfigPath;
+        playbackSettings.processingSettings =
+            std::make_shared<radar::core::SettingsChannel<radar::core::ProcessingSettings>>(variant->processing);
+        radar::RadarPlayback playback(playbackSettings);
+        ASSERT_TRUE(playback.initialize());
+        radar::FusedRadarMapping mapping(variant->mapping);
+
+        std::size_t frames = 0U;
+        std::size_t detections = 0U;
+        std::size_t stationary = 0U;
+        radar::RadarFrame frame;
+        while (playback.readNextFrame(frame))
+        {
+            ++frames;
+            detections += frame.detections.size();
+            stationary += static_cast<std::size_t>(std::count_if(
+                frame.detections.begin(),
+                frame.detections.end(),
+                [](const radar::RadarPoint& point) { return point.isStationary != 0U; }));
+            mapping.update(frame.detections);
+        }
+
+        const auto& result = sweep.results()[variant == &baseline ? 0U : 1U];
+        EXPECT_EQ(result.name, variant->name);
+        EXPECT_EQ(result.metrics.frames, frames);
+        EXPECT_EQ(result.metrics.detections, detections);
+        EXPECT_EQ(result.metrics.stationaryDetections, stationary);
+        EXPECT_EQ(result.metrics.occupiedCells, mapping.occupiedCells().size());
+    }
+
+    EXPECT_NE(sweep.report().find("loose"), std::string::npos);
+}
+
+TEST(ParameterSweepTest, FailsWithoutVariantsOrCapture)
+{
+    radar::ParameterSweep::Settings settings;
+    settings.dataRoot = test_helpers::makeTempDir("parameter_sweep_empty");
+    radar::ParameterSweep empty(settings);
+    EXPECT_FALSE(empty.run());
+
+    empty.addVariant(radar::SweepVariant{});
+    EXPECT_FALSE(empty.run());
+}
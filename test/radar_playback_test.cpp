@@ -4,6 +4,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 namespace fs = std::filesystem;
 
 TEST(RadarPlaybackTest, InitializeFailsWithoutConfig)
@@ -56,3 +59,151 @@ TEST(RadarPlaybackTest, ReadsDetectionsAndTracks)
 
     EXPECT_FALSE(playback.readNextFrame(frame));
 }
+
+TEST(RadarPlaybackTest, ParallelStartupKeepsMergeOrderAndTimesFirstFrame)
+{
+    const fs::path tempDir = test_helpers::makeTempDir("radar_playback_startup");
+    const fs::path dataDir = tempDir / "data";
+    test_helpers::writeFile(dataDir / "Vehicle.ini", test_helpers::buildVehicleConfigIni(1.2f, true, false));
+    test_helpers::writeFile(dataDir / "corner.txt",
+                            test_helpers::buildCornerDetectionsLine(300U, 290U, 0) + "\n" +
+                                test_helpers::buildCornerDetectionsLine(500U, 490U, 0));
+    test_helpers::writeFile(dataDir / "front.txt", test_helpers::buildFrontDetectionsLine(200U, 190U));
+    test_helpers::writeFile(dataDir / "tracks.txt",
+                            test_helpers::buildTrackLine(100U) + "\n" + test_helpers::buildTrackLine(400U));
+
+    radar::RadarPlayback::Settings settings;
+    settings.dataRoot = dataDir;
+    // The missing input is skipped without holding up the others.
+    settings.inputFiles = {"corner.txt", "missing_front.txt", "front.txt", "tracks.txt"};
+
+    radar::RadarPlayback playback(settings);
+    ASSERT_TRUE(playback.initialize());
+    EXPECT_EQ(playback.timeToFirstFrameUs(), 0U);
+
+    std::vector<uint64_t> timestamps;
+    radar::RadarRecordBatch batch;
+    while (playback.readNextRecords(batch))
+    {
+        timestamps.push_back(batch.timestampUs);
+    }
+    EXPECT_EQ(timestamps, (std::vector<uint64_t>{100U, 200U, 300U, 400U, 500U}));
+    EXPECT_GT(playback.timeToFirstFrameUs(), 0U);
+}
+
+TEST(RadarPlaybackTest, ReorderBufferRestoresSensorTimestampOrder)
+{
+    const fs::path tempDir = test_helpers::makeTempDir("radar_playback_reorder");
+    const fs::path dataDir = tempDir / "data";
+    const fs::path vehicleFile = dataDir / "Vehicle.ini";
+    const fs::path cornerFile = dataDir / "corner.txt";
+
+    test_helpers::writeFile(vehicleFile, test_helpers::buildVehicleConfigIni(1.2f, true, false));
+    test_helpers::writeFile(cornerFile,
+                            test_helpers::buildCornerDetectionsLine(130U, 120U, 0) + "\n" +
+                                test_helpers::buildCornerDetectionsLine(110U, 100U, 0) + "\n" +
+                                test_helpers::buildCornerDetectionsLine(150U, 140U, 1) + "\n");
+
+    radar::RadarPlayback::Settings settings;
+    settings.dataRoot = dataDir;
+    settings.inputFiles = {cornerFile.filename().string()};
+    settings.reorderLatencyUs = 50U;
+
+    radar::RadarPlayback playback(settings);
+    ASSERT_TRUE(playback.initialize());
+
+    std::vector<uint64_t> timestamps;
+    radar::RadarFrame frame;
+    while (playback.readNextFrame(frame))
+    {
+        timestamps.push_back(frame.timestampUs);
+    }
+    EXPECT_EQ(timestamps, (std::vector<uint64_t>{110U, 130U, 150U}));
+
+    const auto statistics = playback.reorderStatistics();
+    ASSERT_EQ(statistics.size(), 2U);
+    EXPECT_EQ(statistics[0].source, "corner:front_left");
+    EXPECT_EQ(statistics[0].statistics.released, 2U);
+    EXPECT_EQ(statistics[0].statistics.reordered, 1U);
+    EXPECT_EQ(statistics[0].statistics.late, 0U);
+}
+
+TEST(RadarPlaybackTest, InterleavesStreamsAcrossManyReadBlocks)
+{
+    const fs::path tempDir = test_helpers::makeTempDir("radar_playback_blocks");
+    const fs::path dataDir = tempDir / "data";
+    test_helpers::writeFile(dataDir / "Vehicle.ini", test_helpers::buildVehicleConfigIni(1.2f, true, false));
+
+    // Enough records that each stream spans several read-ahead blocks; corner records take the odd slots.
+    constexpr uint64_t kRecords = 300U;
+    std::string corner;
+    std::string tracks;
+    for (uint64_t i = 0; i < kRecords; ++i)
+    {
+        corner += test_helpers::buildCornerDetectionsLine(200U * i + 100U, 200U * i + 90U, 0) + "\n";
+        tracks += test_helpers::buildTrackLine(200U * i + 200U) + "\n";
+    }
+    ASSERT_GT(corner.size(), 256U * 1024U);
+    test_helpers::writeFile(dataDir / "corner.txt", corner);
+    test_helpers::writeFile(dataDir / "tracks.txt", tracks);
+
+    radar::RadarPlayback::Settings settings;
+    settings.dataRoot = dataDir;
+    settings.inputFiles = {"corner.txt", "tracks.txt"};
+
+    radar::RadarPlayback playback(settings);
+    ASSERT_TRUE(playback.initialize());
+
+    uint64_t expected = 100U;
+    radar::RadarRecordBatch batch;
+    while (playback.readNextRecords(batch))
+    {
+        ASSERT_EQ(batch.timestampUs, expected);
+        ASSERT_EQ(batch.records.size(), 1U);
+        expected += 100U;
+    }
+    EXPECT_EQ(expected, 200U * kRecords + 100U);
+}
+
+TEST(RadarPlaybackTest, SketchesPerSensorLatency)
+{
+    const fs::path tempDir = test_helpers::makeTempDir("radar_playback_latency");
+    const fs::path dataDir = tempDir / "data";
+    test_helpers::writeFile(dataDir / "Vehicle.ini", test_helpers::buildVehicleConfigIni(1.2f, true, false));
+    std::string corner;
+    for (uint64_t i = 0; i < 40U; ++i)
+    {
+        // Front left publishes 10 us after capture, rear right 30 ms after (its budget is 10 + 10 ms).
+        corner += test_helpers::buildCornerDetectionsLine(1000000U + 50000U * i, 999990U + 50000U * i, 0) + "\n";
+        corner += test_helpers::buildCornerDetectionsLine(1025000U + 50000U * i, 995000U + 50000U * i, 3) + "\n";
+    }
+    test_helpers::writeFile(dataDir / "corner.txt", corner);
+
+    radar::RadarPlayback::Settings settings;
+    settings.dataRoot = dataDir;
+    settings.inputFiles = {"corner.txt"};
+    settings.enableLatencyAnalysis = true;
+    settings.latencyBudget.transportAllowance_us = 10000U;
+    settings.latencyBudget.pipelineBudget_us = 1000000U;
+
+    radar::RadarPlayback playback(settings);
+    ASSERT_TRUE(playback.initialize());
+    radar::RadarFrame frame;
+    while (playback.readNextFrame(frame))
+    {
+    }
+
+    const auto* latency = playback.latencyAnalyzer();
+    ASSERT_NE(latency, nullptr);
+    const auto& sources = latency->sources();
+    ASSERT_EQ(sources.size(), 5U);
+    EXPECT_EQ(sources[0].name, "corner:front_left");
+    EXPECT_EQ(sources[0].captureToPublish.count(), 40U);
+    EXPECT_EQ(sources[0].captureToPublish.max(), 10U);
+    EXPECT_FALSE(sources[0].overCaptureBudget);
+    EXPECT_EQ(sources[3].captureToPublish.min(), 30000U);
+    EXPECT_TRUE(sources[3].overCaptureBudget);
+    EXPECT_FALSE(sources[3].overPipelineBudget);
+    EXPECT_EQ(sources[4].publishToProcessed.count(), 0U);
+    EXPECT_TRUE(latency->overBudget());
+}
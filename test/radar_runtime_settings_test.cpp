@@ -0,0 +1,122 @@
+#include "config/RuntimeSettings.hpp"
+#include "mapping/FusedRadarMapping.hpp"
+
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+void writeSettings(const fs::path& path, const std::string& contents)
+{
+    const auto previous = fs::exists(path) ? fs::last_write_time(path) : fs::file_time_type::min();
+    test_helpers::writeFile(path, contents);
+    // Coarse file systems can keep the same timestamp for two quick saves.
+    if (fs::last_write_time(path) <= previous)
+    {
+        fs::last_write_time(path, previous + std::chrono::seconds(1));
+    }
+}
+
+radar::RadarPoint stationaryHit()
+{
+    radar::RadarPoint point{};
+    point.x = 0.5f;
+    point.y = 0.5f;
+    point.range_m = 0.8f;
+    point.radarValid = 1U;
+    point.sensorIndex = 4;
+    point.amplitude_dBsm = 50.0f;
+    point.isStationary = 1U;
+    return point;
+}
+} // namespace
+
+TEST(SettingsChannelTest, ReadersAdoptNewSnapshotsOnce)
+{
+    auto channel = std::make_shared<radar::core::SettingsChannel<int>>(1);
+    radar::core::SettingsReader<int> reader(channel);
+    ASSERT_TRUE(reader.refresh());
+    EXPECT_EQ(reader.settings(), 1);
+    EXPECT_FALSE(reader.refresh());
+
+    const auto pinned = channel->snapshot();
+    EXPECT_EQ(channel->publish(2), 2U);
+    ASSERT_TRUE(reader.refresh());
+    EXPECT_EQ(reader.settings(), 2);
+    EXPECT_EQ(reader.adoptedVersion(), 2U);
+    // Snapshots held by a worker mid-frame are unaffected by later publications.
+    EXPECT_EQ(pinned->settings, 1);
+
+    radar::core::SettingsReader<int> detached;
+    EXPECT_FALSE(detached.refresh());
+}
+
+TEST(RuntimeSettingsTest, WatcherPublishesOnlyChangedSubsystems)
+{
+    const fs::path dir = test_helpers::makeTempDir("runtime_settings");
+    const fs::path path = dir / "RuntimeSettings.ini";
+    writeSettings(path, "[Processing]\nrangeRateSigma=2.5\n[Odometry]\nminInliers=9\n");
+
+    radar::RuntimeSettingsWatcher watcher(path);
+    EXPECT_FLOAT_EQ(watcher.current().processing.association.rangeRateSigma, 2.5f);
+    EXPECT_EQ(watcher.current().processing.odometry.minInliers, 9);
+    // Keys that are absent keep their defaults.
+    EXPECT_EQ(watcher.current().processing.odometry.maxIterations, 120);
+    EXPECT_FALSE(watcher.poll());
+
+    const auto processingVersion = watcher.processingChannel()->version();
+    const auto mappingVersion = watcher.mappingChannel()->version();
+    writeSettings(path, "[Processing]\nrangeRateSigma=2.5\n[Odometry]\nminInliers=9\n[Mapping]\nhitIncrement=0.7\n"
+                        "[VirtualSensor]\nsegmentCount=48\n");
+    ASSERT_TRUE(watcher.poll());
+    EXPECT_EQ(watcher.processingChannel()->version(), processingVersion);
+    EXPECT_EQ(watcher.mappingChannel()->version(), mappingVersion + 1U);
+    EXPECT_FLOAT_EQ(watcher.mappingChannel()->snapshot()->settings.hitIncrement, 0.7f);
+    EXPECT_EQ(watcher.segmentChannel()->snapshot()->settings, 48U);
+
+    writeSettings(path, "[Mapping]\ncellSize=0\n");
+    EXPECT_FALSE(watcher.poll());
+    EXPECT_FALSE(watcher.poll());
+    EXPECT_FLOAT_EQ(watcher.current().mapping.hitIncrement, 0.7f);
+
+    // A broken file is retried on every poll and picked up once it is fixed.
+    writeSettings(path, "[Mapping]\nhitIncrement=0.6\n");
+    ASSERT_TRUE(watcher.poll());
+    EXPECT_FLOAT_EQ(watcher.current().mapping.hitIncrement, 0.6f);
+}
+
+TEST(RuntimeSettingsTest, MappingKeepsGridAcrossNonGeometryChanges)
+{
+    radar::FusedRadarMapping::Settings settings;
+    settings.cellSize = 0.5f;
+    settings.mapRadius = 2.0f;
+    settings.radarModel = radar::FusedRadarMapping::RadarModel::Hits;
+    settings.enablePlausibilityScaling = false;
+    settings.enableFreespace = false;
+    settings.minPlausibility = 0.0f;
+    settings.occupiedThreshold = 0.0f;
+
+    auto channel = std::make_shared<radar::FusedRadarMapping::SettingsChannel>(settings);
+    radar::FusedRadarMapping mapping(settings);
+    mapping.setSettingsChannel(channel);
+    mapping.update({stationaryHit()});
+    ASSERT_FALSE(mapping.occupiedCells().empty());
+
+    settings.occupiedThreshold = 0.1f;
+    settings.enablePlausibilityScaling = true;
+    channel->publish(settings);
+    mapping.update({});
+    EXPECT_FLOAT_EQ(mapping.settings().occupiedThreshold, 0.1f);
+    EXPECT_FALSE(mapping.occupiedCells().empty());
+
+    settings.mapRadius = 3.0f;
+    EXPECT_TRUE(mapping.applySettings(settings));
+    EXPECT_TRUE(mapping.occupiedCells().empty());
+}
@@ -0,0 +1,154 @@
+#include "processing/RadarPlayback.hpp"
+#include "processing/ScenarioGenerator.hpp"
+
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+std::string readAll(const fs::path& path)
+{
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+} // namespace
+
+TEST(ScenarioGeneratorTest, IsDeterministicForSeed)
+{
+    radar::ScenarioSettings settings;
+    settings.seed = 7U;
+    settings.duration_s = 0.5F;
+    radar::ScenarioGenerator generator(settings);
+
+    const fs::path first = test_helpers::makeTempDir("scenario_a");
+    const fs::path second = test_helpers::makeTempDir("scenario_b");
+    radar::ScenarioCapture captureA;
+    radar::ScenarioCapture captureB;
+    ASSERT_TRUE(generator.write(first, captureA));
+    ASSERT_TRUE(generator.write(second, captureB));
+
+    ASSERT_EQ(captureA.inputFiles, captureB.inputFiles);
+    for (const auto& file : captureA.inputFiles)
+    {
+        EXPECT_EQ(readAll(first / file), readAll(second / file)) << file;
+    }
+
+    settings.seed = 8U;
+    radar::ScenarioCapture captureC;
+    const fs::path third = test_helpers::makeTempDir("scenario_c");
+    ASSERT_TRUE(radar::ScenarioGenerator(settings).write(third, captureC));
+    EXPECT_NE(readAll(first / captureA.inputFiles.front()), readAll(third / captureC.inputFiles.front()));
+}
+
+TEST(ScenarioGeneratorTest, SplitsSensorsAndTracksAcrossCaptures)
+{
+    radar::ScenarioSettings settings;
+    settings.duration_s = 0.2F;
+    settings.scanPeriod_s = 0.05F;
+    settings.cornerSensorCount = 6U;
+    settings.trackCount = 150U;
+
+    const fs::path dataDir = test_helpers::makeTempDir("scenario_split");
+    radar::ScenarioCapture capture;
+    ASSERT_TRUE(radar::ScenarioGenerator(settings).write(dataDir, capture));
+
+    EXPECT_EQ(capture.scanCount, 4U);
+    EXPECT_EQ(capture.inputFiles.size(), 5U);
+    EXPECT_EQ(capture.detectionLineCount, 4U * 7U);
+    EXPECT_EQ(capture.trackLineCount, 4U * 2U);
+}
+
+TEST(ScenarioGeneratorTest, PlaysBackThroughRadarPlayback)
+{
+    radar::ScenarioSettings settings;
+    settings.duration_s = 0.5F;
+    settings.returnsPerScan = 40U;
+    settings.trackCount = 12U;
+    settings.clutterFraction = 0.25F;
+
+    const fs::path dataDir = test_helpers::makeTempDir("scenario_playback");
+    radar::ScenarioCapture capture;
+    ASSERT_TRUE(radar::ScenarioGenerator(settings).write(dataDir, capture));
+
+    radar::RadarPlayback::Settings playbackSettings;
+    playbackSettings.dataRoot = dataDir;
+    playbackSettings.inputFiles = capture.inputFiles;
+    playbackSettings.vehicleConfigPath = capture.vehicleConfigPath;
+    radar::RadarPlayback playback(std::move(playbackSettings));
+    ASSERT_TRUE(playback.initialize());
+
+    std::size_t frames = 0U;
+    std::size_t detections = 0U;
+    bool sawTracks = false;
+    radar::RadarFrame frame;
+    while (playback.readNextFrame(frame))
+    {
+        ++frames;
+        detections += frame.detections.size();
+        sawTracks = sawTracks || !frame.tracks.empty();
+    }
+
+    EXPECT_GE(frames, capture.scanCount);
+    EXPECT_GE(detections, capture.scanCount * 4U * settings.returnsPerScan);
+    EXPECT_TRUE(sawTracks);
+}
+
+TEST(ScenarioGeneratorTest, BinaryCapturesPlayBackLikeText)
+{
+    radar::ScenarioSettings settings;
+    settings.duration_s = 0.3F;
+    settings.returnsPerScan = 24U;
+    settings.trackCount = 8U;
+
+    auto playAll = [](const fs::path& dataDir, const radar::ScenarioCapture& capture)
+    {
+        radar::RadarPlayback::Settings playbackSettings;
+        playbackSettings.dataRoot = dataDir;
+        playbackSettings.inputFiles = capture.inputFiles;
+        playbackSettings.vehicleConfigPath = capture.vehicleConfigPath;
+        radar::RadarPlayback playback(std::move(playbackSettings));
+        std::vector<radar::RadarFrame> frames;
+        if (!playback.initialize())
+        {
+            return frames;
+        }
+        radar::RadarFrame frame;
+        while (playback.readNextFrame(frame))
+        {
+            frames.push_back(frame);
+        }
+        return frames;
+    };
+
+    const fs::path textDir = test_helpers::makeTempDir("scenario_text");
+    radar::ScenarioCapture textCapture;
+    ASSERT_TRUE(radar::ScenarioGenerator(settings).write(textDir, textCapture));
+
+    settings.binaryCaptures = true;
+    const fs::path binaryDir = test_helpers::makeTempDir("scenario_binary");
+    radar::ScenarioCapture binaryCapture;
+    ASSERT_TRUE(radar::ScenarioGenerator(settings).write(binaryDir, binaryCapture));
+    EXPECT_EQ(binaryCapture.inputFiles.front(), "scenarioCornerDetections.rdrb");
+
+    const auto textFrames = playAll(textDir, textCapture);
+    const auto binaryFrames = playAll(binaryDir, binaryCapture);
+    ASSERT_FALSE(textFrames.empty());
+    ASSERT_EQ(textFrames.size(), binaryFrames.size());
+    for (std::size_t i = 0; i < textFrames.size(); ++i)
+    {
+        EXPECT_EQ(textFrames[i].timestampUs, binaryFrames[i].timestampUs);
+        ASSERT_EQ(textFrames[i].detections.size(), binaryFrames[i].detections.size());
+        ASSERT_EQ(textFrames[i].tracks.size(), binaryFrames[i].tracks.size());
+        for (std::size_t d = 0; d < textFrames[i].detections.size(); ++d)
+        {
+            EXPECT_EQ(textFrames[i].detections[d].x, binaryFrames[i].detections[d].x);
+            EXPECT_EQ(textFrames[i].detections[d].y, binaryFrames[i].detections[d].y);
+        }
+    }
+}
@@ -107,6 +107,46 @@ TEST(TextRadarSensorTest, ParsesRadarReturnLine)
     EXPECT_NE(sensor.vehicleProfile(), nullptr);
 }
 
+TEST(TextRadarSensorTest, ParsesAnyReturnCount)
+{
+    // 9 header fields, 14 fields per return, 3 tail fields, then one elevation per return.
+    const auto buildLine = [](std::size_t returnCount, uint64_t timestamp)
+    {
+        std::ostringstream oss;
+        oss << "2 " << timestamp << ' ' << timestamp << " 1 120 1 0 0 0";
+        for (std::size_t i = 0; i < returnCount; ++i)
+        {
+            const float offset = 1.0f + static_cast<float>(i % 50U);
+            oss << " 10 0 0 0.1 0.1 -5 " << offset << " 1 0 1 0 0 0 0";
+        }
+        oss << " 0 0 0";
+        for (std::size_t i = 0; i < returnCount; ++i)
+        {
+            oss << " 0";
+        }
+        return oss.str();
+    };
+
+    const fs::path tempDir = test_helpers::makeTempDir("text_radar_counts");
+    const fs::path dataFile = tempDir / "counts.txt";
+    test_helpers::writeFile(dataFile, buildLine(3U, 100U) + "\n" + buildLine(130U, 200U) + "\n");
+
+    radar::TextRadarSensor sensor(dataFile);
+    radar::BaseRadarSensor::PointCloud points;
+    uint64_t timestamp = 0U;
+    ASSERT_TRUE(sensor.readNextScan(points, timestamp));
+    EXPECT_EQ(timestamp, 100U);
+    ASSERT_EQ(points.size(), 3U);
+    EXPECT_EQ(points[0].sensorIndex, 2);
+    EXPECT_FLOAT_EQ(points[2].y, 3.0f);
+    EXPECT_FLOAT_EQ(points[2].x, 1.0f);
+
+    ASSERT_TRUE(sensor.readNextScan(points, timestamp));
+    EXPECT_EQ(timestamp, 200U);
+    ASSERT_EQ(points.size(), 130U);
+    EXPECT_FLOAT_EQ(points[129].y, 30.0f);
+}
+
 TEST(TextRadarSensorTest, ParsesLegacyLine)
 {
     const fs::path tempDir = test_helpers::makeTempDir("text_radar_legacy");
@@ -143,6 +183,22 @@ TEST(OfflineRadarDataReaderTest, ReadsCombinedScan)
     EXPECT_FALSE(points.empty());
 }
 
+TEST(OfflineRadarDataReaderTest, NamesSourcesWhenAnEarlierFileIsMissing)
+{
+    const fs::path tempDir = test_helpers::makeTempDir("offline_reader_missing");
+    const fs::path dataDir = tempDir / "data";
+    test_helpers::writeFile(dataDir / "b.txt", test_helpers::buildCornerDetectionsLine(100U, 90U, 1));
+
+    radar::OfflineRadarDataReader reader(dataDir, {"missing.txt", "b.txt"});
+    ASSERT_TRUE(reader.configure(120.0f));
+
+    radar::BaseRadarSensor::PointCloud points;
+    uint64_t timestamp = 0U;
+    ASSERT_TRUE(reader.readNextScan(points, timestamp));
+    ASSERT_EQ(reader.lastFrameSources().size(), 1U);
+    EXPECT_EQ(reader.lastFrameSources().front(), "b.txt");
+}
+
 TEST(OfflineRadarSensorTest, ReadsDefaultFiles)
 {
     const fs::path tempDir = test_helpers::makeTempDir("offline_sensor");
@@ -46,6 +46,34 @@ void RadarVisualizer::updateMapSegments(const std::vector<glm::vec3>&)
 {
 }
 
+std::span<radar::MapVertex> RadarVisualizer::mapPointBuffer(std::size_t capacity)
+{
+    m_mapVertices.resize(capacity);
+    return m_mapVertices;
+}
+
+void RadarVisualizer::commitMapPoints(std::size_t count)
+{
+    m_mapVertices.resize(std::min(count, m_mapVertices.size()));
+}
+
+std::span<radar::MapVertex> RadarVisualizer::mapSegmentBuffer(std::size_t capacity)
+{
+    m_mapSegmentVertices.resize(capacity);
+    return m_mapSegmentVertices;
+}
+
+void RadarVisualizer::commitMapSegments(std::size_t count)
+{
+    m_mapSegmentVertices.resize(std::min(count, m_mapSegmentVertices.size()));
+}
+
+radar::MapVertexTransform RadarVisualizer::mapVertexTransform() const
+{
+    return m_vcsToIsoEnabled ? radar::MapVertexTransform{-1.0F, m_vcsToIsoLongitudinalOffset}
+                             : radar::MapVertexTransform{};
+}
+
 void RadarVisualizer::updateVehicleContour(const std::vector<glm::vec2>&)
 {
 }
@@ -56,6 +84,11 @@ void RadarVisualizer::setVcsToIsoTransform(float distRearAxle)
     m_vcsToIsoLongitudinalOffset = distRearAxle;
 }
 
+void RadarVisualizer::setFrameMetrics(const radar::core::FrameMetricsRing* metrics)
+{
+    m_frameMetrics = metrics;
+}
+
 void RadarVisualizer::setResetMapCallback(std::function<void()> callback)
 {
     m_resetMapCallback = std::move(callback);
@@ -88,4 +121,14 @@ std::size_t RadarVisualizer::mapSegmentCount() const
     return static_cast<std::size_t>(clamped);
 }
 
+bool RadarVisualizer::downsampleEnabled() const
+{
+    return m_enableDownsampling;
+}
+
+float RadarVisualizer::downsampleCellSize() const
+{
+    return std::max(0.05f, m_downsampleCellSize);
+}
+
 } // namespace visualization
@@ -0,0 +1,155 @@
+#include "utility/radar_records.hpp"
+
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename Record>
+std::vector<char> encode(const Record& record)
+{
+    std::vector<char> bytes(utility::binaryRecordSize<Record>());
+    utility::encodeBinary(record, bytes.data());
+    return bytes;
+}
+
+std::unique_ptr<utility::RawTrackFusion> makeTracks()
+{
+    auto tracks = std::make_unique<utility::RawTrackFusion>();
+    tracks->timestamp_us = 123456789U;
+    tracks->fusionIndex = 42U;
+    for (std::size_t i = 0; i < utility::kTrackCount; ++i)
+    {
+        tracks->vcsLongitudinalPosition[i] = 0.5F * static_cast<float>(i);
+        tracks->vcsLateralPosition[i] = -0.25F * static_cast<float>(i);
+        tracks->id[i] = static_cast<std::int32_t>(i) - 3;
+        tracks->objectClassification[i] = static_cast<std::uint16_t>(i % 13U);
+        tracks->status[i] = static_cast<std::uint8_t>(i % 7U);
+        tracks->vcsHeading[i] = 0.001F * static_cast<float>(i);
+    }
+    return tracks;
+}
+} // namespace
+
+TEST(RecordCodecTest, ParsesCaptureLines)
+{
+    utility::CornerDetectionsRecord corner;
+    ASSERT_TRUE(utility::parseText(test_helpers::buildCornerDetectionsLine(100U, 90U, 2), corner));
+    EXPECT_EQ(corner.detections.sensor, utility::SensorIndex::RearLeft);
+    EXPECT_EQ(corner.publishTimestamp_us, 100U);
+    EXPECT_EQ(corner.detections.header.timestamp_us, 90U);
+    EXPECT_FLOAT_EQ(corner.detections.header.maximumRange_m, 120.0F);
+    EXPECT_FLOAT_EQ(corner.detections.range_m[0], 10.0F);
+    EXPECT_FLOAT_EQ(corner.detections.azimuth_rad[5], 0.1F);
+    EXPECT_EQ(corner.detections.radarValidReturn[0], 1U);
+    EXPECT_EQ(corner.detections.radarValidReturn[1], 0U);
+    EXPECT_FLOAT_EQ(corner.elevationRaw_rad[0], 0.05F);
+
+    auto front = std::make_unique<utility::FrontDetectionsRecord>();
+    ASSERT_TRUE(utility::parseText(test_helpers::buildFrontDetectionsLine(120U, 110U), *front));
+    EXPECT_EQ(front->publishTimestamp_us, 120U);
+    EXPECT_FLOAT_EQ(front->detections.range_m[64], 8.0F);
+
+    auto tracks = std::make_unique<utility::RawTrackFusion>();
+    ASSERT_TRUE(utility::parseText(test_helpers::buildTrackLine(500U), *tracks));
+    EXPECT_EQ(tracks->timestamp_us, 500U);
+    EXPECT_EQ(tracks->id[0], 7);
+    EXPECT_EQ(tracks->vehicleFlag[0], 1U);
+    EXPECT_EQ(tracks->status[0], 5U);
+    EXPECT_EQ(tracks->objectClassificationConfidence[0], 80U);
+}
+
+TEST(RecordCodecTest, TrailerIsOptionalButElementsAreNot)
+{
+    // Header and returns only: no tail, no elevations.
+    std::istringstream tokens(test_helpers::buildCornerDetectionsLine(100U, 90U, 0));
+    std::string truncated;
+    std::string token;
+    for (std::size_t i = 0; i < 9U + utility::kCornerReturnCount * 14U && tokens >> token; ++i)
+    {
+        truncated += token + ' ';
+    }
+
+    utility::CornerDetectionsRecord corner;
+    corner.elevationRaw_rad.fill(1.0F);
+    ASSERT_TRUE(utility::parseText(truncated, corner));
+    EXPECT_FLOAT_EQ(corner.elevationRaw_rad[0], 0.0F);
+    EXPECT_FLOAT_EQ(corner.detections.range_m[0], 10.0F);
+
+    truncated.resize(truncated.size() / 2U);
+    EXPECT_FALSE(utility::parseText(truncated, corner));
+    EXPECT_FALSE(utility::parseText("1 2 3", corner));
+}
+
+TEST(RecordCodecTest, TextAndBinaryRoundTrip)
+{
+    const auto tracks = makeTracks();
+
+    std::string line;
+    utility::appendText(*tracks, line);
+    EXPECT_EQ(utility::countTextTokens(line), utility::textTokenCount<utility::RawTrackFusion>());
+    auto parsed = std::make_unique<utility::RawTrackFusion>();
+    ASSERT_TRUE(utility::parseText(line, *parsed));
+    EXPECT_EQ(encode(*parsed), encode(*tracks));
+
+    const std::vector<char> bytes = encode(*tracks);
+    auto decoded = std::make_unique<utility::RawTrackFusion>();
+    utility::decodeBinary(bytes.data(), *decoded);
+    EXPECT_EQ(decoded->id[10], 7);
+    EXPECT_FLOAT_EQ(decoded->vcsHeading[95], tracks->vcsHeading[95]);
+    EXPECT_EQ(encode(*decoded), bytes);
+}
+
+TEST(RecordCodecTest, BinaryStreamCarriesLayoutHeader)
+{
+    utility::CornerDetectionsRecord corner;
+    ASSERT_TRUE(utility::parseText(test_helpers::buildCornerDetectionsLine(100U, 90U, 1), corner));
+
+    std::stringstream stream;
+    ASSERT_TRUE(utility::writeBinaryStreamHeader<utility::CornerDetectionsRecord>(stream));
+    ASSERT_TRUE(utility::writeBinary(stream, corner));
+    ASSERT_TRUE(utility::writeBinary(stream, corner));
+
+    utility::BinaryStreamHeader header;
+    ASSERT_TRUE(utility::readBinaryStreamHeader(stream, header));
+    EXPECT_EQ(header.recordTag, static_cast<std::uint32_t>(utility::RecordTag::CornerDetections));
+    EXPECT_EQ(header.recordSize, utility::binaryRecordSize<utility::CornerDetectionsRecord>());
+
+    utility::CornerDetectionsRecord decoded;
+    EXPECT_TRUE(utility::readBinary(stream, decoded));
+    EXPECT_TRUE(utility::readBinary(stream, decoded));
+    EXPECT_FALSE(utility::readBinary(stream, decoded));
+    EXPECT_EQ(encode(decoded), encode(corner));
+
+    std::istringstream text(test_helpers::buildTrackLine(1U));
+    EXPECT_FALSE(utility::readBinaryStreamHeader(text, header));
+    std::string firstToken;
+    text >> firstToken;
+    EXPECT_EQ(firstToken, "1");
+}
+
+TEST(RecordCodecTest, ExportsNamedColumns)
+{
+    const auto tracks = makeTracks();
+    std::vector<std::string> names;
+    std::size_t values = 0U;
+    utility::forEachColumn(*tracks,
+                           [&](const char* name, const auto* data, std::size_t count)
+                           {
+                               names.emplace_back(name);
+                               values += count;
+                               static_cast<void>(data);
+                           });
+
+    ASSERT_EQ(names.size(), 5U + 20U);
+    EXPECT_EQ(names.front(), "timestamp_us");
+    EXPECT_EQ(names[5], "vcsLongitudinalPosition");
+    EXPECT_EQ(names.back(), "vcsHeadingRate");
+    EXPECT_EQ(values, 5U + 20U * utility::kTrackCount);
+}
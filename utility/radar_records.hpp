@@ -0,0 +1,151 @@
+#pragma once
+
+#include "utility/radar_types.hpp"
+#include "utility/record_codec.hpp"
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+namespace utility
+{
+
+// Capture records: the raw sensor structs plus the per-line values the pipeline does not consume directly.
+struct CornerDetectionsRecord
+{
+    std::uint64_t publishTimestamp_us = 0U;
+    RawCornerDetections detections;
+    std::array<float, kCornerReturnCount> elevationRaw_rad{};
+};
+
+struct FrontDetectionsRecord
+{
+    // Radar index column of the capture; the pipeline addresses the front radar as FrontShort/FrontLong.
+    std::int32_t radarIndex = 0;
+    std::uint64_t publishTimestamp_us = 0U;
+    RawFrontDetections detections;
+    std::array<float, kFrontReturnCount> elevationRaw_rad{};
+};
+
+enum class RecordTag : std::uint32_t
+{
+    CornerDetections = 1U,
+    FrontDetections = 2U,
+    TrackFusion = 3U
+};
+
+namespace record_fields
+{
+template <typename Record, typename Raw>
+constexpr auto detectionHeader()
+{
+    return std::make_tuple(
+        field<&Record::publishTimestamp_us>("publishTimestamp_us"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::timestamp_us>("timestamp_us"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::horizontalFov_rad>("horizontalFov_rad"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::maximumRange_m>("maximumRange_m"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::azimuthPolarity>("azimuthPolarity"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::boresightAngle_rad>("boresightAngle_rad"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::sensorLongitudinal_m>("sensorLongitudinal_m"),
+        field<&Record::detections, &Raw::header, &RawDetectionsHeader::sensorLateral_m>("sensorLateral_m"));
+}
+
+template <typename Record, typename Raw>
+constexpr auto detectionReturn()
+{
+    return std::make_tuple(field<&Record::detections, &Raw::range_m>("range_m"),
+                           field<&Record::detections, &Raw::rangeRate_ms>("rangeRate_ms"),
+                           field<&Record::detections, &Raw::rangeRateRaw_ms>("rangeRateRaw_ms"),
+                           field<&Record::detections, &Raw::azimuthRaw_rad>("azimuthRaw_rad"),
+                           field<&Record::detections, &Raw::azimuth_rad>("azimuth_rad"),
+                           field<&Record::detections, &Raw::amplitude_dBsm>("amplitude_dBsm"),
+                           field<&Record::detections, &Raw::longitudinalOffset_m>("longitudinalOffset_m"),
+                           field<&Record::detections, &Raw::lateralOffset_m>("lateralOffset_m"),
+                           field<&Record::detections, &Raw::motionStatus>("motionStatus"),
+                           field<&Record::detections, &Raw::radarValidReturn>("radarValidReturn"),
+                           field<&Record::detections, &Raw::superResolutionDetection>("superResolutionDetection"),
+                           field<&Record::detections, &Raw::nearTargetDetection>("nearTargetDetection"),
+                           field<&Record::detections, &Raw::hostVehicleClutter>("hostVehicleClutter"),
+                           field<&Record::detections, &Raw::multibounceDetection>("multibounceDetection"));
+}
+
+// lookType, scanType, lookIndex.
+constexpr auto detectionTail()
+{
+    return std::make_tuple(Skip<3>{});
+}
+} // namespace record_fields
+
+template <>
+struct RecordLayout<CornerDetectionsRecord>
+{
+    static constexpr RecordTag kTag = RecordTag::CornerDetections;
+    static constexpr std::uint32_t kRecordTag = static_cast<std::uint32_t>(kTag);
+    static constexpr std::size_t kElementCount = kCornerReturnCount;
+    static constexpr auto kHeader = std::tuple_cat(
+        std::make_tuple(field<&CornerDetectionsRecord::detections, &RawCornerDetections::sensor>("sensor")),
+        record_fields::detectionHeader<CornerDetectionsRecord, RawCornerDetections>());
+    static constexpr auto kElement = record_fields::detectionReturn<CornerDetectionsRecord, RawCornerDetections>();
+    static constexpr auto kTail = record_fields::detectionTail();
+    static constexpr auto kTrailer = std::make_tuple(field<&CornerDetectionsRecord::elevationRaw_rad>("elevationRaw_rad"));
+};
+
+template <>
+struct RecordLayout<FrontDetectionsRecord>
+{
+    static constexpr RecordTag kTag = RecordTag::FrontDetections;
+    static constexpr std::uint32_t kRecordTag = static_cast<std::uint32_t>(kTag);
+    static constexpr std::size_t kElementCount = kFrontReturnCount;
+    static constexpr auto kHeader =
+        std::tuple_cat(std::make_tuple(field<&FrontDetectionsRecord::radarIndex>("radarIndex")),
+                       record_fields::detectionHeader<FrontDetectionsRecord, RawFrontDetections>());
+    static constexpr auto kElement = record_fields::detectionReturn<FrontDetectionsRecord, RawFrontDetections>();
+    static constexpr auto kTail = record_fields::detectionTail();
+    static constexpr auto kTrailer = std::make_tuple(field<&FrontDetectionsRecord::elevationRaw_rad>("elevationRaw_rad"));
+};
+
+// Track lines carry 35 tokens per track; the unused ones are skipped in text and dropped from the binary form.
+template <>
+struct RecordLayout<RawTrackFusion>
+{
+    static constexpr RecordTag kTag = RecordTag::TrackFusion;
+    static constexpr std::uint32_t kRecordTag = static_cast<std::uint32_t>(kTag);
+    static constexpr std::size_t kElementCount = kTrackCount;
+    static constexpr auto kHeader = std::make_tuple(field<&RawTrackFusion::timestamp_us>("timestamp_us"),
+                                                    field<&RawTrackFusion::visionTimestamp>("visionTimestamp"),
+                                                    field<&RawTrackFusion::fusionTimestamp>("fusionTimestamp"),
+                                                    field<&RawTrackFusion::fusionIndex>("fusionIndex"),
+                                                    field<&RawTrackFusion::imageFrameIndex>("imageFrameIndex"));
+    static constexpr auto kElement = std::make_tuple(
+        field<&RawTrackFusion::vcsLongitudinalPosition>("vcsLongitudinalPosition"),
+        field<&RawTrackFusion::vcsLateralPosition>("vcsLateralPosition"),
+        Skip<2>{},
+        field<&RawTrackFusion::length>("length"),
+        field<&RawTrackFusion::width>("width"),
+        field<&RawTrackFusion::height>("height"),
+        field<&RawTrackFusion::probabilityOfDetection>("probabilityOfDetection"),
+        field<&RawTrackFusion::id>("id"),
+        Skip<8>{},
+        field<&RawTrackFusion::movingFlag>("movingFlag"),
+        field<&RawTrackFusion::stationaryFlag>("stationaryFlag"),
+        field<&RawTrackFusion::moveableFlag>("moveableFlag"),
+        Skip<5>{},
+        field<&RawTrackFusion::vehicleFlag>("vehicleFlag"),
+        field<&RawTrackFusion::status>("status"),
+        field<&RawTrackFusion::objectClassification>("objectClassification"),
+        field<&RawTrackFusion::objectClassificationConfidence>("objectClassificationConfidence"),
+        field<&RawTrackFusion::vcsLateralVelocity>("vcsLateralVelocity"),
+        field<&RawTrackFusion::vcsLongitudinalVelocity>("vcsLongitudinalVelocity"),
+        field<&RawTrackFusion::vcsLateralAcceleration>("vcsLateralAcceleration"),
+        field<&RawTrackFusion::vcsLongitudinalAcceleration>("vcsLongitudinalAcceleration"),
+        field<&RawTrackFusion::vcsHeading>("vcsHeading"),
+        field<&RawTrackFusion::vcsHeadingRate>("vcsHeadingRate"));
+    static constexpr auto kTail = std::tuple<>{};
+    static constexpr auto kTrailer = std::tuple<>{};
+};
+
+static_assert(textTokenCount<CornerDetectionsRecord>() == 9U + kCornerReturnCount * 14U + 3U + kCornerReturnCount);
+static_assert(textTokenCount<FrontDetectionsRecord>() == 9U + kFrontReturnCount * 14U + 3U + kFrontReturnCount);
+static_assert(textTokenCount<RawTrackFusion>() == 5U + kTrackCount * 35U);
+
+} // namespace utility
@@ -0,0 +1,613 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace utility
+{
+
+// Compile-time field tables for fixed-layout records. A record type specialises RecordLayout with four
+// constexpr tuples of descriptors:
+//   kHeader  - scalar fields, one text token each, written first;
+//   kElement - per-element fields (std::array members), interleaved element by element in text;
+//   kTail    - tokens that follow the elements (usually Skip<> only);
+//   kTrailer - per-element fields written column by column after the tail; optional in text.
+// Text parsing, text formatting, binary encode/decode and column export are all generated from the same
+// table, so adding a field means adding one descriptor.
+
+// Member-pointer path into a record, e.g. field<&Record::header, &Header::timestamp_us>("timestamp_us").
+template <auto... Path>
+struct Field
+{
+    static constexpr std::size_t kTokenCount = 1U;
+
+    const char* name;
+
+    template <typename Record>
+    static constexpr decltype(auto) get(Record& record)
+    {
+        return (record .* ... .* Path);
+    }
+};
+
+template <auto... Path>
+constexpr Field<Path...> field(const char* name)
+{
+    return Field<Path...>{name};
+}
+
+// Text tokens that are present in the capture but not stored. Skipped fields are not part of the binary form.
+template <std::size_t Count>
+struct Skip
+{
+    static constexpr std::size_t kTokenCount = Count;
+};
+
+template <typename Record>
+struct RecordLayout;
+
+struct BinaryStreamHeader
+{
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0U;
+    std::uint32_t recordTag = 0U;
+    std::uint32_t recordSize = 0U;
+};
+
+constexpr std::array<char, 4> kBinaryStreamMagic = {'R', 'D', 'R', 'B'};
+constexpr std::uint32_t kBinaryStreamVersion = 1U;
+
+namespace codec_detail
+{
+// Binary captures are plain native-endian column dumps; every supported target is little-endian.
+static_assert(std::endian::native == std::endian::little, "binary record codec assumes little-endian");
+
+template <typename Descriptor>
+constexpr bool kIsSkip = false;
+
+template <std::size_t Count>
+constexpr bool kIsSkip<Skip<Count>> = true;
+
+template <typename T>
+struct ArrayTraits
+{
+    static constexpr bool kIsArray = false;
+    static constexpr std::size_t kSize = 1U;
+};
+
+template <typename T, std::size_t N>
+struct ArrayTraits<std::array<T, N>>
+{
+    static constexpr bool kIsArray = true;
+    static constexpr std::size_t kSize = N;
+};
+
+template <typename Record, typename Descriptor>
+using StoredType = std::remove_cvref_t<decltype(Descriptor::get(std::declval<Record&>()))>;
+
+constexpr bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+class TextCursor
+{
+public:
+    explicit TextCursor(std::string_view text)
+        : m_pos(text.data())
+        , m_end(text.data() + text.size())
+    {
+    }
+
+    bool next(double& value)
+    {
+        while (m_pos < m_end && isSpace(*m_pos))
+        {
+            ++m_pos;
+        }
+        if (m_pos < m_end && *m_pos == '+')
+        {
+            ++m_pos;
+        }
+        const auto result = std::from_chars(m_pos, m_end, value);
+        if (result.ec != std::errc{})
+        {
+            return false;
+        }
+        m_pos = result.ptr;
+        return true;
+    }
+
+    bool skip(std::size_t count)
+    {
+        double ignored = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!next(ignored))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+};
+
+template <typename T>
+void assignValue(T& target, double value)
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        target = static_cast<T>(static_cast<std::underlying_type_t<T>>(value));
+    }
+    else
+    {
+        target = static_cast<T>(value);
+    }
+}
+
+template <typename T>
+void appendValue(std::string& out, T value)
+{
+    std::array<char, 32> buffer{};
+    std::to_chars_result result{};
+    if constexpr (std::is_enum_v<T>)
+    {
+        result = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                               static_cast<long long>(static_cast<std::underlying_type_t<T>>(value)));
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    }
+    else
+    {
+        result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), static_cast<long long>(value));
+    }
+    out.append(buffer.data(), result.ptr);
+}
+
+inline void appendZeros(std::string& out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out.append(" 0");
+    }
+}
+
+template <typename Record, typename Descriptor>
+bool readScalar(TextCursor& cursor, Record& record, const Descriptor&)
+{
+    if constexpr (kIsSkip<Descriptor>)
+    {
+        return cursor.skip(Descriptor::kTokenCount);
+    }
+    else
+    {
+        static_assert(!ArrayTraits<StoredType<Record, Descriptor>>::kIsArray, "scalar section holds an array");
+        double value = 0.0;
+        if (!cursor.next(value))
+        {
+            return false;
+        }
+        assignValue(Descriptor::get(record), value);
+        return true;
+    }
+}
+
+template <typename Record, typename Descriptor>
+bool readElement(TextCursor& cursor, Record& record, const Descriptor&, std::size_t index)
+{
+    if constexpr (kIsSkip<Descriptor>)
+    {
+        return cursor.skip(Descriptor::kTokenCount);
+    }
+    else
+    {
+        static_assert(ArrayTraits<StoredType<Record, Descriptor>>::kIsArray, "element section holds a scalar");
+        double value = 0.0;
+        if (!cursor.next(value))
+        {
+            return false;
+        }
+        assignValue(Descriptor::get(record)[index], value);
+        return true;
+    }
+}
+
+template <typename Record, typename Descriptor>
+bool readColumn(TextCursor& cursor, Record& record, const Descriptor&)
+{
+    static_assert(!kIsSkip<Descriptor>, "trailer columns cannot be skipped");
+    auto& column = Descriptor::get(record);
+    for (auto& entry : column)
+    {
+        double value = 0.0;
+        if (!cursor.next(value))
+        {
+            return false;
+        }
+        assignValue(entry, value);
+    }
+    return true;
+}
+
+// Reads count trailer values of one column; values [first, first + column size) are stored from slot 0.
+template <typename Record, typename Descriptor>
+bool readColumnWindow(TextCursor& cursor, Record& record, const Descriptor&, std::size_t count, std::size_t first)
+{
+    static_assert(!kIsSkip<Descriptor>, "trailer columns cannot be skipped");
+    auto& column = Descriptor::get(record);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double value = 0.0;
+        if (!cursor.next(value))
+        {
+            return false;
+        }
+        if (i >= first && i - first < column.size())
+        {
+            assignValue(column[i - first], value);
+        }
+    }
+    return true;
+}
+
+template <typename Record, typename Descriptor>
+void clearColumn(Record& record, const Descriptor&)
+{
+    if constexpr (!kIsSkip<Descriptor>)
+    {
+        Descriptor::get(record).fill({});
+    }
+}
+
+template <typename Record, typename Descriptor>
+void writeScalar(std::string& out, const Record& record, const Descriptor&)
+{
+    if constexpr (kIsSkip<Descriptor>)
+    {
+        appendZeros(out, Descriptor::kTokenCount);
+    }
+    else
+    {
+        out.push_back(' ');
+        appendValue(out, Descriptor::get(record));
+    }
+}
+
+template <typename Record, typename Descriptor>
+void writeElement(std::string& out, const Record& record, const Descriptor&, std::size_t index)
+{
+    if constexpr (kIsSkip<Descriptor>)
+    {
+        appendZeros(out, Descriptor::kTokenCount);
+    }
+    else
+    {
+        out.push_back(' ');
+        appendValue(out, Descriptor::get(record)[index]);
+    }
+}
+
+template <typename Record, typename Descriptor>
+void writeColumn(std::string& out, const Record& record, const Descriptor&)
+{
+    for (const auto& entry : Descriptor::get(record))
+    {
+        out.push_back(' ');
+        appendValue(out, entry);
+    }
+}
+
+template <typename Record, typename Descriptor, typename Visitor>
+void visitColumn(Record& record, const Descriptor& descriptor, Visitor& visitor)
+{
+    if constexpr (!kIsSkip<Descriptor>)
+    {
+        auto& stored = Descriptor::get(record);
+        if constexpr (ArrayTraits<std::remove_cvref_t<decltype(stored)>>::kIsArray)
+        {
+            visitor(descriptor.name, stored.data(), stored.size());
+        }
+        else
+        {
+            visitor(descriptor.name, &stored, std::size_t{1});
+        }
+    }
+}
+
+template <typename Record, typename Descriptor>
+constexpr std::size_t storedBytes(const Descriptor&)
+{
+    if constexpr (kIsSkip<Descriptor>)
+    {
+        return 0U;
+    }
+    else
+    {
+        return sizeof(StoredType<Record, Descriptor>);
+    }
+}
+
+template <typename Record, typename Tuple>
+constexpr std::size_t tableBytes(const Tuple& descriptors)
+{
+    return std::apply([](const auto&... entries) { return (std::size_t{0} + ... + storedBytes<Record>(entries)); },
+                      descriptors);
+}
+
+template <typename Tuple>
+constexpr std::size_t tokenCount(const Tuple& descriptors)
+{
+    return std::apply(
+        [](const auto&... entries) { return (std::size_t{0} + ... + std::remove_cvref_t<decltype(entries)>::kTokenCount); },
+        descriptors);
+}
+} // namespace codec_detail
+
+template <typename Record>
+constexpr std::size_t textTokenCount()
+{
+    using Layout = RecordLayout<Record>;
+    return codec_detail::tokenCount(Layout::kHeader) + Layout::kElementCount * codec_detail::tokenCount(Layout::kElement) +
+           codec_detail::tokenCount(Layout::kTail) + Layout::kElementCount * std::tuple_size_v<decltype(Layout::kTrailer)>;
+}
+
+// Number of elements in a text line of the given token count when it carries a whole number of elements
+// followed by the tail and trailer, 0 otherwise. Captures are not bound to kElementCount.
+template <typename Record>
+constexpr std::size_t textElementCount(std::size_t tokens)
+{
+    using Layout = RecordLayout<Record>;
+    constexpr std::size_t fixed = codec_detail::tokenCount(Layout::kHeader) + codec_detail::tokenCount(Layout::kTail);
+    constexpr std::size_t stride =
+        codec_detail::tokenCount(Layout::kElement) + std::tuple_size_v<decltype(Layout::kTrailer)>;
+    if (tokens <= fixed || (tokens - fixed) % stride != 0U)
+    {
+        return 0U;
+    }
+    return (tokens - fixed) / stride;
+}
+
+template <typename Record>
+constexpr std::size_t binaryRecordSize()
+{
+    using Layout = RecordLayout<Record>;
+    return codec_detail::tableBytes<Record>(Layout::kHeader) + codec_detail::tableBytes<Record>(Layout::kElement) +
+           codec_detail::tableBytes<Record>(Layout::kTrailer);
+}
+
+inline std::size_t countTextTokens(std::string_view line)
+{
+    std::size_t count = 0U;
+    bool inToken = false;
+    for (const char c : line)
+    {
+        const bool space = codec_detail::isSpace(c);
+        count += (!space && !inToken) ? 1U : 0U;
+        inToken = !space;
+    }
+    return count;
+}
+
+// Parses one whitespace separated capture line. Header and element tokens are mandatory; the tail and
+// trailer are optional and trailer columns stay zero when the line ends early.
+template <typename Record>
+bool parseText(std::string_view line, Record& record)
+{
+    using Layout = RecordLayout<Record>;
+    codec_detail::TextCursor cursor(line);
+
+    const bool header = std::apply(
+        [&](const auto&... entries) { return (codec_detail::readScalar(cursor, record, entries) && ...); },
+        Layout::kHeader);
+    if (!header)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < Layout::kElementCount; ++i)
+    {
+        const bool element = std::apply(
+            [&](const auto&... entries) { return (codec_detail::readElement(cursor, record, entries, i) && ...); },
+            Layout::kElement);
+        if (!element)
+        {
+            return false;
+        }
+    }
+
+    std::apply([&](const auto&... entries) { (std::remove_cvref_t<decltype(entries)>::get(record).fill({}), ...); },
+               Layout::kTrailer);
+    const bool tail = std::apply(
+        [&](const auto&... entries) { return (codec_detail::readScalar(cursor, record, entries) && ...); },
+        Layout::kTail);
+    if (tail)
+    {
+        std::apply([&](const auto&... entries) { static_cast<void>((codec_detail::readColumn(cursor, record, entries) && ...)); },
+                   Layout::kTrailer);
+    }
+    return true;
+}
+
+// Parses a capture line carrying elementCount elements (see textElementCount) instead of kElementCount.
+// Elements [firstElement, firstElement + kElementCount) are stored from slot 0, the others are skipped and
+// unused slots stay zero. The tail and trailer are mandatory since the element count assumes them.
+template <typename Record>
+bool parseTextWindow(std::string_view line, Record& record, std::size_t elementCount, std::size_t firstElement = 0U)
+{
+    using Layout = RecordLayout<Record>;
+    constexpr std::size_t elementTokens = codec_detail::tokenCount(Layout::kElement);
+    codec_detail::TextCursor cursor(line);
+
+    const bool header = std::apply(
+        [&](const auto&... entries) { return (codec_detail::readScalar(cursor, record, entries) && ...); },
+        Layout::kHeader);
+    if (!header)
+    {
+        return false;
+    }
+
+    std::apply([&](const auto&... entries) { (codec_detail::clearColumn(record, entries), ...); }, Layout::kElement);
+    std::apply([&](const auto&... entries) { (codec_detail::clearColumn(record, entries), ...); }, Layout::kTrailer);
+    for (std::size_t i = 0; i < elementCount; ++i)
+    {
+        const bool stored = i >= firstElement && i - firstElement < Layout::kElementCount;
+        const bool element =
+            stored ? std::apply(
+                         [&](const auto&... entries)
+                         { return (codec_detail::readElement(cursor, record, entries, i - firstElement) && ...); },
+                         Layout::kElement)
+                   : cursor.skip(elementTokens);
+        if (!element)
+        {
+            return false;
+        }
+    }
+
+    const bool tail = std::apply(
+        [&](const auto&... entries) { return (codec_detail::readScalar(cursor, record, entries) && ...); },
+        Layout::kTail);
+    return tail && std::apply(
+                       [&](const auto&... entries)
+                       {
+                           return (codec_detail::readColumnWindow(cursor, record, entries, elementCount,
+                                                                  firstElement) && ...);
+                       },
+                       Layout::kTrailer);
+}
+
+// Appends the record as one capture line (no newline). Floats use the shortest round-trip representation.
+template <typename Record>
+void appendText(const Record& record, std::string& out)
+{
+    using Layout = RecordLayout<Record>;
+    const std::size_t start = out.size();
+    std::apply([&](const auto&... entries) { (codec_detail::writeScalar(out, record, entries), ...); }, Layout::kHeader);
+    for (std::size_t i = 0; i < Layout::kElementCount; ++i)
+    {
+        std::apply([&](const auto&... entries) { (codec_detail::writeElement(out, record, entries, i), ...); },
+                   Layout::kElement);
+    }
+    std::apply([&](const auto&... entries) { (codec_detail::writeScalar(out, record, entries), ...); }, Layout::kTail);
+    std::apply([&](const auto&... entries) { (codec_detail::writeColumn(out, record, entries), ...); }, Layout::kTrailer);
+    if (out.size() > start && out[start] == ' ')
+    {
+        out.erase(start, 1U);
+    }
+}
+
+// Calls visitor(name, pointer, count) for every stored field in table order: header scalars with count 1,
+// element and trailer columns with kElementCount. Const records yield const pointers.
+template <typename Record, typename Visitor>
+void forEachColumn(Record& record, Visitor&& visitor)
+{
+    using Layout = RecordLayout<std::remove_const_t<Record>>;
+    const auto visitAll = [&](const auto& descriptors)
+    {
+        std::apply([&](const auto&... entries) { (codec_detail::visitColumn(record, entries, visitor), ...); },
+                   descriptors);
+    };
+    visitAll(Layout::kHeader);
+    visitAll(Layout::kElement);
+    visitAll(Layout::kTrailer);
+}
+
+// Binary form: stored fields in table order, arrays as contiguous columns. out must hold binaryRecordSize().
+template <typename Record>
+void encodeBinary(const Record& record, char* out)
+{
+    forEachColumn(record,
+                  [&out](const char*, const auto* data, std::size_t count)
+                  {
+                      const std::size_t bytes = count * sizeof(*data);
+                      std::memcpy(out, data, bytes);
+                      out += bytes;
+                  });
+}
+
+template <typename Record>
+void decodeBinary(const char* in, Record& record)
+{
+    forEachColumn(record,
+                  [&in](const char*, auto* data, std::size_t count)
+                  {
+                      const std::size_t bytes = count * sizeof(*data);
+                      std::memcpy(data, in, bytes);
+                      in += bytes;
+                  });
+}
+
+template <typename Record>
+bool writeBinaryStreamHeader(std::ostream& out)
+{
+    BinaryStreamHeader header;
+    header.magic = kBinaryStreamMagic;
+    header.version = kBinaryStreamVersion;
+    header.recordTag = RecordLayout<Record>::kRecordTag;
+    header.recordSize = static_cast<std::uint32_t>(binaryRecordSize<Record>());
+    out.write(header.magic.data(), static_cast<std::streamsize>(header.magic.size()));
+    out.write(reinterpret_cast<const char*>(&header.version), sizeof(header.version));
+    out.write(reinterpret_cast<const char*>(&header.recordTag), sizeof(header.recordTag));
+    out.write(reinterpret_cast<const char*>(&header.recordSize), sizeof(header.recordSize));
+    return static_cast<bool>(out);
+}
+
+// Reads the stream header when the stream starts with the binary magic. Text streams are rewound and
+// reported as not binary.
+inline bool readBinaryStreamHeader(std::istream& in, BinaryStreamHeader& header)
+{
+    const auto start = in.tellg();
+    in.read(header.magic.data(), static_cast<std::streamsize>(header.magic.size()));
+    if (in.gcount() != static_cast<std::streamsize>(header.magic.size()) || header.magic != kBinaryStreamMagic)
+    {
+        in.clear();
+        in.seekg(start);
+        return false;
+    }
+    in.read(reinterpret_cast<char*>(&header.version), sizeof(header.version));
+    in.read(reinterpret_cast<char*>(&header.recordTag), sizeof(header.recordTag));
+    in.read(reinterpret_cast<char*>(&header.recordSize), sizeof(header.recordSize));
+    return static_cast<bool>(in);
+}
+
+template <typename Record>
+bool writeBinary(std::ostream& out, const Record& record)
+{
+    forEachColumn(record,
+                  [&out](const char*, const auto* data, std::size_t count)
+                  {
+                      out.write(reinterpret_cast<const char*>(data),
+                                static_cast<std::streamsize>(count * sizeof(*data)));
+                  });
+    return static_cast<bool>(out);
+}
+
+// Reads columns straight into the record; false on a short read (end of stream).
+template <typename Record>
+bool readBinary(std::istream& in, Record& record)
+{
+    forEachColumn(record,
+                  [&in](const char*, auto* data, std::size_t count)
+                  {
+                      in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(*data)));
+                  });
+    return static_cast<bool>(in);
+}
+
+} // namespace utility
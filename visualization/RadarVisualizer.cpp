@@ -8,6 +8,7 @@
 #include <imgui.h>
 #include <imgui_impl_glfw.hpp>
 #include <imgui_impl_opengl3.hpp>
+#include <implot.h>
 #include <array>
 #include <filesystem>
 #include <cmath>
@@ -25,6 +26,10 @@ namespace
 {
 constexpr const char* kVertexShaderPath = "shaders/point.vs";
 constexpr const char* kFragmentShaderPath = "shaders/point.fs";
+constexpr const char* kDetectionVertexShaderPath = "shaders/detection.vs";
+constexpr const char* kDetectionFragmentShaderPath = "shaders/detection.fs";
+// Initial detection ring buffer size in vertices; grows when the retained history does not fit.
+constexpr std::size_t kDetectionRingInitialCapacity = 16384;
 constexpr std::size_t kMapSplineSampleCount = 192;
 constexpr int kMapSegmentMin = 12;
 constexpr int kMapSegmentMax = 360;
@@ -49,8 +54,36 @@ constexpr std::array<const char*, 3> kDetectionMotionFilterLabels = {
     "Moving",
     "All"};
 constexpr int kFovArcPointCount = 24;
+constexpr auto kPerformanceRefreshPeriod = std::chrono::milliseconds(100);
+constexpr std::array<const char*, 3> kPercentileLabels = {"p50", "p95", "p99"};
+constexpr std::array<float, 3> kPercentiles = {0.5F, 0.95F, 0.99F};
+// Indexed by utility::SensorIndex.
+constexpr std::array<const char*, radar::core::kFrameMetricsSensorCount> kSensorLabels = {
+    "front left",
+    "front right",
+    "rear left",
+    "rear right",
+    "front short",
+    "front long"};
+// Per-sensor colours; the last entry is used for points without a sensor index.
+const std::array<glm::vec3, 6> kSensorPalette = {
+    glm::vec3(0.95F, 0.75F, 0.25F),
+    glm::vec3(0.2F, 0.8F, 0.85F),
+    glm::vec3(0.25F, 0.45F, 0.95F),
+    glm::vec3(0.85F, 0.3F, 0.85F),
+    glm::vec3(0.3F, 0.25F, 0.9F),
+    glm::vec3(0.7F, 0.7F, 0.7F)};
 constexpr float kSplineControlPointEpsilon = 1e-4F;
 
+std::size_t sensorPaletteSlot(int sensorIndex)
+{
+    if (sensorIndex < 0)
+    {
+        return kSensorPalette.size() - 1;
+    }
+    return static_cast<std::size_t>(sensorIndex) % (kSensorPalette.size() - 1);
+}
+
 std::vector<glm::vec2> resampleLoop(const std::vector<glm::vec2>& points, std::size_t targetCount)
 {
     if (points.size() < 2U || targetCount == 0U)
@@ -136,6 +169,18 @@ std::vector<glm::vec2> resampleLoop(const std::vector<glm::vec2>& points, std::s
 
     return resampled;
 }
+
+// Selection, so values ends up partially reordered.
+float percentile(std::vector<float>& values, float fraction)
+{
+    if (values.empty())
+    {
+        return 0.0F;
+    }
+    const auto nth = values.begin() + static_cast<std::ptrdiff_t>(fraction * static_cast<float>(values.size() - 1U));
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
 }
 
 RadarVisualizer::~RadarVisualizer()
@@ -181,6 +226,10 @@ bool RadarVisualizer::initialize()
     {
         return false;
     }
+    if (!m_detectionShader.load(kDetectionVertexShaderPath, kDetectionFragmentShaderPath))
+    {
+        return false;
+    }
 
     glGenVertexArrays(1, &m_vao);
     glGenBuffers(1, &m_vbo);
@@ -198,6 +247,8 @@ bool RadarVisualizer::initialize()
     glGenBuffers(1, &m_fovVbo);
     glGenVertexArrays(1, &m_trackVao);
     glGenBuffers(1, &m_trackVbo);
+    glGenVertexArrays(1, &m_detectionVao);
+    glGenBuffers(1, &m_detectionVbo);
 
     setupVertexAttributes(m_vao, m_vbo);
     setupVertexAttributes(m_mapVao, m_mapVbo);
@@ -208,8 +259,30 @@ bool RadarVisualizer::initialize()
     setupVertexAttributes(m_fovVao, m_fovVbo);
     setupVertexAttributes(m_trackVao, m_trackVbo);
 
+    glBindVertexArray(m_detectionVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_detectionVbo);
+    resizeDetectionRing(kDetectionRingInitialCapacity);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0, 3, GL_FLOAT, GL_FALSE, sizeof(DetectionVertex), reinterpret_cast<void*>(offsetof(DetectionVertex, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1,
+                          1,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(DetectionVertex),
+                          reinterpret_cast<void*>(offsetof(DetectionVertex, stationaryProbability)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(
+        2, 1, GL_FLOAT, GL_FALSE, sizeof(DetectionVertex), reinterpret_cast<void*>(offsetof(DetectionVertex, rangeRate)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(
+        3, 1, GL_UNSIGNED_INT, sizeof(DetectionVertex), reinterpret_cast<void*>(offsetof(DetectionVertex, attributes)));
+    glBindVertexArray(0);
+
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
+    ImPlot::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     static std::string iniPath;
     const std::filesystem::path visualizationIni = std::filesystem::path("visualization") / "imgui.ini";
@@ -235,6 +308,7 @@ void RadarVisualizer::cleanup()
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::SaveIniSettingsToDisk(ImGui::GetIO().IniFilename);
+        ImPlot::DestroyContext();
         ImGui::DestroyContext();
         glfwDestroyWindow(m_window);
         glfwTerminate();
@@ -336,6 +410,20 @@ void RadarVisualizer::cleanup()
         glDeleteVertexArrays(1, &m_trackVao);
         m_trackVao = 0;
     }
+
+    if (m_detectionVbo != 0)
+    {
+        glDeleteBuffers(1, &m_detectionVbo);
+        m_detectionVbo = 0;
+    }
+
+    if (m_detectionVao != 0)
+    {
+        glDeleteVertexArrays(1, &m_detectionVao);
+        m_detectionVao = 0;
+    }
+    m_detectionCapacity = 0U;
+    m_detectionWriteCursor = 0U;
 }
 
 void RadarVisualizer::updatePoints(const radar::BaseRadarSensor::PointCloud& points,
@@ -478,19 +566,61 @@ void RadarVisualizer::uploadBuffer()
 
 void RadarVisualizer::updateMapPoints(const std::vector<glm::vec3>& points)
 {
-    m_mapVertices.clear();
-    m_mapVertices.reserve(points.size());
-    for (const auto& point : points)
+    const auto transform = mapVertexTransform();
+    const auto out = mapPointBuffer(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
     {
-        glm::vec3 position = point;
-        if (m_vcsToIsoEnabled)
-        {
-            position = glm::vec3(-position.x, position.y + m_vcsToIsoLongitudinalOffset, position.z);
-        }
-        m_mapVertices.push_back({position, 1.0F});
+        out[i] = transform.apply(glm::vec2(points[i].x, points[i].y));
+        out[i].position.z = points[i].z;
     }
+    commitMapPoints(points.size());
+}
+
+void RadarVisualizer::updateMapSegments(const std::vector<glm::vec3>& points)
+{
+    const auto transform = mapVertexTransform();
+    const auto out = mapSegmentBuffer(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        out[i] = transform.apply(glm::vec2(points[i].x, points[i].y));
+        out[i].position.z = points[i].z;
+    }
+    commitMapSegments(points.size());
+}
+
+std::span<radar::MapVertex> RadarVisualizer::mapPointBuffer(std::size_t capacity)
+{
+    m_mapVertices.resize(capacity);
+    return m_mapVertices;
+}
+
+void RadarVisualizer::commitMapPoints(std::size_t count)
+{
+    m_mapVertices.resize(std::min(count, m_mapVertices.size()));
     m_mapDirty = true;
+    rebuildMapSpline();
+}
 
+std::span<radar::MapVertex> RadarVisualizer::mapSegmentBuffer(std::size_t capacity)
+{
+    m_mapSegmentVertices.resize(capacity);
+    return m_mapSegmentVertices;
+}
+
+void RadarVisualizer::commitMapSegments(std::size_t count)
+{
+    m_mapSegmentVertices.resize(std::min(count, m_mapSegmentVertices.size()));
+    m_mapSegmentDirty = true;
+}
+
+radar::MapVertexTransform RadarVisualizer::mapVertexTransform() const
+{
+    return m_vcsToIsoEnabled ? radar::MapVertexTransform{-1.0F, m_vcsToIsoLongitudinalOffset}
+                             : radar::MapVertexTransform{};
+}
+
+void RadarVisualizer::rebuildMapSpline()
+{
     m_mapSplineVertices.clear();
     if (!m_showBsplineMap)
     {
@@ -516,22 +646,6 @@ void RadarVisualizer::updateMapPoints(const std::vector<glm::vec3>& points)
     m_mapSplineDirty = true;
 }
 
-void RadarVisualizer::updateMapSegments(const std::vector<glm::vec3>& points)
-{
-    m_mapSegmentVertices.clear();
-    m_mapSegmentVertices.reserve(points.size());
-    for (const auto& point : points)
-    {
-        glm::vec3 position = point;
-        if (m_vcsToIsoEnabled)
-        {
-            position = glm::vec3(-position.x, position.y + m_vcsToIsoLongitudinalOffset, position.z);
-        }
-        m_mapSegmentVertices.push_back({position, 1.0F});
-    }
-    m_mapSegmentDirty = true;
-}
-
 void RadarVisualizer::updateVehicleContour(const std::vector<glm::vec2>& contourPoints)
 {
     m_contourVertices.clear();
@@ -655,6 +769,13 @@ void RadarVisualizer::setResetMapCallback(std::function<void()> callback)
     m_resetMapCallback = std::move(callback);
 }
 
+void RadarVisualizer::setFrameMetrics(const radar::core::FrameMetricsRing* metrics)
+{
+    m_frameMetrics = metrics;
+    m_metricsPublished = 0U;
+    m_metricSamples.clear();
+}
+
 void RadarVisualizer::setVcsToIsoTransform(float distRearAxle)
 {
     m_vcsToIsoEnabled = true;
@@ -793,20 +914,6 @@ void RadarVisualizer::mouseButtonCallback(GLFWwindow* window, int button, int ac
     }
 }
 
-bool RadarVisualizer::passesMotionFilter(const radar::RadarPoint& point) const
-{
-    switch (m_detectionMotionFilter)
-    {
-        case DetectionMotionFilter::Static:
-            return point.motionStatus == 0;
-        case DetectionMotionFilter::Moving:
-            return point.motionStatus == 1;
-        case DetectionMotionFilter::All:
-        default:
-            return true;
-    }
-}
-
 RadarVisualizer::DetectionType RadarVisualizer::detectionTypeForPoint(const radar::RadarPoint& point) const
 {
     if (point.multibounce)
@@ -834,19 +941,7 @@ RadarVisualizer::DetectionType RadarVisualizer::detectionTypeForPoint(const rada
 
 glm::vec3 RadarVisualizer::colorForSensor(int sensorIndex) const
 {
-    static const std::array<glm::vec3, 6> kSensorPalette = {
-        glm::vec3(0.95F, 0.75F, 0.25F),
-        glm::vec3(0.2F, 0.8F, 0.85F),
-        glm::vec3(0.25F, 0.45F, 0.95F),
-        glm::vec3(0.85F, 0.3F, 0.85F),
-        glm::vec3(0.3F, 0.25F, 0.9F),
-        glm::vec3(0.7F, 0.7F, 0.7F)};
-    if (sensorIndex < 0)
-    {
-        return kSensorPalette.back();
-    }
-    const size_t paletteIndex = static_cast<size_t>(sensorIndex) % (kSensorPalette.size() - 1);
-    return kSensorPalette[paletteIndex];
+    return kSensorPalette[sensorPaletteSlot(sensorIndex)];
 }
 
 glm::vec3 RadarVisualizer::colorForDetectionType(DetectionType type) const
@@ -882,49 +977,6 @@ glm::vec3 RadarVisualizer::trackColor(const radar::RadarTrack& track) const
     return m_trackUnknownColor;
 }
 
-float RadarVisualizer::computeDetectionAlpha(const radar::RadarPoint& point, float ageSeconds) const
-{
-    float alpha = m_detectionAlphaConstant;
-    switch (m_detectionAlphaMode)
-    {
-        case DetectionAlphaMode::MotionProbability:
-        {
-            float stationaryProbability = point.stationaryProbability;
-            if (stationaryProbability <= 0.0F)
-            {
-                const float scale = std::max(0.1F, m_rangeRateStationaryScale);
-                stationaryProbability = std::exp(-std::abs(point.rangeRate_ms) / scale);
-            }
-
-            if (point.isStationary || point.motionStatus == 0)
-            {
-                alpha = stationaryProbability;
-            }
-            else if (point.isMoveable || point.motionStatus == 1)
-            {
-                alpha = 1.0F - stationaryProbability;
-            }
-            else
-            {
-                alpha = 0.5F;
-            }
-            break;
-        }
-        case DetectionAlphaMode::TimeDecay:
-        {
-            const float window = std::max(0.01F, m_lastFramePeriodSec * std::max(1, m_detectionScanRetention));
-            alpha = std::exp(-m_detectionAlphaDecay * ageSeconds / window);
-            break;
-        }
-        case DetectionAlphaMode::Constant:
-        default:
-            break;
-    }
-
-    alpha = std::clamp(alpha * m_intensityScale, 0.05F, 1.0F);
-    return alpha;
-}
-
 void RadarVisualizer::drawUI()
 {
     ImGui::Begin("Radar Controls");
@@ -938,6 +990,10 @@ void RadarVisualizer::drawUI()
     ImGui::SliderInt("B-spline control points", &m_mapSplineControlPointCount,
                      kMapSplineControlPointMin, kMapSplineControlPointMax);
     ImGui::Checkbox("Show vehicle contour", &m_showVehicleContour);
+    if (m_frameMetrics)
+    {
+        ImGui::Checkbox("Show performance panel", &m_showPerformance);
+    }
     ImGui::SliderFloat("Contour width", &m_contourLineWidth, 1.0F, 6.0F);
     bool gridDirty = false;
     gridDirty |= ImGui::Checkbox("Show grid", &m_showGrid);
@@ -966,6 +1022,11 @@ void RadarVisualizer::drawUI()
         {
             ImGui::SliderInt("Scan retention", &m_detectionScanRetention, 1, 300);
         }
+        ImGui::Checkbox("Voxel downsampling", &m_enableDownsampling);
+        if (m_enableDownsampling)
+        {
+            ImGui::SliderFloat("Voxel size (m)", &m_downsampleCellSize, 0.05F, 2.0F, "%.2f");
+        }
 
         int colorMode = static_cast<int>(m_detectionColorMode);
         if (ImGui::Combo("Color mode", &colorMode, kDetectionColorModeLabels.data(),
@@ -1094,6 +1155,138 @@ void RadarVisualizer::drawUI()
     }
     ImGui::End();
 
+    drawPerformancePanel();
+}
+
+void RadarVisualizer::refreshPerformanceStatistics()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const std::uint64_t published = m_frameMetrics->published();
+    if (published == m_metricsPublished || now - m_lastMetricsRefresh < kPerformanceRefreshPeriod)
+    {
+        return;
+    }
+    m_metricsPublished = published;
+    m_lastMetricsRefresh = now;
+
+    const std::size_t count =
+        m_frameMetrics->snapshot(m_metricSamples, static_cast<std::size_t>(std::max(1, m_performanceWindow)));
+    m_plotFrameIndex.resize(count);
+    m_plotFrameWork.resize(count);
+    m_plotFrameInterval.resize(count);
+    m_plotQueueDepth.resize(count);
+    m_plotAllocations.resize(count);
+    for (auto& series : m_plotSensorPoints)
+    {
+        series.resize(count);
+    }
+    double intervalSum = 0.0;
+    std::size_t intervalCount = 0U;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& sample = m_metricSamples[i];
+        m_plotFrameIndex[i] = static_cast<float>(sample.frameIndex);
+        m_plotFrameWork[i] = sample.frameWork_ms;
+        m_plotFrameInterval[i] = sample.frameInterval_ms;
+        m_plotQueueDepth[i] = static_cast<float>(sample.queueDepth);
+        m_plotAllocations[i] = static_cast<float>(sample.allocations);
+        for (std::size_t sensor = 0; sensor < m_plotSensorPoints.size(); ++sensor)
+        {
+            m_plotSensorPoints[sensor][i] = static_cast<float>(sample.pointsPerSensor[sensor]);
+        }
+        if (sample.frameInterval_ms > 0.0F)
+        {
+            intervalSum += sample.frameInterval_ms;
+            ++intervalCount;
+        }
+    }
+    m_framesPerSecond = intervalSum > 0.0 ? static_cast<float>(1000.0 * intervalCount / intervalSum) : 0.0F;
+    m_percentileScratch.assign(m_plotFrameWork.begin(), m_plotFrameWork.end());
+    m_frameWorkP50 = percentile(m_percentileScratch, 0.5F);
+    m_frameWorkP95 = percentile(m_percentileScratch, 0.95F);
+
+    const std::size_t stages = m_frameMetrics->stageCount();
+    m_stagePercentiles.assign(kPercentiles.size() * stages, 0.0F);
+    m_stageLabels.resize(stages);
+    m_stageTicks.resize(stages);
+    for (std::size_t stage = 0; stage < stages; ++stage)
+    {
+        m_percentileScratch.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_percentileScratch[i] = m_metricSamples[i].stage_ms[stage];
+        }
+        for (std::size_t p = 0; p < kPercentiles.size(); ++p)
+        {
+            m_stagePercentiles[p * stages + stage] = percentile(m_percentileScratch, kPercentiles[p]);
+        }
+        m_stageLabels[stage] = m_frameMetrics->stageName(stage);
+        m_stageTicks[stage] = static_cast<double>(stage);
+    }
+}
+
+void RadarVisualizer::drawPerformancePanel()
+{
+    if (!m_frameMetrics || !m_showPerformance)
+    {
+        return;
+    }
+    const auto panelStart = std::chrono::steady_clock::now();
+    refreshPerformanceStatistics();
+
+    ImGui::SetNextWindowSize(ImVec2(560.0F, 720.0F), ImGuiCond_Once);
+    if (ImGui::Begin("Performance", &m_showPerformance))
+    {
+        ImGui::SliderInt("Window (frames)", &m_performanceWindow, 30,
+                         static_cast<int>(radar::core::FrameMetricsRing::kCapacity));
+        ImGui::Text("%.1f fps   frame work p50 %.2f ms  p95 %.2f ms   panel %.3f ms",
+                    m_framesPerSecond,
+                    m_frameWorkP50,
+                    m_frameWorkP95,
+                    m_performancePanelMs);
+
+        const int count = static_cast<int>(m_plotFrameIndex.size());
+        const int stages = static_cast<int>(m_stageLabels.size());
+        const ImVec2 plotSize(-1.0F, 150.0F);
+        const ImPlotAxisFlags autoFit = ImPlotAxisFlags_AutoFit;
+        if (stages > 0 && ImPlot::BeginPlot("Stage latency (ms)", plotSize, ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes(nullptr, nullptr, autoFit, autoFit);
+            ImPlot::SetupAxisTicks(ImAxis_X1, m_stageTicks.data(), stages, m_stageLabels.data());
+            ImPlot::PlotBarGroups(kPercentileLabels.data(),
+                                  m_stagePercentiles.data(),
+                                  static_cast<int>(kPercentileLabels.size()),
+                                  stages);
+            ImPlot::EndPlot();
+        }
+        if (count > 0 && ImPlot::BeginPlot("Frame time (ms)", plotSize, ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes("frame", nullptr, autoFit, autoFit);
+            ImPlot::PlotLine("work", m_plotFrameIndex.data(), m_plotFrameWork.data(), count);
+            ImPlot::PlotLine("interval", m_plotFrameIndex.data(), m_plotFrameInterval.data(), count);
+            ImPlot::EndPlot();
+        }
+        if (count > 0 && ImPlot::BeginPlot("Queue depth / allocations", plotSize, ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes("frame", nullptr, autoFit, autoFit);
+            ImPlot::PlotLine("queued frames", m_plotFrameIndex.data(), m_plotQueueDepth.data(), count);
+            ImPlot::PlotLine("allocations", m_plotFrameIndex.data(), m_plotAllocations.data(), count);
+            ImPlot::EndPlot();
+        }
+        if (count > 0 && ImPlot::BeginPlot("Points per sensor", plotSize, ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes("frame", nullptr, autoFit, autoFit);
+            for (std::size_t sensor = 0; sensor < m_plotSensorPoints.size(); ++sensor)
+            {
+                ImPlot::PlotLine(kSensorLabels[sensor], m_plotFrameIndex.data(), m_plotSensorPoints[sensor].data(), count);
+            }
+            ImPlot::EndPlot();
+        }
+    }
+    ImGui::End();
+
+    m_performancePanelMs =
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - panelStart).count();
 }
 
 void RadarVisualizer::render()
@@ -1299,144 +1492,186 @@ void RadarVisualizer::drawDetections(const glm::mat4& viewProjection)
         return;
     }
 
-    std::unordered_map<int, std::vector<Vertex>> buckets;
-    const uint64_t currentTimestamp = m_lastTimestampUs;
+    uploadPendingDetections();
 
-    for (const auto& frame : m_detectionHistory)
+    m_detectionShader.use();
+    const auto setFloat = [this](const char* name, float value)
     {
-        const float ageSeconds =
-            currentTimestamp > frame.timestampUs
-                ? static_cast<float>(currentTimestamp - frame.timestampUs) / 1'000'000.0F
-                : 0.0F;
-
-        for (const auto& point : frame.points)
+        const GLint location = m_detectionShader.uniformLocation(name);
+        if (location >= 0)
         {
-            if (!passesMotionFilter(point))
-            {
-                continue;
-            }
-
-            const DetectionType type = detectionTypeForPoint(point);
-            if (type == DetectionType::Valid && !m_displayValid)
-            {
-                continue;
-            }
-            if (type == DetectionType::SuperRes && !m_displaySuperRes)
-            {
-                continue;
-            }
-            if (type == DetectionType::NdTarget && !m_displayNdTarget)
-            {
-                continue;
-            }
-            if (type == DetectionType::HostVehicleClutter && !m_displayHostVehicleClutter)
-            {
-                continue;
-            }
-            if (type == DetectionType::MultiBounce && !m_displayMultiBounce)
-            {
-                continue;
-            }
-
-            float alpha = computeDetectionAlpha(point, ageSeconds);
-            if (alpha <= 0.05F)
-            {
-                continue;
-            }
-
-            glm::vec3 position(point.x, point.y, m_displayElevation ? point.z : 0.0F);
-            int bucketId = 0;
-            switch (m_detectionColorMode)
-            {
-                case DetectionColorMode::RadarUnit:
-                    bucketId = point.sensorIndex;
-                    break;
-                case DetectionColorMode::DetectionType:
-                    bucketId = static_cast<int>(type);
-                    break;
-                case DetectionColorMode::MotionState:
-                default:
-                    bucketId = point.motionStatus;
-                    break;
-            }
+            glUniform1f(location, value);
+        }
+    };
+    const auto setInt = [this](const char* name, int value)
+    {
+        const GLint location = m_detectionShader.uniformLocation(name);
+        if (location >= 0)
+        {
+            glUniform1i(location, value);
+        }
+    };
+    const auto setColors = [this](const char* name, const glm::vec3* colors, std::size_t count)
+    {
+        const GLint location = m_detectionShader.uniformLocation(name);
+        if (location >= 0)
+        {
+            glUniform3fv(location, static_cast<GLsizei>(count), glm::value_ptr(colors[0]));
+        }
+    };
 
-            buckets[bucketId].push_back({position, alpha});
+    const GLint vpLoc = m_detectionShader.uniformLocation("uViewProjection");
+    if (vpLoc >= 0)
+    {
+        glUniformMatrix4fv(vpLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+    }
+    setFloat("uPointSize", m_pointSize);
+    setFloat("uElevationScale", m_displayElevation ? 1.0F : 0.0F);
+    setInt("uMotionFilter", static_cast<int>(m_detectionMotionFilter));
+    setInt("uColorMode", static_cast<int>(m_detectionColorMode));
+    setInt("uAlphaMode", static_cast<int>(m_detectionAlphaMode));
+    setFloat("uAlphaConstant", m_detectionAlphaConstant);
+    setFloat("uIntensityScale", m_intensityScale);
+    setFloat("uRangeRateScale", std::max(0.1F, m_rangeRateStationaryScale));
+    const float decayWindow = std::max(0.01F, m_lastFramePeriodSec * std::max(1, m_detectionScanRetention));
+    setFloat("uDecayPerSecond", m_detectionAlphaDecay / decayWindow);
+
+    // Unknown detections have no toggle and are always drawn.
+    GLuint typeMask = 1U << static_cast<GLuint>(DetectionType::Unknown);
+    const std::array<bool, 5> typeEnabled = {
+        m_displayValid, m_displaySuperRes, m_displayNdTarget, m_displayHostVehicleClutter, m_displayMultiBounce};
+    for (std::size_t type = 0; type < typeEnabled.size(); ++type)
+    {
+        if (typeEnabled[type])
+        {
+            typeMask |= 1U << type;
         }
     }
-
-    if (buckets.empty())
+    const GLint typeMaskLoc = m_detectionShader.uniformLocation("uTypeMask");
+    if (typeMaskLoc >= 0)
     {
-        return;
+        glUniform1ui(typeMaskLoc, typeMask);
     }
 
-    m_shader.use();
-    const GLint vpLoc = m_shader.uniformLocation("uViewProjection");
-    if (vpLoc >= 0)
+    const std::array<glm::vec3, 3> motionColors = {m_staticColor, m_movingColor, m_ambiguousColor};
+    std::array<glm::vec3, 6> typeColors{};
+    for (std::size_t type = 0; type < typeColors.size(); ++type)
     {
-        glUniformMatrix4fv(vpLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+        typeColors[type] = colorForDetectionType(static_cast<DetectionType>(type));
     }
+    setColors("uMotionColors", motionColors.data(), motionColors.size());
+    setColors("uSensorColors", kSensorPalette.data(), kSensorPalette.size());
+    setColors("uTypeColors", typeColors.data(), typeColors.size());
 
-    const GLint pointSizeLoc = m_shader.uniformLocation("uPointSize");
-    if (pointSizeLoc >= 0)
+    // Only the frame age changes between draws; everything else was uploaded once per frame.
+    const uint64_t currentTimestamp = m_lastTimestampUs;
+    glBindVertexArray(m_detectionVao);
+    for (const auto& frame : m_detectionHistory)
     {
-        glUniform1f(pointSizeLoc, m_pointSize);
+        if (frame.gpuCount == 0)
+        {
+            continue;
+        }
+        const float ageSeconds =
+            currentTimestamp > frame.timestampUs
+                ? static_cast<float>(currentTimestamp - frame.timestampUs) / 1'000'000.0F
+                : 0.0F;
+        setFloat("uAgeSeconds", ageSeconds);
+        glDrawArrays(GL_POINTS, frame.gpuFirst, frame.gpuCount);
     }
+    glBindVertexArray(0);
+}
 
-    const GLint intensityLoc = m_shader.uniformLocation("uIntensityScale");
-    if (intensityLoc >= 0)
+void RadarVisualizer::uploadPendingDetections()
+{
+    std::size_t retained = 0U;
+    for (const auto& frame : m_detectionHistory)
     {
-        glUniform1f(intensityLoc, 1.0F);
+        retained += frame.points.size();
+    }
+    if (retained > m_detectionCapacity)
+    {
+        resizeDetectionRing(retained * 2U);
     }
 
-    for (const auto& bucket : buckets)
+    glBindBuffer(GL_ARRAY_BUFFER, m_detectionVbo);
+    for (auto& frame : m_detectionHistory)
     {
-        if (bucket.second.empty())
+        if (frame.gpuFirst >= 0)
         {
             continue;
         }
 
-        glm::vec3 color = m_movingColor;
-        if (m_detectionColorMode == DetectionColorMode::RadarUnit)
+        const std::size_t count = frame.points.size();
+        std::size_t first = m_detectionWriteCursor;
+        if (first + count > m_detectionCapacity)
         {
-            color = colorForSensor(bucket.first);
+            first = 0U;
         }
-        else if (m_detectionColorMode == DetectionColorMode::DetectionType)
+        const bool overlapsLiveFrame =
+            std::any_of(m_detectionHistory.begin(),
+                        m_detectionHistory.end(),
+                        [first, count](const DetectionFrame& live)
+                        {
+                            if (live.gpuFirst < 0 || live.gpuCount == 0)
+                            {
+                                return false;
+                            }
+                            const std::size_t liveFirst = static_cast<std::size_t>(live.gpuFirst);
+                            return first < liveFirst + static_cast<std::size_t>(live.gpuCount) &&
+                                   liveFirst < first + count;
+                        });
+        if (overlapsLiveFrame)
         {
-            color = colorForDetectionType(static_cast<DetectionType>(bucket.first));
+            // The history no longer fits behind the oldest frame; re-upload all of it into a larger ring,
+            // where it lands contiguously from the start.
+            resizeDetectionRing(std::max(m_detectionCapacity * 2U, retained * 2U));
+            uploadPendingDetections();
+            return;
         }
-        else
+
+        m_detectionStaging.clear();
+        m_detectionStaging.reserve(count);
+        for (const auto& point : frame.points)
         {
-            if (bucket.first == 0)
-            {
-                color = m_staticColor;
-            }
-            else if (bucket.first == 1)
-            {
-                color = m_movingColor;
-            }
-            else
-            {
-                color = m_ambiguousColor;
-            }
+            m_detectionStaging.push_back(
+                {glm::vec3(point.x, point.y, point.z), point.stationaryProbability, point.rangeRate_ms,
+                 packDetectionAttributes(point)});
         }
-
-        const GLint colorLoc = m_shader.uniformLocation("uBaseColor");
-        if (colorLoc >= 0)
+        if (count > 0U)
         {
-            glUniform3f(colorLoc, color.r, color.g, color.b);
+            glBufferSubData(GL_ARRAY_BUFFER,
+                            static_cast<GLintptr>(first * sizeof(DetectionVertex)),
+                            static_cast<GLsizeiptr>(count * sizeof(DetectionVertex)),
+                            m_detectionStaging.data());
         }
+        frame.gpuFirst = static_cast<GLint>(first);
+        frame.gpuCount = static_cast<GLsizei>(count);
+        m_detectionWriteCursor = first + count;
+    }
+}
 
-        glBindVertexArray(m_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferData(GL_ARRAY_BUFFER,
-                     bucket.second.size() * sizeof(Vertex),
-                     bucket.second.data(),
-                     GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(bucket.second.size()));
-        glBindVertexArray(0);
+void RadarVisualizer::resizeDetectionRing(std::size_t capacity)
+{
+    m_detectionCapacity = std::max(capacity, kDetectionRingInitialCapacity);
+    m_detectionWriteCursor = 0U;
+    glBindBuffer(GL_ARRAY_BUFFER, m_detectionVbo);
+    glBufferData(GL_ARRAY_BUFFER, m_detectionCapacity * sizeof(DetectionVertex), nullptr, GL_DYNAMIC_DRAW);
+    for (auto& frame : m_detectionHistory)
+    {
+        frame.gpuFirst = -1;
+        frame.gpuCount = 0;
     }
 }
 
+std::uint32_t RadarVisualizer::packDetectionAttributes(const radar::RadarPoint& point) const
+{
+    const std::uint32_t motion = point.motionStatus == 0 ? 0U : (point.motionStatus == 1 ? 1U : 2U);
+    return static_cast<std::uint32_t>(sensorPaletteSlot(point.sensorIndex)) |
+           (static_cast<std::uint32_t>(detectionTypeForPoint(point)) << 3U) | (motion << 6U) |
+           ((point.isStationary != 0U ? 1U : 0U) << 8U) | ((point.isMoveable != 0U ? 1U : 0U) << 9U);
+}
+
 void RadarVisualizer::drawTracks(const glm::mat4& viewProjection)
 {
     if (m_tracks.empty())
@@ -1727,4 +1962,14 @@ std::size_t RadarVisualizer::mapSegmentCount() const
     return static_cast<std::size_t>(clamped);
 }
 
+bool RadarVisualizer::downsampleEnabled() const
+{
+    return m_enableDownsampling;
+}
+
+float RadarVisualizer::downsampleCellSize() const
+{
+    return std::max(0.05F, m_downsampleCellSize);
+}
+
 } // namespace visualization
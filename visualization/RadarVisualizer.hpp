@@ -2,16 +2,22 @@
 
 #include "visualization/Shader.hpp"
 
+#include "mapping/MapVertex.hpp"
 #include "processing/RadarTrack.hpp"
+#include "radar_core/frame_metrics.hpp"
+#include "radar_core/memory_accounting.hpp"
 #include "sensors/BaseRadarSensor.hpp"
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,25 +41,53 @@ public:
     void updateTracks(const std::vector<radar::RadarTrack>& tracks);
     void updateMapPoints(const std::vector<glm::vec3>& points);
     void updateMapSegments(const std::vector<glm::vec3>& points);
+    // Direct-write map updates: the span is the visualizer's own vertex storage for up to capacity vertices and
+    // stays valid until the matching commit, which takes the number of vertices actually written. Positions
+    // must already be transformed with mapVertexTransform().
+    std::span<radar::MapVertex> mapPointBuffer(std::size_t capacity);
+    void commitMapPoints(std::size_t count);
+    std::span<radar::MapVertex> mapSegmentBuffer(std::size_t capacity);
+    void commitMapSegments(std::size_t count);
+    radar::MapVertexTransform mapVertexTransform() const;
     void updateVehicleContour(const std::vector<glm::vec2>& contourPoints);
     void setVcsToIsoTransform(float distRearAxle);
     void setResetMapCallback(std::function<void()> callback);
+    // Source of the Performance panel; not owned, must outlive the visualizer. Null hides the panel.
+    void setFrameMetrics(const radar::core::FrameMetricsRing* metrics);
     void render();
     bool windowShouldClose() const;
     float frameSpeedScale() const;
     std::size_t mapSegmentCount() const;
+    bool downsampleEnabled() const;
+    float downsampleCellSize() const;
 
 private:
-    struct Vertex
+    // Shared with the mapping classes' direct-write outputs.
+    using Vertex = radar::MapVertex;
+
+    // Per-point attributes for shaders/detection.vs; filtering, colour and alpha are resolved on the GPU.
+    struct DetectionVertex
     {
         glm::vec3 position;
-        float intensity;
+        float stationaryProbability;
+        float rangeRate;
+        std::uint32_t attributes;
     };
 
+    using VertexBuffer =
+        std::vector<Vertex, radar::core::TaggedAllocator<Vertex, radar::core::MemoryTag::VisualizerVertices>>;
+    using DetectionVertexBuffer = std::vector<DetectionVertex,
+        radar::core::TaggedAllocator<DetectionVertex, radar::core::MemoryTag::VisualizerVertices>>;
+    using HistoryPoints = std::vector<radar::RadarPoint,
+        radar::core::TaggedAllocator<radar::RadarPoint, radar::core::MemoryTag::VisualizerHistory>>;
+
     struct DetectionFrame
     {
-        std::vector<radar::RadarPoint> points;
+        HistoryPoints points;
         uint64_t timestampUs = 0;
+        // Range in the detection ring buffer; gpuFirst < 0 until uploaded.
+        GLint gpuFirst = -1;
+        GLsizei gpuCount = 0;
     };
 
     struct FovDescriptor
@@ -122,6 +156,7 @@ private:
     void uploadMapBuffer();
     void uploadMapSegmentBuffer();
     void uploadMapSplineBuffer();
+    void rebuildMapSpline();
     void uploadContourBuffer();
     void uploadGridBuffer();
     void buildGridVertices();
@@ -137,18 +172,21 @@ private:
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     void drawUI();
+    void drawPerformancePanel();
+    void refreshPerformanceStatistics();
     void drawDetections(const glm::mat4& viewProjection);
+    void uploadPendingDetections();
+    void resizeDetectionRing(std::size_t capacity);
+    std::uint32_t packDetectionAttributes(const radar::RadarPoint& point) const;
     void drawFovPolygons(const glm::mat4& viewProjection);
     void drawTracks(const glm::mat4& viewProjection);
     std::vector<glm::vec2> buildMapSplineBoundary(const std::vector<glm::vec2>& basePoints) const;
     std::vector<double> sampleBspline(const std::vector<double>& parameters,
                                       const std::vector<double>& values,
                                       std::size_t resolution) const;
-    bool passesMotionFilter(const radar::RadarPoint& point) const;
     DetectionType detectionTypeForPoint(const radar::RadarPoint& point) const;
     glm::vec3 colorForSensor(int sensorIndex) const;
     glm::vec3 colorForDetectionType(DetectionType type) const;
-    float computeDetectionAlpha(const radar::RadarPoint& point, float ageSeconds) const;
     glm::vec3 trackColor(const radar::RadarTrack& track) const;
 
     GLFWwindow* m_window = nullptr;
@@ -168,13 +206,20 @@ private:
     GLuint m_fovVbo = 0;
     GLuint m_trackVao = 0;
     GLuint m_trackVbo = 0;
+    GLuint m_detectionVao = 0;
+    GLuint m_detectionVbo = 0;
+    // Detection history lives in one ring buffer of m_detectionCapacity vertices; each frame is written once.
+    std::size_t m_detectionCapacity = 0U;
+    std::size_t m_detectionWriteCursor = 0U;
+    DetectionVertexBuffer m_detectionStaging;
     Shader m_shader;
-    std::vector<Vertex> m_vertices;
-    std::vector<Vertex> m_mapVertices;
-    std::vector<Vertex> m_mapSegmentVertices;
-    std::vector<Vertex> m_mapSplineVertices;
-    std::vector<Vertex> m_contourVertices;
-    std::vector<Vertex> m_gridVertices;
+    Shader m_detectionShader;
+    VertexBuffer m_vertices;
+    VertexBuffer m_mapVertices;
+    VertexBuffer m_mapSegmentVertices;
+    VertexBuffer m_mapSplineVertices;
+    VertexBuffer m_contourVertices;
+    VertexBuffer m_gridVertices;
     std::vector<radar::RadarTrack> m_tracks;
     bool m_bufferDirty = false;
     bool m_mapDirty = false;
@@ -210,6 +255,8 @@ private:
     bool m_displayElevation = true;
     bool m_enablePersistentDetections = false;
     int m_detectionScanRetention = 10;
+    bool m_enableDownsampling = false;
+    float m_downsampleCellSize = 0.25F;
     DetectionColorMode m_detectionColorMode = DetectionColorMode::MotionState;
     DetectionAlphaMode m_detectionAlphaMode = DetectionAlphaMode::Constant;
     DetectionMotionFilter m_detectionMotionFilter = DetectionMotionFilter::All;
@@ -231,7 +278,7 @@ private:
     float m_detectionAlphaDecay = 0.35F;
     float m_rangeRateStationaryScale = 5.0F;
     std::deque<DetectionFrame> m_detectionHistory;
-    std::vector<radar::RadarPoint> m_currentPoints;
+    HistoryPoints m_currentPoints;
     bool m_showTracks = true;
     float m_trackLineWidth = 1.5F;
     float m_trackAlpha = 0.85F;
@@ -248,6 +295,30 @@ private:
     int m_activeMouseButton = -1;
     uint64_t m_lastTimestampUs = 0;
     std::vector<std::string> m_lastSources;
+
+    // Performance panel: a copy of the newest samples, refreshed at most every kPerformanceRefreshPeriod, and
+    // the plot series derived from it, so frames in between only draw.
+    const radar::core::FrameMetricsRing* m_frameMetrics = nullptr;
+    bool m_showPerformance = true;
+    int m_performanceWindow = 300;
+    std::vector<radar::core::FrameMetricsSample> m_metricSamples;
+    std::uint64_t m_metricsPublished = 0U;
+    std::chrono::steady_clock::time_point m_lastMetricsRefresh;
+    std::vector<float> m_plotFrameIndex;
+    std::vector<float> m_plotFrameWork;
+    std::vector<float> m_plotFrameInterval;
+    std::vector<float> m_plotQueueDepth;
+    std::vector<float> m_plotAllocations;
+    std::array<std::vector<float>, radar::core::kFrameMetricsSensorCount> m_plotSensorPoints;
+    // Row-major p50 / p95 / p99 x stage, as ImPlot::PlotBarGroups takes them.
+    std::vector<float> m_stagePercentiles;
+    std::vector<const char*> m_stageLabels;
+    std::vector<double> m_stageTicks;
+    std::vector<float> m_percentileScratch;
+    float m_framesPerSecond = 0.0F;
+    float m_frameWorkP50 = 0.0F;
+    float m_frameWorkP95 = 0.0F;
+    float m_performancePanelMs = 0.0F;
 };
 
 } // namespace visualization